@@ -19,6 +19,7 @@
 
 #include "uds/uds_core.h"
 #include "uds/uds_isotp.h"
+#include "uds/uds_trace.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -145,8 +146,8 @@ static char g_customer_name[16] = "ECU_OWNER";
  * @brief Example DID table setup.
  */
 static const uds_did_entry_t g_ecu_dids[] = {
-    {0xF190, 14, 0, 0, NULL, NULL, g_ecu_vin},       /* VIN (Direct storage) */
-    {0x0123, 16, 0, 0, NULL, NULL, g_customer_name}, /* Customer Name (Read/Write) */
+    {0xF190, 14, 0, 0, NULL, NULL, g_ecu_vin, 0},       /* VIN (Direct storage) */
+    {0x0123, 16, 0, 0, NULL, NULL, g_customer_name, 0}, /* Customer Name (Read/Write) */
 };
 
 static const uds_did_table_t g_ecu_did_table = {.entries = g_ecu_dids, .count = 2};
@@ -298,6 +299,20 @@ static int mock_periodic_read(struct uds_ctx *ctx, uint8_t periodic_id, uint8_t
     return 2;
 }
 
+/* Binary event trace, drained to a file when one is given on the command line */
+static uds_trace_record_t g_trace_records[256];
+static uds_trace_ring_t g_trace;
+
+static void trace_flush(FILE *out)
+{
+    uds_trace_record_t batch[32];
+    uint32_t n;
+    while ((n = uds_trace_read(&g_trace, batch, 32)) > 0) {
+        fwrite(batch, sizeof(batch[0]), n, out);
+    }
+    fflush(out);
+}
+
 /**
  * @brief Main Entry Point for ECU Simulator.
  */
@@ -312,6 +327,11 @@ int main(int argc, char **argv)
     if (argc > 2) {
         enable_fd = atoi(argv[2]);
     }
+    FILE *trace_out = NULL;
+    if (argc > 3) {
+        /* Decode with tools/decode_trace.py */
+        trace_out = fopen(argv[3], "wb");
+    }
 
     printf("Starting UDS ECU Simulator (ISO-TP over UDP:%d) [CAN-FD: %d]...\n", port, enable_fd);
 
@@ -336,6 +356,7 @@ int main(int argc, char **argv)
                         .get_time_ms = get_time_ms,
                         .fn_log = log_event,
                         .fn_tp_send = uds_isotp_send,
+                        .fn_tp_max_sdu = uds_isotp_max_sdu,
                         .fn_reset = mock_reset,
                         .fn_dtc_read = mock_dtc_read,
                         .fn_dtc_clear = mock_dtc_clear,
@@ -360,6 +381,11 @@ int main(int argc, char **argv)
                         .p2_ms = 50,
                         .p2_star_ms = 2000};
 
+    if (trace_out != NULL) {
+        uds_trace_init(&g_trace, g_trace_records, 256);
+        cfg.trace = &g_trace;
+    }
+
     uds_ctx_t ctx;
     uds_init(&ctx, &cfg);
 
@@ -397,6 +423,10 @@ int main(int argc, char **argv)
             uds_isotp_rx_callback(&ctx, pkt.id, pkt.data, pkt.len);
         }
 
+        if (trace_out != NULL) {
+            trace_flush(trace_out);
+        }
+
         usleep(100);
     }
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_access.h
+ * @brief Precomputed Session / Security Permission Matrix
+ *
+ * The session_mask and security_mask of a service or DID entry are expanded
+ * into a 64-bit permission word: one bit per (session, security level) cell.
+ * Authorizing a request is then a single bit test against the cell of the
+ * active session and security level.
+ *
+ * Rows (sessions): default, extended, programming, and any other session.
+ * The last row is only granted by session_mask 0 or UDS_SESSION_ALL.
+ * Columns (security levels): 0 (locked) to 15. The two tables keep their
+ * own meaning of security_mask:
+ * - services: minimum level (0 = none), so every level from it on is set;
+ * - DIDs: UDS_SECURITY_LEVEL() bit per granting level (0 = none).
+ * Levels above 15 have no column and are checked against the entry itself.
+ *
+ * With uds_config_t::access_matrix set, uds_init() compiles the words of
+ * every user service and DID once. Without it, the same word is built for
+ * each check, with identical results.
+ */
+
+#ifndef UDS_ACCESS_H
+#define UDS_ACCESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** Security levels per row (columns of the matrix) */
+#define UDS_ACCESS_LEVELS 16u
+
+/** Words needed in uds_config_t::access_matrix */
+#define UDS_ACCESS_MATRIX_SIZE(user_service_count, did_count) \
+    ((user_service_count) + (did_count))
+
+/* --- Public API --- */
+
+/**
+ * @brief Permission word of a set of granting levels.
+ *
+ * @param session_mask UDS_SESSION_* bits (0 = all sessions).
+ * @param levels       Bit n grants security level n (0..15) in those sessions.
+ * @return Bit (row * UDS_ACCESS_LEVELS + level) set for every permitted cell.
+ */
+uint64_t uds_access_bits(uint8_t session_mask, uint16_t levels);
+
+/**
+ * @brief Permission word of a service entry.
+ *
+ * @param session_mask UDS_SESSION_* bits (0 = all sessions).
+ * @param min_level    Minimum security level (0 = no security required).
+ */
+uint64_t uds_access_service_bits(uint8_t session_mask, uint16_t min_level);
+
+/**
+ * @brief Permission word of a DID entry.
+ *
+ * @param session_mask  UDS_SESSION_* bits (0 = all sessions).
+ * @param security_mask UDS_SECURITY_LEVEL() bits (0 = no security required).
+ */
+uint64_t uds_access_did_bits(uint8_t session_mask, uint16_t security_mask);
+
+/**
+ * @brief Recompile the permission matrix of a context.
+ *
+ * Called by uds_init(). Call it again after replacing user_services or
+ * did_table of an initialized context.
+ *
+ * @param ctx Initialized context.
+ * @return UDS_OK (also without access_matrix), UDS_ERR_NOT_INIT, or
+ *         UDS_ERR_BUFFER_TOO_SMALL if access_matrix_size is below
+ *         UDS_ACCESS_MATRIX_SIZE().
+ */
+int uds_access_compile(uds_ctx_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_ACCESS_H */
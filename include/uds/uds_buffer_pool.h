@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_buffer_pool.h
+ * @brief Shared Buffer Pool for Many Contexts
+ *
+ * Alternative to a dedicated rx_buffer / tx_buffer per uds_config_t. With
+ * uds_config_t::buffer_pool set, a context borrows its response buffer when
+ * it dispatches a request and returns it once the final response is sent,
+ * and the built-in ISO-TP borrows its reassembly buffer for the length
+ * announced in the First Frame. Memory then scales with the number of
+ * concurrent transfers instead of the number of configured ECUs.
+ *
+ * Blocks are grouped in up to UDS_BUFFER_POOL_MAX_CLASSES size classes. A
+ * borrow takes the smallest class that fits and falls back to larger ones.
+ * Borrowing and returning are lock-free, so one pool can be shared by
+ * contexts on different threads.
+ */
+
+#ifndef UDS_BUFFER_POOL_H
+#define UDS_BUFFER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** Maximum number of size classes per pool */
+#ifndef UDS_BUFFER_POOL_MAX_CLASSES
+#define UDS_BUFFER_POOL_MAX_CLASSES 4u
+#endif
+
+/** Bitmap words needed for count blocks */
+#define UDS_BUFFER_POOL_WORDS(count) (((count) + 31u) / 32u)
+
+/**
+ * @brief One size class (blocks of equal size)
+ */
+typedef struct
+{
+    uint8_t *storage;     /**< block_count * block_size bytes */
+    uint32_t *used;       /**< Allocation bitmap, UDS_BUFFER_POOL_WORDS(block_count) words */
+    uint16_t block_size;  /**< Bytes per block */
+    uint16_t block_count; /**< Number of blocks */
+} uds_buffer_class_t;
+
+/**
+ * @brief Buffer Pool
+ *
+ * Allocated by the application; storage is added per class.
+ */
+typedef struct uds_buffer_pool
+{
+    uds_buffer_class_t classes[UDS_BUFFER_POOL_MAX_CLASSES]; /**< Ascending block size */
+    uint8_t class_count;                                     /**< Classes added */
+    uint32_t in_use;                                         /**< Blocks currently borrowed */
+    uint32_t exhausted;                                      /**< Borrows that found no block */
+} uds_buffer_pool_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize an empty pool.
+ *
+ * @param pool Pool to initialize.
+ */
+void uds_buffer_pool_init(uds_buffer_pool_t *pool);
+
+/**
+ * @brief Add a size class. Call before the pool is used.
+ *
+ * @param pool        Pool.
+ * @param storage     block_count * block_size bytes.
+ * @param used        UDS_BUFFER_POOL_WORDS(block_count) bitmap words.
+ * @param block_size  Bytes per block.
+ * @param block_count Number of blocks.
+ * @return UDS_OK, UDS_ERR_INVALID_ARG, or UDS_ERR_BUFFER_TOO_SMALL if all
+ *         class slots are taken.
+ */
+int uds_buffer_pool_add_class(uds_buffer_pool_t *pool, uint8_t *storage, uint32_t *used,
+                              uint16_t block_size, uint16_t block_count);
+
+/**
+ * @brief Borrow a block of at least size bytes.
+ *
+ * @param pool    Pool.
+ * @param size    Bytes needed.
+ * @param granted Receives the block size (may be NULL).
+ * @return The block, or NULL if no class can serve the request.
+ */
+uint8_t *uds_buffer_pool_borrow(uds_buffer_pool_t *pool, uint16_t size, uint16_t *granted);
+
+/**
+ * @brief Return a borrowed block.
+ *
+ * @param pool  Pool.
+ * @param block Block from uds_buffer_pool_borrow() (NULL is ignored).
+ */
+void uds_buffer_pool_return(uds_buffer_pool_t *pool, uint8_t *block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_BUFFER_POOL_H */
@@ -19,9 +19,44 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "uds_features.h"
+
 /* Forward declaration of the opaque context */
 struct uds_ctx;
 
+/* Forward declaration of an asynchronous job (uds_job.h) */
+struct uds_job;
+
+/* Forward declaration of the statistics storage (uds_stats.h) */
+struct uds_stats;
+
+/* Forward declaration of the event trace ring (uds_trace.h) */
+struct uds_trace_ring;
+
+/* Forward declaration of the single-owner mailbox (uds_mailbox.h) */
+struct uds_mailbox;
+
+/* Forward declaration of the shared buffer pool (uds_buffer_pool.h) */
+struct uds_buffer_pool;
+
+/* Forward declaration of the DID response cache (uds_did_cache.h) */
+struct uds_did_cache;
+
+/* Forward declaration of a dynamically defined DID (uds_dyn_did.h) */
+struct uds_dyn_did;
+
+/* Forward declaration of the periodic data scheduler (uds_periodic.h) */
+struct uds_periodic;
+
+/* Forward declaration of the ResponseOnEvent state (uds_roe.h) */
+struct uds_roe;
+
+/* Forward declaration of the DTC fault memory (uds_dtc.h) */
+struct uds_dtc_store;
+
+/* Forward declaration of the TransferData staging pool (uds_transfer_pipe.h) */
+struct uds_transfer_pipe;
+
 /* --- Log Levels --- */
 
 /** Error level logging */
@@ -60,6 +95,98 @@ typedef uint32_t (*uds_get_time_fn)(void);
  */
 typedef int (*uds_tp_send_fn)(struct uds_ctx *ctx, const uint8_t *data, uint16_t len);
 
+/**
+ * @brief One segment of a scattered SDU
+ */
+typedef struct
+{
+    const uint8_t *base; /**< Start of the segment */
+    uint16_t len;        /**< Segment length in bytes */
+} uds_iovec_t;
+
+/**
+ * @brief Scatter-Gather Transport Send Function (SDU Level)
+ *
+ * Sends the concatenation of all segments as one SDU. Segments may point
+ * outside the tx_buffer (e.g. into flash); they are only guaranteed to stay
+ * valid until the function returns.
+ *
+ * @param ctx   Pointer to the UDS stack context.
+ * @param iov   Segments in transmission order.
+ * @param count Number of segments.
+ * @param len   Total SDU length in bytes.
+ * @return      0 on success, negative error code on failure.
+ */
+typedef int (*uds_tp_sendv_fn)(struct uds_ctx *ctx, const uds_iovec_t *iov, uint8_t count,
+                               uint16_t len);
+
+/**
+ * @brief Producer of a Streamed Response Body (uds_response_stream())
+ *
+ * Writes the body bytes at positions pos .. pos + len - 1 into buf. Positions
+ * start at the value given to uds_response_stream() and are requested in
+ * increasing order without gaps, one transport frame at a time.
+ *
+ * @param ctx Pointer to the UDS stack context.
+ * @param arg Argument given to uds_response_stream().
+ * @param pos Position of the first byte.
+ * @param buf Destination of len bytes.
+ * @param len Number of bytes to produce.
+ * @return    UDS_OK, or a negative NRC.
+ */
+typedef int (*uds_stream_fn)(struct uds_ctx *ctx, void *arg, uint32_t pos, uint8_t *buf,
+                             uint16_t len);
+
+/**
+ * @brief Streaming Transport Send Function (SDU Level)
+ *
+ * Starts an SDU of len bytes without its data: the transport pulls the bytes
+ * with uds_stream_pull() as it emits frames, so the SDU may be larger than
+ * the tx_buffer. Frames sent after this call returns are pulled with
+ * uds_stream_pull_locked() (see uds_response.h).
+ *
+ * @param ctx Pointer to the UDS stack context.
+ * @param len Total SDU length in bytes.
+ * @return    0 on success, negative error code on failure.
+ */
+typedef int (*uds_tp_send_stream_fn)(struct uds_ctx *ctx, uint32_t len);
+
+/**
+ * @brief Transport SDU Limit
+ *
+ * Reports the largest SDU the transport carries in one direction. Sizes the
+ * maxNumberOfBlockLength of RequestDownload (received blocks) and
+ * RequestUpload (sent blocks).
+ *
+ * @param ctx      Pointer to the UDS stack context.
+ * @param response true for SDUs sent by the stack, false for received ones.
+ * @return         Largest SDU length in bytes.
+ */
+typedef uint32_t (*uds_tp_max_sdu_fn)(struct uds_ctx *ctx, bool response);
+
+/** Maximum bytes of a streamed response written before its body (SID and header) */
+#ifndef UDS_STREAM_HEAD_MAX
+#define UDS_STREAM_HEAD_MAX 8u
+#endif
+
+/**
+ * @brief Streamed Response State
+ *
+ * Lives in the context from uds_response_commit() until the transport has
+ * pulled the last byte.
+ */
+typedef struct
+{
+    uds_stream_fn fn;                      /**< Body producer */
+    void *arg;                             /**< Producer argument */
+    uint32_t start;                        /**< Position of the first body byte */
+    uint32_t len;                          /**< SDU length (head and body) */
+    uint32_t pos;                          /**< SDU bytes pulled so far */
+    uint8_t head[UDS_STREAM_HEAD_MAX];     /**< Response bytes before the body */
+    uint8_t head_len;                      /**< Bytes used in head */
+    bool active;                           /**< The transport is pulling this response */
+} uds_stream_t;
+
 /**
  * @brief ECU Reset Callback (SID 0x11)
  *
@@ -83,6 +210,12 @@ typedef int (*uds_security_seed_fn)(struct uds_ctx *ctx, uint8_t level, uint8_t
 typedef int (*uds_security_key_fn)(struct uds_ctx *ctx, uint8_t level, const uint8_t *seed,
                                    const uint8_t *key, uint16_t key_len);
 
+/**
+ * @brief DID Cache Flags (uds_did_cache.h)
+ */
+#define UDS_DID_FLAG_IMMUTABLE 0x01u /**< Value never changes (VIN, part numbers) */
+#define UDS_DID_FLAG_VERSIONED 0x02u /**< Value changes only with uds_did_cache_bump() */
+
 /**
  * @brief DID Registry Entry
  */
@@ -90,11 +223,12 @@ typedef struct
 {
     uint16_t id;            /**< Data Identifier (e.g., 0xF190) */
     uint16_t size;          /**< Expected data size in bytes */
-    uint8_t session_mask;   /**< Allowed sessions bitmask (0=All) */
-    uint16_t security_mask; /**< Required security level (0=None) */
+    uint8_t session_mask;   /**< Allowed sessions, UDS_SESSION_* bits (0 = all) */
+    uint16_t security_mask; /**< Granting levels, UDS_SECURITY_LEVEL() bits (0 = none needed) */
     uds_did_read_fn read;   /**< Optional: Dynamic read callback */
     uds_did_write_fn write; /**< Optional: Dynamic write callback */
     void *storage;          /**< Optional: Direct data storage pointer */
+    uint8_t flags;          /**< Optional: UDS_DID_FLAG_* (0 = encoded on every read) */
 } uds_did_entry_t;
 
 /**
@@ -116,6 +250,16 @@ typedef struct
 #define UDS_SESSION_PROGRAMMING (1 << 2)
 #define UDS_SESSION_ALL (0xFF)
 
+/**
+ * @brief Security Level Mask
+ *
+ * security_mask of DIDs: set the bit of every level (0..15) that grants
+ * access, e.g. UDS_SECURITY_LEVEL(1) | UDS_SECURITY_LEVEL(3). Services give
+ * a minimum level instead.
+ * See uds_access.h.
+ */
+#define UDS_SECURITY_LEVEL(level) ((uint16_t) (1u << (level)))
+
 /**
  * @brief Service Handler Function Signature
  *
@@ -133,12 +277,81 @@ typedef struct
 {
     uint8_t sid;                   /**< Service ID (e.g., 0x22) */
     uint16_t min_len;              /**< Minimum required request length */
-    uint8_t session_mask;          /**< Allowed sessions bitmask */
-    uint16_t security_mask;        /**< Minimum security level required (bitmask or level) */
+    uint8_t session_mask;          /**< Allowed sessions, UDS_SESSION_* bits (0 = all) */
+    uint16_t security_mask;        /**< Minimum security level required (0 = none) */
     uds_service_handler_t handler; /**< Function pointer to handler */
     const uint8_t *sub_mask; /**< Optional bitmask of supported 7-bit subfunctions (16 bytes) */
 } uds_service_entry_t;
 
+/* --- Multi-Tester Support --- */
+
+/**
+ * @brief Per-Tester Connection State
+ *
+ * One entry per concurrently connected tester, keyed by its source address
+ * (or transport channel). The application provides the storage through
+ * uds_config_t::tester_states; the stack swaps the entry in and out of the
+ * context around every request so that each tester sees its own session,
+ * security and P2/S3 timing.
+ */
+typedef struct
+{
+    uint16_t addr;               /**< Tester source address / channel id */
+    bool in_use;                 /**< True while the entry is bound to a tester */
+    uint8_t active_session;      /**< Diagnostic session of this tester */
+    uint8_t security_level;      /**< Security level unlocked by this tester */
+    uint32_t last_msg_time;      /**< Last request timestamp (S3 timer) */
+    uint32_t p2_timer_start;     /**< P2/P2* timer start */
+    uint32_t pending_start_time; /**< Dispatch time of the outstanding request */
+#if UDS_CFG_FEATURE_JOB
+    uint16_t pending_job_id; /**< Job serving the outstanding request (0 = none) */
+#endif
+#if UDS_CFG_FEATURE_STATS
+    uint32_t stats_start_us; /**< Statistics start time of the outstanding request */
+#endif
+    bool p2_msg_pending;         /**< Asynchronous request outstanding */
+    bool p2_star_active;         /**< NRC 0x78 already sent */
+    uint8_t pending_sid;         /**< SID of the outstanding request */
+    bool suppress_pos_resp;      /**< Suppress bit of the outstanding request */
+    uint16_t rcrrp_count;        /**< NRC 0x78 repetitions */
+#if UDS_CFG_FEATURE_SECURITY
+    uint32_t security_delay_end; /**< Security delay expiry */
+    uint8_t security_attempts;   /**< Failed security attempts */
+#endif
+} uds_tester_state_t;
+
+/* --- Request Queue --- */
+
+/** Answer requests received while busy with NRC 0x21 (default) */
+#define UDS_QUEUE_POLICY_REJECT 0u
+/** Queue requests received while busy, reject with NRC 0x21 only when full */
+#define UDS_QUEUE_POLICY_QUEUE 1u
+/** Like QUEUE, but a newer request of the same tester and SID replaces the queued one */
+#define UDS_QUEUE_POLICY_REPLACE_SAME_SID 2u
+
+/** Per-entry bookkeeping bytes (request length + tester address) */
+#define UDS_QUEUE_SLOT_HEADER 4u
+
+/** Size of uds_config_t::queue_buffer for @p depth requests of up to @p slot_size bytes */
+#define UDS_QUEUE_BUFFER_SIZE(depth, slot_size) ((depth) * ((slot_size) + UDS_QUEUE_SLOT_HEADER))
+
+/* --- Response Pending (NRC 0x78) Policy --- */
+
+/** Send NRC 0x78 as soon as a handler returns UDS_PENDING (default) */
+#define UDS_RCRRP_POLICY_IMMEDIATE 0u
+/** Send the first NRC 0x78 only if the handler has not completed shortly before P2 expires */
+#define UDS_RCRRP_POLICY_DEFERRED 1u
+/** Like DEFERRED, but SIDs whose learned latency exceeds P2 get NRC 0x78 immediately */
+#define UDS_RCRRP_POLICY_ADAPTIVE 2u
+
+/** Default safety margin before P2 expiry for the deferred NRC 0x78 (ms) */
+#define UDS_RCRRP_DEFAULT_MARGIN_MS 5u
+
+/** Number of SIDs whose handler latency is learned (ADAPTIVE policy) */
+#ifndef UDS_LATENCY_TABLE_SIZE
+#define UDS_LATENCY_TABLE_SIZE 8u
+#endif
+
 /* --- Configuration Structure --- */
 
 /**
@@ -161,6 +374,23 @@ typedef struct
     /* --- Transport Interface --- */
     /** Mandatory: Output function for UDS SDUs */
     uds_tp_send_fn fn_tp_send;
+    /**
+     * Optional: Scatter-gather output used by the response writer (uds_response.h).
+     * NULL = referenced data is copied into the tx_buffer and sent with fn_tp_send.
+     */
+    uds_tp_sendv_fn fn_tp_sendv;
+#if UDS_CFG_FEATURE_STREAM
+    /**
+     * Optional: Streaming output for responses larger than the tx_buffer
+     * (uds_response_stream()). NULL = such responses are answered with NRC 0x14.
+     */
+    uds_tp_send_stream_fn fn_tp_send_stream;
+#endif
+    /**
+     * Optional: Largest SDU of the transport (e.g. uds_isotp_max_sdu()).
+     * NULL = SDUs are limited by the rx_buffer / tx_buffer only.
+     */
+    uds_tp_max_sdu_fn fn_tp_max_sdu;
 
     /* --- Timing Configuration (ISO 14229-1) --- */
     /** Default P2 server timeout (usually 50ms) */
@@ -188,16 +418,27 @@ typedef struct
 
     /* --- Memory Management (Zero Malloc) --- */
 
-    /** Working buffer for reassembling incoming requests */
+    /** Working buffer for reassembling incoming requests (NULL with buffer_pool) */
     uint8_t *rx_buffer;
     /** Size of rx_buffer. Determines Max Request Size */
     uint16_t rx_buffer_size;
 
-    /** Working buffer for constructing responses */
+    /**
+     * Working buffer for constructing responses (NULL with buffer_pool).
+     * Handlers should access it through uds_tx_buffer().
+     */
     uint8_t *tx_buffer;
-    /** Size of tx_buffer. Determines Max Response Size */
+    /** Size of tx_buffer. Determines Max Response Size (block size borrowed with buffer_pool) */
     uint16_t tx_buffer_size;
 
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    /**
+     * Optional: Shared pool the rx/tx buffers are borrowed from per transfer
+     * (uds_buffer_pool.h). NULL = dedicated rx_buffer / tx_buffer.
+     */
+    struct uds_buffer_pool *buffer_pool;
+#endif
+
     /* --- Enterprise Hardening --- */
     /**
      * @brief Enable strict ISO 14229-1 compliance checks.
@@ -221,6 +462,17 @@ typedef struct
     /** ISO 14229-1: Max allowed NRC 0x78 (ResponsePending) repetitions. 0=Infinite (C-07) */
     uint16_t rcrrp_limit;
 
+    /**
+     * @brief NRC 0x78 transmission policy (UDS_RCRRP_POLICY_*).
+     *
+     * DEFERRED and ADAPTIVE require uds_process() to run at least once per
+     * rcrrp_margin_ms (or a timer wheel). ADAPTIVE calls get_time_ms() once
+     * more when a pending request completes.
+     */
+    uint8_t rcrrp_policy;
+    /** Deferred NRC 0x78 is sent this long before P2 expires. 0 = UDS_RCRRP_DEFAULT_MARGIN_MS */
+    uint16_t rcrrp_margin_ms;
+
     /**
      * @brief Flash transfer robustness: accept last-block replay (SID 0x36).
      *
@@ -236,6 +488,18 @@ typedef struct
     /* --- Data Identifiers (SID 0x22 / 0x2E) --- */
     /** Mandatory for RDBI/WDBI: Table of supported DIDs */
     uds_did_table_t did_table;
+#if UDS_CFG_FEATURE_DID_CACHE
+    /** Optional: Cache of encoded UDS_DID_FLAG_* DIDs (uds_did_cache.h). NULL = disabled */
+    struct uds_did_cache *did_cache;
+#endif
+    /**
+     * @brief Optional: Dynamically defined DIDs (SID 0x2C, uds_dyn_did.h).
+     *
+     * dyn_did_count application-owned slots. NULL = 0x2C answers NRC 0x22.
+     */
+    struct uds_dyn_did *dyn_dids;
+    /** Number of entries in dyn_dids */
+    uint8_t dyn_did_count;
 
     /* --- Custom Services --- */
     /** Optional: Table of application-specific service handlers */
@@ -243,6 +507,95 @@ typedef struct
     /** Number of entries in user_services table */
     uint16_t user_service_count;
 
+#if UDS_CFG_FEATURE_ACCESS_MATRIX
+    /* --- Access Control (uds_access.h) --- */
+    /**
+     * @brief Optional: Storage for the compiled permission matrix.
+     *
+     * UDS_ACCESS_MATRIX_SIZE(user_service_count, did_table.count) words,
+     * filled by uds_init(). NULL = permissions are derived from the masks on
+     * every check.
+     */
+    uint64_t *access_matrix;
+    /** Number of words in access_matrix */
+    uint16_t access_matrix_size;
+#endif
+
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    /* --- Multi-Tester Support --- */
+    /**
+     * @brief Optional: Per-tester connection state storage.
+     *
+     * When set, every request fed through uds_input_sdu_from() is served with
+     * the session, security and timing state of its source address. Up to
+     * tester_state_count testers are tracked; idle default-session testers are
+     * evicted (least recently used) when a new one connects. NULL = a single
+     * tester shares the context state.
+     */
+    uds_tester_state_t *tester_states;
+    /** Number of entries in tester_states */
+    uint8_t tester_state_count;
+#endif
+
+#if UDS_CFG_FEATURE_QUEUE
+    /* --- Request Queue --- */
+    /**
+     * @brief Optional: Storage for requests received while a request is pending.
+     *
+     * Must hold UDS_QUEUE_BUFFER_SIZE(queue_depth, queue_slot_size) bytes.
+     * Queued requests are dispatched in arrival order as soon as the pending
+     * request of their tester completes. NULL = always answer NRC 0x21.
+     */
+    uint8_t *queue_buffer;
+    /** Largest request (bytes, including SID) that can be queued */
+    uint16_t queue_slot_size;
+    /** Number of requests the queue can hold */
+    uint8_t queue_depth;
+    /** Busy handling policy (UDS_QUEUE_POLICY_*) */
+    uint8_t queue_policy;
+#endif
+
+#if UDS_CFG_FEATURE_JOB
+    /* --- Job Executor (uds_job.h) --- */
+    /**
+     * @brief Optional: Hand a job submitted with uds_submit_job() to an executor.
+     *
+     * The executor (worker thread, thread pool, RTOS work queue) must later call
+     * uds_job_execute(job) from its own context. NULL = jobs run inline inside
+     * the service handler. Requires fn_mutex_lock / fn_mutex_unlock or a
+     * mailbox, otherwise uds_init() fails: the completion must not run while
+     * the request is still being dispatched.
+     *
+     * @param executor job_executor handle.
+     * @param job      Job to run.
+     * @return 0 if the job was accepted, negative if it could not be queued.
+     */
+    int (*fn_job_submit)(void *executor, struct uds_job *job);
+    /** Executor handle passed to fn_job_submit */
+    void *job_executor;
+#endif
+
+    /* --- Instrumentation (uds_stats.h) --- */
+#if UDS_CFG_FEATURE_STATS
+    /**
+     * @brief Optional: Per-SID counters and latency histograms.
+     *
+     * Costs two time reads per dispatched request and one per completed
+     * pending request. NULL = disabled.
+     */
+    struct uds_stats *stats;
+#endif
+    /** Optional: Microsecond clock for statistics and tracing. NULL = get_time_ms() * 1000 */
+    uds_get_time_fn get_time_us;
+#if UDS_CFG_FEATURE_TRACE
+    /**
+     * @brief Optional: Binary event trace ring (uds_trace.h).
+     *
+     * Costs one time read per trace point. NULL = disabled.
+     */
+    struct uds_trace_ring *trace;
+#endif
+
     /* --- Advanced Policy Callbacks --- */
 
     /**
@@ -282,6 +635,25 @@ typedef struct
      */
     int (*fn_dtc_clear)(struct uds_ctx *ctx, uint32_t group);
 
+#if UDS_CFG_FEATURE_DTC
+    /**
+     * @brief Optional: Built-in DTC fault memory (uds_dtc.h).
+     *
+     * Answers 0x19 subfunctions 0x01, 0x02 and 0x0A and clears DTCs for 0x14.
+     * NULL = fn_dtc_read / fn_dtc_clear handle everything.
+     */
+    struct uds_dtc_store *dtc_store;
+#endif
+
+#if UDS_CFG_SERVICE_86
+    /**
+     * @brief Optional: ResponseOnEvent state (SID 0x86, uds_roe.h).
+     *
+     * NULL = 0x86 answers NRC 0x22.
+     */
+    struct uds_roe *roe;
+#endif
+
     /**
      * @brief Optional: Authentication (SID 0x29).
      * @param ctx       Pointer to context.
@@ -338,6 +710,27 @@ typedef struct
      */
     int (*fn_transfer_exit)(struct uds_ctx *ctx);
 
+#if UDS_CFG_FEATURE_FLASH
+    /**
+     * @brief Optional: Pipelined TransferData (uds_transfer_pipe.h).
+     *
+     * Blocks are acknowledged once staged, and fn_transfer_data writes them
+     * on the job executor while the next block is received. NULL = each
+     * block is written before its response.
+     */
+    struct uds_transfer_pipe *transfer_pipe;
+#endif
+
+    /**
+     * @brief Optional: Cap of maxNumberOfBlockLength (SID 0x34 / 0x35).
+     *
+     * The block length reported by RequestDownload and RequestUpload is the
+     * largest message the buffers, the transport (fn_tp_max_sdu) and the
+     * transfer_pipe slots allow. A non-zero value lowers it, e.g. to the
+     * flash page size. 0 = no cap.
+     */
+    uint32_t max_block_length;
+
     /**
      * @brief Callback for Read Memory By Address (0x23)
      *
@@ -349,6 +742,17 @@ typedef struct
      */
     int (*fn_mem_read)(struct uds_ctx *ctx, uint32_t addr, uint32_t size, uint8_t *out_buf);
 
+    /**
+     * @brief Optional: Map a memory range for zero-copy Read Memory By Address (0x23)
+     *
+     * Used by 0x23 together with fn_tp_sendv: the range is then sent by
+     * reference instead of through fn_mem_read(). Also used by 0x2C to turn a
+     * memory source of a dynamic DID into a plain copy.
+     *
+     * @return Pointer to directly readable memory, or NULL to use fn_mem_read().
+     */
+    const uint8_t *(*fn_mem_map)(struct uds_ctx *ctx, uint32_t addr, uint32_t size);
+
     /** Callback for Write Memory By Address (0x3D) */
     int (*fn_mem_write)(struct uds_ctx *ctx, uint32_t addr, uint32_t size, const uint8_t *data);
 
@@ -361,6 +765,21 @@ typedef struct
     /** Optional: Periodic Data Read (Used for SID 0x2A) */
     int (*fn_periodic_read)(struct uds_ctx *ctx, uint8_t periodic_id, uint8_t *out_buf,
                             uint16_t max_len);
+    /**
+     * @brief Optional: Raw periodic transmit hook (SID 0x2A).
+     *
+     * Sends one complete periodic message [periodic_id][data], e.g. as a
+     * single CAN frame on the periodic CAN ID (ISO 14229-1 type 1), outside
+     * of ISO-TP. NULL = periodic messages are sent with fn_tp_send.
+     */
+    int (*fn_periodic_send)(struct uds_ctx *ctx, const uint8_t *frame, uint16_t len);
+    /**
+     * @brief Optional: Periodic data scheduler (SID 0x2A, uds_periodic.h).
+     *
+     * Capacity, intervals and payload size of 0x2A. NULL = the built-in
+     * scheduler of UDS_PERIODIC_BUILTIN_SLOTS IDs with the default rates.
+     */
+    struct uds_periodic *periodic;
 
     /* --- OS Abstraction Layer (OSAL) --- */
 
@@ -378,6 +797,17 @@ typedef struct
      * @brief Callback to unlock the UDS context mutex.
      */
     void (*fn_mutex_unlock)(void *mutex_handle);
+
+#if UDS_CFG_FEATURE_MAILBOX
+    /**
+     * @brief Optional: Single-owner mode (uds_mailbox.h).
+     *
+     * Calls from other threads are posted here and executed by the thread
+     * that calls uds_process(). Leave the mutex callbacks NULL in this mode.
+     * NULL = every call runs immediately under the mutex.
+     */
+    struct uds_mailbox *mailbox;
+#endif
     /* --- Timing Parameters (C-19) --- */
     /** Default P2 Server Max (ms). Recommended: 50ms */
     uint16_t p2_server_max;
@@ -388,6 +818,45 @@ typedef struct
 
 /* --- Internal Context --- */
 
+/**
+ * @brief Timer Wheel Node
+ *
+ * Embedded in every context so that it can register its next deadline with a
+ * shared uds_timer_wheel_t without any allocation.
+ */
+typedef struct uds_timer_node
+{
+    struct uds_timer_node *next;   /**< Next node in the slot list */
+    struct uds_timer_node **pprev; /**< Link pointing at this node (O(1) unlink) */
+    struct uds_ctx *owner;         /**< Context this node belongs to */
+    uint32_t expires;              /**< Absolute deadline (ms) */
+    bool armed;                    /**< True while linked into a wheel slot */
+} uds_timer_node_t;
+
+/** Periodic IDs scheduled without uds_config_t::periodic */
+#ifndef UDS_PERIODIC_BUILTIN_SLOTS
+#define UDS_PERIODIC_BUILTIN_SLOTS 8u
+#endif
+
+/** Size of the built-in periodic message buffer: ID byte and 8 data bytes */
+#define UDS_PERIODIC_FRAME_LEN 9u
+
+/**
+ * @brief Scheduled Periodic ID (SID 0x2A, uds_periodic.h)
+ *
+ * One heap entry: the next deadline and the transmission statistics.
+ */
+typedef struct
+{
+    uint32_t deadline;       /**< Next transmission (ms) */
+    uint32_t sent;           /**< Messages transmitted */
+    uint32_t overruns;       /**< Transmissions missed (server behind or send failed) */
+    uint16_t last_jitter_ms; /**< Delay of the last transmission past its deadline */
+    uint16_t max_jitter_ms;  /**< Largest such delay */
+    uint8_t id;              /**< Periodic identifier */
+    uint8_t rate;            /**< Transmission mode (1 fast, 2 medium, 3 slow) */
+} uds_periodic_entry_t;
+
 /**
  * @brief UDS Internal Context
  *
@@ -416,6 +885,18 @@ typedef struct uds_ctx
     bool p2_msg_pending;
     /** True if we have already sent the first 0x78 NRC */
     bool p2_star_active;
+    /** Dispatch time of the outstanding UDS_PENDING request */
+    uint32_t pending_start_time;
+#if UDS_CFG_FEATURE_JOB
+    /** Job serving the outstanding request (0 = none) */
+    uint16_t pending_job_id;
+    /** Last job id handed out by uds_submit_job() */
+    uint16_t job_seq;
+#endif
+#if UDS_CFG_FEATURE_STATS
+    /** Statistics start time of the outstanding request (us) */
+    uint32_t stats_start_us;
+#endif
 
     /* --- Processing --- */
     /** True if the application is processing a request asynchronously */
@@ -424,6 +905,8 @@ typedef struct uds_ctx
     void *client_cb;
     /** SID we are waiting for a response for */
     uint8_t pending_sid;
+    /** maxNumberOfBlockLength granted by the server's last 0x74 (0 = none) */
+    uint32_t client_block_length;
 
     /** Communication control state for SID 0x28 (uds_comm_control_type_t) */
     uint8_t comm_state;
@@ -437,23 +920,71 @@ typedef struct uds_ctx
     /** Current P2* server timeout */
     uint32_t p2_star_ms;
 
+#if UDS_CFG_FEATURE_FLASH
     /** ISO 14229-1: Block Sequence Counter for SID 0x36 */
     uint8_t flash_sequence;
+#endif
 
+#if UDS_CFG_FEATURE_SECURITY
     /* --- Security State (C-14, C-15) --- */
     /** Timestamp when security delay expires */
     uint32_t security_delay_end;
     /** Counter for failed security attempts */
     uint8_t security_attempts;
+#endif
 
     /** ISO 14229-1: Counter for NRC 0x78 repetitions (C-07) */
     uint16_t rcrrp_count;
 
+#if UDS_CFG_FEATURE_PERIODIC
     /* --- Periodic Data State (SID 0x2A) --- */
-    uint8_t periodic_ids[8];     /**< Active periodic IDs */
-    uint8_t periodic_rates[8];   /**< Subfunction rates (1-3) */
-    uint32_t periodic_timers[8]; /**< Next transmission deadline */
-    uint8_t periodic_count;      /**< Number of active periodic IDs */
+    /** Heap of the built-in scheduler (unused with config->periodic) */
+    uds_periodic_entry_t periodic_slots[UDS_PERIODIC_BUILTIN_SLOTS];
+    uint16_t periodic_count; /**< Entries in periodic_slots */
+    /** Periodic message buffer, separate from tx_buffer (unless config->periodic has frames) */
+    uint8_t periodic_frame[UDS_PERIODIC_FRAME_LEN];
+#endif
+
+#if UDS_CFG_FEATURE_TIMER_WHEEL
+    /* --- Shared Timer Wheel --- */
+    /** Wheel this context is attached to (NULL = standalone polling) */
+    struct uds_timer_wheel *timer_wheel;
+    /** Wheel registration of the next S3 / P2 / periodic deadline */
+    uds_timer_node_t timer_node;
+#endif
+
+    /* --- Multi-Tester State --- */
+    /** Source address of the tester being served (target of responses) */
+    uint16_t tester_addr;
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    /** Tester entry currently loaded into this context (NULL = single tester) */
+    uds_tester_state_t *active_tester;
+#endif
+
+#if UDS_CFG_FEATURE_QUEUE
+    /* --- Request Queue State --- */
+    uint8_t queue_head;  /**< Index of the oldest queued request */
+    uint8_t queue_count; /**< Number of queued requests */
+#endif
+
+#if UDS_CFG_FEATURE_STREAM
+    /* --- Streamed Response --- */
+    /** Response being pulled by fn_tp_send_stream's transport */
+    uds_stream_t stream;
+#endif
+
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    /* --- Buffer Pool State --- */
+    uint8_t *tx_lease;      /**< Response buffer borrowed from buffer_pool (NULL = none) */
+    uint16_t tx_lease_size; /**< Size of tx_lease */
+#endif
+
+#if UDS_CFG_FEATURE_RCRRP_ADAPTIVE
+    /* --- Handler Latency Learning (UDS_RCRRP_POLICY_ADAPTIVE) --- */
+    uint8_t latency_sid[UDS_LATENCY_TABLE_SIZE]; /**< Learned SIDs (0 = free) */
+    uint16_t latency_ms[UDS_LATENCY_TABLE_SIZE]; /**< Smoothed completion latency */
+    uint8_t latency_next;                        /**< Next entry to replace */
+#endif
 } uds_ctx_t;
 
 #ifdef __cplusplus
@@ -31,6 +31,15 @@ extern "C" {
 /** The stack context has not been initialized */
 #define UDS_ERR_NOT_INIT -3
 
+/** The job no longer matches the request it was submitted for (aborted or superseded) */
+#define UDS_ERR_STALE_JOB -4
+
+/** The mailbox has no free slot; the call was not executed (uds_mailbox.h) */
+#define UDS_ERR_MAILBOX_FULL -5
+
+/** A background operation on the same object is still running; retry later */
+#define UDS_ERR_BUSY -6
+
 /** The service operation is currently in progress (used for NRC 0x78) */
 #define UDS_PENDING 1
 
@@ -80,6 +89,37 @@ typedef enum
  */
 typedef void (*uds_response_cb)(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data, uint16_t len);
 
+/* --- Response Buffer Access --- */
+
+/**
+ * @brief Buffer that handlers build their response in.
+ *
+ * The dedicated tx_buffer, or the block borrowed from the buffer pool for the
+ * request being served. NULL if the context holds no block.
+ */
+static inline uint8_t *uds_tx_buffer(const uds_ctx_t *ctx)
+{
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    if (ctx->tx_lease != NULL) {
+        return ctx->tx_lease;
+    }
+#endif
+    return ctx->config->tx_buffer;
+}
+
+/**
+ * @brief Size of the buffer returned by uds_tx_buffer().
+ */
+static inline uint16_t uds_tx_buffer_size(const uds_ctx_t *ctx)
+{
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    if (ctx->tx_lease != NULL) {
+        return ctx->tx_lease_size;
+    }
+#endif
+    return ctx->config->tx_buffer_size;
+}
+
 /* --- Public API --- */
 
 /**
@@ -108,7 +148,8 @@ void uds_process(uds_ctx_t *ctx);
  * @brief Input a UDS SDU (Service Data Unit).
  *
  * Feeds a fully assembled UDS message into the stack. This is the entry point
- * for incoming CAN/ISO-TP messages.
+ * for incoming CAN/ISO-TP messages. In single-owner mode (uds_mailbox.h)
+ * the SDU is copied into the mailbox and dispatched by the next uds_process().
  *
  * @param ctx  Pointer to the initialized context.
  * @param data Pointer to the buffer containing the SDU.
@@ -116,6 +157,59 @@ void uds_process(uds_ctx_t *ctx);
  */
 void uds_input_sdu(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 
+/**
+ * @brief Input a UDS SDU received from a specific tester.
+ *
+ * With uds_config_t::tester_states configured, the request is served with the
+ * session, security and P2/S3 state of @p tester_addr, so several testers can
+ * work in parallel. Responses are sent through fn_tp_send() with
+ * ctx->tester_addr set to the requesting tester. If every tester entry is in
+ * use by a non-idle tester the request is rejected with NRC 0x21.
+ *
+ * Without tester_states this behaves like uds_input_sdu() and only records
+ * @p tester_addr as the response target.
+ *
+ * @param ctx         Pointer to the initialized context.
+ * @param tester_addr Source address (or transport channel) of the tester.
+ * @param data        Pointer to the buffer containing the SDU.
+ * @param len         Length of the data in bytes.
+ */
+void uds_input_sdu_from(uds_ctx_t *ctx, uint16_t tester_addr, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Load the state of a connected tester into the context.
+ *
+ * @deprecated The lock is released on return, so another tester may be
+ * loaded, and the tx_buffer overwritten, before the response is sent. Use
+ * uds_complete_for_tester() or the job API (uds_complete_pending()) to
+ * complete a pending request.
+ *
+ * @param ctx         Pointer to the initialized context.
+ * @param tester_addr Source address of the tester.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG if the tester is not connected.
+ */
+int uds_select_tester(uds_ctx_t *ctx, uint16_t tester_addr);
+
+/**
+ * @brief Complete the pending request of a tester.
+ *
+ * For asynchronous handlers that returned UDS_PENDING with tester_states
+ * configured. Selecting the tester, copying the response into the tx_buffer
+ * and sending it happen under one context lock, so a request of another
+ * tester cannot interleave. A 3-byte response 0x7F [SID] [NRC] is sent as a
+ * negative response. In single-owner mode (uds_mailbox.h), call it from the
+ * owner thread only.
+ *
+ * @param ctx         Pointer to the initialized context.
+ * @param tester_addr Source address of the tester whose request is pending.
+ * @param response    Complete response, starting with the response SID.
+ * @param len         Length of response in bytes.
+ * @return The result of fn_tp_send(), UDS_ERR_INVALID_ARG if the tester is
+ *         not connected or has no pending request, or UDS_ERR_BUFFER_TOO_SMALL.
+ */
+int uds_complete_for_tester(uds_ctx_t *ctx, uint16_t tester_addr, const uint8_t *response,
+                            uint16_t len);
+
 /**
  * @brief Send a UDS Request as a Client.
  *
@@ -125,10 +219,27 @@ void uds_input_sdu(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
  * @param len      Length of the payload data.
  * @param callback Function to call when a response is received from the ECU.
  * @return UDS_OK if the request was successfully passed to the transport layer.
+ *         UDS_ERR_BUFFER_TOO_SMALL for a TransferData (0x36) request larger
+ *         than the server's maxNumberOfBlockLength (uds_client_block_length()).
+ *         In single-owner mode (uds_mailbox.h) the request is only posted:
+ *         UDS_OK, UDS_ERR_BUFFER_TOO_SMALL or UDS_ERR_MAILBOX_FULL.
  */
 int uds_client_request(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data, uint16_t len,
                        uds_response_cb callback);
 
+/**
+ * @brief maxNumberOfBlockLength granted by the server for the current download.
+ *
+ * Taken from the positive response to the last RequestDownload (0x34) sent
+ * with uds_client_request(). It is the length of a whole TransferData message
+ * (SID, blockSequenceCounter and data), so each block carries up to 2 bytes
+ * less of data.
+ *
+ * @param ctx Pointer to the initialized context.
+ * @return    The block length, or 0 if none was granted.
+ */
+uint32_t uds_client_block_length(const uds_ctx_t *ctx);
+
 /**
  * @brief Send a positive response manually.
  *
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_did_cache.h
+ * @brief Pre-Encoded Response Cache for Static DIDs (SID 0x22)
+ *
+ * Enabled by pointing uds_config_t::did_cache at an application-owned
+ * uds_did_cache_t. DIDs flagged UDS_DID_FLAG_IMMUTABLE or
+ * UDS_DID_FLAG_VERSIONED are encoded once as [DID hi][DID lo][data] and
+ * later reads reuse that fragment, without calling the read callback.
+ *
+ * A multi-DID request made only of cached DIDs is also stored as a whole:
+ * the next identical request is answered with one pre-assembled response.
+ * Session and security rules are still checked for every DID.
+ *
+ * Cached values are dropped by a successful 0x2E on the DID, and versioned
+ * ones by uds_did_cache_bump(). When the storage is full, the cache is
+ * cleared at the start of the next 0x22 request and refilled.
+ */
+
+#ifndef UDS_DID_CACHE_H
+#define UDS_DID_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** Number of cached DIDs */
+#ifndef UDS_DID_CACHE_ENTRIES
+#define UDS_DID_CACHE_ENTRIES 16u
+#endif
+
+/** Maximum number of DIDs in a pre-assembled response */
+#ifndef UDS_DID_CACHE_MAX_IDS
+#define UDS_DID_CACHE_MAX_IDS 8u
+#endif
+
+/**
+ * @brief Cached fragment of one DID
+ */
+typedef struct
+{
+    uint16_t did;    /**< Data Identifier */
+    uint16_t offset; /**< Fragment position in storage */
+    uint16_t len;    /**< Fragment length (2 + DID size), 0 = stale */
+    uint8_t flags;   /**< UDS_DID_FLAG_* of the DID */
+} uds_did_cache_entry_t;
+
+/**
+ * @brief DID Response Cache
+ *
+ * Allocated by the application, one per context. Initialize with
+ * uds_did_cache_init().
+ */
+typedef struct uds_did_cache
+{
+    uint8_t *storage;                                     /**< Fragment storage */
+    uint16_t size;                                        /**< Size of storage */
+    uint16_t used;                                        /**< Bytes of storage in use */
+    uds_did_cache_entry_t entries[UDS_DID_CACHE_ENTRIES]; /**< Cached DIDs */
+    uint8_t count;                                        /**< Entries in use */
+    bool full;                                            /**< Clear before the next request */
+    uint8_t asm_req[UDS_DID_CACHE_MAX_IDS * 2u];          /**< DIDs of the assembled request */
+    uint16_t asm_index[UDS_DID_CACHE_MAX_IDS];            /**< Their did_table indexes */
+    uint8_t asm_count;                                    /**< DIDs in asm_req (0 = none) */
+    uint16_t asm_offset;                                  /**< Assembled response in storage */
+    uint16_t asm_len;                                     /**< Length of the assembled response */
+    uint32_t hits;                                        /**< DIDs served from the cache */
+    uint32_t misses;                                      /**< Flagged DIDs that were encoded */
+} uds_did_cache_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize an empty cache.
+ *
+ * @param cache   Cache to initialize.
+ * @param storage Fragment storage (encoded DIDs and assembled responses).
+ * @param size    Size of storage in bytes.
+ */
+void uds_did_cache_init(uds_did_cache_t *cache, uint8_t *storage, uint16_t size);
+
+/**
+ * @brief Drop the values of every UDS_DID_FLAG_VERSIONED DID.
+ *
+ * Call when the data behind versioned DIDs changes (e.g. after a software
+ * update or a calibration change), from the thread that owns the context.
+ */
+void uds_did_cache_bump(uds_did_cache_t *cache);
+
+/**
+ * @brief Drop every cached value.
+ */
+void uds_did_cache_clear(uds_did_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_DID_CACHE_H */
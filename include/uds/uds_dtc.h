@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_dtc.h
+ * @brief Built-in DTC Fault Memory (SID 0x14, 0x19, 0x85)
+ *
+ * Enabled by pointing uds_config_t::dtc_store at an application-owned
+ * uds_dtc_store_t (built with UDS_CFG_FEATURE_DTC, which also covers the
+ * snapshot records and uds_nvm_journal.h). The application registers its DTCs once and reports
+ * status changes with uds_dtc_set_status(); the library then answers:
+ *
+ * - 0x19 0x01 reportNumberOfDTCByStatusMask
+ * - 0x19 0x02 reportDTCByStatusMask
+ * - 0x19 0x0A reportSupportedDTC
+ * - 0x14 ClearDiagnosticInformation (all DTCs or one DTC)
+ * - 0x85 ControlDTCSetting (status updates ignored while off)
+ *
+ * Other 0x19 subfunctions still go to fn_dtc_read(), and fn_dtc_clear(),
+ * when set, runs before the store is cleared so the application can drop its
+ * own records.
+ *
+ * Besides the status byte of each DTC, the store keeps one bitset per status
+ * bit: bit i of plane b is bit b of the status of DTC i. A mask query ORs the
+ * planes selected by the mask one 32-bit word at a time, so counting is a
+ * popcount per word and reporting only visits the matching DTCs, whatever
+ * the number of DTCs registered.
+ *
+ * With uds_dtc_store_t::records, the store also captures snapshot records
+ * (0x19 0x03 / 0x04) and counts occurrences (extended data record 0x01,
+ * 0x19 0x06). A snapshot is the value of a fixed set of DIDs, taken when a
+ * trigger status bit of a DTC is set. All snapshots share one byte pool and
+ * are stored as sparse XOR deltas against the previous snapshot: a byte that
+ * did not change costs one bitmap bit. Any record can be evicted by folding
+ * its delta into the next one.
+ *
+ * With uds_dtc_store_t::journal, status bytes and occurrence counters are
+ * persisted by an append-only flash journal (uds_nvm_journal.h).
+ */
+
+#ifndef UDS_DTC_H
+#define UDS_DTC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** Words of one status bit plane for capacity DTCs */
+#define UDS_DTC_WORDS(capacity) (((uint32_t) (capacity) + 31u) / 32u)
+
+/** Size of the bits storage (uint32_t words) for capacity DTCs */
+#define UDS_DTC_BITS_WORDS(capacity) (8u * UDS_DTC_WORDS(capacity))
+
+/** groupOfDTC of a 0x14 request that clears every DTC */
+#define UDS_DTC_GROUP_ALL 0xFFFFFFu
+
+/** DTCFormatIdentifier ISO_14229-1_DTCFormat */
+#define UDS_DTC_FORMAT_ISO14229_1 0x01u
+
+/** Status after a clear: testNotCompletedSinceLastClear, testNotCompletedThisOperationCycle */
+#define UDS_DTC_STATUS_CLEARED 0x50u
+
+struct uds_nvm_journal;
+
+/** Drop the oldest snapshot of the pool when a new one does not fit */
+#define UDS_DTC_EVICT_OLDEST 0x00u
+/** Keep the pool as is and drop the new snapshot */
+#define UDS_DTC_EVICT_NONE 0x01u
+
+/** Bytes of a snapshot record header: DTC index (2), record number, changed bytes (2) */
+#define UDS_DTC_RECORD_HEADER 5u
+
+/**
+ * @brief Snapshot and extended data records
+ *
+ * Allocated by the application, one per store. Initialize with
+ * uds_dtc_records_init(). The pool holds three working copies of a
+ * snapshot (the latest values and two scratch copies) followed by the
+ * records.
+ */
+typedef struct uds_dtc_records
+{
+    const uint16_t *dids; /**< DIDs of a snapshot, in response order */
+    uint8_t did_count;    /**< Number of dids */
+    uint8_t trigger_mask; /**< Status bits that capture a snapshot when set, default 0x01 */
+    uint8_t max_per_dtc;  /**< Record numbers 1..max_per_dtc per DTC, default 2 */
+    uint8_t policy;       /**< UDS_DTC_EVICT_OLDEST or UDS_DTC_EVICT_NONE */
+    uint8_t *pool;        /**< Shared record storage */
+    uint16_t pool_size;   /**< Size of pool */
+    uint16_t frame_len;   /**< Bytes of one snapshot, 0 = not laid out yet */
+    uint16_t used;        /**< Bytes of records in the pool */
+    uint16_t count;       /**< Records in the pool */
+    uint32_t captured;    /**< Snapshots stored */
+    uint32_t evicted;     /**< Records dropped to make room */
+    uint32_t dropped;     /**< Snapshots not stored (UDS_DTC_EVICT_NONE, pool too small) */
+    uint8_t *occurrences; /**< Per-DTC occurrence counters (store capacity), NULL = none */
+} uds_dtc_records_t;
+
+/**
+ * @brief DTC fault memory
+ *
+ * Allocated by the application with its storage, one per context.
+ * Initialize with uds_dtc_init(), then register the DTCs with uds_dtc_add().
+ */
+typedef struct uds_dtc_store
+{
+    uint32_t *codes;                 /**< DTC numbers (24 bits), ascending */
+    uint8_t *status;                 /**< Status byte of each DTC */
+    uint32_t *bits;                  /**< 8 status bit planes of UDS_DTC_WORDS(capacity) words */
+    uint16_t capacity;               /**< Size of codes and status */
+    uint16_t count;                  /**< Registered DTCs */
+    uint16_t words;                  /**< Words per bit plane */
+    uint8_t availability_mask;       /**< DTCStatusAvailabilityMask, default 0xFF */
+    uint8_t format;                  /**< DTCFormatIdentifier reported by 0x19 0x01 */
+    bool setting_off;                /**< ControlDTCSetting off: status updates ignored */
+    uds_dtc_records_t *records;      /**< Snapshot / extended data records, NULL = none */
+    struct uds_nvm_journal *journal; /**< Status persistence, NULL = none */
+} uds_dtc_store_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize an empty DTC store.
+ *
+ * @param store    Store to initialize.
+ * @param codes    Storage for capacity DTC numbers.
+ * @param status   Storage for capacity status bytes.
+ * @param bits     Storage for UDS_DTC_BITS_WORDS(capacity) words.
+ * @param capacity Number of DTCs the store can hold.
+ */
+void uds_dtc_init(uds_dtc_store_t *store, uint32_t *codes, uint8_t *status, uint32_t *bits,
+                  uint16_t capacity);
+
+/**
+ * @brief Register a DTC with status 0.
+ *
+ * DTCs are registered in ascending order, which is also the order of the
+ * 0x19 responses.
+ *
+ * @return UDS_OK, UDS_ERR_BUFFER_TOO_SMALL if the store is full, or
+ *         UDS_ERR_INVALID_ARG if dtc is not above the last DTC or wider than 24 bits.
+ */
+int uds_dtc_add(uds_dtc_store_t *store, uint32_t dtc);
+
+/**
+ * @brief Initialize empty snapshot records.
+ *
+ * Attach to a store with store->records = records. With n snapshot bytes
+ * (the sizes of the DIDs), the pool needs 3 * n bytes of working copies plus
+ * UDS_DTC_RECORD_HEADER + (n + 7) / 8 bytes and one byte per changed value
+ * for each record.
+ *
+ * @param records     Records to initialize.
+ * @param dids        DIDs captured by each snapshot (table DIDs).
+ * @param did_count   Number of dids.
+ * @param pool        Record storage.
+ * @param pool_size   Size of pool.
+ * @param occurrences Per-DTC occurrence counters (store capacity), or NULL.
+ */
+void uds_dtc_records_init(uds_dtc_records_t *records, const uint16_t *dids, uint8_t did_count,
+                          uint8_t *pool, uint16_t pool_size, uint8_t *occurrences);
+
+/**
+ * @brief Set the status byte of a DTC.
+ *
+ * Bits outside the availability mask are dropped. Ignored while
+ * ControlDTCSetting is off. A change is reported to ResponseOnEvent
+ * (uds_roe_notify_dtc()). Setting a trigger bit captures a snapshot, and
+ * setting testFailed counts an occurrence, and with a journal the change is
+ * appended to flash. Call from the thread that runs uds_process().
+ *
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG if the DTC is not registered.
+ */
+int uds_dtc_set_status(uds_ctx_t *ctx, uint32_t dtc, uint8_t status);
+
+/**
+ * @brief Read the status byte of a DTC.
+ *
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG if the DTC is not registered.
+ */
+int uds_dtc_get_status(const uds_ctx_t *ctx, uint32_t dtc, uint8_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_DTC_H */
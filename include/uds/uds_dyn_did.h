@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_dyn_did.h
+ * @brief Dynamically Defined Data Identifiers (SID 0x2C)
+ *
+ * Enabled by pointing uds_config_t::dyn_dids at an application-owned array of
+ * uds_dyn_did_t. A tester composes a dynamic DID (UDS_DYN_DID_FIRST to
+ * UDS_DYN_DID_LAST) from slices of table DIDs (defineByIdentifier) and
+ * memory ranges (defineByMemoryAddress), then reads it with 0x22 like any
+ * other DID.
+ *
+ * Each definition is compiled into a flat gather plan. A slice of a DID with
+ * static storage, or of memory that fn_mem_map() maps, becomes a source
+ * pointer; reading it is a plain copy. Only DIDs with a read callback and
+ * unmapped memory are read at request time. The session and security rules
+ * of the source DIDs are checked on every read.
+ */
+
+#ifndef UDS_DYN_DID_H
+#define UDS_DYN_DID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** First dynamically definable DID (ISO 14229-1 range) */
+#define UDS_DYN_DID_FIRST 0xF200u
+/** Last dynamically definable DID */
+#define UDS_DYN_DID_LAST 0xF3FFu
+
+/** Gather steps per dynamic DID */
+#ifndef UDS_DYN_DID_MAX_STEPS
+#define UDS_DYN_DID_MAX_STEPS 16u
+#endif
+
+/**
+ * @brief One step of a gather plan
+ *
+ * Exactly one source is used: src, else did (read callback), else addr
+ * (fn_mem_read).
+ */
+typedef struct
+{
+    const uint8_t *src;         /**< Source bytes, NULL = read at request time */
+    const uds_did_entry_t *did; /**< Source DID (NULL for memory) */
+    uint32_t addr;              /**< Memory address (unmapped memory) */
+    uint16_t offset;            /**< Offset in the value of a read-callback DID */
+    uint16_t len;               /**< Bytes copied */
+} uds_dyn_did_step_t;
+
+/**
+ * @brief Dynamically defined DID
+ */
+typedef struct uds_dyn_did
+{
+    uint16_t id;                                     /**< DID, 0 = slot free */
+    uint16_t size;                                   /**< Total data size */
+    uint8_t count;                                   /**< Steps in use */
+    uds_dyn_did_step_t steps[UDS_DYN_DID_MAX_STEPS]; /**< Gather plan in output order */
+} uds_dyn_did_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Clear every dynamically defined DID.
+ *
+ * Same as a 0x2C clear request without a DID, e.g. for an application that
+ * drops the definitions on a return to the default session.
+ */
+void uds_dyn_did_clear(uds_ctx_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_DYN_DID_H */
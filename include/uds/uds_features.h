@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_features.h
+ * @brief Compile-Time Service and Feature Selection
+ *
+ * Every built-in service and every piece of optional server state can be
+ * removed at compile time. A stripped service loses its handler, its entry in
+ * the core service table and its subfunction mask; requests for it are
+ * answered with NRC 0x11 (or served by a user_services entry). A stripped
+ * feature also removes its fields from uds_ctx_t.
+ *
+ * All macros must be identical for the library and for every translation
+ * unit that includes the public headers, since they change the layout of
+ * uds_ctx_t. Pass them on the compiler command line (or through Kconfig on
+ * Zephyr).
+ *
+ * Example, ECU exposing only ReadDataByIdentifier and TesterPresent:
+ * @code
+ *   -DUDS_CFG_DEFAULT=0 -DUDS_CFG_SERVICE_22=1 -DUDS_CFG_SERVICE_3E=1
+ * @endcode
+ */
+
+#ifndef UDS_FEATURES_H
+#define UDS_FEATURES_H
+
+/** Value of every UDS_CFG_* macro that is not defined explicitly (1 = all built in) */
+#ifndef UDS_CFG_DEFAULT
+#define UDS_CFG_DEFAULT 1
+#endif
+
+/* --- Features (state in uds_ctx_t) --- */
+
+/** SecurityAccess state: failed attempt counter and delay timer */
+#ifndef UDS_CFG_FEATURE_SECURITY
+#define UDS_CFG_FEATURE_SECURITY UDS_CFG_DEFAULT
+#endif
+
+/** Periodic data scheduler: periodic ID table and timers */
+#ifndef UDS_CFG_FEATURE_PERIODIC
+#define UDS_CFG_FEATURE_PERIODIC UDS_CFG_DEFAULT
+#endif
+
+/** Data transfer (download/upload): block sequence counter */
+#ifndef UDS_CFG_FEATURE_FLASH
+#define UDS_CFG_FEATURE_FLASH UDS_CFG_DEFAULT
+#endif
+
+/** Built-in DTC fault memory (uds_dtc.h): store, snapshot records, NVM journal */
+#ifndef UDS_CFG_FEATURE_DTC
+#define UDS_CFG_FEATURE_DTC UDS_CFG_DEFAULT
+#endif
+
+/** Per-tester state table (uds_config_t::tester_states) */
+#ifndef UDS_CFG_FEATURE_MULTI_TESTER
+#define UDS_CFG_FEATURE_MULTI_TESTER UDS_CFG_DEFAULT
+#endif
+
+/** Queue of requests received while one is pending (uds_config_t::queue_buffer) */
+#ifndef UDS_CFG_FEATURE_QUEUE
+#define UDS_CFG_FEATURE_QUEUE UDS_CFG_DEFAULT
+#endif
+
+/** Shared rx / tx buffer pool (uds_buffer_pool.h): borrowed response buffer */
+#ifndef UDS_CFG_FEATURE_BUFFER_POOL
+#define UDS_CFG_FEATURE_BUFFER_POOL UDS_CFG_DEFAULT
+#endif
+
+/** Shared timer wheel (uds_timer_wheel.h); server groups also need UDS_CFG_FEATURE_MAILBOX */
+#ifndef UDS_CFG_FEATURE_TIMER_WHEEL
+#define UDS_CFG_FEATURE_TIMER_WHEEL UDS_CFG_DEFAULT
+#endif
+
+/** Single-owner mode (uds_mailbox.h) */
+#ifndef UDS_CFG_FEATURE_MAILBOX
+#define UDS_CFG_FEATURE_MAILBOX UDS_CFG_DEFAULT
+#endif
+
+/** Asynchronous jobs and executors (uds_job.h): job ids of the pending request */
+#ifndef UDS_CFG_FEATURE_JOB
+#define UDS_CFG_FEATURE_JOB UDS_CFG_DEFAULT
+#endif
+
+/** Per-SID counters and latency histograms (uds_stats.h) */
+#ifndef UDS_CFG_FEATURE_STATS
+#define UDS_CFG_FEATURE_STATS UDS_CFG_DEFAULT
+#endif
+
+/** Binary event trace ring (uds_trace.h) */
+#ifndef UDS_CFG_FEATURE_TRACE
+#define UDS_CFG_FEATURE_TRACE UDS_CFG_DEFAULT
+#endif
+
+/** Handler latency table of UDS_RCRRP_POLICY_ADAPTIVE (which acts as DEFERRED without it) */
+#ifndef UDS_CFG_FEATURE_RCRRP_ADAPTIVE
+#define UDS_CFG_FEATURE_RCRRP_ADAPTIVE UDS_CFG_DEFAULT
+#endif
+
+/** Compiled permission matrix (uds_access.h); without it the masks are checked directly */
+#ifndef UDS_CFG_FEATURE_ACCESS_MATRIX
+#define UDS_CFG_FEATURE_ACCESS_MATRIX UDS_CFG_DEFAULT
+#endif
+
+/** Response cache of UDS_DID_FLAG_* DIDs (uds_did_cache.h) */
+#ifndef UDS_CFG_FEATURE_DID_CACHE
+#define UDS_CFG_FEATURE_DID_CACHE UDS_CFG_DEFAULT
+#endif
+
+/** Streamed responses larger than the tx_buffer (uds_response_stream()) */
+#ifndef UDS_CFG_FEATURE_STREAM
+#define UDS_CFG_FEATURE_STREAM UDS_CFG_DEFAULT
+#endif
+
+/* --- Services --- */
+
+#ifndef UDS_CFG_SERVICE_10
+#define UDS_CFG_SERVICE_10 UDS_CFG_DEFAULT /**< DiagnosticSessionControl */
+#endif
+#ifndef UDS_CFG_SERVICE_11
+#define UDS_CFG_SERVICE_11 UDS_CFG_DEFAULT /**< ECUReset */
+#endif
+#ifndef UDS_CFG_SERVICE_14
+#define UDS_CFG_SERVICE_14 UDS_CFG_DEFAULT /**< ClearDiagnosticInformation */
+#endif
+#ifndef UDS_CFG_SERVICE_19
+#define UDS_CFG_SERVICE_19 UDS_CFG_DEFAULT /**< ReadDTCInformation */
+#endif
+#ifndef UDS_CFG_SERVICE_22
+#define UDS_CFG_SERVICE_22 UDS_CFG_DEFAULT /**< ReadDataByIdentifier */
+#endif
+#ifndef UDS_CFG_SERVICE_23
+#define UDS_CFG_SERVICE_23 UDS_CFG_DEFAULT /**< ReadMemoryByAddress */
+#endif
+#ifndef UDS_CFG_SERVICE_27
+#define UDS_CFG_SERVICE_27 UDS_CFG_FEATURE_SECURITY /**< SecurityAccess */
+#endif
+#ifndef UDS_CFG_SERVICE_28
+#define UDS_CFG_SERVICE_28 UDS_CFG_DEFAULT /**< CommunicationControl */
+#endif
+#ifndef UDS_CFG_SERVICE_29
+#define UDS_CFG_SERVICE_29 UDS_CFG_DEFAULT /**< Authentication */
+#endif
+#ifndef UDS_CFG_SERVICE_2A
+#define UDS_CFG_SERVICE_2A UDS_CFG_FEATURE_PERIODIC /**< ReadDataByPeriodicIdentifier */
+#endif
+#ifndef UDS_CFG_SERVICE_2C
+#define UDS_CFG_SERVICE_2C UDS_CFG_DEFAULT /**< DynamicallyDefineDataIdentifier */
+#endif
+#ifndef UDS_CFG_SERVICE_2E
+#define UDS_CFG_SERVICE_2E UDS_CFG_DEFAULT /**< WriteDataByIdentifier */
+#endif
+#ifndef UDS_CFG_SERVICE_2F
+#define UDS_CFG_SERVICE_2F UDS_CFG_DEFAULT /**< InputOutputControlByIdentifier */
+#endif
+#ifndef UDS_CFG_SERVICE_31
+#define UDS_CFG_SERVICE_31 UDS_CFG_DEFAULT /**< RoutineControl */
+#endif
+#ifndef UDS_CFG_SERVICE_34
+#define UDS_CFG_SERVICE_34 UDS_CFG_FEATURE_FLASH /**< RequestDownload */
+#endif
+#ifndef UDS_CFG_SERVICE_35
+#define UDS_CFG_SERVICE_35 UDS_CFG_FEATURE_FLASH /**< RequestUpload */
+#endif
+#ifndef UDS_CFG_SERVICE_36
+#define UDS_CFG_SERVICE_36 UDS_CFG_FEATURE_FLASH /**< TransferData */
+#endif
+#ifndef UDS_CFG_SERVICE_37
+#define UDS_CFG_SERVICE_37 UDS_CFG_FEATURE_FLASH /**< RequestTransferExit */
+#endif
+#ifndef UDS_CFG_SERVICE_3D
+#define UDS_CFG_SERVICE_3D UDS_CFG_DEFAULT /**< WriteMemoryByAddress */
+#endif
+#ifndef UDS_CFG_SERVICE_3E
+#define UDS_CFG_SERVICE_3E UDS_CFG_DEFAULT /**< TesterPresent */
+#endif
+#ifndef UDS_CFG_SERVICE_85
+#define UDS_CFG_SERVICE_85 UDS_CFG_DEFAULT /**< ControlDTCSetting */
+#endif
+#ifndef UDS_CFG_SERVICE_86
+#define UDS_CFG_SERVICE_86 UDS_CFG_DEFAULT /**< ResponseOnEvent */
+#endif
+
+/* --- Consistency --- */
+
+#if UDS_CFG_SERVICE_27 && !UDS_CFG_FEATURE_SECURITY
+#error "UDS_CFG_SERVICE_27 requires UDS_CFG_FEATURE_SECURITY"
+#endif
+
+#if UDS_CFG_SERVICE_2A && !UDS_CFG_FEATURE_PERIODIC
+#error "UDS_CFG_SERVICE_2A requires UDS_CFG_FEATURE_PERIODIC"
+#endif
+
+#if (UDS_CFG_SERVICE_34 || UDS_CFG_SERVICE_35 || UDS_CFG_SERVICE_36 || UDS_CFG_SERVICE_37) && \
+    !UDS_CFG_FEATURE_FLASH
+#error "UDS_CFG_SERVICE_34..37 require UDS_CFG_FEATURE_FLASH"
+#endif
+
+/* The transfer pipe writes its blocks on the job executor */
+#if UDS_CFG_FEATURE_FLASH && !UDS_CFG_FEATURE_JOB
+#error "UDS_CFG_FEATURE_FLASH requires UDS_CFG_FEATURE_JOB"
+#endif
+
+#endif /* UDS_FEATURES_H */
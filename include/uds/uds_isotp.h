@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "uds_config.h"
 
 /* --- ISO-TP Frame Types (PCI) --- */
 
@@ -34,6 +35,11 @@ extern "C" {
 #define ISOTP_FF_MAX_DATA_CANFD 62u /**< Max FF payload (FD) */
 #define ISOTP_MAX_SDU_LEN_STD 4095u /**< Max SDU size with 12-bit length */
 
+/** N_Cr: time to wait for the next Consecutive Frame of a received SDU */
+#ifndef ISOTP_TIMEOUT_N_CR_MS
+#define ISOTP_TIMEOUT_N_CR_MS 1000u
+#endif
+
 /* --- Flow Control Flags --- */
 
 #define ISOTP_FC_CTS 0  /**< Continue To Send */
@@ -93,8 +99,8 @@ typedef struct
 
     /* --- State --- */
     uds_isotp_state_t state;  /**< Current state machine position */
-    uint16_t msg_len;         /**< Total length of current message SDU */
-    uint16_t bytes_processed; /**< Number of SDU bytes handled so far */
+    uint32_t msg_len;         /**< Total length of current message SDU */
+    uint32_t bytes_processed; /**< Number of SDU bytes handled so far */
     uint8_t sn;               /**< Current Sequence Number (0-15) */
     uint8_t bs_counter;       /**< Counter tracking blocks sent/received */
 
@@ -135,6 +141,50 @@ void uds_tp_isotp_set_fd(bool enabled);
  */
 int uds_isotp_send(struct uds_ctx *ctx, const uint8_t *data, uint16_t len);
 
+/**
+ * @brief Send a scattered SDU via ISO-TP (uds_tp_sendv_fn compatible).
+ *
+ * The segments are gathered directly into the frame or segmentation buffer,
+ * so referenced data is copied only once.
+ *
+ * @param ctx   Pointer to the core UDS context.
+ * @param iov   Segments in transmission order.
+ * @param count Number of segments.
+ * @param len   Total SDU length in bytes.
+ * @return      0 on success, or negative on failure.
+ */
+int uds_isotp_sendv(struct uds_ctx *ctx, const uds_iovec_t *iov, uint8_t count, uint16_t len);
+
+#if UDS_CFG_FEATURE_STREAM
+/**
+ * @brief Send a streamed SDU via ISO-TP (uds_tp_send_stream_fn compatible).
+ *
+ * The SDU is pulled one frame at a time while the consecutive frames go
+ * out, so it is not limited by the segmentation buffer.
+ * uds_tp_isotp_process() pulls under the context lock, so it must not be
+ * called with the lock held. SDUs above 4095 bytes use the escape First Frame with a 32-bit
+ * length. A producer failure aborts the transfer.
+ *
+ * @param ctx Pointer to the core UDS context.
+ * @param len Total SDU length in bytes.
+ * @return    0 on success, or -1 on failure.
+ */
+int uds_isotp_send_stream(struct uds_ctx *ctx, uint32_t len);
+#endif
+
+/**
+ * @brief Largest SDU of the ISO-TP link (uds_tp_max_sdu_fn compatible).
+ *
+ * Received SDUs are limited to 4095 bytes on Classic CAN. On CAN-FD the
+ * escape First Frame is accepted, so only the rx_buffer limits them. Sent
+ * SDUs are limited by the segmentation buffer.
+ *
+ * @param ctx      Pointer to the core UDS context.
+ * @param response true for sent SDUs, false for received ones.
+ * @return         Largest SDU length in bytes.
+ */
+uint32_t uds_isotp_max_sdu(struct uds_ctx *ctx, bool response);
+
 /**
  * @brief CAN Receive Callback.
  *
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_job.h
+ * @brief Asynchronous Job API for UDS_PENDING Service Handlers
+ *
+ * A service handler describes its long-running work as a uds_job_t and
+ * returns the result of uds_submit_job(). The work runs on the configured
+ * executor without holding the context lock; the completion function then
+ * builds the response under the lock and the stack sends it to the tester
+ * that made the request.
+ *
+ * @code
+ * static int erase_work(uds_job_t *job)
+ * {
+ *     return flash_erase_all() ? UDS_OK : -0x72;
+ * }
+ *
+ * static int erase_complete(uds_ctx_t *ctx, uds_job_t *job, int result)
+ * {
+ *     ctx->config->tx_buffer[0] = 0x71;
+ *     ...
+ *     return 5;
+ * }
+ *
+ * static uds_job_t erase_job = {erase_work, erase_complete, NULL};
+ *
+ * static int erase_handler(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+ * {
+ *     return uds_submit_job(ctx, data[0], &erase_job);
+ * }
+ * @endcode
+ */
+
+#ifndef UDS_JOB_H
+#define UDS_JOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/**
+ * @brief Job Work Function
+ *
+ * Runs on the executor without the context lock. Must not touch the context
+ * or its buffers.
+ *
+ * @param job The job being executed.
+ * @return UDS_OK (or any non-negative value) on success, negative NRC on failure.
+ */
+typedef int (*uds_job_work_fn)(struct uds_job *job);
+
+/**
+ * @brief Job Completion Function
+ *
+ * Runs with the context lock held and the requesting tester selected.
+ *
+ * @param ctx    Pointer to the UDS context.
+ * @param job    The finished job.
+ * @param result Return value of the work function.
+ * @return Length of the positive response written to tx_buffer, negative NRC,
+ *         or 0 to finish the request without a response.
+ */
+typedef int (*uds_job_complete_fn)(struct uds_ctx *ctx, struct uds_job *job, int result);
+
+/**
+ * @brief Asynchronous Job
+ *
+ * Allocated by the application (static or embedded in its own state). A job
+ * object must not be submitted again before its previous run has completed.
+ */
+typedef struct uds_job
+{
+    uds_job_work_fn work;         /**< Mandatory: work function */
+    uds_job_complete_fn complete; /**< Optional: response builder (NULL = result only) */
+    void *user_data;              /**< Application data for work / complete */
+
+    /* --- Owned by the stack --- */
+    struct uds_ctx *ctx;  /**< Context the job was submitted on */
+    uint16_t tester_addr; /**< Tester that made the request */
+    uint16_t id;          /**< Identifies the request the job belongs to */
+    uint8_t sid;          /**< Service ID of the request */
+} uds_job_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Run a job for the request currently being dispatched.
+ *
+ * Must be called from a service handler, and the handler must return the
+ * result. With an executor configured (fn_job_submit) the job is queued and
+ * UDS_PENDING is returned, which lets the stack handle NRC 0x78 until the job
+ * completes. Without an executor the job runs inline and its response is sent
+ * before returning UDS_OK. If the executor rejects the job, NRC 0x21 is sent.
+ *
+ * With a NULL completion function a non-negative result is answered with a
+ * positive response that only carries the SID.
+ *
+ * @param ctx Pointer to the context (as passed to the handler).
+ * @param sid Service ID of the request.
+ * @param job Job to run.
+ * @return UDS_PENDING, UDS_OK, or UDS_ERR_INVALID_ARG.
+ */
+int uds_submit_job(uds_ctx_t *ctx, uint8_t sid, uds_job_t *job);
+
+/**
+ * @brief Finalize the pending request of a job.
+ *
+ * Thread-safe (takes the context lock). Selects the tester of the job, calls
+ * its completion function and sends the response. Requests that were queued
+ * meanwhile are dispatched afterwards.
+ *
+ * @param ctx    Pointer to the context.
+ * @param job    The finished job.
+ * @param result Result of the work (UDS_OK or negative NRC).
+ * @return UDS_OK, or UDS_ERR_STALE_JOB if the request was aborted in the
+ *         meantime (e.g. by the NRC 0x78 limit); no response is sent then.
+ *         In single-owner mode (uds_mailbox.h) the call is only posted:
+ *         UDS_OK or UDS_ERR_MAILBOX_FULL.
+ */
+int uds_complete_pending(uds_ctx_t *ctx, uds_job_t *job, int result);
+
+/**
+ * @brief Executor entry point: run the work of a job and complete it.
+ *
+ * Called by executors from their worker context.
+ *
+ * @param job Job previously passed to fn_job_submit.
+ */
+void uds_job_execute(uds_job_t *job);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_JOB_H */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_mailbox.h
+ * @brief Single-Owner Threading Model (Lock-Free MPSC Mailbox)
+ *
+ * Alternative to fn_mutex_lock/fn_mutex_unlock for multi-threaded
+ * integrations. With uds_config_t::mailbox set, exactly one owner thread
+ * calls uds_process(). uds_input_sdu(), uds_input_sdu_from(),
+ * uds_client_request() and uds_complete_pending() may then be called from
+ * any thread: they copy their arguments into the mailbox and return at
+ * once. The owner executes them at the start of its next uds_process(), in
+ * posting order. No lock is shared between the threads, so a slow request
+ * cannot block a CAN RX thread and a low-priority thread cannot hold up the
+ * owner (no priority inversion).
+ */
+
+#ifndef UDS_MAILBOX_H
+#define UDS_MAILBOX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/* --- Mail Kinds --- */
+
+#define UDS_MAIL_SDU 1u            /**< uds_input_sdu() */
+#define UDS_MAIL_SDU_FROM 2u       /**< uds_input_sdu_from() */
+#define UDS_MAIL_CLIENT_REQUEST 3u /**< uds_client_request() */
+#define UDS_MAIL_JOB_COMPLETE 4u   /**< uds_complete_pending() */
+
+/**
+ * @brief Mail Header (one per mailbox slot)
+ */
+typedef struct
+{
+    uint32_t seq;  /**< Slot sequence number (owned by the mailbox) */
+    uint8_t kind;  /**< UDS_MAIL_* */
+    uint16_t addr; /**< Tester source address (UDS_MAIL_SDU_FROM) */
+    uint16_t len;  /**< Bytes used in the slot's data area */
+    int result;    /**< Job result (UDS_MAIL_JOB_COMPLETE) */
+    void *ptr;     /**< Client callback or job */
+} uds_mail_t;
+
+/**
+ * @brief Mailbox
+ *
+ * Bounded multi-producer / single-consumer queue. Producers claim a slot
+ * with one compare-and-swap, so posting never blocks; when all slots are
+ * taken the post fails and is counted in dropped.
+ */
+typedef struct uds_mailbox
+{
+    uds_mail_t *mails;            /**< depth headers */
+    uint8_t *data;                /**< depth * slot_size bytes of payload */
+    uint16_t slot_size;           /**< Maximum payload length per mail */
+    uint32_t mask;                /**< depth - 1 */
+    uint32_t enqueue_pos;         /**< Next slot claimed by a producer */
+    uint32_t dequeue_pos;         /**< Next slot read by the owner */
+    uint32_t dropped;             /**< Posts rejected because the mailbox was full */
+    void (*fn_notify)(void *arg); /**< Optional: wake the owner after a post */
+    void *notify_arg;             /**< Argument of fn_notify */
+} uds_mailbox_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize a mailbox.
+ *
+ * @param mb        Mailbox to initialize.
+ * @param mails     Array of depth headers.
+ * @param data      Payload storage of depth * slot_size bytes.
+ * @param depth     Number of slots, must be a power of two.
+ * @param slot_size Largest SDU that can be posted.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG.
+ */
+int uds_mailbox_init(uds_mailbox_t *mb, uds_mail_t *mails, uint8_t *data, uint32_t depth,
+                     uint16_t slot_size);
+
+/**
+ * @brief Post a mail (any thread).
+ *
+ * Used by the public API in mailbox mode; exposed for custom transports.
+ *
+ * @param mb     Mailbox.
+ * @param kind   UDS_MAIL_*.
+ * @param addr   Tester address.
+ * @param data   Payload (may be NULL if len is 0).
+ * @param len    Payload length.
+ * @param ptr    Callback or job pointer.
+ * @param result Job result.
+ * @return UDS_OK, UDS_ERR_BUFFER_TOO_SMALL, or UDS_ERR_MAILBOX_FULL.
+ */
+int uds_mailbox_post(uds_mailbox_t *mb, uint8_t kind, uint16_t addr, const uint8_t *data,
+                     uint16_t len, void *ptr, int result);
+
+/**
+ * @brief Post a mail whose payload is the concatenation of several segments.
+ *
+ * Same as uds_mailbox_post(), with the payload gathered from iov.
+ */
+int uds_mailbox_postv(uds_mailbox_t *mb, uint8_t kind, uint16_t addr, const uds_iovec_t *iov,
+                      uint8_t count, void *ptr, int result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_MAILBOX_H */
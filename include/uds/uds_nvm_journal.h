@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_nvm_journal.h
+ * @brief Log-Structured NVM Journal for DTC Status
+ *
+ * Persists the status bytes and occurrence counters of a uds_dtc_store_t
+ * without rewriting them in place. Every status change appends one small
+ * record to the active flash sector; a checkpoint of the whole store is
+ * written only when a sector fills up and the journal moves to the other
+ * sector (compaction). Recovery loads the last checkpoint and replays the
+ * records after it.
+ *
+ * The journal uses two sectors of uds_nvm_flash_t::sector_size bytes at
+ * addresses 0 and sector_size, accessed through the application's flash
+ * hooks (uds_posix_nvm.h implements them on a file for host testing):
+ *
+ * @code
+ * static uds_nvm_journal_t journal;
+ * uds_nvm_journal_init(&journal, &flash);
+ * store.journal = &journal;
+ * uds_nvm_journal_restore(&store);   // after the DTCs are registered
+ * @endcode
+ *
+ * Every record is [type][length hi][lo][payload][CRC-16 hi][lo]. A status
+ * change costs UDS_NVM_JOURNAL_RECORD bytes and a clear of all DTCs five.
+ * Erased flash (0xFF) ends a sector, and so does a record with a bad CRC
+ * (a write cut by a reset).
+ */
+
+#ifndef UDS_NVM_JOURNAL_H
+#define UDS_NVM_JOURNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_dtc.h"
+#if UDS_CFG_FEATURE_JOB
+#include "uds_job.h"
+#endif
+
+/** Bytes of one status record: DTC index (2), status, occurrences + framing */
+#define UDS_NVM_JOURNAL_RECORD 9u
+
+/** Bytes of the record that opens a sector */
+#define UDS_NVM_JOURNAL_HEADER 11u
+
+/** Bytes of a checkpoint of count DTCs (with occurrence counters) */
+#define UDS_NVM_JOURNAL_CHECKPOINT(count) (7u + (2u * (uint32_t) (count)))
+
+/**
+ * @brief Flash hooks of the journal
+ *
+ * Provided by the application. Addresses are relative to the journal area of
+ * 2 * sector_size bytes. Writes only ever go to erased bytes, in increasing
+ * address order. Each hook returns UDS_OK or a negative error code.
+ *
+ * With a job executor (uds_config_t::fn_job_submit), uds_process() erases
+ * the sector of the next checkpoint on the executor: fn_erase may then run
+ * while fn_write appends to the other sector.
+ */
+typedef struct uds_nvm_flash
+{
+    /** Read len bytes at addr */
+    int (*fn_read)(void *dev, uint32_t addr, uint8_t *buf, uint16_t len);
+    /** Program len bytes at addr */
+    int (*fn_write)(void *dev, uint32_t addr, const uint8_t *data, uint16_t len);
+    /** Erase the sector starting at addr to 0xFF */
+    int (*fn_erase)(void *dev, uint32_t addr);
+    void *dev;            /**< Passed to the hooks */
+    uint32_t sector_size; /**< Bytes of one sector */
+} uds_nvm_flash_t;
+
+/**
+ * @brief Journal instance
+ *
+ * Allocated by the application, one per store. Initialize with
+ * uds_nvm_journal_init(). Status changes are only journaled after
+ * uds_nvm_journal_restore().
+ */
+typedef struct uds_nvm_journal
+{
+    const uds_nvm_flash_t *flash; /**< Flash hooks */
+    uint16_t reserve;             /**< Free bytes that start a compaction, default 16 records */
+    uint8_t active;               /**< Sector records are appended to */
+    bool ready;                   /**< Restored, changes are journaled */
+    bool compact_due;             /**< Compaction runs on the next uds_process() */
+    uint32_t seq;                 /**< Generation of the active sector */
+    uint32_t pos;                 /**< Append offset in the active sector */
+    uint32_t appended;            /**< Records written */
+    uint32_t replayed;            /**< Records applied by the last restore */
+    uint32_t compactions;         /**< Checkpoints written */
+    uint32_t errors;              /**< Failed flash operations */
+#if UDS_CFG_FEATURE_JOB
+    bool erasing; /**< The erase of a compaction runs on the job executor */
+    uds_job_t job; /**< Erase job of uds_process() */
+#endif
+} uds_nvm_journal_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize a journal.
+ *
+ * @param journal Journal to initialize.
+ * @param flash   Flash hooks, kept by pointer.
+ */
+void uds_nvm_journal_init(uds_nvm_journal_t *journal, const uds_nvm_flash_t *flash);
+
+/**
+ * @brief Load the journaled status into a store and start journaling.
+ *
+ * Picks the newest sector holding a valid checkpoint, applies it to the
+ * registered DTCs and replays the status records after it. Bit planes are
+ * rebuilt, and neither ResponseOnEvent nor snapshot capture sees the loaded
+ * values. Blank flash formats sector 0 with a checkpoint of the current
+ * store. When the log ends in a damaged record or the number of DTCs changed,
+ * the state is compacted at once so later appends stay readable.
+ *
+ * @param store Store with store->journal set and its DTCs registered.
+ * @return UDS_OK, UDS_ERR_INVALID_ARG, UDS_ERR_BUFFER_TOO_SMALL if a
+ *         checkpoint and the reserve do not fit a sector, or the error of a
+ *         flash hook.
+ */
+int uds_nvm_journal_restore(uds_dtc_store_t *store);
+
+/**
+ * @brief Write a checkpoint of the store to the other sector now.
+ *
+ * uds_process() does this when the active sector runs low, with the erase
+ * on the job executor; call it before a controlled shutdown to make the next
+ * restore a pure checkpoint load.
+ *
+ * @param store Store with a restored journal.
+ * @return UDS_OK, UDS_ERR_NOT_INIT before restore, UDS_ERR_BUSY while the
+ *         erase of uds_process() runs, or the error of a flash hook.
+ */
+int uds_nvm_journal_compact(uds_dtc_store_t *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_NVM_JOURNAL_H */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_periodic.h
+ * @brief Periodic Data Scheduler (SID 0x2A)
+ *
+ * Without configuration, the context schedules up to UDS_PERIODIC_BUILTIN_SLOTS
+ * periodic IDs with the default rates and payloads of up to 8 bytes. Pointing
+ * uds_config_t::periodic at an application-owned uds_periodic_t raises the
+ * capacity (up to 256 IDs, one per periodicDataIdentifier) and the payload
+ * size (frames, e.g. for CAN FD), and sets the interval of each transmission
+ * mode.
+ *
+ * Active IDs form a min-heap ordered by deadline: uds_process() only looks at
+ * the IDs that are due, whatever the number of IDs scheduled. Deadlines move
+ * on a fixed grid (deadline += interval), so a late tick does not shift the
+ * following transmissions. When the server falls behind by a whole interval
+ * or more, the missed transmissions are skipped and counted as overruns.
+ *
+ * Periodic messages never use the response buffer: they are built in a
+ * buffer of their own (uds_ctx_t::periodic_frame, or the frames of the
+ * scheduler) and sent with fn_periodic_send() when set, so they do not
+ * compete with request / response traffic or ISO-TP segmentation.
+ */
+
+#ifndef UDS_PERIODIC_H
+#define UDS_PERIODIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** Largest scheduler capacity: one entry per periodicDataIdentifier */
+#define UDS_PERIODIC_MAX_CAPACITY 256u
+
+/** Default interval of transmission mode 0x01 (fast) */
+#define UDS_PERIODIC_FAST_INTERVAL_MS 100u
+/** Default interval of transmission mode 0x02 (medium) */
+#define UDS_PERIODIC_MEDIUM_INTERVAL_MS 500u
+/** Default interval of transmission mode 0x03 (slow) */
+#define UDS_PERIODIC_SLOW_INTERVAL_MS 1000u
+
+/**
+ * @brief Periodic Data Scheduler
+ *
+ * Allocated by the application, one per context. Initialize with
+ * uds_periodic_init(), then adjust interval_ms and set the frames if needed.
+ * With several frames, a message stays untouched until frame_count - 1 more
+ * messages have been built, for transports that send asynchronously.
+ */
+typedef struct uds_periodic
+{
+    uds_periodic_entry_t *entries; /**< Heap storage (capacity entries) */
+    uint16_t capacity;             /**< Size of entries, 1 to UDS_PERIODIC_MAX_CAPACITY */
+    uint16_t count;                /**< Scheduled IDs */
+    uint16_t interval_ms[3];       /**< Interval of modes fast, medium, slow (0 = default) */
+    uint16_t max_len;              /**< Largest payload, 0 = frame_size - 1 */
+    uint8_t *frames;               /**< frame_count message buffers, NULL = built-in buffer */
+    uint16_t frame_size;           /**< Size of each frame: ID byte and payload */
+    uint8_t frame_count;           /**< Frames used in turn (messages in flight) */
+    uint8_t frame_next;            /**< Frame of the next message */
+} uds_periodic_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize an empty scheduler with the default intervals.
+ *
+ * @param sched    Scheduler to initialize.
+ * @param entries  Storage for the scheduled IDs.
+ * @param capacity Number of entries (at most UDS_PERIODIC_MAX_CAPACITY).
+ */
+void uds_periodic_init(uds_periodic_t *sched, uds_periodic_entry_t *entries, uint16_t capacity);
+
+/**
+ * @brief Read the schedule and statistics of one periodic ID.
+ *
+ * @param ctx         Context.
+ * @param periodic_id Periodic identifier (low byte of 0xF2xx).
+ * @param out         Copy of the entry: deadline, jitter, overruns, sent count.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG if the ID is not scheduled.
+ */
+int uds_periodic_get(const uds_ctx_t *ctx, uint8_t periodic_id, uds_periodic_entry_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_PERIODIC_H */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_posix_executor.h
+ * @brief POSIX Thread Pool Executor for UDS Jobs
+ *
+ * Part of the optional uds_posix library. Plug it into the stack with:
+ *
+ * @code
+ * static uds_posix_executor_t pool;
+ * uds_posix_executor_init(&pool, 2);
+ * cfg.fn_job_submit = uds_posix_executor_submit;
+ * cfg.job_executor = &pool;
+ * @endcode
+ *
+ * The context also needs fn_mutex_lock / fn_mutex_unlock (or a mailbox).
+ */
+
+#ifndef UDS_POSIX_EXECUTOR_H
+#define UDS_POSIX_EXECUTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+
+#include "uds_job.h"
+
+/** Maximum number of worker threads */
+#ifndef UDS_POSIX_EXECUTOR_MAX_THREADS
+#define UDS_POSIX_EXECUTOR_MAX_THREADS 4u
+#endif
+
+/** Maximum number of queued (not yet running) jobs */
+#ifndef UDS_POSIX_EXECUTOR_QUEUE_DEPTH
+#define UDS_POSIX_EXECUTOR_QUEUE_DEPTH 16u
+#endif
+
+/**
+ * @brief Thread Pool Instance
+ *
+ * Allocated by the application. Members are private.
+ */
+typedef struct
+{
+    pthread_t threads[UDS_POSIX_EXECUTOR_MAX_THREADS];
+    uint8_t thread_count;
+    uds_job_t *queue[UDS_POSIX_EXECUTOR_QUEUE_DEPTH];
+    uint8_t head;
+    uint8_t count;
+    bool stop;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} uds_posix_executor_t;
+
+/**
+ * @brief Start a thread pool.
+ *
+ * @param pool    Pointer to the pool instance.
+ * @param threads Number of worker threads (1..UDS_POSIX_EXECUTOR_MAX_THREADS).
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG.
+ */
+int uds_posix_executor_init(uds_posix_executor_t *pool, uint8_t threads);
+
+/**
+ * @brief Queue a job (uds_config_t::fn_job_submit compatible).
+ *
+ * @param executor Pointer to the uds_posix_executor_t.
+ * @param job      Job to run.
+ * @return 0 on success, UDS_ERR_BUFFER_TOO_SMALL if the queue is full.
+ */
+int uds_posix_executor_submit(void *executor, uds_job_t *job);
+
+/**
+ * @brief Stop the pool after the queued jobs have run, and join the workers.
+ *
+ * @param pool Pointer to the pool instance.
+ */
+void uds_posix_executor_shutdown(uds_posix_executor_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_POSIX_EXECUTOR_H */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_posix_group.h
+ * @brief POSIX Shard Threads for a UDS Server Group
+ *
+ * Part of the optional uds_posix library. Runs one thread per shard of a
+ * uds_server_group_t, optionally pinned to a CPU (Linux):
+ *
+ * @code
+ * static const int cpus[] = {0, 1, 2, 3};
+ * static uds_posix_group_t runner;
+ * uds_posix_group_start(&runner, &group, get_time_ms, cpus);
+ * // RX thread: uds_server_group_input(&group, target, source, sdu, len);
+ * @endcode
+ */
+
+#ifndef UDS_POSIX_GROUP_H
+#define UDS_POSIX_GROUP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+
+#include "uds_server_group.h"
+
+/** Maximum number of shard threads */
+#ifndef UDS_POSIX_GROUP_MAX_SHARDS
+#define UDS_POSIX_GROUP_MAX_SHARDS 16u
+#endif
+
+/** Longest sleep of an idle shard thread (timer wheel resolution) */
+#ifndef UDS_POSIX_GROUP_TICK_MS
+#define UDS_POSIX_GROUP_TICK_MS 1u
+#endif
+
+/**
+ * @brief Wake-up state of one shard thread. Private.
+ */
+typedef struct
+{
+    struct uds_posix_group *runner;
+    uint8_t shard;
+    bool kicked;
+    bool stop;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} uds_posix_group_shard_t;
+
+/**
+ * @brief Shard Thread Runner
+ *
+ * Allocated by the application. Members are private.
+ */
+typedef struct uds_posix_group
+{
+    uds_server_group_t *group;
+    uint32_t (*get_time_ms)(void);
+    pthread_t threads[UDS_POSIX_GROUP_MAX_SHARDS];
+    uds_posix_group_shard_t shards[UDS_POSIX_GROUP_MAX_SHARDS];
+    uint8_t thread_count;
+} uds_posix_group_t;
+
+/**
+ * @brief Start one thread per shard.
+ *
+ * Installs the shards' fn_wake hooks, so posts wake the owning thread at
+ * once; idle threads still wake every UDS_POSIX_GROUP_TICK_MS for timers.
+ *
+ * @param runner      Runner instance.
+ * @param group       Group with all members added.
+ * @param get_time_ms Time base of the members.
+ * @param cpus        CPU per shard (negative = not pinned), or NULL. Pinning
+ *                    is only supported on Linux and ignored elsewhere.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG.
+ */
+int uds_posix_group_start(uds_posix_group_t *runner, uds_server_group_t *group,
+                          uint32_t (*get_time_ms)(void), const int *cpus);
+
+/**
+ * @brief Stop and join the shard threads.
+ *
+ * @param runner Runner instance.
+ */
+void uds_posix_group_stop(uds_posix_group_t *runner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_POSIX_GROUP_H */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_posix_nvm.h
+ * @brief File-Backed Flash for the NVM Journal
+ *
+ * Part of the optional uds_posix library. Emulates the two journal sectors in
+ * a file with NOR flash semantics (erase sets 0xFF, programming only clears
+ * bits), so the journal can be tested and used on a Linux host:
+ *
+ * @code
+ * static uds_posix_nvm_t file;
+ * uds_posix_nvm_open(&file, "dtc.journal", 4096u);
+ * uds_nvm_journal_init(&journal, &file.flash);
+ * @endcode
+ */
+
+#ifndef UDS_POSIX_NVM_H
+#define UDS_POSIX_NVM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_nvm_journal.h"
+
+/**
+ * @brief File flash instance
+ *
+ * Allocated by the application. flash is the hook table to pass to
+ * uds_nvm_journal_init(); the other members are private.
+ */
+typedef struct
+{
+    uds_nvm_flash_t flash;
+    int fd;
+} uds_posix_nvm_t;
+
+/**
+ * @brief Open or create the backing file.
+ *
+ * A new or shorter file is extended with erased (0xFF) bytes to two sectors.
+ *
+ * @param nvm         Instance to initialize.
+ * @param path        File path.
+ * @param sector_size Bytes of one sector.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG if the file cannot be opened.
+ */
+int uds_posix_nvm_open(uds_posix_nvm_t *nvm, const char *path, uint32_t sector_size);
+
+/**
+ * @brief Flush and close the backing file.
+ *
+ * @param nvm Instance to close.
+ */
+void uds_posix_nvm_close(uds_posix_nvm_t *nvm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_POSIX_NVM_H */
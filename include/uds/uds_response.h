@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_response.h
+ * @brief Zero-Copy Response Writer
+ *
+ * Builds a positive response from pieces: bytes written in place into the
+ * tx_buffer (reserve/append) and references to external memory such as
+ * static DID storage or memory-mapped flash (ref). On commit, the pieces are
+ * handed to uds_config_t::fn_tp_sendv as a segment list, so referenced data
+ * is never copied into the tx_buffer. Without fn_tp_sendv, references are
+ * copied and the response goes out through fn_tp_send as usual.
+ *
+ * A body too large for the tx_buffer can be streamed instead: the handler
+ * registers a producer with uds_response_stream(), and a transport with
+ * uds_config_t::fn_tp_send_stream pulls the bytes with uds_stream_pull()
+ * while it emits consecutive frames. Only the few bytes written before the
+ * body are kept, so the response size is bounded by the transport, not RAM.
+ *
+ * Locking: the producer runs long after the handler returned, and reads
+ * server state (e.g. the DTC store) that handlers and uds_process() change.
+ * Pulls made inside fn_tp_send_stream() run under the context lock already
+ * and use uds_stream_pull(). Pulls from the transport's frame pump (the
+ * consecutive frames) must use uds_stream_pull_locked(), which takes
+ * fn_mutex_lock around the producer. In mailbox mode there is no lock: run
+ * the frame pump on the thread that owns the context.
+ *
+ * @code
+ * uds_response_t resp;
+ * uds_response_begin(&resp, ctx, 0x22);
+ * uint8_t *hdr = uds_response_reserve(&resp, 2);  // DID identifier
+ * uds_response_ref(&resp, vin_storage, 17);       // sent by reference
+ * return uds_response_commit(&resp);
+ * @endcode
+ */
+
+#ifndef UDS_RESPONSE_H
+#define UDS_RESPONSE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/** Maximum number of segments of one response */
+#ifndef UDS_RESPONSE_MAX_SEGMENTS
+#define UDS_RESPONSE_MAX_SEGMENTS 8u
+#endif
+
+/**
+ * @brief Response Writer State
+ *
+ * Lives on the handler's stack between uds_response_begin() and
+ * uds_response_commit().
+ */
+typedef struct
+{
+    uds_ctx_t *ctx;                              /**< Owning context */
+    uds_iovec_t seg[UDS_RESPONSE_MAX_SEGMENTS]; /**< Segments in transmission order */
+    uint8_t count;                               /**< Segments in use */
+    uint16_t used;                               /**< Bytes used in the tx_buffer */
+    uint16_t total;                              /**< Total response length */
+    bool overflow;                               /**< A piece did not fit */
+    uint8_t nrc;                                 /**< NRC of a failed in-place stream */
+    uds_stream_fn stream_fn;                     /**< Body producer (NULL = not streamed) */
+    void *stream_arg;                            /**< Producer argument */
+    uint32_t stream_start;                       /**< Position of the first body byte */
+    uint32_t stream_len;                         /**< Body length */
+} uds_response_t;
+
+/**
+ * @brief Start a positive response.
+ *
+ * Writes the response SID (sid + 0x40) as the first byte.
+ *
+ * @param resp Writer state.
+ * @param ctx  Pointer to the context.
+ * @param sid  Request service ID.
+ * @return UDS_OK, or UDS_ERR_NOT_INIT.
+ */
+int uds_response_begin(uds_response_t *resp, uds_ctx_t *ctx, uint8_t sid);
+
+/**
+ * @brief Reserve bytes in the tx_buffer to be filled in place.
+ *
+ * @return Pointer to len writable bytes, or NULL if they do not fit.
+ */
+uint8_t *uds_response_reserve(uds_response_t *resp, uint16_t len);
+
+/**
+ * @brief Copy bytes into the response.
+ *
+ * @return UDS_OK, or UDS_ERR_BUFFER_TOO_SMALL.
+ */
+int uds_response_append(uds_response_t *resp, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Add external memory to the response by reference.
+ *
+ * The memory must remain unchanged until uds_response_commit() returns.
+ * Falls back to uds_response_append() without fn_tp_sendv or when all
+ * segments are in use.
+ *
+ * @return UDS_OK, or UDS_ERR_BUFFER_TOO_SMALL.
+ */
+int uds_response_ref(uds_response_t *resp, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief End the response with a body produced on demand.
+ *
+ * If the body fits the tx_buffer, fn is called at once to fill it in place.
+ * Otherwise the body is streamed through fn_tp_send_stream, which requires
+ * that everything before it was written in place and is at most
+ * UDS_STREAM_HEAD_MAX bytes. Nothing may be added after the body.
+ *
+ * @param resp  Writer state.
+ * @param start Position passed to fn for the first body byte.
+ * @param len   Body length.
+ * @param fn    Producer, called later from the transport when streamed.
+ * @param arg   Producer argument, must stay valid until the stream ends.
+ * @return UDS_OK, UDS_ERR_BUFFER_TOO_SMALL if the response is too long for
+ *         the configuration, or UDS_ERR_INVALID_ARG if the producer failed
+ *         (its NRC is sent by uds_response_commit()).
+ */
+int uds_response_stream(uds_response_t *resp, uint32_t start, uint32_t len, uds_stream_fn fn,
+                        void *arg);
+
+/**
+ * @brief Send the response.
+ *
+ * Behaves like uds_send_response() (pending requests, suppressPosRsp,
+ * statistics). If a piece did not fit, NRC 0x14 (responseTooLong) is sent
+ * instead, and the producer's NRC if an in-place stream failed.
+ *
+ * @return Result of the transport, or an error code.
+ */
+int uds_response_commit(uds_response_t *resp);
+
+#if UDS_CFG_FEATURE_STREAM
+/**
+ * @brief Pull the next bytes of the streamed response (transport side).
+ *
+ * Called by a fn_tp_send_stream transport for each frame, in order, until
+ * the SDU length given to it has been pulled. The caller holds the context
+ * lock (inside fn_tp_send_stream()); see uds_stream_pull_locked(). The stream ends after the last
+ * byte or on a failure; the transport then aborts the SDU.
+ *
+ * @param ctx Pointer to the context.
+ * @param buf Destination.
+ * @param max Bytes wanted.
+ * @return Bytes written (max unless the SDU ends), or a negative error code
+ *         (UDS_ERR_NOT_INIT without an active stream, UDS_ERR_INVALID_ARG
+ *         if the producer failed).
+ */
+int uds_stream_pull(uds_ctx_t *ctx, uint8_t *buf, uint16_t max);
+
+/**
+ * @brief uds_stream_pull() under the context lock.
+ *
+ * For pulls outside fn_tp_send_stream(), e.g. from a transport's frame pump.
+ * Must not be called with the context lock held.
+ *
+ * @return As uds_stream_pull().
+ */
+int uds_stream_pull_locked(uds_ctx_t *ctx, uint8_t *buf, uint16_t max);
+#endif /* UDS_CFG_FEATURE_STREAM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_RESPONSE_H */
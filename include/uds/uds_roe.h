@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_roe.h
+ * @brief ResponseOnEvent (SID 0x86)
+ *
+ * Enabled by pointing uds_config_t::roe at an application-owned uds_roe_t.
+ * A tester sets up events, starts them with startResponseOnEvent, and the
+ * server then executes the serviceToRespondTo (a 0x22 or 0x19 request) each
+ * time an event occurs, instead of being polled:
+ *
+ * - onDTCStatusChange (0x01): a status bit selected by the DTCStatusMask
+ *   changes, as reported by uds_roe_notify_dtc().
+ * - onChangeOfDataIdentifier (0x03): the value of a DID changes.
+ * - onComparisonOfValues (0x07): a value inside a DID starts to satisfy a
+ *   comparison with a reference value, with hysteresis before it re-arms.
+ *
+ * DID values are not compared byte by byte: each event keeps a 32-bit hash
+ * of the last value seen. A DID is only read again when it is marked dirty,
+ * by a successful 0x2E or by uds_roe_notify_did(), or every poll_ms for
+ * values the application does not report. Everything is evaluated in
+ * uds_process(), never while a request is pending.
+ */
+
+#ifndef UDS_ROE_H
+#define UDS_ROE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/* --- Event Types (ISO 14229-1, bits 0-5 of the subfunction) --- */
+
+#define UDS_ROE_STOP 0x00u                 /**< stopResponseOnEvent */
+#define UDS_ROE_ON_DTC_STATUS_CHANGE 0x01u /**< onDTCStatusChange */
+#define UDS_ROE_ON_CHANGE_OF_DID 0x03u     /**< onChangeOfDataIdentifier */
+#define UDS_ROE_REPORT_ACTIVATED 0x04u     /**< reportActivatedEvents */
+#define UDS_ROE_START 0x05u                /**< startResponseOnEvent */
+#define UDS_ROE_CLEAR 0x06u                /**< clearResponseOnEvent */
+#define UDS_ROE_ON_COMPARISON 0x07u        /**< onComparisonOfValues */
+
+/* --- Event Window Times --- */
+
+#define UDS_ROE_WINDOW_INFINITE 0x02u /**< Active until stopped */
+#define UDS_ROE_WINDOW_SHORT 0x03u    /**< window_ms[0] */
+#define UDS_ROE_WINDOW_MEDIUM 0x04u   /**< window_ms[1] */
+#define UDS_ROE_WINDOW_LONG 0x05u     /**< window_ms[2] */
+
+/* --- Comparison Logic (onComparisonOfValues) --- */
+
+#define UDS_ROE_CMP_LESS 0x01u      /**< Value < reference */
+#define UDS_ROE_CMP_GREATER 0x02u   /**< Value > reference */
+#define UDS_ROE_CMP_EQUAL 0x03u     /**< Value == reference */
+#define UDS_ROE_CMP_NOT_EQUAL 0x04u /**< Value != reference */
+
+/** Largest eventTypeRecord (onComparisonOfValues) */
+#define UDS_ROE_MAX_RECORD 10u
+
+/** Largest serviceToRespondToRecord */
+#ifndef UDS_ROE_MAX_STRR
+#define UDS_ROE_MAX_STRR 8u
+#endif
+
+/**
+ * @brief Set-up event
+ */
+typedef struct uds_roe_event
+{
+    uint8_t type;                       /**< UDS_ROE_ON_*, 0 = slot free */
+    uint8_t window;                     /**< eventWindowTime of the request */
+    uint8_t record[UDS_ROE_MAX_RECORD]; /**< eventTypeRecord */
+    uint8_t record_len;                 /**< Bytes in record */
+    uint8_t strr[UDS_ROE_MAX_STRR];     /**< serviceToRespondToRecord */
+    uint8_t strr_len;                   /**< Bytes in strr */
+    bool active;                        /**< Started, window open */
+    bool dirty;                         /**< Evaluate on the next uds_process() */
+    bool primed;                        /**< hash holds the value at start or later */
+    bool armed;                         /**< Comparison may fire (hysteresis) */
+    uint8_t identified;                 /**< Events identified in the window */
+    uint16_t tester_addr;               /**< Source address of the tester that set it up */
+    uint32_t hash;                      /**< Hash of the last DID value seen */
+    uint32_t window_end;                /**< End of a finite window (ms) */
+} uds_roe_event_t;
+
+/**
+ * @brief ResponseOnEvent state
+ *
+ * Allocated by the application, one per context. Initialize with
+ * uds_roe_init(), then adjust poll_ms and window_ms if needed.
+ */
+typedef struct uds_roe
+{
+    uds_roe_event_t *events; /**< Event slots */
+    uint8_t count;           /**< Number of slots */
+    uint16_t poll_ms;        /**< Re-read DIDs this often, 0 = only when dirty */
+    uint32_t window_ms[3];   /**< Short, medium and long event windows */
+    uint32_t next_poll;      /**< Next poll (ms) */
+    uint32_t responses;      /**< Responses sent for identified events */
+} uds_roe_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize ResponseOnEvent without events.
+ *
+ * Windows default to 10 s (short), 60 s (medium) and 10 min (long), and DIDs
+ * are only re-read when dirty.
+ */
+void uds_roe_init(uds_roe_t *roe, uds_roe_event_t *events, uint8_t count);
+
+/**
+ * @brief Report that the value of a DID may have changed.
+ *
+ * Marks the events watching the DID dirty; they are evaluated by the next
+ * uds_process(). Call from the thread that runs uds_process().
+ */
+void uds_roe_notify_did(uds_ctx_t *ctx, uint16_t did);
+
+/**
+ * @brief Report a status change of a DTC.
+ *
+ * Triggers the onDTCStatusChange events whose DTCStatusMask selects a bit
+ * that differs between old_status and new_status. Call from the thread that
+ * runs uds_process().
+ */
+void uds_roe_notify_dtc(uds_ctx_t *ctx, uint32_t dtc, uint8_t old_status, uint8_t new_status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_ROE_H */
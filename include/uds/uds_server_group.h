@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_server_group.h
+ * @brief Multi-ECU Server Group (one RX dispatch, one poll loop)
+ *
+ * Owns many server contexts (virtual ECUs) of one process. Incoming SDUs are
+ * routed to a member by its physical address, and one process call per
+ * shard only touches the members with due work: contexts with mail to
+ * execute and contexts whose timer wheel deadline fired.
+ *
+ * With one shard, everything runs on the caller's thread. With several
+ * shards, every shard is driven by its own thread (see uds_posix_group.h)
+ * and every member must be in single-owner mode (uds_config_t::mailbox), so
+ * that the RX thread never touches a context owned by a shard thread.
+ */
+
+#ifndef UDS_SERVER_GROUP_H
+#define UDS_SERVER_GROUP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_timer_wheel.h"
+
+/**
+ * @brief Group Member (one virtual ECU)
+ *
+ * Storage is provided by the application through uds_server_group_init().
+ */
+typedef struct uds_server_member
+{
+    uds_ctx_t *ctx;                       /**< Initialized server context */
+    uint16_t addr;                        /**< Physical RX address of the ECU */
+    uint8_t shard;                        /**< Shard that owns the context */
+    uint32_t queued;                      /**< Internal: on the shard's ready list */
+    struct uds_server_member *next_ready; /**< Internal: ready list link */
+} uds_server_member_t;
+
+/**
+ * @brief Shard (members processed by one thread)
+ */
+typedef struct uds_server_shard
+{
+    uds_timer_wheel_t wheel;    /**< Deadlines of the shard's members */
+    uds_server_member_t *ready; /**< Members with posted mail (lock-free stack) */
+    void (*fn_wake)(void *arg); /**< Optional: wake the shard thread after a post */
+    void *wake_arg;             /**< Argument of fn_wake */
+} uds_server_shard_t;
+
+/**
+ * @brief Server Group
+ *
+ * Allocated by the application. Members are kept sorted by address, so RX
+ * dispatch is a binary search.
+ */
+typedef struct uds_server_group
+{
+    uds_server_member_t *members; /**< Member storage */
+    uint16_t capacity;            /**< Number of entries in members */
+    uint16_t count;               /**< Members added */
+    uds_server_shard_t *shards;   /**< Shard storage */
+    uint8_t shard_count;          /**< Number of entries in shards */
+    uint32_t unknown;             /**< SDUs for an address without member */
+} uds_server_group_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize a server group.
+ *
+ * @param group       Group to initialize.
+ * @param members     Member storage (capacity entries).
+ * @param capacity    Maximum number of members.
+ * @param shards      Shard storage (shard_count entries).
+ * @param shard_count Number of shards (at least 1).
+ * @param now_ms      Current time in milliseconds (time base of the members).
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG.
+ */
+int uds_server_group_init(uds_server_group_t *group, uds_server_member_t *members,
+                          uint16_t capacity, uds_server_shard_t *shards, uint8_t shard_count,
+                          uint32_t now_ms);
+
+/**
+ * @brief Add an initialized context to the group.
+ *
+ * Attaches the context to the timer wheel of its shard. Add every member
+ * before the shards are processed; members are moved to keep them sorted.
+ *
+ * @param group Group.
+ * @param ctx   Context, after uds_init().
+ * @param addr  Physical RX address (must be unique in the group).
+ * @param shard Owning shard (< shard_count).
+ * @return UDS_OK, UDS_ERR_BUFFER_TOO_SMALL if the group is full,
+ *         UDS_ERR_NOT_INIT, or UDS_ERR_INVALID_ARG (duplicate address, bad
+ *         shard, or no mailbox while the group has several shards).
+ */
+int uds_server_group_add(uds_server_group_t *group, uds_ctx_t *ctx, uint16_t addr, uint8_t shard);
+
+/**
+ * @brief Look up the member context serving an address.
+ *
+ * @return The context, or NULL.
+ */
+uds_ctx_t *uds_server_group_find(const uds_server_group_t *group, uint16_t addr);
+
+/**
+ * @brief Route a physically addressed SDU to its member (RX thread).
+ *
+ * @param group       Group.
+ * @param addr        Target (ECU) address.
+ * @param tester_addr Source (tester) address.
+ * @param data        SDU.
+ * @param len         SDU length.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG if no member serves addr.
+ */
+int uds_server_group_input(uds_server_group_t *group, uint16_t addr, uint16_t tester_addr,
+                           const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Deliver a functionally addressed SDU to every member (RX thread).
+ */
+void uds_server_group_input_functional(uds_server_group_t *group, uint16_t tester_addr,
+                                       const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Process the members of one shard that have due work.
+ *
+ * Runs uds_process() on the members with posted mail, then advances the
+ * shard's timer wheel. Must only be called from the shard's thread.
+ *
+ * @param group  Group.
+ * @param shard  Shard index.
+ * @param now_ms Current time in milliseconds.
+ * @return Number of contexts processed.
+ */
+uint32_t uds_server_group_process_shard(uds_server_group_t *group, uint8_t shard, uint32_t now_ms);
+
+/**
+ * @brief Process every shard from the calling thread (single poll loop).
+ *
+ * @return Number of contexts processed.
+ */
+uint32_t uds_server_group_process(uds_server_group_t *group, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_SERVER_GROUP_H */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_stats.h
+ * @brief Per-SID Performance Counters and Latency Histograms
+ *
+ * Enabled by pointing uds_config_t::stats at an application-owned
+ * uds_stats_t. The stack then counts requests, positive responses, NRCs per
+ * code and NRC 0x78 repetitions for each SID. It also records
+ * request-to-response latency in log2 microsecond buckets and the longest
+ * handler execution time.
+ */
+
+#ifndef UDS_STATS_H
+#define UDS_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/* --- Dimensions --- */
+
+/** Number of distinct SIDs that are tracked (first come, first served) */
+#ifndef UDS_STATS_MAX_SIDS
+#define UDS_STATS_MAX_SIDS 16u
+#endif
+
+/** Latency histogram buckets: bucket n counts latencies in [2^n, 2^(n+1)) us */
+#define UDS_STATS_HIST_BUCKETS 24u
+
+/** NRC buckets: one per code of uds_stats_nrc_bucket(), plus "other" */
+#define UDS_STATS_NRC_BUCKETS 17u
+
+/** Bucket index of NRCs without a dedicated bucket */
+#define UDS_STATS_NRC_OTHER (UDS_STATS_NRC_BUCKETS - 1u)
+
+/** A response later than this share of P2 (percent) counts as a P2 near-miss */
+#define UDS_STATS_P2_NEAR_MISS_PCT 80u
+
+/* --- DID Export --- */
+
+/** Suggested DID for uds_stats_read_did() (system supplier specific range) */
+#define UDS_DID_STACK_STATISTICS 0xFDF0u
+
+/** Bytes per SID record in the DID export */
+#define UDS_STATS_DID_RECORD_SIZE 25u
+
+/** Size of the statistics DID (use as uds_did_entry_t::size) */
+#define UDS_STATS_DID_SIZE (UDS_STATS_MAX_SIDS * UDS_STATS_DID_RECORD_SIZE)
+
+/**
+ * @brief Counters of one SID
+ */
+typedef struct
+{
+    uint8_t sid;                                   /**< Service ID (0 = unused entry) */
+    uint32_t requests;                             /**< Requests received */
+    uint32_t positive;                             /**< Positive responses (incl. suppressed) */
+    uint32_t negative;                             /**< Final NRCs (excluding 0x78) */
+    uint32_t rcrrp;                                /**< NRC 0x78 sent */
+    uint32_t p2_near_miss;                         /**< Completions later than the P2 budget */
+    uint32_t nrc[UDS_STATS_NRC_BUCKETS];           /**< Final NRCs per code bucket */
+    uint32_t latency_hist[UDS_STATS_HIST_BUCKETS]; /**< Request-to-completion latency */
+    uint32_t max_latency_us;                       /**< Longest request-to-completion time */
+    uint32_t max_handler_us;                       /**< Longest synchronous handler run */
+} uds_sid_stats_t;
+
+/**
+ * @brief Statistics Storage
+ *
+ * Allocated by the application. Updated with the context lock held; readers
+ * without the lock may observe a partially updated record.
+ */
+typedef struct uds_stats
+{
+    uds_sid_stats_t sids[UDS_STATS_MAX_SIDS]; /**< Per-SID counters */
+    uint32_t dropped;                         /**< Events of SIDs that found no free entry */
+} uds_stats_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Get the counters of a SID.
+ *
+ * @param ctx Pointer to the context.
+ * @param sid Service ID.
+ * @return Pointer to the counters, or NULL if the SID has not been seen or
+ *         statistics are disabled.
+ */
+const uds_sid_stats_t *uds_stats_get(const uds_ctx_t *ctx, uint8_t sid);
+
+/**
+ * @brief Clear all counters.
+ *
+ * @param ctx Pointer to the context.
+ */
+void uds_stats_reset(uds_ctx_t *ctx);
+
+/**
+ * @brief Bucket index used for an NRC in uds_sid_stats_t::nrc.
+ *
+ * @param nrc Negative response code.
+ * @return Bucket index, UDS_STATS_NRC_OTHER for codes without a bucket.
+ */
+uint8_t uds_stats_nrc_bucket(uint8_t nrc);
+
+/**
+ * @brief DID read callback exporting the counters (uds_did_read_fn compatible).
+ *
+ * Register it with size UDS_STATS_DID_SIZE, e.g. at UDS_DID_STACK_STATISTICS.
+ * Each record is: SID (1), requests, positive, negative, NRC 0x78,
+ * max latency us, max handler us (4 bytes each, big endian). Unused
+ * records are zero.
+ *
+ * @return Number of bytes written, or -0x22 if statistics are disabled.
+ */
+int uds_stats_read_did(struct uds_ctx *ctx, uint16_t did, uint8_t *buf, uint16_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_STATS_H */
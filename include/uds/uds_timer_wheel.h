@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_timer_wheel.h
+ * @brief Shared Hierarchical Timer Wheel for Many UDS Contexts
+ *
+ * Contexts attached to a wheel register their next S3 / P2 / periodic deadline
+ * whenever it changes. A host managing many contexts then calls
+ * uds_timer_wheel_process() instead of uds_process() on every context; only
+ * the contexts whose deadline fired are processed.
+ */
+
+#ifndef UDS_TIMER_WHEEL_H
+#define UDS_TIMER_WHEEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/* --- Wheel Geometry --- */
+
+/** Number of wheel levels (hierarchy depth) */
+#define UDS_TIMER_WHEEL_LEVELS 4u
+
+/** log2 of the number of slots per level */
+#define UDS_TIMER_WHEEL_SLOT_BITS 6u
+
+/** Slots per level (1 ms resolution at level 0) */
+#define UDS_TIMER_WHEEL_SLOTS (1u << UDS_TIMER_WHEEL_SLOT_BITS)
+
+/** Longest deadline representable without re-cascading (~4.6 hours) */
+#define UDS_TIMER_WHEEL_MAX_MS \
+    ((1uL << (UDS_TIMER_WHEEL_SLOT_BITS * UDS_TIMER_WHEEL_LEVELS)) - 1uL)
+
+/**
+ * @brief Timer Wheel Instance
+ *
+ * Allocated by the application (static or stack). The wheel does not allocate
+ * memory; every attached context embeds its own uds_timer_node_t.
+ *
+ * The wheel is not internally locked. Drive it, uds_input_sdu() and
+ * uds_process() of all attached contexts from the same thread, or serialize
+ * them with an application-level lock.
+ */
+typedef struct uds_timer_wheel
+{
+    /** Intrusive slot lists, one set per level */
+    uds_timer_node_t *slots[UDS_TIMER_WHEEL_LEVELS][UDS_TIMER_WHEEL_SLOTS];
+    /** Nodes whose deadline had already passed when they were armed */
+    uds_timer_node_t *due;
+    /** Last processed tick (ms) */
+    uint32_t current;
+    /** Number of armed nodes */
+    uint32_t armed;
+} uds_timer_wheel_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize a timer wheel.
+ *
+ * @param wheel  Pointer to the wheel to initialize.
+ * @param now_ms Current time in milliseconds (same time base as get_time_ms).
+ */
+void uds_timer_wheel_init(uds_timer_wheel_t *wheel, uint32_t now_ms);
+
+/**
+ * @brief Attach an initialized context to a wheel.
+ *
+ * Must be called after uds_init(). From now on the context keeps its next
+ * deadline registered with the wheel.
+ *
+ * @param wheel Pointer to the wheel.
+ * @param ctx   Pointer to the initialized context.
+ * @return UDS_OK on success, UDS_ERR_INVALID_ARG on NULL arguments or
+ *         UDS_ERR_NOT_INIT if the context has not been initialized.
+ */
+int uds_timer_wheel_attach(uds_timer_wheel_t *wheel, uds_ctx_t *ctx);
+
+/**
+ * @brief Detach a context from its wheel.
+ *
+ * @param ctx Pointer to the context.
+ */
+void uds_timer_wheel_detach(uds_ctx_t *ctx);
+
+/**
+ * @brief Advance the wheel and process the contexts whose deadline fired.
+ *
+ * Calls uds_process() on every fired context. Each timer operation is O(1);
+ * idle contexts are never touched. The wheel jumps from one occupied slot or
+ * cascade boundary to the next, so a long gap between calls costs a scan of
+ * the slots rather than one step per millisecond.
+ *
+ * @param wheel  Pointer to the wheel.
+ * @param now_ms Current time in milliseconds.
+ * @return Number of contexts processed.
+ */
+uint32_t uds_timer_wheel_process(uds_timer_wheel_t *wheel, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_TIMER_WHEEL_H */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_trace.h
+ * @brief Binary Event Trace Ring Buffer
+ *
+ * A low-cost alternative to fn_log for production builds. The stack writes
+ * fixed-size binary records into an application-owned ring; nothing is
+ * formatted on the target. The ring is single-producer / single-consumer and
+ * lock-free: the stack writes with the context lock held, and one reader
+ * (a background task, a debugger, a DID handler) drains it with
+ * uds_trace_read(). Dumped records are decoded offline with
+ * tools/decode_trace.py.
+ */
+
+#ifndef UDS_TRACE_H
+#define UDS_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_core.h"
+
+/* --- Compile-Time Level --- */
+
+/**
+ * Highest UDS_LOG_* level that is compiled in. Trace points above this level
+ * produce no code. Define as -1 to remove tracing completely.
+ */
+#ifndef UDS_TRACE_LEVEL
+#define UDS_TRACE_LEVEL UDS_LOG_INFO
+#endif
+
+/* --- Event IDs --- */
+
+#define UDS_TRACE_EV_REQUEST 0x01u     /**< Request dispatched (arg = length) */
+#define UDS_TRACE_EV_RESPONSE 0x02u    /**< Positive response sent (arg = length) */
+#define UDS_TRACE_EV_NRC 0x03u         /**< Negative response sent (arg = NRC) */
+#define UDS_TRACE_EV_PENDING 0x04u     /**< Handler returned UDS_PENDING */
+#define UDS_TRACE_EV_BUSY 0x05u        /**< Request rejected or queued while busy (arg = 1 if queued) */
+#define UDS_TRACE_EV_S3_TIMEOUT 0x06u  /**< Session fell back to default (arg = old session) */
+#define UDS_TRACE_EV_RCRRP_LIMIT 0x07u /**< Pending request aborted after the 0x78 limit */
+#define UDS_TRACE_EV_JOB_SUBMIT 0x08u  /**< Job handed to the executor (arg = job ID) */
+#define UDS_TRACE_EV_JOB_DONE 0x09u    /**< Job result accepted (arg = job ID) */
+#define UDS_TRACE_EV_JOB_STALE 0x0Au   /**< Stale job result dropped (arg = job ID) */
+
+/**
+ * @brief One trace record (8 bytes, host byte order)
+ */
+typedef struct
+{
+    uint32_t timestamp; /**< get_time_us() if set, otherwise get_time_ms() * 1000 */
+    uint8_t event;      /**< UDS_TRACE_EV_* */
+    uint8_t sid;        /**< Service ID the event belongs to (0 = none) */
+    uint16_t arg;       /**< Event specific argument */
+} uds_trace_record_t;
+
+/**
+ * @brief Trace Ring
+ *
+ * Initialize with uds_trace_init() and assign to uds_config_t::trace. When
+ * the ring is full new records are dropped and counted, so the reader never
+ * sees a record being overwritten.
+ */
+typedef struct uds_trace_ring
+{
+    uds_trace_record_t *records; /**< Storage, capacity entries */
+    uint32_t mask;               /**< capacity - 1 */
+    uint32_t head;               /**< Next write index (producer owned) */
+    uint32_t tail;               /**< Next read index (consumer owned) */
+    uint32_t dropped;            /**< Records lost because the ring was full */
+} uds_trace_ring_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize a trace ring.
+ *
+ * @param ring     Ring to initialize.
+ * @param records  Storage for the records.
+ * @param capacity Number of records, must be a power of two.
+ * @return UDS_OK, or UDS_ERR_INVALID_ARG.
+ */
+int uds_trace_init(uds_trace_ring_t *ring, uds_trace_record_t *records, uint32_t capacity);
+
+/**
+ * @brief Append a record (producer side).
+ *
+ * Used by the stack; applications may add their own events with IDs from
+ * 0x80 upwards, from the same thread that feeds the stack.
+ */
+void uds_trace_write(uds_trace_ring_t *ring, uint32_t timestamp, uint8_t event, uint8_t sid,
+                     uint16_t arg);
+
+/**
+ * @brief Remove up to max records from the ring (consumer side).
+ *
+ * @param ring Trace ring.
+ * @param out  Destination for the records.
+ * @param max  Capacity of out.
+ * @return Number of records copied.
+ */
+uint32_t uds_trace_read(uds_trace_ring_t *ring, uds_trace_record_t *out, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_TRACE_H */
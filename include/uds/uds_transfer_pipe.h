@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_transfer_pipe.h
+ * @brief Pipelined TransferData (SID 0x36)
+ *
+ * Enabled by pointing uds_config_t::transfer_pipe at an application-owned
+ * uds_transfer_pipe_t. Each 0x36 block is copied into a staging slot and
+ * acknowledged at once; fn_transfer_data() then writes the slots in order,
+ * one at a time, as background jobs on the job executor (fn_job_submit,
+ * uds_job.h). The tester sends block N + 1 while block N is programmed.
+ *
+ * @code
+ * static uint8_t slots[2 * 4096];
+ * static uds_transfer_pipe_t pipe;
+ * uds_transfer_pipe_init(&pipe, slots, 4096, 2);  // double buffering
+ * cfg.transfer_pipe = &pipe;
+ * cfg.fn_job_submit = uds_posix_executor_submit;
+ * @endcode
+ *
+ * A block is only acknowledged while another slot stays free, so the next
+ * block always finds room. Otherwise the request stays pending (NRC 0x78)
+ * until a write finishes. RequestTransferExit (0x37) likewise waits for the
+ * last write before fn_transfer_exit() runs.
+ *
+ * A failed write ends the transfer: the blocks still staged are dropped, and
+ * the waiting request, every later 0x36 and the 0x37 are answered with the
+ * NRC of fn_transfer_data() until the next RequestDownload (0x34).
+ *
+ * fn_transfer_data() runs on the executor, like the work of any job: it must
+ * only use its data argument and its own state. Without an executor the
+ * writes run inline and the behaviour is that of the plain handler.
+ */
+
+#ifndef UDS_TRANSFER_PIPE_H
+#define UDS_TRANSFER_PIPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "uds_job.h"
+
+/** Maximum number of staging slots */
+#ifndef UDS_TRANSFER_PIPE_MAX_SLOTS
+#define UDS_TRANSFER_PIPE_MAX_SLOTS 4u
+#endif
+
+/**
+ * @brief TransferData staging pool
+ *
+ * Allocated by the application with its slot storage, one per context.
+ * Initialize with uds_transfer_pipe_init().
+ */
+typedef struct uds_transfer_pipe
+{
+    uint8_t *slots;       /**< slot_count * slot_size bytes of staging storage */
+    uint16_t slot_size;   /**< Largest block (0x36 data after the counter) */
+    uint8_t slot_count;   /**< Slots, 1..UDS_TRANSFER_PIPE_MAX_SLOTS */
+
+    /* --- Owned by the stack --- */
+    uint16_t len[UDS_TRANSFER_PIPE_MAX_SLOTS]; /**< Block length of each slot */
+    uint8_t seq[UDS_TRANSFER_PIPE_MAX_SLOTS];  /**< blockSequenceCounter of each slot */
+    uint8_t head;                              /**< Oldest staged slot, written next */
+    uint8_t count;                             /**< Staged slots, including the one being written */
+    bool busy;                                 /**< A write is running */
+    bool waiting;                              /**< A 0x36 / 0x37 request waits for the pipe */
+    uint8_t error;                             /**< NRC of a failed write, 0 = none */
+    uint8_t wait_seq;                          /**< blockSequenceCounter of the waiting 0x36 */
+    uds_job_t write;                           /**< Background write of the head slot */
+    uds_job_t waiter;                          /**< Pending request, completed by a write */
+    uint32_t written;                          /**< Blocks written */
+    uint32_t stalls;                           /**< Blocks that waited for a free slot */
+} uds_transfer_pipe_t;
+
+/* --- Public API --- */
+
+/**
+ * @brief Initialize an empty staging pool.
+ *
+ * @param pipe       Pool to initialize.
+ * @param slots      Storage for slot_count * slot_size bytes.
+ * @param slot_size  Largest block the tester sends.
+ * @param slot_count Number of slots (2 for double buffering).
+ */
+void uds_transfer_pipe_init(uds_transfer_pipe_t *pipe, uint8_t *slots, uint16_t slot_size,
+                            uint8_t slot_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_TRANSFER_PIPE_H */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_access.c
+ * @brief Session / Security Permission Matrix Implementation
+ */
+
+#include "uds/uds_access.h"
+#include "uds_internal.h"
+
+/** Levels of one row that grant access: every level */
+#define ACCESS_ALL_LEVELS 0xFFFFu
+
+/** Row of sessions without a UDS_SESSION_* bit */
+#define ACCESS_ROW_OTHER 3u
+
+/* --- Internal Helpers --- */
+
+static uint8_t access_row(uint8_t session)
+{
+    switch (session) {
+        case UDS_SESSION_ID_DEFAULT:
+            return 0u;
+        case UDS_SESSION_ID_EXTENDED:
+            return 1u;
+        case UDS_SESSION_ID_PROGRAMMING:
+            return 2u;
+        default:
+            return ACCESS_ROW_OTHER;
+    }
+}
+
+/* True if session_mask permits the active session, whatever the security level */
+static bool session_permitted(uint8_t session_mask, uint8_t session)
+{
+    return ((uds_access_bits(session_mask, 1u) >> (access_row(session) * UDS_ACCESS_LEVELS)) &
+            1u) != 0u;
+}
+
+/*
+ * One bit test at the cell of the active session and level. Levels above the
+ * matrix columns are decided by the caller (high_granted). A denial is a
+ * session error when the session itself is not permitted.
+ */
+static int access_check(const uds_ctx_t *ctx, uint64_t bits, bool high_granted,
+                        uint8_t session_mask)
+{
+    uint8_t level = ctx->security_level;
+    bool granted;
+    if (level < UDS_ACCESS_LEVELS) {
+        uint8_t cell = (uint8_t) ((access_row(ctx->active_session) * UDS_ACCESS_LEVELS) + level);
+        granted = ((bits >> cell) & 1u) != 0u;
+    }
+    else {
+        granted = high_granted && session_permitted(session_mask, ctx->active_session);
+    }
+    if (granted) {
+        return UDS_ACCESS_OK;
+    }
+    return session_permitted(session_mask, ctx->active_session) ? UDS_ACCESS_DENIED_SECURITY
+                                                                : UDS_ACCESS_DENIED_SESSION;
+}
+
+/* Compiled word of entry index; false if the matrix does not cover it */
+static bool access_compiled(const uds_ctx_t *ctx, uint32_t index, uint64_t *bits)
+{
+#if UDS_CFG_FEATURE_ACCESS_MATRIX
+    if ((ctx->config->access_matrix == NULL) || (index >= ctx->config->access_matrix_size)) {
+        return false;
+    }
+    *bits = ctx->config->access_matrix[index];
+    return true;
+#else
+    (void) ctx;
+    (void) index;
+    (void) bits;
+    return false;
+#endif
+}
+
+/* --- Internal API --- */
+
+int uds_internal_service_access(const uds_ctx_t *ctx, const uds_service_entry_t *service)
+{
+    const uds_config_t *cfg = ctx->config;
+    uint64_t bits = 0u;
+
+    bool user = (cfg->user_services != NULL) && (service >= cfg->user_services) &&
+                (service < &cfg->user_services[cfg->user_service_count]);
+    if (!user || !access_compiled(ctx, (uint32_t) (service - cfg->user_services), &bits)) {
+        bits = uds_access_service_bits(service->session_mask, service->security_mask);
+    }
+    return access_check(ctx, bits, service->security_mask <= ctx->security_level,
+                        service->session_mask);
+}
+
+int uds_internal_did_access(const uds_ctx_t *ctx, const uds_did_entry_t *entry)
+{
+    const uds_config_t *cfg = ctx->config;
+    uint64_t bits = 0u;
+
+    uint32_t index =
+        (uint32_t) cfg->user_service_count + (uint32_t) (entry - cfg->did_table.entries);
+    if (!access_compiled(ctx, index, &bits)) {
+        bits = uds_access_did_bits(entry->session_mask, entry->security_mask);
+    }
+    /* The 16-bit mask cannot name a level above 15 */
+    return access_check(ctx, bits, entry->security_mask == 0u, entry->session_mask);
+}
+
+/* --- Public API --- */
+
+uint64_t uds_access_bits(uint8_t session_mask, uint16_t levels)
+{
+    uint64_t row = (uint64_t) levels;
+    uint64_t bits = 0u;
+    bool all = (session_mask == 0u) || (session_mask == UDS_SESSION_ALL);
+
+    if (all || ((session_mask & UDS_SESSION_DEFAULT) != 0u)) {
+        bits |= row << (0u * UDS_ACCESS_LEVELS);
+    }
+    if (all || ((session_mask & UDS_SESSION_EXTENDED) != 0u)) {
+        bits |= row << (1u * UDS_ACCESS_LEVELS);
+    }
+    if (all || ((session_mask & UDS_SESSION_PROGRAMMING) != 0u)) {
+        bits |= row << (2u * UDS_ACCESS_LEVELS);
+    }
+    if (all) {
+        bits |= row << (ACCESS_ROW_OTHER * UDS_ACCESS_LEVELS);
+    }
+    return bits;
+}
+
+uint64_t uds_access_service_bits(uint8_t session_mask, uint16_t min_level)
+{
+    /* Levels min_level..15; none of the columns for a minimum above 15 */
+    uint16_t levels = (min_level >= UDS_ACCESS_LEVELS)
+                          ? 0u
+                          : (uint16_t) (ACCESS_ALL_LEVELS << min_level);
+    return uds_access_bits(session_mask, levels);
+}
+
+uint64_t uds_access_did_bits(uint8_t session_mask, uint16_t security_mask)
+{
+    return uds_access_bits(session_mask,
+                           (security_mask == 0u) ? (uint16_t) ACCESS_ALL_LEVELS : security_mask);
+}
+
+#if UDS_CFG_FEATURE_ACCESS_MATRIX
+int uds_access_compile(uds_ctx_t *ctx)
+{
+    if ((ctx == NULL) || (ctx->config == NULL)) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    const uds_config_t *cfg = ctx->config;
+    if (cfg->access_matrix == NULL) {
+        return UDS_OK;
+    }
+    uint32_t needed = UDS_ACCESS_MATRIX_SIZE((uint32_t) cfg->user_service_count,
+                                             (uint32_t) cfg->did_table.count);
+    if (cfg->access_matrix_size < needed) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t *out = cfg->access_matrix;
+    for (uint16_t i = 0u; i < cfg->user_service_count; i++) {
+        *out++ = uds_access_service_bits(cfg->user_services[i].session_mask,
+                                         cfg->user_services[i].security_mask);
+    }
+    for (uint16_t i = 0u; i < cfg->did_table.count; i++) {
+        *out++ = uds_access_did_bits(cfg->did_table.entries[i].session_mask,
+                                     cfg->did_table.entries[i].security_mask);
+    }
+    return UDS_OK;
+}
+#endif /* UDS_CFG_FEATURE_ACCESS_MATRIX */
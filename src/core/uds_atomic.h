@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_atomic.h
+ * @brief Minimal Atomic Helpers for Lock-Free Structures
+ *
+ * Uses the GCC/Clang __atomic builtins when available. Other compilers fall
+ * back to volatile accesses, which are sufficient for loads and stores on
+ * single-core targets where a 32-bit aligned access is atomic.
+ */
+
+#ifndef UDS_ATOMIC_H
+#define UDS_ATOMIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define UDS_ATOMIC_LOAD_RELAXED(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define UDS_ATOMIC_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define UDS_ATOMIC_STORE_RELEASE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define UDS_ATOMIC_FETCH_ADD(ptr, val) __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+/* Strong compare-and-swap; on failure *expected receives the current value */
+#define UDS_ATOMIC_CAS(ptr, expected, desired)                                         \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), false, __ATOMIC_ACQ_REL, \
+                                __ATOMIC_RELAXED)
+/* Pointer variants (lock-free stacks) */
+#define UDS_ATOMIC_XCHG_PTR(ptr, val) __atomic_exchange_n((ptr), (val), __ATOMIC_ACQ_REL)
+#define UDS_ATOMIC_CAS_PTR(ptr, expected, desired) UDS_ATOMIC_CAS((ptr), (expected), (desired))
+
+#else
+
+#define UDS_ATOMIC_LOAD_RELAXED(ptr) (*(volatile const uint32_t *) (ptr))
+#define UDS_ATOMIC_LOAD_ACQUIRE(ptr) (*(volatile const uint32_t *) (ptr))
+#define UDS_ATOMIC_STORE_RELEASE(ptr, val) (*(volatile uint32_t *) (ptr) = (val))
+#define UDS_ATOMIC_FETCH_ADD(ptr, val) uds_atomic_fetch_add_fallback((ptr), (val))
+#define UDS_ATOMIC_CAS(ptr, expected, desired) \
+    uds_atomic_cas_fallback((ptr), (expected), (desired))
+#define UDS_ATOMIC_XCHG_PTR(ptr, val) uds_atomic_xchg_ptr_fallback((void **) (ptr), (val))
+#define UDS_ATOMIC_CAS_PTR(ptr, expected, desired) \
+    uds_atomic_cas_ptr_fallback((void **) (ptr), (void **) (expected), (desired))
+
+/*
+ * Read-modify-write fallbacks are only atomic if producers cannot preempt
+ * each other (single core, producers at the same priority or in ISRs of one
+ * level). Port the two functions to the target's primitives otherwise.
+ */
+static inline uint32_t uds_atomic_fetch_add_fallback(uint32_t *ptr, uint32_t val)
+{
+    uint32_t old = *(volatile uint32_t *) ptr;
+    *(volatile uint32_t *) ptr = old + val;
+    return old;
+}
+
+static inline bool uds_atomic_cas_fallback(uint32_t *ptr, uint32_t *expected, uint32_t desired)
+{
+    uint32_t current = *(volatile uint32_t *) ptr;
+    if (current != *expected) {
+        *expected = current;
+        return false;
+    }
+    *(volatile uint32_t *) ptr = desired;
+    return true;
+}
+
+static inline void *uds_atomic_xchg_ptr_fallback(void **ptr, void *val)
+{
+    void *old = *(void *volatile *) ptr;
+    *(void *volatile *) ptr = val;
+    return old;
+}
+
+static inline bool uds_atomic_cas_ptr_fallback(void **ptr, void **expected, void *desired)
+{
+    void *current = *(void *volatile *) ptr;
+    if (current != *expected) {
+        *expected = current;
+        return false;
+    }
+    *(void *volatile *) ptr = desired;
+    return true;
+}
+
+#endif
+
+#endif /* UDS_ATOMIC_H */
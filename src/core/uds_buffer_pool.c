@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_buffer_pool.c
+ * @brief Shared Buffer Pool Implementation
+ *
+ * Each class tracks its blocks in a bitmap; a block is claimed or released
+ * with one compare-and-swap on its bitmap word.
+ */
+
+#include <string.h>
+
+#include "uds/uds_buffer_pool.h"
+#include "uds_atomic.h"
+
+#if UDS_CFG_FEATURE_BUFFER_POOL
+
+/* --- Internal Helpers --- */
+
+static uint8_t *class_borrow(uds_buffer_class_t *cls)
+{
+    for (uint16_t w = 0u; w < UDS_BUFFER_POOL_WORDS(cls->block_count); w++) {
+        uint32_t word = UDS_ATOMIC_LOAD_RELAXED(&cls->used[w]);
+
+        for (;;) {
+            uint32_t bits = 32u;
+            if (((uint32_t) w * 32u + 32u) > cls->block_count) {
+                bits = cls->block_count - ((uint32_t) w * 32u);
+            }
+            uint32_t valid = (bits == 32u) ? 0xFFFFFFFFu : ((1uL << bits) - 1u);
+            uint32_t free_bits = ~word & valid;
+            if (free_bits == 0u) {
+                break; /* Word full: next word */
+            }
+
+            uint32_t bit = 0u;
+            while ((free_bits & (1uL << bit)) == 0u) {
+                bit++;
+            }
+            if (UDS_ATOMIC_CAS(&cls->used[w], &word, word | (1uL << bit))) {
+                uint32_t index = (uint32_t) w * 32u + bit;
+                return &cls->storage[index * cls->block_size];
+            }
+            /* Lost the race: word now holds the current bitmap, retry */
+        }
+    }
+    return NULL;
+}
+
+/* --- Public API --- */
+
+void uds_buffer_pool_init(uds_buffer_pool_t *pool)
+{
+    if (pool != NULL) {
+        memset(pool, 0, sizeof(*pool));
+    }
+}
+
+int uds_buffer_pool_add_class(uds_buffer_pool_t *pool, uint8_t *storage, uint32_t *used,
+                              uint16_t block_size, uint16_t block_count)
+{
+    if ((pool == NULL) || (storage == NULL) || (used == NULL) || (block_size == 0u) ||
+        (block_count == 0u)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (pool->class_count >= UDS_BUFFER_POOL_MAX_CLASSES) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    /* Keep the classes sorted by block size */
+    uint8_t pos = pool->class_count;
+    while ((pos > 0u) && (pool->classes[pos - 1u].block_size > block_size)) {
+        pool->classes[pos] = pool->classes[pos - 1u];
+        pos--;
+    }
+
+    memset(used, 0, UDS_BUFFER_POOL_WORDS(block_count) * sizeof(uint32_t));
+    pool->classes[pos].storage = storage;
+    pool->classes[pos].used = used;
+    pool->classes[pos].block_size = block_size;
+    pool->classes[pos].block_count = block_count;
+    pool->class_count++;
+    return UDS_OK;
+}
+
+uint8_t *uds_buffer_pool_borrow(uds_buffer_pool_t *pool, uint16_t size, uint16_t *granted)
+{
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    for (uint8_t i = 0u; i < pool->class_count; i++) {
+        uds_buffer_class_t *cls = &pool->classes[i];
+        if (cls->block_size < size) {
+            continue;
+        }
+        uint8_t *block = class_borrow(cls);
+        if (block != NULL) {
+            (void) UDS_ATOMIC_FETCH_ADD(&pool->in_use, 1u);
+            if (granted != NULL) {
+                *granted = cls->block_size;
+            }
+            return block;
+        }
+    }
+
+    (void) UDS_ATOMIC_FETCH_ADD(&pool->exhausted, 1u);
+    return NULL;
+}
+
+void uds_buffer_pool_return(uds_buffer_pool_t *pool, uint8_t *block)
+{
+    if ((pool == NULL) || (block == NULL)) {
+        return;
+    }
+
+    for (uint8_t i = 0u; i < pool->class_count; i++) {
+        uds_buffer_class_t *cls = &pool->classes[i];
+        uint32_t span = (uint32_t) cls->block_count * cls->block_size;
+        if ((block < cls->storage) || (block >= &cls->storage[span])) {
+            continue;
+        }
+
+        uint32_t index = (uint32_t) (block - cls->storage) / cls->block_size;
+        uint32_t *word = &cls->used[index / 32u];
+        uint32_t mask = 1uL << (index % 32u);
+        uint32_t current = UDS_ATOMIC_LOAD_RELAXED(word);
+        while (!UDS_ATOMIC_CAS(word, &current, current & ~mask)) {
+            /* current was refreshed by the failed CAS */
+        }
+        (void) UDS_ATOMIC_FETCH_ADD(&pool->in_use, 0xFFFFFFFFu); /* -1 */
+        return;
+    }
+}
+
+#endif /* UDS_CFG_FEATURE_BUFFER_POOL */
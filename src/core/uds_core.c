@@ -10,51 +10,132 @@
 
 #include <string.h>
 
+#include "uds/uds_access.h"
+#include "uds/uds_buffer_pool.h"
 #include "uds/uds_core.h"
+#include "uds/uds_dtc.h"
+#include "uds/uds_mailbox.h"
+#include "uds/uds_nvm_journal.h"
+#include "uds/uds_transfer_pipe.h"
+#include "uds/uds_periodic.h"
+#include "uds/uds_roe.h"
 #include "uds_internal.h"
 
 /* --- Subfunction Masks --- */
+#if UDS_CFG_SERVICE_10
 static const uint8_t mask_sub_10[] = UDS_MASK_SUB_10;
+#endif
+#if UDS_CFG_SERVICE_11
 static const uint8_t mask_sub_11[] = UDS_MASK_SUB_11;
+#endif
+#if UDS_CFG_SERVICE_19
 static const uint8_t mask_sub_19[] = UDS_MASK_SUB_19;
+#endif
+#if UDS_CFG_SERVICE_27
 static const uint8_t mask_sub_27[] = UDS_MASK_SUB_27;
+#endif
+#if UDS_CFG_SERVICE_28
 static const uint8_t mask_sub_28[] = UDS_MASK_SUB_28;
+#endif
+#if UDS_CFG_SERVICE_31
 static const uint8_t mask_sub_31[] = UDS_MASK_SUB_31;
+#endif
+#if UDS_CFG_SERVICE_3E
 static const uint8_t mask_sub_3E[] = UDS_MASK_SUB_3E;
+#endif
+#if UDS_CFG_SERVICE_85
 static const uint8_t mask_sub_85[] = UDS_MASK_SUB_85;
+#endif
+#if UDS_CFG_SERVICE_2A
 static const uint8_t mask_sub_2A[] = UDS_MASK_SUB_2A;
-
+#endif
+#if UDS_CFG_SERVICE_2C
+static const uint8_t mask_sub_2C[] = UDS_MASK_SUB_2C;
+#endif
+#if UDS_CFG_SERVICE_86
+static const uint8_t mask_sub_86[] = UDS_MASK_SUB_86;
+#endif
+
+/* Entries are compiled out per service (uds_features.h); keep at least one enabled */
 static const uds_service_entry_t core_services[] = {
+#if UDS_CFG_SERVICE_10
     {UDS_SID_SESSION_CONTROL, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_session_control,
      mask_sub_10},
+#endif
+#if UDS_CFG_SERVICE_11
     {UDS_SID_ECU_RESET, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_ecu_reset, mask_sub_11},
+#endif
+#if UDS_CFG_SERVICE_14
     {UDS_SID_CLEAR_DTC, 4u, UDS_SESSION_ALL, 0u, uds_internal_handle_clear_dtc, NULL},
+#endif
+#if UDS_CFG_SERVICE_19
     {UDS_SID_READ_DTC_INFO, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_read_dtc_info,
      mask_sub_19},
+#endif
+#if UDS_CFG_SERVICE_22
     {UDS_SID_READ_DATA_BY_ID, 3u, UDS_SESSION_ALL, 0u, uds_internal_handle_read_data_by_id, NULL},
+#endif
+#if UDS_CFG_SERVICE_23
     {UDS_SID_READ_MEM_BY_ADDR, 3u, UDS_SESSION_ALL, 0u, uds_internal_handle_read_memory_by_addr,
      NULL},
+#endif
+#if UDS_CFG_SERVICE_27
     {UDS_SID_SECURITY_ACCESS, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_security_access,
      mask_sub_27},
+#endif
+#if UDS_CFG_SERVICE_28
     {UDS_SID_COMM_CONTROL, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_comm_control, mask_sub_28},
+#endif
+#if UDS_CFG_SERVICE_29
     {UDS_SID_AUTHENTICATION, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_authentication, NULL},
+#endif
+#if UDS_CFG_SERVICE_2C
+    {UDS_SID_DYN_DEFINE_DID, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_dynamic_define_did,
+     mask_sub_2C},
+#endif
+#if UDS_CFG_SERVICE_2E
     {UDS_SID_WRITE_DATA_BY_ID, 3u, UDS_SESSION_ALL, 0u, uds_internal_handle_write_data_by_id, NULL},
+#endif
+#if UDS_CFG_SERVICE_31
     {UDS_SID_ROUTINE_CONTROL, 4u, UDS_SESSION_ALL, 0u, uds_internal_handle_routine_control,
      mask_sub_31},
+#endif
+#if UDS_CFG_SERVICE_34
     {UDS_SID_REQUEST_DOWNLOAD, 4u, UDS_SESSION_ALL, 0u, uds_internal_handle_request_download, NULL},
+#endif
+#if UDS_CFG_SERVICE_36
     {UDS_SID_TRANSFER_DATA, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_transfer_data, NULL},
+#endif
+#if UDS_CFG_SERVICE_37
     {UDS_SID_TRANSFER_EXIT, 1u, UDS_SESSION_ALL, 0u, uds_internal_handle_request_transfer_exit,
      NULL},
+#endif
+#if UDS_CFG_SERVICE_3D
     {UDS_SID_WRITE_MEM_BY_ADDR, 3u, UDS_SESSION_ALL, 0u, uds_internal_handle_write_memory_by_addr,
      NULL},
+#endif
+#if UDS_CFG_SERVICE_3E
     {UDS_SID_TESTER_PRESENT, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_tester_present,
      mask_sub_3E},
+#endif
+#if UDS_CFG_SERVICE_85
     {UDS_SID_CONTROL_DTC_SETTING, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_control_dtc_setting,
      mask_sub_85},
+#endif
+#if UDS_CFG_SERVICE_86
+    {UDS_SID_RESPONSE_ON_EVENT, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_response_on_event,
+     mask_sub_86},
+#endif
+#if UDS_CFG_SERVICE_2A
     {UDS_SID_READ_BY_PER_ID, 2u, UDS_SESSION_ALL, 0u, uds_internal_handle_periodic_read,
      mask_sub_2A},
+#endif
+#if UDS_CFG_SERVICE_2F
     {UDS_SID_IO_CONTROL_BY_ID, 4u, UDS_SESSION_ALL, 0u, uds_internal_handle_io_control, NULL},
+#endif
+#if UDS_CFG_SERVICE_35
     {UDS_SID_REQUEST_UPLOAD, 4u, UDS_SESSION_ALL, 0u, uds_internal_handle_request_upload, NULL},
+#endif
 };
 
 #define CORE_SERVICE_COUNT (sizeof(core_services) / sizeof(core_services[0]))
@@ -70,6 +151,14 @@ void uds_internal_log(uds_ctx_t *ctx, uint8_t level, const char *msg)
     }
 }
 
+uint32_t uds_internal_now_us(uds_ctx_t *ctx)
+{
+    if (ctx->config->get_time_us != NULL) {
+        return ctx->config->get_time_us();
+    }
+    return ctx->config->get_time_ms() * 1000u;
+}
+
 const uds_did_entry_t *uds_internal_find_did(uds_ctx_t *ctx, uint16_t id)
 {
     if (!ctx || !ctx->config) {
@@ -112,6 +201,338 @@ bool uds_internal_parse_addr_len(const uint8_t *data, uint16_t len, uint8_t form
     return true;
 }
 
+/* --- Response Pending Helpers --- */
+
+static uint16_t rcrrp_margin(const uds_ctx_t *ctx)
+{
+    return (ctx->config->rcrrp_margin_ms > 0u) ? ctx->config->rcrrp_margin_ms
+                                               : (uint16_t) UDS_RCRRP_DEFAULT_MARGIN_MS;
+}
+
+/**
+ * @brief Time from the P2 timer start until the next NRC 0x78 is due.
+ */
+static uint32_t p2_limit(const uds_ctx_t *ctx, bool star_active)
+{
+    if (star_active) {
+        return ctx->p2_star_ms;
+    }
+    if ((ctx->config->rcrrp_policy != UDS_RCRRP_POLICY_IMMEDIATE) &&
+        (rcrrp_margin(ctx) < ctx->p2_ms)) {
+        /* First NRC 0x78 deferred: leave a margin for polling jitter and transmission */
+        return (uint32_t) ctx->p2_ms - rcrrp_margin(ctx);
+    }
+    return ctx->p2_ms;
+}
+
+#if UDS_CFG_FEATURE_RCRRP_ADAPTIVE
+static int latency_find(const uds_ctx_t *ctx, uint8_t sid)
+{
+    for (uint8_t i = 0u; i < UDS_LATENCY_TABLE_SIZE; i++) {
+        if (ctx->latency_sid[i] == sid) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief True if the handler of @p sid is known to need longer than the deferred P2 window.
+ */
+static bool latency_predicts_slow(const uds_ctx_t *ctx, uint8_t sid)
+{
+    int index = latency_find(ctx, sid);
+    return (index >= 0) && ((uint32_t) ctx->latency_ms[index] >= p2_limit(ctx, false));
+}
+
+/**
+ * @brief Learn the completion latency of the pending request (ADAPTIVE policy only).
+ */
+static void latency_learn(uds_ctx_t *ctx)
+{
+    if ((ctx->config->rcrrp_policy != UDS_RCRRP_POLICY_ADAPTIVE) || (ctx->pending_sid == 0u)) {
+        return;
+    }
+
+    uint32_t sample = ctx->config->get_time_ms() - ctx->pending_start_time;
+    if (sample > 0xFFFFu) {
+        sample = 0xFFFFu;
+    }
+
+    int index = latency_find(ctx, ctx->pending_sid);
+    if (index < 0) {
+        /* New SID: take the first sample as is, replacing entries round-robin */
+        index = (int) ctx->latency_next;
+        ctx->latency_next = (uint8_t) ((ctx->latency_next + 1u) % UDS_LATENCY_TABLE_SIZE);
+        ctx->latency_sid[index] = ctx->pending_sid;
+        ctx->latency_ms[index] = (uint16_t) sample;
+        return;
+    }
+
+    /* Exponential moving average, weight 1/4 */
+    int32_t avg = (int32_t) ctx->latency_ms[index];
+    avg += ((int32_t) sample - avg) / 4;
+    ctx->latency_ms[index] = (uint16_t) avg;
+}
+#endif /* UDS_CFG_FEATURE_RCRRP_ADAPTIVE */
+
+/**
+ * @brief Bookkeeping when the outstanding UDS_PENDING request gets its final response.
+ */
+static void pending_completed(uds_ctx_t *ctx)
+{
+#if !UDS_CFG_FEATURE_RCRRP_ADAPTIVE && !UDS_CFG_FEATURE_STATS
+    (void) ctx;
+#endif
+#if UDS_CFG_FEATURE_RCRRP_ADAPTIVE
+    latency_learn(ctx);
+#endif
+
+#if UDS_CFG_FEATURE_STATS
+    if (ctx->config->stats != NULL) {
+        uds_internal_stats_latency(ctx, ctx->pending_sid,
+                                   uds_internal_now_us(ctx) - ctx->stats_start_us);
+    }
+#endif
+}
+
+/* --- Multi-Tester Helpers --- */
+
+#if UDS_CFG_FEATURE_MULTI_TESTER || UDS_CFG_FEATURE_TIMER_WHEEL
+static void tester_capture(const uds_ctx_t *ctx, uds_tester_state_t *state)
+{
+    state->active_session = ctx->active_session;
+    state->security_level = ctx->security_level;
+    state->last_msg_time = ctx->last_msg_time;
+    state->p2_timer_start = ctx->p2_timer_start;
+    state->pending_start_time = ctx->pending_start_time;
+#if UDS_CFG_FEATURE_JOB
+    state->pending_job_id = ctx->pending_job_id;
+#endif
+#if UDS_CFG_FEATURE_STATS
+    state->stats_start_us = ctx->stats_start_us;
+#endif
+    state->p2_msg_pending = ctx->p2_msg_pending;
+    state->p2_star_active = ctx->p2_star_active;
+    state->pending_sid = ctx->pending_sid;
+    state->suppress_pos_resp = ctx->suppress_pos_resp;
+    state->rcrrp_count = ctx->rcrrp_count;
+#if UDS_CFG_FEATURE_SECURITY
+    state->security_delay_end = ctx->security_delay_end;
+    state->security_attempts = ctx->security_attempts;
+#endif
+}
+#endif
+
+#if UDS_CFG_FEATURE_MULTI_TESTER
+static void tester_load(uds_ctx_t *ctx, uds_tester_state_t *state)
+{
+    ctx->active_tester = state;
+    ctx->tester_addr = state->addr;
+    ctx->active_session = state->active_session;
+    ctx->security_level = state->security_level;
+    ctx->last_msg_time = state->last_msg_time;
+    ctx->p2_timer_start = state->p2_timer_start;
+    ctx->pending_start_time = state->pending_start_time;
+#if UDS_CFG_FEATURE_JOB
+    ctx->pending_job_id = state->pending_job_id;
+#endif
+#if UDS_CFG_FEATURE_STATS
+    ctx->stats_start_us = state->stats_start_us;
+#endif
+    ctx->p2_msg_pending = state->p2_msg_pending;
+    ctx->p2_star_active = state->p2_star_active;
+    ctx->pending_sid = state->pending_sid;
+    ctx->suppress_pos_resp = state->suppress_pos_resp;
+    ctx->rcrrp_count = state->rcrrp_count;
+#if UDS_CFG_FEATURE_SECURITY
+    ctx->security_delay_end = state->security_delay_end;
+    ctx->security_attempts = state->security_attempts;
+#endif
+}
+
+static void tester_save(uds_ctx_t *ctx)
+{
+    if (ctx->active_tester != NULL) {
+        tester_capture(ctx, ctx->active_tester);
+    }
+}
+
+static uds_tester_state_t *tester_find(const uds_ctx_t *ctx, uint16_t addr)
+{
+    for (uint8_t i = 0u; i < ctx->config->tester_state_count; i++) {
+        uds_tester_state_t *state = &ctx->config->tester_states[i];
+        if (state->in_use && (state->addr == addr)) {
+            return state;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the entry of a tester, or bind a free / idle entry to it.
+ *
+ * The loaded tester must have been saved beforehand.
+ */
+static uds_tester_state_t *tester_acquire(uds_ctx_t *ctx, uint16_t addr)
+{
+    uds_tester_state_t *state = tester_find(ctx, addr);
+    if (state != NULL) {
+        return state;
+    }
+
+    /* Free entry first, otherwise the least recently used idle tester */
+    for (uint8_t i = 0u; i < ctx->config->tester_state_count; i++) {
+        uds_tester_state_t *candidate = &ctx->config->tester_states[i];
+        if (!candidate->in_use) {
+            state = candidate;
+            break;
+        }
+        bool idle = (candidate->active_session == UDS_SESSION_ID_DEFAULT) &&
+                    !candidate->p2_msg_pending && (candidate->pending_sid == 0u);
+        if (idle && ((state == NULL) ||
+                     ((int32_t) (candidate->last_msg_time - state->last_msg_time) < 0))) {
+            state = candidate;
+        }
+    }
+
+    if (state != NULL) {
+        memset(state, 0, sizeof(uds_tester_state_t));
+        state->addr = addr;
+        state->in_use = true;
+        state->active_session = UDS_SESSION_ID_DEFAULT;
+    }
+    return state;
+}
+#endif /* UDS_CFG_FEATURE_MULTI_TESTER */
+
+/**
+ * @brief Load the state of the tester a request comes from.
+ * @return false if no entry is available (the request was rejected with NRC 0x21).
+ */
+static bool tester_select_for_input(uds_ctx_t *ctx, uint16_t addr, uint8_t sid)
+{
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    if (ctx->config->tester_states == NULL) {
+        ctx->tester_addr = addr;
+        return true;
+    }
+
+    tester_save(ctx);
+    uds_tester_state_t *state = tester_acquire(ctx, addr);
+    if (state == NULL) {
+        /* Every entry is busy: answer the new tester without touching the loaded state.
+         * Sent from the stack, since in pool mode no tx block may be borrowed. */
+        const uint8_t nrc[3] = {UDS_NRC_SERVICE_NOT_SUPP_IN_SESS, sid, UDS_NRC_BUSY_REPEAT_REQUEST};
+        uint16_t loaded_addr = ctx->tester_addr;
+        ctx->tester_addr = addr;
+        (void) ctx->config->fn_tp_send(ctx, nrc, sizeof(nrc));
+        ctx->tester_addr = loaded_addr;
+        uds_internal_log(ctx, UDS_LOG_INFO, "Multi-Tester: No free tester entry");
+        return false;
+    }
+
+    tester_load(ctx, state);
+    return true;
+#else
+    (void) sid;
+    ctx->tester_addr = addr;
+    return true;
+#endif
+}
+
+bool uds_internal_tester_select(uds_ctx_t *ctx, uint16_t addr)
+{
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    if (ctx->config->tester_states != NULL) {
+        uds_tester_state_t *state = tester_find(ctx, addr);
+        if (state == NULL) {
+            return false;
+        }
+        if (state != ctx->active_tester) {
+            tester_save(ctx);
+            tester_load(ctx, state);
+        }
+        return true;
+    }
+#endif
+    ctx->tester_addr = addr;
+    return true;
+}
+
+#if UDS_CFG_FEATURE_TIMER_WHEEL
+
+static void merge_deadline(bool *has_deadline, uint32_t *next, uint32_t deadline)
+{
+    if (!*has_deadline || (int32_t) (deadline - *next) < 0) {
+        *next = deadline;
+    }
+    *has_deadline = true;
+}
+
+static void merge_tester_deadline(const uds_ctx_t *ctx, const uds_tester_state_t *state,
+                                  bool *has_deadline, uint32_t *next)
+{
+    if (state->active_session != UDS_SESSION_ID_DEFAULT) {
+        merge_deadline(has_deadline, next, state->last_msg_time + UDS_S3_TIMEOUT_MS + 1u);
+    }
+
+    if (state->p2_msg_pending) {
+        merge_deadline(has_deadline, next,
+                       state->p2_timer_start + p2_limit(ctx, state->p2_star_active));
+    }
+}
+
+void uds_internal_timer_rearm(uds_ctx_t *ctx, uint32_t now)
+{
+    bool has_deadline = false;
+    uint32_t next = 0u;
+
+    /* Earliest of: S3 expiry, P2/P2* expiry (of every tester) and the next periodic transmission */
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    if (ctx->config->tester_states != NULL) {
+        tester_save(ctx);
+        for (uint8_t i = 0u; i < ctx->config->tester_state_count; i++) {
+            if (ctx->config->tester_states[i].in_use) {
+                merge_tester_deadline(ctx, &ctx->config->tester_states[i], &has_deadline, &next);
+            }
+        }
+    }
+    else
+#endif
+    {
+        uds_tester_state_t state;
+        tester_capture(ctx, &state);
+        merge_tester_deadline(ctx, &state, &has_deadline, &next);
+    }
+
+#if UDS_CFG_FEATURE_PERIODIC
+    uint32_t periodic_next;
+    if (uds_internal_periodic_next(ctx, &periodic_next)) {
+        merge_deadline(&has_deadline, &next, periodic_next);
+    }
+#endif
+
+#if UDS_CFG_SERVICE_86
+    uint32_t roe_next;
+    if (uds_internal_roe_next(ctx, now, &roe_next)) {
+        merge_deadline(&has_deadline, &next, roe_next);
+    }
+#endif
+
+    if (has_deadline) {
+        /* Never register a deadline in the past relative to the caller's clock */
+        if ((int32_t) (next - now) < 0) {
+            next = now;
+        }
+        uds_internal_timer_arm(ctx, next);
+    }
+    else {
+        uds_internal_timer_cancel(ctx);
+    }
+}
+#endif /* UDS_CFG_FEATURE_TIMER_WHEEL */
+
 static const uds_service_entry_t *find_service(uds_ctx_t *ctx, uint8_t sid)
 {
     /* 1. Check User Services first (Override capability) */
@@ -133,28 +554,8 @@ static const uds_service_entry_t *find_service(uds_ctx_t *ctx, uint8_t sid)
     return NULL;
 }
 
-static uint8_t get_session_bit(uint8_t session)
-{
-    switch (session) {
-        case UDS_SESSION_ID_DEFAULT:
-            return UDS_SESSION_DEFAULT;
-        case UDS_SESSION_ID_PROGRAMMING:
-            return UDS_SESSION_PROGRAMMING;
-        case UDS_SESSION_ID_EXTENDED:
-            return UDS_SESSION_EXTENDED;
-        default:
-            return (uint8_t) 0u;
-    }
-}
-
 /* --- Validation Helpers --- */
 
-static bool is_session_supported(const uds_ctx_t *ctx, const uds_service_entry_t *service)
-{
-    uint8_t sess_bit = get_session_bit(ctx->active_session);
-    return (service->session_mask & (uint16_t) sess_bit) != 0u;
-}
-
 static bool is_subfunction_supported(const uds_service_entry_t *service, uint8_t sub)
 {
     if (service->sub_mask == NULL) {
@@ -168,13 +569,47 @@ static bool is_subfunction_supported(const uds_service_entry_t *service, uint8_t
 static int execute_handler(uds_ctx_t *ctx, const uds_service_entry_t *service, const uint8_t *data,
                            uint16_t len)
 {
+#if UDS_CFG_FEATURE_STATS
+    bool timed = (ctx->config->stats != NULL);
+    uint32_t start_us = timed ? uds_internal_now_us(ctx) : 0u;
+#endif
+
     int res = service->handler(ctx, data, len);
+
+#if UDS_CFG_FEATURE_STATS
+    if (timed) {
+        uint32_t elapsed_us = uds_internal_now_us(ctx) - start_us;
+        uds_internal_stats_handler(ctx, data[0], elapsed_us);
+        if (res == UDS_PENDING) {
+            ctx->stats_start_us = start_us;
+        }
+        else {
+            uds_internal_stats_latency(ctx, data[0], elapsed_us);
+        }
+    }
+#endif
+
     if (res == UDS_PENDING) {
-        uds_send_nrc(ctx, data[0], UDS_NRC_RESPONSE_PENDING);
+        uint8_t policy = ctx->config->rcrrp_policy;
+        UDS_TRACE(ctx, UDS_LOG_DEBUG, UDS_TRACE_EV_PENDING, data[0], 0u);
         ctx->p2_msg_pending = true;
-        ctx->p2_star_active = true;
-        ctx->p2_timer_start = ctx->config->get_time_ms();
         ctx->pending_sid = data[0];
+        ctx->pending_start_time = ctx->p2_timer_start;
+
+        bool immediate = (policy == UDS_RCRRP_POLICY_IMMEDIATE);
+#if UDS_CFG_FEATURE_RCRRP_ADAPTIVE
+        immediate = immediate ||
+                    ((policy == UDS_RCRRP_POLICY_ADAPTIVE) && latency_predicts_slow(ctx, data[0]));
+#endif
+        if (immediate) {
+            uds_send_nrc(ctx, data[0], UDS_NRC_RESPONSE_PENDING);
+            ctx->p2_star_active = true;
+            ctx->p2_timer_start = ctx->config->get_time_ms();
+        }
+        else {
+            /* Deferred: uds_process() sends NRC 0x78 shortly before P2 expires */
+            ctx->p2_star_active = false;
+        }
     }
     return res;
 }
@@ -191,7 +626,8 @@ static void handle_request(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 
     /* ISO 14229-1 Priority: Session -> Subfunction -> Length -> Security -> Safety */
 
-    if (!is_session_supported(ctx, service)) {
+    int access = uds_internal_service_access(ctx, service);
+    if (access == UDS_ACCESS_DENIED_SESSION) {
         uds_send_nrc(
             ctx, sid,
             UDS_NRC_SERVICE_NOT_SUPP_IN_SESS); /* Service Not Supported In Active Session */
@@ -221,7 +657,7 @@ static void handle_request(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
         return;
     }
 
-    if (service->security_mask > ctx->security_level) {
+    if (access == UDS_ACCESS_DENIED_SECURITY) {
         uds_send_nrc(ctx, sid, UDS_NRC_SECURITY_ACCESS_DENIED); /* Security Access Denied */
         return;
     }
@@ -234,75 +670,22 @@ static void handle_request(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
     execute_handler(ctx, service, data, len);
 }
 
-/* --- Public API --- */
-
-// cppcheck-suppress unusedFunction
-int uds_init(uds_ctx_t *ctx, const uds_config_t *config)
+void uds_internal_execute_request(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
-    if (!ctx || !config) {
-        return UDS_ERR_INVALID_ARG;
-    }
-
-    /* Validate mandatory config members */
-    if (!config->get_time_ms || !config->fn_tp_send || !config->rx_buffer || !config->tx_buffer) {
-        return UDS_ERR_INVALID_ARG;
-    }
-
-    memset(ctx, 0, sizeof(uds_ctx_t));
-    ctx->config = config;
-    ctx->active_session = UDS_SESSION_ID_DEFAULT; /* Default Session */
-    ctx->security_level = 0u;                     /* Locked */
-    ctx->comm_state = 0x00u;                      /* Enable Rx/Tx */
+    /* No suppressPosRspMsgIndicationBit carried over from the last tester request */
     ctx->suppress_pos_resp = false;
-
-    ctx->rcrrp_count = 0u;
-
-    /* Enforce Timing Safety (ISO 14229-1 requires reasonable timeouts) */
-    ctx->p2_ms = (config->p2_ms > 0u) ? config->p2_ms : 50u;
-    ctx->p2_star_ms = (config->p2_star_ms > 0u) ? config->p2_star_ms : 5000u;
-
-    if (config->strict_compliance) {
-        if (ctx->p2_ms < UDS_P2_MIN_SAFE_MS) ctx->p2_ms = UDS_P2_MIN_SAFE_MS;
-        if (ctx->p2_star_ms < UDS_P2_STAR_MIN_SAFE_MS) ctx->p2_star_ms = UDS_P2_STAR_MIN_SAFE_MS;
-        uds_internal_log(ctx, UDS_LOG_INFO,
-                         "Strict Compliance: Enforcing minimum P2/P2* durations");
-    }
-
-    uds_internal_log(ctx, UDS_LOG_INFO, "UDS Stack Initialized");
-
-    /* NVM Persistence: Load State */
-    if (config->fn_nvm_load) {
-        uint8_t state[2] = {0};
-        if (config->fn_nvm_load(ctx, state, 2u) == 2) {
-            ctx->active_session = state[0];
-            ctx->security_level = state[1];
-            uds_internal_log(ctx, UDS_LOG_INFO, "NVM State Loaded");
-        }
-    }
-
-    return UDS_OK;
+    handle_request(ctx, data, len);
 }
 
-// cppcheck-suppress unusedFunction
-void uds_process(uds_ctx_t *ctx)
+/**
+ * @brief S3 session timeout and P2/P2* response deadlines of the loaded tester.
+ */
+static void process_session_timers(uds_ctx_t *ctx, uint32_t now)
 {
-    if (!ctx || !ctx->config) {
-        return;
-    }
-
-    if (ctx->config->fn_mutex_lock) {
-        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
-    }
-
-    if (ctx->p2_msg_pending) {
-        /* If we are waiting for the app to finish a routine, do nothing in tick */
-    }
-
-    uint32_t now = ctx->config->get_time_ms();
-
     /* S3 Timer: Revert to Default Session if no activity */
     if (ctx->active_session != UDS_SESSION_ID_DEFAULT) {
         if ((now - ctx->last_msg_time) > UDS_S3_TIMEOUT_MS) {
+            UDS_TRACE(ctx, UDS_LOG_INFO, UDS_TRACE_EV_S3_TIMEOUT, 0u, ctx->active_session);
             ctx->active_session = UDS_SESSION_ID_DEFAULT;
             ctx->security_level = 0u;
             uds_internal_log(ctx, UDS_LOG_INFO, "S3 Timeout: Reverted to Default Session");
@@ -312,128 +695,244 @@ void uds_process(uds_ctx_t *ctx)
     /* P2/P2* Timing: Manage Response Deadlines */
     if (ctx->p2_msg_pending) {
         uint32_t elapsed = now - ctx->p2_timer_start;
-        uint32_t limit = ctx->p2_star_active ? ctx->p2_star_ms : ctx->p2_ms;
+        uint32_t limit = p2_limit(ctx, ctx->p2_star_active);
 
         if (elapsed >= limit) {
             /* C-07: RCRRP Limit Check */
             if (ctx->config->rcrrp_limit > 0u && ctx->rcrrp_count >= ctx->config->rcrrp_limit) {
+                UDS_TRACE(ctx, UDS_LOG_ERROR, UDS_TRACE_EV_RCRRP_LIMIT, ctx->pending_sid, 0u);
                 uds_send_nrc(ctx, ctx->pending_sid, UDS_NRC_CONDITIONS_NOT_CORRECT);
                 ctx->rcrrp_count = 0u;
-                return;
+                /* No early return: uds_process() still unlocks the context and re-arms the
+                 * timer wheel after an abort (test_rcrrp_abort_releases_lock) */
             }
-
-            /* Send NRC 0x78 (Response Pending) */
-            uds_send_nrc(ctx, ctx->pending_sid, UDS_NRC_RESPONSE_PENDING);
-            ctx->rcrrp_count++;
-            ctx->p2_star_active = true;
-            ctx->p2_timer_start = now; /* Reset timer for P2* */
-        }
-    }
-
-    /* SID 0x2A: Periodic Data Transmission Scheduler */
-    if (ctx->periodic_count > 0u) {
-        for (uint8_t i = 0u; i < 8u; i++) {
-            if (ctx->periodic_ids[i] != 0u) {
-                if (now >= ctx->periodic_timers[i]) {
-                    uint8_t out_buf[UDS_MAX_PERIODIC_MSG_LEN];
-                    int written = ctx->config->fn_periodic_read(ctx, ctx->periodic_ids[i], out_buf,
-                                                                UDS_MAX_PERIODIC_MSG_LEN);
-                    if (written > 0) {
-                        /* Send periodic message as a raw CAN/ISO-TP response if needed,
-                           or via a specialized periodic tx hook. For now, use fn_tp_send. */
-                        ctx->config->tx_buffer[0] = ctx->periodic_ids[i];
-                        memcpy(&ctx->config->tx_buffer[1], out_buf, written);
-                        ctx->config->fn_tp_send(ctx, ctx->config->tx_buffer, written + 1);
-                    }
-
-                    /* Reset timer based on rate: Fast (100ms), Medium (500ms), Slow (2000ms) */
-                    uint32_t interval = UDS_PERIODIC_SLOW_INTERVAL_MS;
-                    if (ctx->periodic_rates[i] == UDS_PERIODIC_RATE_FAST) {
-                        interval = UDS_PERIODIC_FAST_INTERVAL_MS;
-                    }
-                    else if (ctx->periodic_rates[i] == UDS_PERIODIC_RATE_MEDIUM) {
-                        interval = UDS_PERIODIC_MEDIUM_INTERVAL_MS;
-                    }
-
-                    ctx->periodic_timers[i] = now + interval;
-                }
+            else {
+                /* Send NRC 0x78 (Response Pending) */
+                uds_send_nrc(ctx, ctx->pending_sid, UDS_NRC_RESPONSE_PENDING);
+                ctx->rcrrp_count++;
+                ctx->p2_star_active = true;
+                ctx->p2_timer_start = now; /* Reset timer for P2* */
             }
         }
     }
-
-    if (ctx->config->fn_mutex_unlock) {
-        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
-    }
 }
 
-// cppcheck-suppress unusedFunction
-int uds_client_request(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data, uint16_t len,
-                       uds_response_cb callback)
+/* --- Request Queue Helpers --- */
+
+#if UDS_CFG_FEATURE_QUEUE
+static bool queue_enabled(const uds_ctx_t *ctx)
 {
-    if (!ctx || !ctx->config || !ctx->config->tx_buffer) {
-        return UDS_ERR_NOT_INIT;
-    }
+    return (ctx->config->queue_policy != UDS_QUEUE_POLICY_REJECT) &&
+           (ctx->config->queue_buffer != NULL) && (ctx->config->queue_depth > 0u);
+}
 
-    if (len > 0 && !data) {
-        return UDS_ERR_INVALID_ARG;
-    }
+static uint8_t *queue_slot(const uds_ctx_t *ctx, uint16_t index)
+{
+    uint32_t stride = (uint32_t) ctx->config->queue_slot_size + UDS_QUEUE_SLOT_HEADER;
+    return &ctx->config->queue_buffer[(uint32_t) (index % ctx->config->queue_depth) * stride];
+}
 
-    if (len + 1u > ctx->config->tx_buffer_size) {
-        return UDS_ERR_BUFFER_TOO_SMALL;
-    }
+static uint16_t queue_slot_len(const uint8_t *slot)
+{
+    return (uint16_t) ((uint16_t) slot[0] | (uint16_t) ((uint16_t) slot[1] << 8u));
+}
 
-    if (ctx->config->fn_mutex_lock != NULL) {
-        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
-    }
+static uint16_t queue_slot_addr(const uint8_t *slot)
+{
+    return (uint16_t) ((uint16_t) slot[2] | (uint16_t) ((uint16_t) slot[3] << 8u));
+}
 
-    ctx->pending_sid = sid;
-    ctx->client_cb = (void *) callback;
+static void queue_store(uint8_t *slot, uint16_t addr, const uint8_t *data, uint16_t len)
+{
+    slot[0] = (uint8_t) (len & 0xFFu);
+    slot[1] = (uint8_t) (len >> 8u);
+    slot[2] = (uint8_t) (addr & 0xFFu);
+    slot[3] = (uint8_t) (addr >> 8u);
+    memcpy(&slot[UDS_QUEUE_SLOT_HEADER], data, len);
+}
 
-    ctx->config->tx_buffer[0] = sid;
-    if (data && len > 0u) {
-        memcpy(&ctx->config->tx_buffer[1], data, len);
+/* Exchange two queued requests (header and payload) */
+static void queue_swap(const uds_ctx_t *ctx, uint16_t a, uint16_t b)
+{
+    uint8_t *slot_a = queue_slot(ctx, a);
+    uint8_t *slot_b = queue_slot(ctx, b);
+    uint16_t len_a = queue_slot_len(slot_a);
+    uint16_t len_b = queue_slot_len(slot_b);
+    uint32_t n = UDS_QUEUE_SLOT_HEADER + (uint32_t) ((len_a > len_b) ? len_a : len_b);
+
+    for (uint32_t i = 0u; i < n; i++) {
+        uint8_t tmp = slot_a[i];
+        slot_a[i] = slot_b[i];
+        slot_b[i] = tmp;
     }
+}
 
-    int result = ctx->config->fn_tp_send(ctx, ctx->config->tx_buffer, (uint16_t) (len + 1u));
-
-    if (ctx->config->fn_mutex_unlock != NULL) {
-        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+static bool queue_holds_tester(const uds_ctx_t *ctx, uint16_t addr)
+{
+    for (uint16_t i = 0u; i < ctx->queue_count; i++) {
+        if (queue_slot_addr(queue_slot(ctx, (uint16_t) (ctx->queue_head + i))) == addr) {
+            return true;
+        }
     }
-
-    return result;
+    return false;
 }
 
-void uds_input_sdu(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+/**
+ * @brief Queue a request of the loaded tester according to the queue policy.
+ * @return true if the request was queued, false if it must be rejected with NRC 0x21.
+ */
+static bool queue_push(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
-    if (!ctx || !ctx->config) {
-        return;
+    if (!queue_enabled(ctx) || (len > ctx->config->queue_slot_size)) {
+        return false;
     }
 
-    if (ctx->config->fn_mutex_lock != NULL) {
-        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    if (ctx->config->queue_policy == UDS_QUEUE_POLICY_REPLACE_SAME_SID) {
+        for (uint16_t i = 0u; i < ctx->queue_count; i++) {
+            uint8_t *slot = queue_slot(ctx, (uint16_t) (ctx->queue_head + i));
+            if ((queue_slot_addr(slot) == ctx->tester_addr) &&
+                (slot[UDS_QUEUE_SLOT_HEADER] == data[0])) {
+                /* The newer request supersedes the queued one */
+                queue_store(slot, ctx->tester_addr, data, len);
+                return true;
+            }
+        }
     }
 
-    if (!data || len == 0u) {
-        if (ctx->config->fn_mutex_unlock != NULL)
-            ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    if (ctx->queue_count >= ctx->config->queue_depth) {
+        return false;
+    }
+
+    queue_store(queue_slot(ctx, (uint16_t) (ctx->queue_head + ctx->queue_count)), ctx->tester_addr,
+                data, len);
+    ctx->queue_count++;
+    return true;
+}
+
+static bool tester_is_busy(uds_ctx_t *ctx, uint16_t addr)
+{
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    if (ctx->config->tester_states != NULL) {
+        tester_save(ctx);
+        const uds_tester_state_t *state = tester_find(ctx, addr);
+        return (state != NULL) && state->p2_msg_pending;
+    }
+#else
+    (void) addr;
+#endif
+    return ctx->p2_msg_pending;
+}
+#endif /* UDS_CFG_FEATURE_QUEUE */
+
+/* --- Buffer Pool --- */
+
+#if UDS_CFG_FEATURE_BUFFER_POOL
+bool uds_internal_tx_acquire(uds_ctx_t *ctx)
+{
+    if ((ctx->config->buffer_pool == NULL) || (ctx->tx_lease != NULL)) {
+        return true;
+    }
+    ctx->tx_lease =
+        uds_buffer_pool_borrow(ctx->config->buffer_pool, ctx->config->tx_buffer_size, NULL);
+    ctx->tx_lease_size = (ctx->tx_lease != NULL) ? ctx->config->tx_buffer_size : 0u;
+    return ctx->tx_lease != NULL;
+}
+
+void uds_internal_tx_release(uds_ctx_t *ctx)
+{
+    if (ctx->tx_lease == NULL) {
+        return;
+    }
+
+    /* An outstanding request of any tester still answers from this buffer */
+    if (ctx->p2_msg_pending) {
+        return;
+    }
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    for (uint8_t i = 0u; i < ctx->config->tester_state_count; i++) {
+        const uds_tester_state_t *state = &ctx->config->tester_states[i];
+        if ((state != ctx->active_tester) && state->in_use && state->p2_msg_pending) {
+            return;
+        }
+    }
+#endif
+
+    uds_buffer_pool_return(ctx->config->buffer_pool, ctx->tx_lease);
+    ctx->tx_lease = NULL;
+    ctx->tx_lease_size = 0u;
+}
+#endif /* UDS_CFG_FEATURE_BUFFER_POOL */
+
+/* --- Request Dispatch --- */
+
+/**
+ * @brief Start P2 timing and dispatch a request of the loaded tester.
+ */
+static void dispatch_request(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    if (!uds_internal_tx_acquire(ctx)) {
+        /* Pool exhausted: the NRC is sent from the stack, the tester repeats later */
+        uds_send_nrc(ctx, data[0], UDS_NRC_BUSY_REPEAT_REQUEST);
+        return;
+    }
+
+    ctx->p2_timer_start = ctx->config->get_time_ms();
+    ctx->p2_msg_pending = false;
+    ctx->p2_star_active = false;
+    ctx->rcrrp_count = 0u;
+
+    handle_request(ctx, data, len);
+}
+
+/**
+ * @brief Client Mode: remember maxNumberOfBlockLength of a positive 0x34 response.
+ */
+static void client_note_block_length(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    ctx->client_block_length = 0u;
+    if (len < 2u) {
         return;
     }
 
+    uint8_t n = (uint8_t) (data[1] >> 4u); /* lengthFormatIdentifier */
+    if ((n == 0u) || (n > 4u) || (len < (uint16_t) (2u + n))) {
+        return; /* Not representable: no limit */
+    }
+    uint32_t value = 0u;
+    for (uint8_t i = 0u; i < n; i++) {
+        value = (value << 8u) | data[2u + i];
+    }
+    ctx->client_block_length = value;
+}
+
+/**
+ * @brief Dispatch one request with the mutex held and the sender's state loaded.
+ */
+static void input_sdu_locked(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
     uint8_t sid = data[0];
     ctx->last_msg_time = ctx->config->get_time_ms();
-
-    /* 1. Concurrent Request Check (Busy) */
-    if (ctx->p2_msg_pending) {
+    uds_internal_stats_request(ctx, sid);
+    UDS_TRACE(ctx, UDS_LOG_INFO, UDS_TRACE_EV_REQUEST, sid, len);
+
+    /* 1. Concurrent Request Check (Busy, or older requests of this tester still queued) */
+    bool busy = ctx->p2_msg_pending;
+#if UDS_CFG_FEATURE_QUEUE
+    busy = busy || ((ctx->queue_count > 0u) && queue_holds_tester(ctx, ctx->tester_addr));
+#endif
+    if (busy) {
         if (sid == UDS_SID_TESTER_PRESENT && len >= 2u && (data[1] & 0x80u)) {
             /* Suppressed TesterPresent: Just update S3, don't interrupt */
-            if (ctx->config->fn_mutex_unlock != NULL) {
-                ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
-            }
             return;
         }
-        uds_send_nrc(ctx, sid, UDS_NRC_BUSY_REPEAT_REQUEST); /* Busy Repeat Request */
-        if (ctx->config->fn_mutex_unlock != NULL) {
-            ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+#if UDS_CFG_FEATURE_QUEUE
+        bool queued = queue_push(ctx, data, len);
+#else
+        bool queued = false;
+#endif
+        UDS_TRACE(ctx, UDS_LOG_INFO, UDS_TRACE_EV_BUSY, sid, queued ? 1u : 0u);
+        if (!queued) {
+            uds_send_nrc(ctx, sid, UDS_NRC_BUSY_REPEAT_REQUEST); /* Busy Repeat Request */
         }
         return;
     }
@@ -444,74 +943,601 @@ void uds_input_sdu(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
         bool is_neg =
             (sid == UDS_NRC_SERVICE_NOT_SUPP_IN_SESS && len >= 2u && data[1] == ctx->pending_sid);
         if (is_pos || is_neg) {
+            if (is_pos && (sid == (uint8_t) (UDS_SID_REQUEST_DOWNLOAD + UDS_RESPONSE_OFFSET))) {
+                client_note_block_length(ctx, data, len);
+            }
             if (ctx->client_cb != NULL) {
                 uds_response_cb cb = (uds_response_cb) ctx->client_cb;
                 cb(ctx, sid, &data[1], (uint16_t) (len - 1u));
                 ctx->client_cb = NULL;
             }
             ctx->pending_sid = 0u;
-            if (ctx->config->fn_mutex_unlock != NULL) {
-                ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
-            }
             return;
         }
     }
 
     /* 3. Start Timing & Dispatch */
-    ctx->p2_timer_start = ctx->config->get_time_ms();
-    ctx->p2_msg_pending = false;
-    ctx->p2_star_active = false;
+    dispatch_request(ctx, data, len);
+}
+
+#if UDS_CFG_FEATURE_QUEUE
+/**
+ * @brief Dispatch queued requests whose tester is no longer busy (arrival order).
+ *
+ * Requests of a busy tester stay queued without holding back the other
+ * testers: each idle tester gets its oldest request dispatched.
+ */
+void uds_internal_queue_drain(uds_ctx_t *ctx)
+{
+    if (ctx->queue_count == 0u) {
+        return;
+    }
+
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    uds_tester_state_t *loaded = ctx->active_tester;
+#endif
+
+    /* Entries before 'skip' belong to busy testers */
+    uint16_t skip = 0u;
+    while (skip < ctx->queue_count) {
+        uint16_t addr = queue_slot_addr(queue_slot(ctx, (uint16_t) (ctx->queue_head + skip)));
+
+        if (tester_is_busy(ctx, addr)) {
+            skip++;
+            continue;
+        }
+
+        /* Move it to the head; the skipped requests keep their order behind it */
+        for (uint16_t i = skip; i > 0u; i--) {
+            uint16_t index = (uint16_t) (ctx->queue_head + i);
+            queue_swap(ctx, index, (uint16_t) (index - 1u));
+        }
+        const uint8_t *slot = queue_slot(ctx, ctx->queue_head);
+
+        /* Pop before dispatching; the slot is not reused while the mutex is held */
+        ctx->queue_head = (uint8_t) ((ctx->queue_head + 1u) % ctx->config->queue_depth);
+        ctx->queue_count--;
+
+        const uint8_t *data = &slot[UDS_QUEUE_SLOT_HEADER];
+        if (tester_select_for_input(ctx, addr, data[0])) {
+            ctx->last_msg_time = ctx->config->get_time_ms();
+            dispatch_request(ctx, data, queue_slot_len(slot));
+        }
+    }
+
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    if ((loaded != NULL) && (loaded != ctx->active_tester)) {
+        tester_save(ctx);
+        tester_load(ctx, loaded);
+    }
+#endif
+}
+#endif /* UDS_CFG_FEATURE_QUEUE */
+
+/* --- Public API --- */
+
+// cppcheck-suppress unusedFunction
+int uds_init(uds_ctx_t *ctx, const uds_config_t *config)
+{
+    if (!ctx || !config) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    /* Validate mandatory config members */
+    if (!config->get_time_ms || !config->fn_tp_send) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    bool pooled = false;
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    pooled = (config->buffer_pool != NULL);
+#endif
+    if (pooled) {
+        /* Buffers are borrowed per transfer; the sizes still set the limits */
+        if ((config->rx_buffer_size == 0u) || (config->tx_buffer_size == 0u)) {
+            return UDS_ERR_INVALID_ARG;
+        }
+    }
+    else if (!config->rx_buffer || !config->tx_buffer) {
+        return UDS_ERR_INVALID_ARG;
+    }
+#if UDS_CFG_FEATURE_PERIODIC
+    if (config->periodic != NULL) {
+        const uds_periodic_t *sched = config->periodic;
+        if ((sched->entries == NULL) || (sched->capacity == 0u) ||
+            (sched->capacity > UDS_PERIODIC_MAX_CAPACITY)) {
+            return UDS_ERR_INVALID_ARG;
+        }
+        if ((sched->frames != NULL) && ((sched->frame_size < 2u) || (sched->frame_count == 0u))) {
+            return UDS_ERR_INVALID_ARG;
+        }
+    }
+#endif
+#if UDS_CFG_FEATURE_DTC
+    if (config->dtc_store != NULL) {
+        const uds_dtc_store_t *store = config->dtc_store;
+        if ((store->codes == NULL) || (store->status == NULL) || (store->bits == NULL) ||
+            (store->words < UDS_DTC_WORDS(store->capacity))) {
+            return UDS_ERR_INVALID_ARG;
+        }
+        const uds_dtc_records_t *rec = store->records;
+        if ((rec != NULL) && ((rec->pool == NULL) || (rec->dids == NULL) ||
+                              (rec->did_count == 0u) || (rec->max_per_dtc == 0u))) {
+            return UDS_ERR_INVALID_ARG;
+        }
+        if ((store->journal != NULL) && (store->journal->flash == NULL)) {
+            return UDS_ERR_INVALID_ARG;
+        }
+    }
+#endif
+#if UDS_CFG_FEATURE_JOB
+    bool owned = false;
+#if UDS_CFG_FEATURE_MAILBOX
+    owned = (config->mailbox != NULL);
+#endif
+    if ((config->fn_job_submit != NULL) && !owned &&
+        ((config->fn_mutex_lock == NULL) || (config->fn_mutex_unlock == NULL))) {
+        /* Executor threads complete jobs: they must serialize with the dispatcher */
+        return UDS_ERR_INVALID_ARG;
+    }
+#endif
+#if UDS_CFG_FEATURE_FLASH
+    if (config->transfer_pipe != NULL) {
+        const uds_transfer_pipe_t *pipe = config->transfer_pipe;
+        if ((pipe->slots == NULL) || (pipe->slot_size == 0u) || (pipe->slot_count == 0u) ||
+            (pipe->slot_count > UDS_TRANSFER_PIPE_MAX_SLOTS)) {
+            return UDS_ERR_INVALID_ARG;
+        }
+    }
+#endif
+
+    memset(ctx, 0, sizeof(uds_ctx_t));
+    ctx->config = config;
+    ctx->active_session = UDS_SESSION_ID_DEFAULT; /* Default Session */
+    ctx->security_level = 0u;                     /* Locked */
+    ctx->comm_state = 0x00u;                      /* Enable Rx/Tx */
+    ctx->suppress_pos_resp = false;
+
     ctx->rcrrp_count = 0u;
 
-    handle_request(ctx, data, len);
+    /* Enforce Timing Safety (ISO 14229-1 requires reasonable timeouts) */
+    ctx->p2_ms = (config->p2_ms > 0u) ? config->p2_ms : 50u;
+    ctx->p2_star_ms = (config->p2_star_ms > 0u) ? config->p2_star_ms : 5000u;
+
+    if (config->strict_compliance) {
+        if (ctx->p2_ms < UDS_P2_MIN_SAFE_MS) ctx->p2_ms = UDS_P2_MIN_SAFE_MS;
+        if (ctx->p2_star_ms < UDS_P2_STAR_MIN_SAFE_MS) ctx->p2_star_ms = UDS_P2_STAR_MIN_SAFE_MS;
+        uds_internal_log(ctx, UDS_LOG_INFO,
+                         "Strict Compliance: Enforcing minimum P2/P2* durations");
+    }
+
+#if UDS_CFG_FEATURE_ACCESS_MATRIX
+    int res = uds_access_compile(ctx);
+    if (res != UDS_OK) {
+        return res;
+    }
+#endif
+
+    uds_internal_log(ctx, UDS_LOG_INFO, "UDS Stack Initialized");
+
+    /* NVM Persistence: Load State */
+    if (config->fn_nvm_load) {
+        uint8_t state[2] = {0};
+        if (config->fn_nvm_load(ctx, state, 2u) == 2) {
+            ctx->active_session = state[0];
+            ctx->security_level = state[1];
+            uds_internal_log(ctx, UDS_LOG_INFO, "NVM State Loaded");
+        }
+    }
+
+    return UDS_OK;
+}
+
+// cppcheck-suppress unusedFunction
+void uds_process(uds_ctx_t *ctx)
+{
+    if (!ctx || !ctx->config) {
+        return;
+    }
+
+    if (ctx->config->fn_mutex_lock) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    if (ctx->p2_msg_pending) {
+        /* If we are waiting for the app to finish a routine, do nothing in tick */
+    }
+
+#if UDS_CFG_FEATURE_MAILBOX
+    if (ctx->config->mailbox != NULL) {
+        /* Single-owner mode: run the calls other threads posted, in order */
+        uds_internal_mailbox_drain(ctx);
+    }
+#endif
+
+    uint32_t now = ctx->config->get_time_ms();
+
+    /* S3 / P2 timing, once per connected tester */
+#if UDS_CFG_FEATURE_MULTI_TESTER
+    if (ctx->config->tester_states != NULL) {
+        uds_tester_state_t *loaded = ctx->active_tester;
+        tester_save(ctx);
+        for (uint8_t i = 0u; i < ctx->config->tester_state_count; i++) {
+            if (ctx->config->tester_states[i].in_use) {
+                tester_load(ctx, &ctx->config->tester_states[i]);
+                process_session_timers(ctx, now);
+                tester_save(ctx);
+            }
+        }
+        if (loaded != NULL) {
+            tester_load(ctx, loaded);
+        }
+    }
+    else
+#endif
+    {
+        process_session_timers(ctx, now);
+    }
+
+    /* Requests queued while their tester was busy */
+    uds_internal_queue_drain(ctx);
+
+#if UDS_CFG_FEATURE_PERIODIC
+    /* SID 0x2A: Periodic Data Transmission Scheduler */
+    uds_internal_periodic_process(ctx, now);
+#endif
+
+#if UDS_CFG_SERVICE_86
+    /* SID 0x86: events that occurred since the last call */
+    uds_internal_roe_process(ctx, now);
+#endif
+
+#if UDS_CFG_FEATURE_DTC
+    /* DTC journal: move to the other sector before the active one fills up */
+    uds_internal_nvm_journal_process(ctx);
+#endif
+
+#if UDS_CFG_FEATURE_FLASH
+    /* SID 0x36: write a staged block the executor did not take yet */
+    uds_internal_pipe_process(ctx);
+#endif
+
+#if UDS_CFG_FEATURE_TIMER_WHEEL
+    if (ctx->timer_wheel != NULL) {
+        uds_internal_timer_rearm(ctx, now);
+    }
+#endif
+
+    /* Completed asynchronous requests are done with the buffer */
+    uds_internal_tx_release(ctx);
+
+    if (ctx->config->fn_mutex_unlock) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+}
+
+int uds_internal_client_request_owned(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data,
+                                      uint16_t len, uds_response_cb callback)
+{
+    if (sid == UDS_SID_REQUEST_DOWNLOAD) {
+        ctx->client_block_length = 0u; /* Granted again by the response */
+    }
+    else if ((sid == UDS_SID_TRANSFER_DATA) && (ctx->client_block_length != 0u) &&
+             ((uint32_t) len + 1u > ctx->client_block_length)) {
+        return UDS_ERR_BUFFER_TOO_SMALL; /* Larger than the server accepts */
+    }
+
+    if (!uds_internal_tx_acquire(ctx)) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    ctx->pending_sid = sid;
+    ctx->client_cb = (void *) callback;
+
+    uds_tx_buffer(ctx)[0] = sid;
+    if (data && len > 0u) {
+        memcpy(&uds_tx_buffer(ctx)[1], data, len);
+    }
+
+    int result = ctx->config->fn_tp_send(ctx, uds_tx_buffer(ctx), (uint16_t) (len + 1u));
+    uds_internal_tx_release(ctx);
+    return result;
+}
+
+#if UDS_CFG_FEATURE_MAILBOX
+/**
+ * @brief Post a client request to the mailbox as [SID][data...].
+ */
+static int post_client_request(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data, uint16_t len,
+                               uds_response_cb callback)
+{
+    uds_iovec_t iov[2] = {{&sid, 1u}, {data, len}};
+    return uds_mailbox_postv(ctx->config->mailbox, UDS_MAIL_CLIENT_REQUEST, 0u, iov,
+                             (len > 0u) ? 2u : 1u, (void *) callback, 0);
+}
+#endif
+
+// cppcheck-suppress unusedFunction
+uint32_t uds_client_block_length(const uds_ctx_t *ctx)
+{
+    return (ctx != NULL) ? ctx->client_block_length : 0u;
+}
+
+// cppcheck-suppress unusedFunction
+int uds_client_request(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data, uint16_t len,
+                       uds_response_cb callback)
+{
+    if (!ctx || !ctx->config) {
+        return UDS_ERR_NOT_INIT;
+    }
+    bool pooled = false;
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    pooled = (ctx->config->buffer_pool != NULL);
+#endif
+    if (!ctx->config->tx_buffer && !pooled) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    if (len > 0 && !data) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    if (len + 1u > ctx->config->tx_buffer_size) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+#if UDS_CFG_FEATURE_MAILBOX
+    if (ctx->config->mailbox != NULL) {
+        /* Single-owner mode: the owner sends it from uds_process() */
+        return post_client_request(ctx, sid, data, len, callback);
+    }
+#endif
+
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    int result = uds_internal_client_request_owned(ctx, sid, data, len, callback);
 
     if (ctx->config->fn_mutex_unlock != NULL) {
         ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
     }
+
+    return result;
 }
 
-int uds_send_response(uds_ctx_t *ctx, uint16_t len)
+void uds_internal_input_sdu_owned(uds_ctx_t *ctx, const uint16_t *tester_addr, const uint8_t *data,
+                                  uint16_t len)
+{
+    /* Older queued requests go first */
+    uds_internal_queue_drain(ctx);
+
+    uint16_t addr = (tester_addr != NULL) ? *tester_addr : ctx->tester_addr;
+
+    if (data && (len > 0u) && tester_select_for_input(ctx, addr, data[0])) {
+        input_sdu_locked(ctx, data, len);
+
+#if UDS_CFG_FEATURE_TIMER_WHEEL
+        if (ctx->timer_wheel != NULL) {
+            uds_internal_timer_rearm(ctx, ctx->last_msg_time);
+        }
+#endif
+    }
+
+    uds_internal_tx_release(ctx);
+}
+
+/**
+ * @brief Common entry of uds_input_sdu() / uds_input_sdu_from().
+ * @param tester_addr Source address, or NULL for the tester served last.
+ */
+static void input_sdu(uds_ctx_t *ctx, const uint16_t *tester_addr, const uint8_t *data,
+                      uint16_t len)
 {
-    if (!ctx || !ctx->config || !ctx->config->tx_buffer) {
+    if (!ctx || !ctx->config) {
+        return;
+    }
+
+#if UDS_CFG_FEATURE_MAILBOX
+    if (ctx->config->mailbox != NULL) {
+        /* Single-owner mode: copied now, dispatched by the owner's uds_process() */
+        if ((data != NULL) && (len > 0u)) {
+            (void) uds_mailbox_post(ctx->config->mailbox,
+                                    (tester_addr != NULL) ? UDS_MAIL_SDU_FROM : UDS_MAIL_SDU,
+                                    (tester_addr != NULL) ? *tester_addr : 0u, data, len, NULL, 0);
+        }
+        return;
+    }
+#endif
+
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    uds_internal_input_sdu_owned(ctx, tester_addr, data, len);
+
+    if (ctx->config->fn_mutex_unlock != NULL) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+}
+
+void uds_input_sdu(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    input_sdu(ctx, NULL, data, len);
+}
+
+// cppcheck-suppress unusedFunction
+void uds_input_sdu_from(uds_ctx_t *ctx, uint16_t tester_addr, const uint8_t *data, uint16_t len)
+{
+    input_sdu(ctx, &tester_addr, data, len);
+}
+
+// cppcheck-suppress unusedFunction
+int uds_select_tester(uds_ctx_t *ctx, uint16_t tester_addr)
+{
+    if (!ctx || !ctx->config) {
         return UDS_ERR_NOT_INIT;
     }
 
-    if (len > ctx->config->tx_buffer_size) {
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    int result = uds_internal_tester_select(ctx, tester_addr) ? UDS_OK : UDS_ERR_INVALID_ARG;
+
+    if (ctx->config->fn_mutex_unlock != NULL) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Complete the pending request of a tester (context lock held).
+ */
+static int complete_for_tester_owned(uds_ctx_t *ctx, uint16_t tester_addr,
+                                     const uint8_t *response, uint16_t len)
+{
+    if (!uds_internal_tester_select(ctx, tester_addr) || !ctx->p2_msg_pending) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    int result;
+    if ((len == 3u) && (response[0] == UDS_NRC_SERVICE_NOT_SUPP_IN_SESS)) {
+        result = uds_send_nrc(ctx, response[1], response[2]);
+    }
+    else if (!uds_internal_tx_acquire(ctx)) {
         return UDS_ERR_BUFFER_TOO_SMALL;
     }
+    else if (len > uds_tx_buffer_size(ctx)) {
+        result = UDS_ERR_BUFFER_TOO_SMALL;
+    }
+    else {
+        memcpy(uds_tx_buffer(ctx), response, len);
+        result = uds_send_response(ctx, len);
+    }
+
+    uds_internal_queue_drain(ctx);
+    uds_internal_tx_release(ctx);
+    return result;
+}
+
+// cppcheck-suppress unusedFunction
+int uds_complete_for_tester(uds_ctx_t *ctx, uint16_t tester_addr, const uint8_t *response,
+                            uint16_t len)
+{
+    if (!ctx || !ctx->config) {
+        return UDS_ERR_NOT_INIT;
+    }
+    if ((response == NULL) || (len == 0u)) {
+        return UDS_ERR_INVALID_ARG;
+    }
 
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    int result = complete_for_tester_owned(ctx, tester_addr, response, len);
+
+    if (ctx->config->fn_mutex_unlock != NULL) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+
+    return result;
+}
+
+bool uds_internal_response_prepare(uds_ctx_t *ctx, uint16_t len)
+{
+    if (ctx->p2_msg_pending) {
+        pending_completed(ctx);
+    }
     ctx->p2_msg_pending = false;
 
+#if UDS_CFG_FEATURE_QUEUE && UDS_CFG_FEATURE_TIMER_WHEEL
+    if ((ctx->queue_count > 0u) && (ctx->timer_wheel != NULL)) {
+        /* Let the wheel dispatch the queued requests on its next run */
+        uds_internal_timer_kick(ctx);
+    }
+#endif
+
+    if ((len > 0u) && (uds_tx_buffer(ctx)[0] >= UDS_RESPONSE_OFFSET)) {
+        uds_internal_stats_response(ctx, (uint8_t) (uds_tx_buffer(ctx)[0] - UDS_RESPONSE_OFFSET),
+                                    0u);
+    }
+
+    ctx->rcrrp_count = 0u;
     if (ctx->suppress_pos_resp) {
         ctx->suppress_pos_resp = false;
-        ctx->rcrrp_count = 0u;
-        return UDS_OK;
+        return false;
     }
 
-    ctx->rcrrp_count = 0u;
-    return ctx->config->fn_tp_send(ctx, ctx->config->tx_buffer, len);
+    UDS_TRACE(ctx, UDS_LOG_INFO, UDS_TRACE_EV_RESPONSE,
+              (len > 0u) ? (uint8_t) (uds_tx_buffer(ctx)[0] - UDS_RESPONSE_OFFSET) : 0u, len);
+    return true;
+}
+
+int uds_send_response(uds_ctx_t *ctx, uint16_t len)
+{
+    if (!ctx || !ctx->config || !uds_tx_buffer(ctx)) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    if (len > uds_tx_buffer_size(ctx)) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    if (!uds_internal_response_prepare(ctx, len)) {
+        return UDS_OK;
+    }
+    return ctx->config->fn_tp_send(ctx, uds_tx_buffer(ctx), len);
 }
 
 int uds_send_nrc(uds_ctx_t *ctx, uint8_t sid, uint8_t nrc)
 {
-    if (!ctx || !ctx->config || !ctx->config->tx_buffer) {
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    uint8_t local[3];
+#endif
+
+    if (!ctx || !ctx->config) {
         return UDS_ERR_NOT_INIT;
     }
 
-    if (ctx->config->tx_buffer_size < 3u) {
+    /* Pool mode without a borrowed block: three bytes do not need one */
+    uint8_t *tx = uds_tx_buffer(ctx);
+    if (tx == NULL) {
+#if UDS_CFG_FEATURE_BUFFER_POOL
+        if (ctx->config->buffer_pool == NULL) {
+            return UDS_ERR_NOT_INIT;
+        }
+        tx = local;
+#else
+        return UDS_ERR_NOT_INIT;
+#endif
+    }
+    else if (uds_tx_buffer_size(ctx) < 3u) {
         return UDS_ERR_BUFFER_TOO_SMALL;
     }
 
     /* NRC 0x78 does not clear the pending flag.
        Others only clear if they refer to the actual pending SID. */
     if (nrc != UDS_NRC_RESPONSE_PENDING && sid == ctx->pending_sid) {
+        if (ctx->p2_msg_pending) {
+            pending_completed(ctx);
+        }
         ctx->p2_msg_pending = false;
+#if UDS_CFG_FEATURE_QUEUE && UDS_CFG_FEATURE_TIMER_WHEEL
+        if ((ctx->queue_count > 0u) && (ctx->timer_wheel != NULL)) {
+            uds_internal_timer_kick(ctx);
+        }
+#endif
     }
 
+    uds_internal_stats_response(ctx, sid, nrc);
+    UDS_TRACE(ctx, UDS_LOG_INFO, UDS_TRACE_EV_NRC, sid, nrc);
+
     /* NRCs are NEVER suppressed by bit 7 */
-    ctx->config->tx_buffer[0] = UDS_NRC_SERVICE_NOT_SUPP_IN_SESS;
-    ctx->config->tx_buffer[1] = sid;
-    ctx->config->tx_buffer[2] = nrc;
+    tx[0] = UDS_NRC_SERVICE_NOT_SUPP_IN_SESS;
+    tx[1] = sid;
+    tx[2] = nrc;
 
-    return ctx->config->fn_tp_send(ctx, ctx->config->tx_buffer, 3u);
+    return ctx->config->fn_tp_send(ctx, tx, 3u);
 }
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_did_cache.c
+ * @brief DID Response Cache Implementation
+ *
+ * Fragments are appended to the storage and never moved while a request is
+ * being built, because the response writer may reference them. Stale
+ * fragments leave holes that are reclaimed by clearing the whole cache at
+ * the start of a request once the storage has run full.
+ */
+
+#include <string.h>
+
+#include "uds/uds_did_cache.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_DID_CACHE
+
+#define DID_CACHE_FLAGS (UDS_DID_FLAG_IMMUTABLE | UDS_DID_FLAG_VERSIONED)
+
+/* --- Internal Helpers --- */
+
+static uds_did_cache_entry_t *cache_find(uds_did_cache_t *cache, uint16_t did)
+{
+    for (uint8_t i = 0u; i < cache->count; i++) {
+        if (cache->entries[i].did == did) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+/* Append len bytes to the storage; NULL (and a clear on the next request) if full */
+static uint8_t *cache_alloc(uds_did_cache_t *cache, uint16_t len)
+{
+    if ((uint32_t) cache->used + len > cache->size) {
+        cache->full = true;
+        return NULL;
+    }
+    uint8_t *out = &cache->storage[cache->used];
+    cache->used = (uint16_t) (cache->used + len);
+    return out;
+}
+
+/* --- Internal API --- */
+
+const uint8_t *uds_internal_did_cache_begin(uds_ctx_t *ctx, const uint8_t *data, uint16_t len,
+                                            uint16_t *resp_len)
+{
+    uds_did_cache_t *cache = ctx->config->did_cache;
+
+    if (cache->full) {
+        uds_did_cache_clear(cache); /* Nothing references the storage between requests */
+    }
+
+    uint16_t ids = (uint16_t) ((len - 1u) / 2u);
+    if ((cache->asm_count == 0u) || (ids != cache->asm_count) ||
+        (memcmp(&data[1], cache->asm_req, (size_t) ids * 2u) != 0)) {
+        return NULL;
+    }
+
+    /* Same request: still subject to the rules of the active session and level */
+    for (uint8_t i = 0u; i < cache->asm_count; i++) {
+        const uds_did_entry_t *entry = &ctx->config->did_table.entries[cache->asm_index[i]];
+        if (uds_internal_did_access(ctx, entry) != UDS_ACCESS_OK) {
+            return NULL; /* Served the long way, which picks the NRC */
+        }
+    }
+
+    cache->hits += cache->asm_count;
+    *resp_len = cache->asm_len;
+    return &cache->storage[cache->asm_offset];
+}
+
+const uint8_t *uds_internal_did_cache_get(uds_ctx_t *ctx, const uds_did_entry_t *entry,
+                                          uint16_t *frag_len)
+{
+    uds_did_cache_t *cache = ctx->config->did_cache;
+
+    if ((entry->flags & DID_CACHE_FLAGS) == 0u) {
+        return NULL;
+    }
+    const uds_did_cache_entry_t *slot = cache_find(cache, entry->id);
+    if ((slot == NULL) || (slot->len == 0u)) {
+        return NULL;
+    }
+
+    cache->hits++;
+    *frag_len = slot->len;
+    return &cache->storage[slot->offset];
+}
+
+void uds_internal_did_cache_put(uds_ctx_t *ctx, const uds_did_entry_t *entry,
+                                const uint8_t *value)
+{
+    uds_did_cache_t *cache = ctx->config->did_cache;
+
+    if ((entry->flags & DID_CACHE_FLAGS) == 0u) {
+        return;
+    }
+    cache->misses++;
+
+    uds_did_cache_entry_t *slot = cache_find(cache, entry->id);
+    if (slot == NULL) {
+        if (cache->count >= UDS_DID_CACHE_ENTRIES) {
+            cache->full = true;
+            return;
+        }
+        slot = &cache->entries[cache->count];
+        slot->did = entry->id;
+        slot->len = 0u;
+    }
+
+    uint16_t len = (uint16_t) (2u + entry->size);
+    uint8_t *frag = cache_alloc(cache, len);
+    if (frag == NULL) {
+        return;
+    }
+    frag[0] = (uint8_t) (entry->id >> 8u);
+    frag[1] = (uint8_t) entry->id;
+    memcpy(&frag[2], value, entry->size);
+
+    if (slot == &cache->entries[cache->count]) {
+        cache->count++;
+    }
+    slot->offset = (uint16_t) (frag - cache->storage);
+    slot->len = len;
+    slot->flags = entry->flags;
+}
+
+void uds_internal_did_cache_assemble(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    uds_did_cache_t *cache = ctx->config->did_cache;
+    const uds_did_table_t *table = &ctx->config->did_table;
+    uint16_t ids = (uint16_t) ((len - 1u) / 2u);
+    uint16_t total = 0u;
+
+    if ((ids < 2u) || (ids > UDS_DID_CACHE_MAX_IDS) || cache->full) {
+        return;
+    }
+
+    /* Every DID must have a fragment */
+    for (uint16_t i = 0u; i < ids; i++) {
+        uint16_t did = (uint16_t) (((uint16_t) data[1u + (2u * i)] << 8u) | data[2u + (2u * i)]);
+        const uds_did_cache_entry_t *slot = cache_find(cache, did);
+        const uds_did_entry_t *entry = uds_internal_find_did(ctx, did);
+        if ((slot == NULL) || (slot->len == 0u) || (entry == NULL)) {
+            return;
+        }
+        cache->asm_index[i] = (uint16_t) (entry - table->entries);
+        total = (uint16_t) (total + slot->len);
+    }
+
+    uint8_t *out = cache_alloc(cache, total);
+    if (out == NULL) {
+        return;
+    }
+    cache->asm_offset = (uint16_t) (out - cache->storage);
+    for (uint16_t i = 0u; i < ids; i++) {
+        uint16_t did = (uint16_t) (((uint16_t) data[1u + (2u * i)] << 8u) | data[2u + (2u * i)]);
+        const uds_did_cache_entry_t *slot = cache_find(cache, did);
+        memcpy(out, &cache->storage[slot->offset], slot->len);
+        out += slot->len;
+    }
+    memcpy(cache->asm_req, &data[1], (size_t) ids * 2u);
+    cache->asm_count = (uint8_t) ids;
+    cache->asm_len = total;
+}
+
+void uds_internal_did_cache_drop(uds_ctx_t *ctx, const uds_did_entry_t *entry)
+{
+    uds_did_cache_t *cache = ctx->config->did_cache;
+
+    if ((entry->flags & DID_CACHE_FLAGS) == 0u) {
+        return;
+    }
+    uds_did_cache_entry_t *slot = cache_find(cache, entry->id);
+    if (slot != NULL) {
+        slot->len = 0u;
+    }
+    cache->asm_count = 0u;
+}
+
+/* --- Public API --- */
+
+void uds_did_cache_init(uds_did_cache_t *cache, uint8_t *storage, uint16_t size)
+{
+    if (cache == NULL) {
+        return;
+    }
+    memset(cache, 0, sizeof(*cache));
+    cache->storage = storage;
+    cache->size = (storage != NULL) ? size : 0u;
+}
+
+void uds_did_cache_bump(uds_did_cache_t *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    for (uint8_t i = 0u; i < cache->count; i++) {
+        if ((cache->entries[i].flags & UDS_DID_FLAG_VERSIONED) != 0u) {
+            cache->entries[i].len = 0u;
+        }
+    }
+    cache->asm_count = 0u;
+}
+
+void uds_did_cache_clear(uds_did_cache_t *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    cache->used = 0u;
+    cache->count = 0u;
+    cache->full = false;
+    cache->asm_count = 0u;
+}
+
+#endif /* UDS_CFG_FEATURE_DID_CACHE */
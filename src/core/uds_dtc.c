@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_dtc.c
+ * @brief Built-in DTC Fault Memory
+ *
+ * Status bytes are mirrored into eight bit planes. A status change toggles
+ * one bit per changed status bit; a mask query ORs the selected planes word
+ * by word and never looks at the DTCs that do not match. Snapshot records
+ * live in uds_dtc_record.c, the flash journal in uds_nvm_journal.c.
+ */
+
+#include <string.h>
+
+#include "uds/uds_dtc.h"
+#include "uds/uds_roe.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_DTC
+
+/* --- Internal Helpers --- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DTC_POPCOUNT(x) ((uint32_t) __builtin_popcount(x))
+#define DTC_CTZ(x) ((uint32_t) __builtin_ctz(x))
+#else
+static uint32_t dtc_popcount(uint32_t x)
+{
+    x = x - ((x >> 1u) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2u) & 0x33333333u);
+    return (((x + (x >> 4u)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24u;
+}
+
+static uint32_t dtc_ctz(uint32_t x)
+{
+    return dtc_popcount((x & (0u - x)) - 1u);
+}
+#define DTC_POPCOUNT(x) dtc_popcount(x)
+#define DTC_CTZ(x) dtc_ctz(x)
+#endif
+
+/* Planes selected by mask; returns their number */
+static uint8_t select_planes(const uds_dtc_store_t *store, uint8_t mask, const uint32_t *planes[8])
+{
+    uint8_t n = 0u;
+    for (uint8_t b = 0u; b < 8u; b++) {
+        if ((mask & (1u << b)) != 0u) {
+            planes[n++] = &store->bits[(uint32_t) b * store->words];
+        }
+    }
+    return n;
+}
+
+static uint32_t match_word(const uint32_t *const planes[8], uint8_t n, uint16_t w)
+{
+    uint32_t set = 0u;
+    for (uint8_t p = 0u; p < n; p++) {
+        set |= planes[p][w];
+    }
+    return set;
+}
+
+/* All registered DTCs of word w */
+static uint32_t registered_word(const uds_dtc_store_t *store, uint16_t w)
+{
+    uint32_t first = (uint32_t) w * 32u;
+    if (first >= store->count) {
+        return 0u;
+    }
+    uint32_t n = store->count - first;
+    return (n >= 32u) ? 0xFFFFFFFFu : ((1u << n) - 1u);
+}
+
+/* Status byte and bit planes only */
+static void set_bits(uds_dtc_store_t *store, uint16_t idx, uint8_t status)
+{
+    uint8_t changed = (uint8_t) (store->status[idx] ^ status);
+    uint32_t bit = 1u << (idx & 31u);
+    uint16_t w = (uint16_t) (idx >> 5u);
+    for (uint8_t b = 0u; b < 8u; b++) {
+        if ((changed & (1u << b)) != 0u) {
+            store->bits[((uint32_t) b * store->words) + w] ^= bit;
+        }
+    }
+    store->status[idx] = status;
+}
+
+/* Returns true if the status changed */
+static bool update(uds_ctx_t *ctx, uds_dtc_store_t *store, uint16_t idx, uint8_t status)
+{
+    uint8_t old = store->status[idx];
+    if (old == status) {
+        return false;
+    }
+    set_bits(store, idx, status);
+
+    uds_dtc_records_t *rec = store->records;
+    uint8_t set = (uint8_t) (~old & status);
+    if (rec != NULL) {
+        if (((set & 0x01u) != 0u) && (rec->occurrences != NULL) &&
+            (rec->occurrences[idx] < 0xFFu)) {
+            rec->occurrences[idx]++; /* testFailed */
+        }
+        if ((set & rec->trigger_mask) != 0u) {
+            uds_internal_dtc_capture(ctx, idx);
+        }
+    }
+    uds_roe_notify_dtc(ctx, store->codes[idx], old, status);
+    return true;
+}
+
+static void put_record(uint8_t *out, uint32_t dtc, uint8_t status)
+{
+    out[0] = (uint8_t) (dtc >> 16u);
+    out[1] = (uint8_t) (dtc >> 8u);
+    out[2] = (uint8_t) dtc;
+    out[3] = status;
+}
+
+/* --- Internal API --- */
+
+bool uds_internal_dtc_reports(const uds_dtc_store_t *store, uint8_t subfn)
+{
+    const uds_dtc_records_t *rec = store->records;
+    switch (subfn) {
+        case 0x01u:
+        case 0x02u:
+        case 0x0Au:
+            return true;
+        case 0x03u:
+        case 0x04u:
+            return rec != NULL;
+        case 0x06u:
+            return (rec != NULL) && (rec->occurrences != NULL);
+        default:
+            return false;
+    }
+}
+
+int uds_internal_dtc_report(uds_ctx_t *ctx, uint8_t subfn, const uint8_t *data, uint16_t len,
+                            uint8_t *out, uint16_t max_len)
+{
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+    if ((subfn == 0x03u) || (subfn == 0x04u) || (subfn == 0x06u)) {
+        return uds_internal_dtc_report_records(ctx, subfn, data, len, out, max_len);
+    }
+
+    uint8_t mask = (len > 2u) ? data[2] : 0u;
+    const uint32_t *planes[8];
+    uint8_t n = select_planes(store, (uint8_t) (mask & store->availability_mask), planes);
+    uint16_t pos = 1u;
+
+    if (max_len < 4u) {
+        return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+    }
+    out[0] = store->availability_mask;
+
+    if (subfn == 0x01u) {
+        uint32_t count = 0u;
+        for (uint16_t w = 0u; w < store->words; w++) {
+            count += DTC_POPCOUNT(match_word(planes, n, w));
+        }
+        out[1] = store->format;
+        out[2] = (uint8_t) (count >> 8u);
+        out[3] = (uint8_t) count;
+        return 4;
+    }
+
+    for (uint16_t w = 0u; w < store->words; w++) {
+        uint32_t set = (subfn == 0x0Au) ? registered_word(store, w) : match_word(planes, n, w);
+        while (set != 0u) {
+            uint16_t idx = (uint16_t) (((uint32_t) w * 32u) + DTC_CTZ(set));
+            set &= set - 1u;
+            if ((uint32_t) pos + 4u > max_len) {
+                return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+            }
+            put_record(&out[pos], store->codes[idx], store->status[idx]);
+            pos = (uint16_t) (pos + 4u);
+        }
+    }
+    return (int) pos;
+}
+
+uint32_t uds_internal_dtc_matches(const uds_dtc_store_t *store, uint8_t subfn, uint8_t mask)
+{
+    const uint32_t *planes[8];
+    uint8_t n = select_planes(store, (uint8_t) (mask & store->availability_mask), planes);
+    uint32_t count = 0u;
+
+    for (uint16_t w = 0u; w < store->words; w++) {
+        count += DTC_POPCOUNT((subfn == 0x0Au) ? registered_word(store, w)
+                                                : match_word(planes, n, w));
+    }
+    return count;
+}
+
+int uds_internal_dtc_stream(uds_ctx_t *ctx, void *arg, uint32_t pos, uint8_t *buf, uint16_t len)
+{
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+    uint8_t subfn = (uint8_t) ((uintptr_t) arg >> 8u);
+    const uint32_t *planes[8];
+    uint8_t n = select_planes(store, (uint8_t) ((uintptr_t) arg & store->availability_mask),
+                              planes);
+    uint32_t skip = pos / 4u; /* Records before the first byte */
+    uint8_t rec[4];
+    uint16_t done = 0u;
+
+    for (uint16_t w = 0u; (w < store->words) && (done < len); w++) {
+        uint32_t set = (subfn == 0x0Au) ? registered_word(store, w) : match_word(planes, n, w);
+        uint32_t cnt = DTC_POPCOUNT(set);
+        if (skip >= cnt) {
+            skip -= cnt; /* Whole word before the first record */
+            continue;
+        }
+        while ((set != 0u) && (done < len)) {
+            uint16_t idx = (uint16_t) (((uint32_t) w * 32u) + DTC_CTZ(set));
+            set &= set - 1u;
+            if (skip > 0u) {
+                skip--;
+                continue;
+            }
+            put_record(rec, store->codes[idx], store->status[idx]);
+            for (uint32_t b = (pos + done) & 3u; (b < 4u) && (done < len); b++) {
+                buf[done++] = rec[b];
+            }
+        }
+    }
+
+    /* DTCs stopped matching since the length was sent */
+    return (done == len) ? UDS_OK : -(int) UDS_NRC_CONDITIONS_NOT_CORRECT;
+}
+
+int uds_internal_dtc_find(const uds_dtc_store_t *store, uint32_t dtc)
+{
+    uint16_t lo = 0u;
+    uint16_t hi = store->count;
+
+    while (lo < hi) {
+        uint16_t mid = (uint16_t) ((lo + hi) / 2u);
+        if (store->codes[mid] < dtc) {
+            lo = (uint16_t) (mid + 1u);
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return ((lo < store->count) && (store->codes[lo] == dtc)) ? (int) lo : -1;
+}
+
+void uds_internal_dtc_clear(uds_ctx_t *ctx, uint32_t group)
+{
+    uds_dtc_store_t *store = ctx->config->dtc_store;
+    uint8_t cleared = (uint8_t) (UDS_DTC_STATUS_CLEARED & store->availability_mask);
+
+    if (group != UDS_DTC_GROUP_ALL) {
+        int idx = uds_internal_dtc_find(store, group);
+        if (idx >= 0) {
+            (void) update(ctx, store, (uint16_t) idx, cleared);
+            if (store->records != NULL) {
+                uds_internal_dtc_drop_records(ctx, idx);
+            }
+            if (store->journal != NULL) {
+                uds_internal_nvm_journal_append(store, idx);
+            }
+        }
+        return;
+    }
+    for (uint16_t i = 0u; i < store->count; i++) {
+        (void) update(ctx, store, i, cleared);
+    }
+    if (store->records != NULL) {
+        uds_internal_dtc_drop_records(ctx, -1);
+    }
+    if (store->journal != NULL) {
+        uds_internal_nvm_journal_append(store, -1); /* One record for all DTCs */
+    }
+}
+
+void uds_internal_dtc_load(uds_dtc_store_t *store, uint16_t idx, uint8_t status)
+{
+    set_bits(store, idx, status);
+}
+
+/* --- Public API --- */
+
+void uds_dtc_init(uds_dtc_store_t *store, uint32_t *codes, uint8_t *status, uint32_t *bits,
+                  uint16_t capacity)
+{
+    if (store == NULL) {
+        return;
+    }
+    memset(store, 0, sizeof(*store));
+    store->codes = codes;
+    store->status = status;
+    store->bits = bits;
+    store->capacity = capacity;
+    store->words = (uint16_t) UDS_DTC_WORDS(capacity);
+    store->availability_mask = 0xFFu;
+    store->format = UDS_DTC_FORMAT_ISO14229_1;
+    if (bits != NULL) {
+        memset(bits, 0, UDS_DTC_BITS_WORDS(capacity) * sizeof(uint32_t));
+    }
+}
+
+int uds_dtc_add(uds_dtc_store_t *store, uint32_t dtc)
+{
+    if ((store == NULL) || (dtc > 0xFFFFFFu) ||
+        ((store->count > 0u) && (dtc <= store->codes[store->count - 1u]))) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (store->count >= store->capacity) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+    store->codes[store->count] = dtc;
+    store->status[store->count] = 0u;
+    store->count++;
+    return UDS_OK;
+}
+
+int uds_dtc_set_status(uds_ctx_t *ctx, uint32_t dtc, uint8_t status)
+{
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->dtc_store == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    uds_dtc_store_t *store = ctx->config->dtc_store;
+
+    int idx = uds_internal_dtc_find(store, dtc);
+    if (idx < 0) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (!store->setting_off &&
+        update(ctx, store, (uint16_t) idx, (uint8_t) (status & store->availability_mask)) &&
+        (store->journal != NULL)) {
+        uds_internal_nvm_journal_append(store, idx);
+    }
+    return UDS_OK;
+}
+
+int uds_dtc_get_status(const uds_ctx_t *ctx, uint32_t dtc, uint8_t *status)
+{
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->dtc_store == NULL) ||
+        (status == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+
+    int idx = uds_internal_dtc_find(store, dtc);
+    if (idx < 0) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    *status = store->status[idx];
+    return UDS_OK;
+}
+
+#endif /* UDS_CFG_FEATURE_DTC */
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_dtc_record.c
+ * @brief DTC Snapshot and Extended Data Records
+ *
+ * Pool layout: [latest][scratch][work][record]...[record], where the three
+ * working copies are frame_len bytes each. A record is
+ * [DTC index hi][lo][record number][changed hi][lo][bitmap][changed bytes]:
+ * bit j of the bitmap is set when byte j of the snapshot differs from the
+ * previous snapshot in the pool, and the changed byte is stored XORed with
+ * it. The first record is a delta against zeros, so every snapshot is the XOR
+ * of all deltas up to it, and latest is the XOR of all deltas.
+ */
+
+#include <string.h>
+
+#include "uds/uds_dtc.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_DTC
+
+#define HDR UDS_DTC_RECORD_HEADER
+
+/* --- Internal Helpers --- */
+
+static uint16_t bitmap_len(const uds_dtc_records_t *rec)
+{
+    return (uint16_t) ((rec->frame_len + 7u) / 8u);
+}
+
+static uint8_t *latest(const uds_dtc_records_t *rec)
+{
+    return rec->pool;
+}
+
+static uint8_t *scratch(const uds_dtc_records_t *rec)
+{
+    return &rec->pool[rec->frame_len];
+}
+
+static uint8_t *work(const uds_dtc_records_t *rec)
+{
+    return &rec->pool[2u * (uint32_t) rec->frame_len];
+}
+
+/* Offset of the first record */
+static uint16_t base(const uds_dtc_records_t *rec)
+{
+    return (uint16_t) (3u * (uint32_t) rec->frame_len);
+}
+
+static uint16_t rec_idx(const uint8_t *r)
+{
+    return (uint16_t) (((uint16_t) r[0] << 8u) | r[1]);
+}
+
+static uint16_t rec_size(const uds_dtc_records_t *rec, const uint8_t *r)
+{
+    return (uint16_t) (HDR + bitmap_len(rec) + (((uint16_t) r[3] << 8u) | r[4]));
+}
+
+/* Size the working copies from the DID table on first use */
+static bool layout(uds_ctx_t *ctx, uds_dtc_records_t *rec)
+{
+    if (rec->frame_len != 0u) {
+        return true;
+    }
+    uint32_t n = 0u;
+    for (uint8_t i = 0u; i < rec->did_count; i++) {
+        const uds_did_entry_t *entry = uds_internal_find_did(ctx, rec->dids[i]);
+        if (entry == NULL) {
+            return false;
+        }
+        n += entry->size;
+    }
+    if ((n == 0u) || ((3u * n) > rec->pool_size)) {
+        return false;
+    }
+    rec->frame_len = (uint16_t) n;
+    memset(rec->pool, 0, 3u * n);
+    rec->used = 0u;
+    rec->count = 0u;
+    return true;
+}
+
+/* Current values of the snapshot DIDs */
+static bool read_frame(uds_ctx_t *ctx, const uds_dtc_records_t *rec, uint8_t *out)
+{
+    uint16_t pos = 0u;
+    for (uint8_t i = 0u; i < rec->did_count; i++) {
+        const uds_did_entry_t *entry = uds_internal_find_did(ctx, rec->dids[i]);
+        if (entry == NULL) {
+            return false;
+        }
+        if (entry->read != NULL) {
+            if (entry->read(ctx, entry->id, &out[pos], entry->size) < 0) {
+                return false;
+            }
+        }
+        else if (entry->storage != NULL) {
+            memcpy(&out[pos], entry->storage, entry->size);
+        }
+        else {
+            memset(&out[pos], 0, entry->size);
+        }
+        pos = (uint16_t) (pos + entry->size);
+    }
+    return true;
+}
+
+/* state ^= delta of record r */
+static void apply(const uds_dtc_records_t *rec, const uint8_t *r, uint8_t *state)
+{
+    const uint8_t *bitmap = &r[HDR];
+    const uint8_t *bytes = &bitmap[bitmap_len(rec)];
+
+    for (uint16_t j = 0u; j < rec->frame_len; j++) {
+        uint8_t bits = bitmap[j >> 3u];
+        if (bits == 0u) {
+            j = (uint16_t) (j | 7u);
+            continue;
+        }
+        if ((bits & (1u << (j & 7u))) != 0u) {
+            state[j] ^= *bytes++;
+        }
+    }
+}
+
+static uint16_t count_changed(const uint8_t *a, const uint8_t *b, uint16_t len)
+{
+    uint16_t n = 0u;
+    for (uint16_t j = 0u; j < len; j++) {
+        if (a[j] != b[j]) {
+            n++;
+        }
+    }
+    return n;
+}
+
+/* Record of the delta between from (NULL = zeros) and to at r; returns its size */
+static uint16_t encode(const uds_dtc_records_t *rec, uint8_t *r, uint16_t idx, uint8_t recno,
+                       const uint8_t *from, const uint8_t *to)
+{
+    uint8_t *bitmap = &r[HDR];
+    uint8_t *bytes = &bitmap[bitmap_len(rec)];
+    uint16_t n = 0u;
+
+    memset(bitmap, 0, bitmap_len(rec));
+    for (uint16_t j = 0u; j < rec->frame_len; j++) {
+        uint8_t delta = (from != NULL) ? (uint8_t) (from[j] ^ to[j]) : to[j];
+        if (delta != 0u) {
+            bitmap[j >> 3u] |= (uint8_t) (1u << (j & 7u));
+            bytes[n++] = delta;
+        }
+    }
+    r[0] = (uint8_t) (idx >> 8u);
+    r[1] = (uint8_t) idx;
+    r[2] = recno;
+    r[3] = (uint8_t) (n >> 8u);
+    r[4] = (uint8_t) n;
+    return (uint16_t) (HDR + bitmap_len(rec) + n);
+}
+
+/* Remove the record at off; its delta moves into the next record */
+static void remove_at(uds_dtc_records_t *rec, uint16_t off)
+{
+    uint8_t *r = &rec->pool[off];
+    uint16_t size = rec_size(rec, r);
+    uint16_t end = (uint16_t) (base(rec) + rec->used);
+
+    if ((uint16_t) (off + size) == end) {
+        /* Newest record: the latest values go back to the previous snapshot */
+        apply(rec, r, latest(rec));
+        rec->used = (uint16_t) (rec->used - size);
+        rec->count--;
+        return;
+    }
+
+    uint8_t *next = &r[size];
+    uint16_t next_size = rec_size(rec, next);
+    uint16_t idx = rec_idx(next);
+    uint8_t recno = next[2];
+    uint8_t *delta = work(rec);
+
+    memset(delta, 0, rec->frame_len);
+    apply(rec, r, delta);
+    apply(rec, next, delta);
+    /* The merged record is not larger than both: written over them, then the tail closes up */
+    uint16_t merged = encode(rec, r, idx, recno, NULL, delta);
+    uint16_t tail = (uint16_t) (off + size + next_size);
+    memmove(&rec->pool[off + merged], &rec->pool[tail], (size_t) (end - tail));
+    rec->used = (uint16_t) (rec->used - (size + next_size - merged));
+    rec->count--;
+}
+
+/* --- Internal API --- */
+
+void uds_internal_dtc_capture(uds_ctx_t *ctx, uint16_t idx)
+{
+    uds_dtc_records_t *rec = ctx->config->dtc_store->records;
+
+    if ((rec->did_count == 0u) || !layout(ctx, rec) || !read_frame(ctx, rec, scratch(rec))) {
+        rec->dropped++;
+        return;
+    }
+
+    /* Record numbers of this DTC: 1 is the first occurrence, max_per_dtc the most recent */
+    uint8_t recno = 1u;
+    uint16_t newest = 0u;
+    bool found = false;
+    for (uint16_t off = base(rec); off < (uint16_t) (base(rec) + rec->used);
+         off = (uint16_t) (off + rec_size(rec, &rec->pool[off]))) {
+        const uint8_t *r = &rec->pool[off];
+        if ((rec_idx(r) == idx) && (r[2] >= recno)) {
+            recno = (uint8_t) (r[2] + 1u);
+            newest = off;
+            found = true;
+        }
+    }
+    if (found && (recno > rec->max_per_dtc)) {
+        if (rec->max_per_dtc <= 1u) {
+            rec->dropped++; /* Keep the first occurrence */
+            return;
+        }
+        /* Removing a record changes the previous values: the new frame stays in scratch */
+        remove_at(rec, newest);
+        recno = rec->max_per_dtc;
+    }
+
+    for (;;) {
+        uint16_t n = count_changed(scratch(rec), latest(rec), rec->frame_len);
+        uint32_t need = HDR + (uint32_t) bitmap_len(rec) + n;
+        if ((base(rec) + (uint32_t) rec->used + need) <= rec->pool_size) {
+            break;
+        }
+        if ((rec->policy == UDS_DTC_EVICT_NONE) || (rec->count == 0u)) {
+            rec->dropped++;
+            return;
+        }
+        remove_at(rec, base(rec));
+        rec->evicted++;
+    }
+
+    uint8_t *r = &rec->pool[base(rec) + rec->used];
+    uint16_t size = encode(rec, r, idx, recno, latest(rec), scratch(rec));
+    memcpy(latest(rec), scratch(rec), rec->frame_len);
+    rec->used = (uint16_t) (rec->used + size);
+    rec->count++;
+    rec->captured++;
+}
+
+void uds_internal_dtc_drop_records(uds_ctx_t *ctx, int idx)
+{
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+    uds_dtc_records_t *rec = store->records;
+
+    if (idx < 0) {
+        memset(rec->pool, 0, rec->frame_len);
+        rec->used = 0u;
+        rec->count = 0u;
+        if (rec->occurrences != NULL) {
+            memset(rec->occurrences, 0, store->count);
+        }
+        return;
+    }
+
+    uint16_t off = base(rec);
+    while (off < (uint16_t) (base(rec) + rec->used)) {
+        if (rec_idx(&rec->pool[off]) == (uint16_t) idx) {
+            remove_at(rec, off); /* The next record, merged, is now at off */
+        }
+        else {
+            off = (uint16_t) (off + rec_size(rec, &rec->pool[off]));
+        }
+    }
+    if (rec->occurrences != NULL) {
+        rec->occurrences[idx] = 0u;
+    }
+}
+
+int uds_internal_dtc_report_records(uds_ctx_t *ctx, uint8_t subfn, const uint8_t *data,
+                                    uint16_t len, uint8_t *out, uint16_t max_len)
+{
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+    uds_dtc_records_t *rec = store->records;
+    uint16_t pos = 0u;
+
+    if (subfn == 0x03u) {
+        /* reportDTCSnapshotIdentification: [DTC][record number] per record, oldest first */
+        for (uint16_t off = base(rec); off < (uint16_t) (base(rec) + rec->used);
+             off = (uint16_t) (off + rec_size(rec, &rec->pool[off]))) {
+            const uint8_t *r = &rec->pool[off];
+            uint32_t dtc = store->codes[rec_idx(r)];
+            if ((uint32_t) pos + 4u > max_len) {
+                return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+            }
+            out[pos++] = (uint8_t) (dtc >> 16u);
+            out[pos++] = (uint8_t) (dtc >> 8u);
+            out[pos++] = (uint8_t) dtc;
+            out[pos++] = r[2];
+        }
+        return (int) pos;
+    }
+
+    /* 0x04 / 0x06: [DTC (3)][record number] */
+    if (len < 6u) {
+        return -(int) UDS_NRC_INCORRECT_LENGTH;
+    }
+    uint32_t dtc = ((uint32_t) data[2] << 16u) | ((uint32_t) data[3] << 8u) | data[4];
+    uint8_t wanted = data[5];
+    int idx = uds_internal_dtc_find(store, dtc);
+    if (idx < 0) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+    if (max_len < 4u) {
+        return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+    }
+    memcpy(out, &data[2], 3u);
+    out[3] = store->status[idx];
+    pos = 4u;
+
+    if (subfn == 0x06u) {
+        /* Extended data record 0x01: occurrence counter */
+        if ((wanted != 0x01u) && (wanted != 0xFFu)) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+        if (max_len < 6u) {
+            return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+        }
+        out[pos++] = 0x01u;
+        out[pos++] = rec->occurrences[idx];
+        return (int) pos;
+    }
+
+    /* reportDTCSnapshotRecordByDTCNumber */
+    if ((wanted != 0xFFu) && ((wanted == 0u) || (wanted > rec->max_per_dtc))) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+    uint8_t *state = work(rec);
+    memset(state, 0, rec->frame_len);
+    for (uint16_t off = base(rec); off < (uint16_t) (base(rec) + rec->used);
+         off = (uint16_t) (off + rec_size(rec, &rec->pool[off]))) {
+        const uint8_t *r = &rec->pool[off];
+        apply(rec, r, state);
+        if ((rec_idx(r) != (uint16_t) idx) || ((wanted != 0xFFu) && (r[2] != wanted))) {
+            continue;
+        }
+
+        if ((uint32_t) pos + 2u + (2u * rec->did_count) + rec->frame_len > max_len) {
+            return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+        }
+        out[pos++] = r[2];
+        out[pos++] = rec->did_count;
+        uint16_t value = 0u;
+        for (uint8_t i = 0u; i < rec->did_count; i++) {
+            const uds_did_entry_t *entry = uds_internal_find_did(ctx, rec->dids[i]);
+            out[pos++] = (uint8_t) (rec->dids[i] >> 8u);
+            out[pos++] = (uint8_t) rec->dids[i];
+            memcpy(&out[pos], &state[value], entry->size);
+            pos = (uint16_t) (pos + entry->size);
+            value = (uint16_t) (value + entry->size);
+        }
+    }
+    return (int) pos;
+}
+
+/* --- Public API --- */
+
+void uds_dtc_records_init(uds_dtc_records_t *records, const uint16_t *dids, uint8_t did_count,
+                          uint8_t *pool, uint16_t pool_size, uint8_t *occurrences)
+{
+    if (records == NULL) {
+        return;
+    }
+    memset(records, 0, sizeof(*records));
+    records->dids = dids;
+    records->did_count = did_count;
+    records->trigger_mask = 0x01u; /* testFailed */
+    records->max_per_dtc = 2u;
+    records->policy = UDS_DTC_EVICT_OLDEST;
+    records->pool = pool;
+    records->pool_size = pool_size;
+    records->occurrences = occurrences;
+}
+
+#endif /* UDS_CFG_FEATURE_DTC */
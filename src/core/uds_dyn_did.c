@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_dyn_did.c
+ * @brief Dynamically Defined DID Gather Plans
+ *
+ * Sources are resolved once, when 0x2C defines them: a slice that can be
+ * addressed directly becomes a source pointer, and a slice that continues
+ * the previous one is merged into its step. Reading a dynamic DID then
+ * walks the plan and copies.
+ */
+
+#include <string.h>
+
+#include "uds/uds_dyn_did.h"
+#include "uds_internal.h"
+
+/* --- Internal Helpers --- */
+
+static int append_step(uds_dyn_did_t *dyn, const uds_dyn_did_step_t *step)
+{
+    if ((uint32_t) dyn->size + step->len > 0xFFFFu) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+
+    /* Continuation of the previous slice of the same source: one longer copy */
+    if ((dyn->count > 0u) && (dyn->steps[dyn->count - 1u].did == step->did)) {
+        uds_dyn_did_step_t *last = &dyn->steps[dyn->count - 1u];
+        bool merge;
+        if ((last->src != NULL) || (step->src != NULL)) {
+            merge = (last->src != NULL) && ((last->src + last->len) == step->src);
+        }
+        else if (step->did != NULL) {
+            merge = ((uint32_t) last->offset + last->len) == step->offset;
+        }
+        else {
+            merge = (last->addr + last->len) == step->addr;
+        }
+        if (merge) {
+            last->len = (uint16_t) (last->len + step->len);
+            dyn->size = (uint16_t) (dyn->size + step->len);
+            return UDS_OK;
+        }
+    }
+
+    if (dyn->count >= UDS_DYN_DID_MAX_STEPS) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+    dyn->steps[dyn->count++] = *step;
+    dyn->size = (uint16_t) (dyn->size + step->len);
+    return UDS_OK;
+}
+
+/* --- Internal API --- */
+
+uds_dyn_did_t *uds_internal_dyn_did_find(uds_ctx_t *ctx, uint16_t id)
+{
+    for (uint8_t i = 0u; i < ctx->config->dyn_did_count; i++) {
+        if (ctx->config->dyn_dids[i].id == id) {
+            return &ctx->config->dyn_dids[i];
+        }
+    }
+    return NULL;
+}
+
+uds_dyn_did_t *uds_internal_dyn_did_open(uds_ctx_t *ctx, uint16_t id)
+{
+    uds_dyn_did_t *dyn = uds_internal_dyn_did_find(ctx, id);
+    if (dyn == NULL) {
+        dyn = uds_internal_dyn_did_find(ctx, 0u);
+        if (dyn != NULL) {
+            dyn->id = id;
+            dyn->size = 0u;
+            dyn->count = 0u;
+        }
+    }
+    return dyn;
+}
+
+int uds_internal_dyn_did_add_did(uds_ctx_t *ctx, uds_dyn_did_t *dyn, const uds_did_entry_t *entry,
+                                 uint16_t offset, uint16_t len)
+{
+    (void) ctx;
+    uds_dyn_did_step_t step = {NULL, entry, 0u, offset, len};
+
+    if (entry->read == NULL) {
+        if (entry->storage == NULL) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+        step.src = &((const uint8_t *) entry->storage)[offset];
+    }
+    return append_step(dyn, &step);
+}
+
+int uds_internal_dyn_did_add_memory(uds_ctx_t *ctx, uds_dyn_did_t *dyn, uint32_t addr,
+                                    uint16_t len)
+{
+    uds_dyn_did_step_t step = {NULL, NULL, addr, 0u, len};
+
+    if (ctx->config->fn_mem_map != NULL) {
+        step.src = ctx->config->fn_mem_map(ctx, addr, len);
+    }
+    if ((step.src == NULL) && (ctx->config->fn_mem_read == NULL)) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+    return append_step(dyn, &step);
+}
+
+void uds_internal_dyn_did_free(uds_dyn_did_t *dyn)
+{
+    dyn->id = 0u;
+    dyn->size = 0u;
+    dyn->count = 0u;
+}
+
+int uds_internal_dyn_did_read(uds_ctx_t *ctx, const uds_dyn_did_t *dyn, uint8_t *out,
+                              uint8_t *scratch, uint16_t scratch_len)
+{
+    const uds_did_entry_t *loaded = NULL;
+
+    for (uint8_t i = 0u; i < dyn->count; i++) {
+        const uds_dyn_did_step_t *step = &dyn->steps[i];
+
+        if (step->did != NULL) {
+            /* The rules of the source DIDs apply to the dynamic DID */
+            int access = uds_internal_did_access(ctx, step->did);
+            if (access == UDS_ACCESS_DENIED_SESSION) {
+                return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+            }
+            if (access == UDS_ACCESS_DENIED_SECURITY) {
+                return -(int) UDS_NRC_SECURITY_ACCESS_DENIED;
+            }
+        }
+
+        if (step->src != NULL) {
+            memcpy(out, step->src, step->len);
+        }
+        else if (step->did != NULL) {
+            /* Whole value read once into the free tx_buffer space, then sliced */
+            if (loaded != step->did) {
+                if (step->did->size > scratch_len) {
+                    return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+                }
+                int res = step->did->read(ctx, step->did->id, scratch, step->did->size);
+                if (res < 0) {
+                    return res;
+                }
+                loaded = step->did;
+            }
+            memcpy(out, &scratch[step->offset], step->len);
+        }
+        else {
+            int res = ctx->config->fn_mem_read(ctx, step->addr, step->len, out);
+            if (res < 0) {
+                return res;
+            }
+        }
+        out += step->len;
+    }
+    return UDS_OK;
+}
+
+/* --- Public API --- */
+
+void uds_dyn_did_clear(uds_ctx_t *ctx)
+{
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->dyn_dids == NULL)) {
+        return;
+    }
+    for (uint8_t i = 0u; i < ctx->config->dyn_did_count; i++) {
+        uds_internal_dyn_did_free(&ctx->config->dyn_dids[i]);
+    }
+}
@@ -12,6 +12,7 @@
 #define UDS_INTERNAL_H
 
 #include "uds/uds_core.h"
+#include "uds/uds_trace.h"
 
 /* --- UDS Constants (ISO 14229-1) --- */
 
@@ -40,6 +41,7 @@
 #define UDS_SID_COMM_CONTROL 0x28u
 #define UDS_SID_AUTHENTICATION 0x29u
 #define UDS_SID_READ_BY_PER_ID 0x2Au
+#define UDS_SID_DYN_DEFINE_DID 0x2Cu
 #define UDS_SID_WRITE_DATA_BY_ID 0x2Eu
 #define UDS_SID_IO_CONTROL_BY_ID 0x2Fu
 #define UDS_SID_ROUTINE_CONTROL 0x31u
@@ -50,22 +52,18 @@
 #define UDS_SID_WRITE_MEM_BY_ADDR 0x3Du
 #define UDS_SID_TESTER_PRESENT 0x3Eu
 #define UDS_SID_CONTROL_DTC_SETTING 0x85u
+#define UDS_SID_RESPONSE_ON_EVENT 0x86u
 
 #define UDS_S3_TIMEOUT_MS 5000u
 #define UDS_P2_MIN_SAFE_MS 20u
 #define UDS_P2_STAR_MIN_SAFE_MS 1000u
 
 #define UDS_RESPONSE_OFFSET 0x40u
-#define UDS_MAX_PERIODIC_MSG_LEN 8u
 
 #define UDS_PERIODIC_RATE_FAST 0x01u
 #define UDS_PERIODIC_RATE_MEDIUM 0x02u
 #define UDS_PERIODIC_RATE_SLOW 0x03u
 
-#define UDS_PERIODIC_FAST_INTERVAL_MS 100u
-#define UDS_PERIODIC_MEDIUM_INTERVAL_MS 500u
-#define UDS_PERIODIC_SLOW_INTERVAL_MS 1000u
-
 /* Protocol Bitmasks */
 #define UDS_MASK_NIBBLE 0x0Fu
 #define UDS_MASK_SUBFUNCTION 0x7Fu
@@ -85,9 +83,10 @@
     {                                                      \
         0x0Eu, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 \
     }
-#define UDS_MASK_SUB_19                                    \
-    {                                                      \
-        0x57u, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 \
+/* 0x00-0x04, 0x06 and reportSupportedDTC (0x0A) */
+#define UDS_MASK_SUB_19                                        \
+    {                                                          \
+        0x5Fu, 0x04u, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 \
     }
 #define UDS_MASK_SUB_27                                                                            \
     {                                                                                              \
@@ -114,11 +113,245 @@
     {                                                      \
         0x1Eu, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 \
     }
+#define UDS_MASK_SUB_2C                                    \
+    {                                                      \
+        0x0Eu, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 \
+    }
+/* 0x00-0x07 except onTimerInterrupt (0x02), and the set-up events with storageState (0x4x) */
+#define UDS_MASK_SUB_86                                        \
+    {                                                          \
+        0xFBu, 0, 0, 0, 0, 0, 0, 0, 0x8Au, 0, 0, 0, 0, 0, 0, 0 \
+    }
 
 const uds_did_entry_t *uds_internal_find_did(uds_ctx_t *ctx, uint16_t id);
 bool uds_internal_parse_addr_len(const uint8_t *data, uint16_t len, uint8_t format, uint32_t *addr,
                                  uint32_t *size);
 void uds_internal_log(uds_ctx_t *ctx, uint8_t level, const char *msg);
+uint32_t uds_internal_now_us(uds_ctx_t *ctx);
+
+/* --- Access Control (uds_access.c) --- */
+#define UDS_ACCESS_OK 0              /**< Permitted */
+#define UDS_ACCESS_DENIED_SESSION 1  /**< Not permitted in the active session */
+#define UDS_ACCESS_DENIED_SECURITY 2 /**< Session permitted, security level is not */
+int uds_internal_service_access(const uds_ctx_t *ctx, const uds_service_entry_t *service);
+int uds_internal_did_access(const uds_ctx_t *ctx, const uds_did_entry_t *entry);
+
+/* --- DID Response Cache (uds_did_cache.c), UDS_CFG_FEATURE_DID_CACHE and config->did_cache --- */
+#if UDS_CFG_FEATURE_DID_CACHE
+/* True if config->did_cache is set */
+#define uds_internal_did_cache_enabled(ctx) ((ctx)->config->did_cache != NULL)
+/* Start of a 0x22 request: the pre-assembled response for data, or NULL */
+const uint8_t *uds_internal_did_cache_begin(uds_ctx_t *ctx, const uint8_t *data, uint16_t len,
+                                            uint16_t *resp_len);
+/* Cached [DID hi][DID lo][data] fragment of a flagged DID, or NULL */
+const uint8_t *uds_internal_did_cache_get(uds_ctx_t *ctx, const uds_did_entry_t *entry,
+                                          uint16_t *frag_len);
+/* Store the encoded value of a flagged DID */
+void uds_internal_did_cache_put(uds_ctx_t *ctx, const uds_did_entry_t *entry,
+                                const uint8_t *value);
+/* After a positive response made only of cached DIDs: keep it pre-assembled */
+void uds_internal_did_cache_assemble(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
+/* A flagged DID was written */
+void uds_internal_did_cache_drop(uds_ctx_t *ctx, const uds_did_entry_t *entry);
+#else
+#define uds_internal_did_cache_enabled(ctx) false
+#define uds_internal_did_cache_begin(ctx, data, len, resp_len) ((const uint8_t *) NULL)
+#define uds_internal_did_cache_get(ctx, entry, frag_len) ((const uint8_t *) NULL)
+#define uds_internal_did_cache_put(ctx, entry, value) ((void) 0)
+#define uds_internal_did_cache_assemble(ctx, data, len) ((void) 0)
+#define uds_internal_did_cache_drop(ctx, entry) ((void) 0)
+#endif
+
+/* --- Dynamically Defined DIDs (uds_dyn_did.c), only with config->dyn_dids --- */
+/* Defined dynamic DID id (0 = a free slot), or NULL */
+struct uds_dyn_did *uds_internal_dyn_did_find(uds_ctx_t *ctx, uint16_t id);
+/* Definition of id to append to: existing, else a free slot; NULL if none is free */
+struct uds_dyn_did *uds_internal_dyn_did_open(uds_ctx_t *ctx, uint16_t id);
+/* Append a slice of a DID value / a memory range; negative NRC if it cannot be added */
+int uds_internal_dyn_did_add_did(uds_ctx_t *ctx, struct uds_dyn_did *dyn,
+                                 const uds_did_entry_t *entry, uint16_t offset, uint16_t len);
+int uds_internal_dyn_did_add_memory(uds_ctx_t *ctx, struct uds_dyn_did *dyn, uint32_t addr,
+                                    uint16_t len);
+void uds_internal_dyn_did_free(struct uds_dyn_did *dyn);
+/* Gather dyn->size bytes into out; scratch holds values of read-callback DIDs */
+int uds_internal_dyn_did_read(uds_ctx_t *ctx, const struct uds_dyn_did *dyn, uint8_t *out,
+                              uint8_t *scratch, uint16_t scratch_len);
+
+/* --- Periodic Data Scheduler (uds_periodic.c) --- */
+/* Schedule periodic_id (first transmission at now) or change its rate; UDS_OK or -NRC */
+int uds_internal_periodic_start(uds_ctx_t *ctx, uint8_t periodic_id, uint8_t rate, uint32_t now);
+/* True if periodic_id is scheduled */
+bool uds_internal_periodic_active(uds_ctx_t *ctx, uint8_t periodic_id);
+/* Entries that can still be scheduled */
+uint16_t uds_internal_periodic_free(uds_ctx_t *ctx);
+void uds_internal_periodic_stop(uds_ctx_t *ctx, uint8_t periodic_id);
+void uds_internal_periodic_stop_all(uds_ctx_t *ctx);
+/* Transmit the periodic IDs due at now */
+void uds_internal_periodic_process(uds_ctx_t *ctx, uint32_t now);
+/* Earliest deadline; false if nothing is scheduled */
+bool uds_internal_periodic_next(uds_ctx_t *ctx, uint32_t *deadline);
+
+/* --- ResponseOnEvent (uds_roe.c), only with UDS_CFG_SERVICE_86 and config->roe --- */
+struct uds_roe_event;
+/* [eventWindowTime][eventTypeRecord][serviceToRespondToRecord]; returns its length */
+uint16_t uds_internal_roe_encode(const struct uds_roe_event *event, uint8_t *out);
+/* Open the event window and record the values to compare with */
+void uds_internal_roe_start(uds_ctx_t *ctx, struct uds_roe_event *event, uint32_t now);
+/* Evaluate the active events and respond to the ones that occurred */
+void uds_internal_roe_process(uds_ctx_t *ctx, uint32_t now);
+/* Next window end, poll or dirty event; false if nothing is active */
+bool uds_internal_roe_next(uds_ctx_t *ctx, uint32_t now, uint32_t *deadline);
+
+/* --- DTC Fault Memory (uds_dtc.c), only with UDS_CFG_FEATURE_DTC and config->dtc_store --- */
+struct uds_dtc_store;
+/* True if the store answers this 0x19 subfunction */
+bool uds_internal_dtc_reports(const struct uds_dtc_store *store, uint8_t subfn);
+/* 0x19 payload after [subfn] into out for the request data; its length, or -NRC */
+int uds_internal_dtc_report(uds_ctx_t *ctx, uint8_t subfn, const uint8_t *data, uint16_t len,
+                            uint8_t *out, uint16_t max_len);
+/* Number of DTCs a 0x19 0x02 (matching mask) or 0x0A report lists */
+uint32_t uds_internal_dtc_matches(const struct uds_dtc_store *store, uint8_t subfn, uint8_t mask);
+/* uds_stream_fn of the 0x02 / 0x0A records, arg = (subfn << 8) | mask */
+int uds_internal_dtc_stream(uds_ctx_t *ctx, void *arg, uint32_t pos, uint8_t *buf, uint16_t len);
+/* Index of a registered DTC, or -1 */
+int uds_internal_dtc_find(const struct uds_dtc_store *store, uint32_t dtc);
+/* Clear one DTC or UDS_DTC_GROUP_ALL */
+void uds_internal_dtc_clear(uds_ctx_t *ctx, uint32_t group);
+/* Set a status byte and its bit planes without any side effect (journal replay) */
+void uds_internal_dtc_load(struct uds_dtc_store *store, uint16_t idx, uint8_t status);
+/* Snapshot records (uds_dtc_record.c), only with store->records: a trigger bit of DTC idx set */
+void uds_internal_dtc_capture(uds_ctx_t *ctx, uint16_t idx);
+/* Drop the records and occurrences of DTC idx, or of every DTC for idx < 0 */
+void uds_internal_dtc_drop_records(uds_ctx_t *ctx, int idx);
+/* 0x19 0x03 / 0x04 / 0x06 payload after [subfn]; its length, or -NRC */
+int uds_internal_dtc_report_records(uds_ctx_t *ctx, uint8_t subfn, const uint8_t *data,
+                                    uint16_t len, uint8_t *out, uint16_t max_len);
+/* NVM journal (uds_nvm_journal.c), only with store->journal: status of DTC idx, or clear all */
+void uds_internal_nvm_journal_append(struct uds_dtc_store *store, int idx);
+/* Background compaction once the active sector runs low */
+void uds_internal_nvm_journal_process(uds_ctx_t *ctx);
+
+/* --- Pipelined TransferData (uds_transfer_pipe.c), UDS_CFG_FEATURE_FLASH and transfer_pipe --- */
+/* Stage a 0x36 block: UDS_OK to acknowledge now, UDS_PENDING until a slot frees, or -NRC */
+int uds_internal_pipe_transfer(uds_ctx_t *ctx, uint8_t sequence, const uint8_t *data,
+                               uint16_t len);
+/* 0x37: UDS_OK once every block is written, UDS_PENDING until then, or -NRC */
+int uds_internal_pipe_exit(uds_ctx_t *ctx);
+/* 0x34: drop the previous transfer; -NRC while one of its writes still runs */
+int uds_internal_pipe_reset(uds_ctx_t *ctx);
+/* Restart writes the executor did not accept */
+void uds_internal_pipe_process(uds_ctx_t *ctx);
+
+/* --- Buffer Pool (uds_core.c) --- */
+#if UDS_CFG_FEATURE_BUFFER_POOL
+/* Borrow the response buffer if the context has none (always true without a pool) */
+bool uds_internal_tx_acquire(uds_ctx_t *ctx);
+/* Return the response buffer unless a request is still outstanding */
+void uds_internal_tx_release(uds_ctx_t *ctx);
+#else
+static inline bool uds_internal_tx_acquire(uds_ctx_t *ctx)
+{
+    (void) ctx;
+    return true;
+}
+static inline void uds_internal_tx_release(uds_ctx_t *ctx)
+{
+    (void) ctx;
+}
+#endif
+
+/* --- Multi-Tester / Request Queue (uds_core.c) --- */
+bool uds_internal_tester_select(uds_ctx_t *ctx, uint16_t addr);
+#if UDS_CFG_FEATURE_QUEUE
+void uds_internal_queue_drain(uds_ctx_t *ctx);
+#else
+static inline void uds_internal_queue_drain(uds_ctx_t *ctx)
+{
+    (void) ctx;
+}
+#endif
+
+/* --- Single-Owner Mode (uds_core.c, uds_job.c, uds_mailbox.c) --- */
+/* Lock-free bodies of the public entry points, run by the mutex wrappers or the owner */
+void uds_internal_input_sdu_owned(uds_ctx_t *ctx, const uint16_t *tester_addr, const uint8_t *data,
+                                  uint16_t len);
+int uds_internal_client_request_owned(uds_ctx_t *ctx, uint8_t sid, const uint8_t *data,
+                                      uint16_t len, uds_response_cb callback);
+int uds_internal_job_complete_owned(uds_ctx_t *ctx, struct uds_job *job, int result);
+/* Make the dispatched request wait for job; the handler returns the result (UDS_PENDING) */
+int uds_internal_job_claim(uds_ctx_t *ctx, uint8_t sid, struct uds_job *job);
+/* Run job->work on the executor (inline without one) and then job->complete, no response */
+bool uds_internal_job_start(uds_ctx_t *ctx, struct uds_job *job);
+void uds_internal_mailbox_drain(uds_ctx_t *ctx);
+
+/* --- Response Path (uds_core.c) --- */
+/* True if responses larger than the tx_buffer can be streamed (fn_tp_send_stream) */
+#if UDS_CFG_FEATURE_STREAM
+#define uds_internal_can_stream(ctx) ((ctx)->config->fn_tp_send_stream != NULL)
+#else
+#define uds_internal_can_stream(ctx) false
+#endif
+/**
+ * Bookkeeping of a positive response (pending state, statistics, trace).
+ * Returns false if the response is suppressed and must not be sent.
+ */
+bool uds_internal_response_prepare(uds_ctx_t *ctx, uint16_t len);
+/* Serve a request generated by the server itself (ResponseOnEvent) like a tester request */
+void uds_internal_execute_request(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
+
+/* --- Statistics (uds_stats.c) --- */
+#if UDS_CFG_FEATURE_STATS
+void uds_internal_stats_request(uds_ctx_t *ctx, uint8_t sid);
+void uds_internal_stats_response(uds_ctx_t *ctx, uint8_t sid, uint8_t nrc);
+void uds_internal_stats_handler(uds_ctx_t *ctx, uint8_t sid, uint32_t elapsed_us);
+void uds_internal_stats_latency(uds_ctx_t *ctx, uint8_t sid, uint32_t latency_us);
+#else
+static inline void uds_internal_stats_request(uds_ctx_t *ctx, uint8_t sid)
+{
+    (void) ctx;
+    (void) sid;
+}
+static inline void uds_internal_stats_response(uds_ctx_t *ctx, uint8_t sid, uint8_t nrc)
+{
+    (void) ctx;
+    (void) sid;
+    (void) nrc;
+}
+#endif
+
+/* --- Event Trace (uds_trace.c) --- */
+void uds_internal_trace(uds_ctx_t *ctx, uint8_t event, uint8_t sid, uint16_t arg);
+
+/**
+ * Trace point. Levels above UDS_TRACE_LEVEL (or UDS_CFG_FEATURE_TRACE=0) compile
+ * to nothing; otherwise the cost at run time is one NULL check while cfg.trace is
+ * not set.
+ */
+#if UDS_CFG_FEATURE_TRACE && (UDS_TRACE_LEVEL >= 0)
+#define UDS_TRACE(ctx, level, event, sid, arg)                                   \
+    do {                                                                         \
+        if ((level) <= UDS_TRACE_LEVEL) {                                        \
+            uds_internal_trace((ctx), (event), (uint8_t) (sid), (uint16_t) (arg)); \
+        }                                                                        \
+    } while (0)
+#else
+#define UDS_TRACE(ctx, level, event, sid, arg) \
+    do {                                       \
+    } while (0)
+#endif
+
+/* --- Shared Timer Wheel (uds_timer_wheel.c) --- */
+#if UDS_CFG_FEATURE_TIMER_WHEEL
+/* True if the context is driven by config->timer_wheel */
+#define uds_internal_on_wheel(ctx) ((ctx)->timer_wheel != NULL)
+void uds_internal_timer_arm(uds_ctx_t *ctx, uint32_t expires);
+void uds_internal_timer_cancel(uds_ctx_t *ctx);
+void uds_internal_timer_kick(uds_ctx_t *ctx);
+void uds_internal_timer_rearm(uds_ctx_t *ctx, uint32_t now);
+#else
+#define uds_internal_on_wheel(ctx) false
+#define uds_internal_timer_kick(ctx) ((void) 0)
+#endif
 
 /* --- Core Service Handlers --- */
 
@@ -126,20 +359,22 @@ void uds_internal_log(uds_ctx_t *ctx, uint8_t level, const char *msg);
 int uds_internal_handle_session_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_tester_present(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 
-/* Data Services (0x22, 0x2E) */
+/* Data Services (0x22, 0x2C, 0x2E) */
 int uds_internal_handle_read_data_by_id(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
+int uds_internal_handle_dynamic_define_did(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_write_data_by_id(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 
 /* Security Services (0x27, 0x29) */
 int uds_internal_handle_security_access(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_authentication(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 
-/* Maintenance Services (0x11, 0x14, 0x19, 0x28, 0x85) */
+/* Maintenance Services (0x11, 0x14, 0x19, 0x28, 0x85, 0x86) */
 int uds_internal_handle_ecu_reset(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_comm_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_clear_dtc(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_read_dtc_info(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 int uds_internal_handle_control_dtc_setting(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
+int uds_internal_handle_response_on_event(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
 
 /* Flash Services (0x31, 0x34, 0x36, 0x37) */
 int uds_internal_handle_routine_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len);
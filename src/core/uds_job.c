@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_job.c
+ * @brief Asynchronous Job API Implementation
+ */
+
+#include "uds/uds_job.h"
+#include "uds/uds_mailbox.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_JOB
+
+/* --- Internal Helpers --- */
+
+/**
+ * @brief Build and send the response of a finished job (context lock held).
+ */
+static void uds_internal_job_finalize(uds_ctx_t *ctx, uds_job_t *job, int result)
+{
+    int len;
+
+    if (job->complete != NULL) {
+        len = job->complete(ctx, job, result);
+    }
+    else if (result < 0) {
+        len = result;
+    }
+    else {
+        uds_tx_buffer(ctx)[0] = (uint8_t) (job->sid + UDS_RESPONSE_OFFSET);
+        len = 1;
+    }
+
+    if (len < 0) {
+        uds_send_nrc(ctx, job->sid, (uint8_t) (-len));
+    }
+    else if (len > 0) {
+        uds_send_response(ctx, (uint16_t) len);
+    }
+    else {
+        /* Finished without a response: same bookkeeping as a sent one */
+        (void) uds_internal_response_prepare(ctx, 0u);
+    }
+
+    ctx->pending_job_id = 0u;
+}
+
+/**
+ * @brief Bind a job to the request being dispatched.
+ */
+static void uds_internal_job_bind(uds_ctx_t *ctx, uint8_t sid, uds_job_t *job)
+{
+    ctx->job_seq++;
+    if (ctx->job_seq == 0u) {
+        ctx->job_seq = 1u;
+    }
+
+    job->ctx = ctx;
+    job->tester_addr = ctx->tester_addr;
+    job->id = ctx->job_seq;
+    job->sid = sid;
+}
+
+/* --- Internal API --- */
+
+int uds_internal_job_claim(uds_ctx_t *ctx, uint8_t sid, uds_job_t *job)
+{
+    uds_internal_job_bind(ctx, sid, job);
+    ctx->pending_job_id = job->id;
+    return UDS_PENDING;
+}
+
+bool uds_internal_job_start(uds_ctx_t *ctx, uds_job_t *job)
+{
+    job->ctx = ctx;
+    job->tester_addr = ctx->tester_addr;
+    job->id = 0u; /* No request waits for it */
+    job->sid = 0u;
+
+    if (ctx->config->fn_job_submit == NULL) {
+        (void) job->complete(ctx, job, job->work(job));
+        return true;
+    }
+    return ctx->config->fn_job_submit(ctx->config->job_executor, job) == 0;
+}
+
+/* --- Public API --- */
+
+int uds_submit_job(uds_ctx_t *ctx, uint8_t sid, uds_job_t *job)
+{
+    if (!ctx || !ctx->config || !job || !job->work) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    uds_internal_job_bind(ctx, sid, job);
+
+    if (ctx->config->fn_job_submit == NULL) {
+        /* No executor: run inline inside the handler */
+        uds_internal_job_finalize(ctx, job, job->work(job));
+        return UDS_OK;
+    }
+
+    /* Claim the request before the executor can complete it: uds_init() requires a
+     * context lock or mailbox with an executor, so the completion waits for the
+     * dispatcher to mark the request pending */
+    ctx->pending_job_id = job->id;
+    if (ctx->config->fn_job_submit(ctx->config->job_executor, job) != 0) {
+        ctx->pending_job_id = 0u;
+        uds_internal_log(ctx, UDS_LOG_ERROR, "Job executor rejected job");
+        uds_send_nrc(ctx, sid, UDS_NRC_BUSY_REPEAT_REQUEST);
+        return UDS_OK;
+    }
+
+    UDS_TRACE(ctx, UDS_LOG_DEBUG, UDS_TRACE_EV_JOB_SUBMIT, sid, (uint16_t) job->id);
+    return UDS_PENDING;
+}
+
+int uds_internal_job_complete_owned(uds_ctx_t *ctx, uds_job_t *job, int result)
+{
+    if (job->id == 0u) {
+        /* Background job (uds_internal_job_start()): only its completion runs */
+        (void) job->complete(ctx, job, result);
+        return UDS_OK;
+    }
+
+    if (uds_internal_tester_select(ctx, job->tester_addr) && ctx->p2_msg_pending &&
+        (ctx->pending_job_id == job->id)) {
+        UDS_TRACE(ctx, UDS_LOG_DEBUG, UDS_TRACE_EV_JOB_DONE, job->sid, (uint16_t) job->id);
+        uds_internal_job_finalize(ctx, job, result);
+        uds_internal_queue_drain(ctx);
+        uds_internal_tx_release(ctx);
+        return UDS_OK;
+    }
+
+    UDS_TRACE(ctx, UDS_LOG_INFO, UDS_TRACE_EV_JOB_STALE, job->sid, (uint16_t) job->id);
+    uds_internal_log(ctx, UDS_LOG_INFO, "Stale job result discarded");
+    return UDS_ERR_STALE_JOB;
+}
+
+int uds_complete_pending(uds_ctx_t *ctx, uds_job_t *job, int result)
+{
+    if (!ctx || !ctx->config || !job) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+#if UDS_CFG_FEATURE_MAILBOX
+    if (ctx->config->mailbox != NULL) {
+        /* Single-owner mode: the owner checks for staleness when it runs the mail */
+        return uds_mailbox_post(ctx->config->mailbox, UDS_MAIL_JOB_COMPLETE, 0u, NULL, 0u, job,
+                                result);
+    }
+#endif
+
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    int ret = uds_internal_job_complete_owned(ctx, job, result);
+
+    if (ctx->config->fn_mutex_unlock != NULL) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+
+    return ret;
+}
+
+void uds_job_execute(uds_job_t *job)
+{
+    if ((job == NULL) || (job->ctx == NULL)) {
+        return;
+    }
+    (void) uds_complete_pending(job->ctx, job, job->work(job));
+}
+
+#endif /* UDS_CFG_FEATURE_JOB */
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_mailbox.c
+ * @brief Lock-Free MPSC Mailbox Implementation
+ *
+ * Bounded queue after D. Vyukov: every slot carries a sequence number that
+ * tells producers and the consumer whose turn it is, so a producer only
+ * needs one compare-and-swap on enqueue_pos and the owner none at all.
+ */
+
+#include <string.h>
+
+#include "uds/uds_mailbox.h"
+#include "uds/uds_job.h"
+#include "uds_atomic.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_MAILBOX
+
+/* --- Internal API (used by the core) --- */
+
+void uds_internal_mailbox_drain(uds_ctx_t *ctx)
+{
+    uds_mailbox_t *mb = ctx->config->mailbox;
+
+    for (;;) {
+        uint32_t pos = mb->dequeue_pos;
+        uds_mail_t *mail = &mb->mails[pos & mb->mask];
+        uint32_t seq = UDS_ATOMIC_LOAD_ACQUIRE(&mail->seq);
+
+        if (seq != (pos + 1u)) {
+            break; /* Empty, or the producer has not finished writing */
+        }
+
+        uint8_t *data = &mb->data[(pos & mb->mask) * mb->slot_size];
+
+        switch (mail->kind) {
+            case UDS_MAIL_SDU:
+                uds_internal_input_sdu_owned(ctx, NULL, data, mail->len);
+                break;
+            case UDS_MAIL_SDU_FROM:
+                uds_internal_input_sdu_owned(ctx, &mail->addr, data, mail->len);
+                break;
+            case UDS_MAIL_CLIENT_REQUEST:
+                (void) uds_internal_client_request_owned(ctx, data[0], &data[1],
+                                                         (uint16_t) (mail->len - 1u),
+                                                         (uds_response_cb) mail->ptr);
+                break;
+#if UDS_CFG_FEATURE_JOB
+            case UDS_MAIL_JOB_COMPLETE:
+                (void) uds_internal_job_complete_owned(ctx, (uds_job_t *) mail->ptr,
+                                                       mail->result);
+                break;
+#endif
+            default:
+                break;
+        }
+
+        /* Hand the slot back to the producers for the next lap */
+        mb->dequeue_pos = pos + 1u;
+        UDS_ATOMIC_STORE_RELEASE(&mail->seq, pos + mb->mask + 1u);
+    }
+}
+
+/* --- Public API --- */
+
+int uds_mailbox_init(uds_mailbox_t *mb, uds_mail_t *mails, uint8_t *data, uint32_t depth,
+                     uint16_t slot_size)
+{
+    if ((mb == NULL) || (mails == NULL) || (data == NULL) || (depth == 0u) ||
+        ((depth & (depth - 1u)) != 0u) || (slot_size == 0u)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memset(mb, 0, sizeof(*mb));
+    mb->mails = mails;
+    mb->data = data;
+    mb->slot_size = slot_size;
+    mb->mask = depth - 1u;
+    for (uint32_t i = 0u; i < depth; i++) {
+        mails[i].seq = i;
+    }
+    return UDS_OK;
+}
+
+int uds_mailbox_post(uds_mailbox_t *mb, uint8_t kind, uint16_t addr, const uint8_t *data,
+                     uint16_t len, void *ptr, int result)
+{
+    if ((len > 0u) && (data == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    uds_iovec_t iov = {data, len};
+    return uds_mailbox_postv(mb, kind, addr, &iov, 1u, ptr, result);
+}
+
+int uds_mailbox_postv(uds_mailbox_t *mb, uint8_t kind, uint16_t addr, const uds_iovec_t *iov,
+                      uint8_t count, void *ptr, int result)
+{
+    if ((mb == NULL) || ((count > 0u) && (iov == NULL))) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    uint32_t len = 0u;
+    for (uint8_t i = 0u; i < count; i++) {
+        len += iov[i].len;
+    }
+    if (len > mb->slot_size) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    uint32_t pos = UDS_ATOMIC_LOAD_RELAXED(&mb->enqueue_pos);
+    uds_mail_t *mail;
+
+    for (;;) {
+        mail = &mb->mails[pos & mb->mask];
+        uint32_t seq = UDS_ATOMIC_LOAD_ACQUIRE(&mail->seq);
+        int32_t diff = (int32_t) (seq - pos);
+
+        if (diff == 0) {
+            /* Slot is free for this lap: try to claim it */
+            if (UDS_ATOMIC_CAS(&mb->enqueue_pos, &pos, pos + 1u)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            /* The owner has not consumed this slot yet: full */
+            (void) UDS_ATOMIC_FETCH_ADD(&mb->dropped, 1u);
+            return UDS_ERR_MAILBOX_FULL;
+        }
+        else {
+            /* Another producer claimed it first */
+            pos = UDS_ATOMIC_LOAD_RELAXED(&mb->enqueue_pos);
+        }
+    }
+
+    mail->kind = kind;
+    mail->addr = addr;
+    mail->len = (uint16_t) len;
+    mail->result = result;
+    mail->ptr = ptr;
+
+    uint8_t *dst = &mb->data[(pos & mb->mask) * mb->slot_size];
+    for (uint8_t i = 0u; i < count; i++) {
+        if (iov[i].len > 0u) {
+            memcpy(dst, iov[i].base, iov[i].len);
+            dst += iov[i].len;
+        }
+    }
+
+    /* Publish: the owner may now consume the slot */
+    UDS_ATOMIC_STORE_RELEASE(&mail->seq, pos + 1u);
+
+    if (mb->fn_notify != NULL) {
+        mb->fn_notify(mb->notify_arg);
+    }
+    return UDS_OK;
+}
+
+#endif /* UDS_CFG_FEATURE_MAILBOX */
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_nvm_journal.c
+ * @brief Log-Structured NVM Journal for DTC Status
+ *
+ * Sector layout: [header][checkpoint][record]...[0xFF...]. The header holds
+ * "UJ" and the sector generation, the checkpoint the count of DTCs, their
+ * status bytes and their occurrence counters, and each record after it one
+ * status change ([index hi][lo][status][occurrences]) or a clear of all
+ * DTCs (no payload). Compaction erases the other sector and writes a new
+ * header and checkpoint there; the old sector stays valid until that
+ * checkpoint is complete, so a reset at any point leaves one sector to
+ * recover from. In uds_process() the erase runs as a background job and
+ * only the checkpoint is written under the context lock; records appended
+ * meanwhile still go to the old sector and end up in the checkpoint.
+ */
+
+#include <string.h>
+
+#include "uds/uds_nvm_journal.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_DTC
+
+#define TYPE_HEADER 0x01u
+#define TYPE_CHECKPOINT 0x02u
+#define TYPE_STATUS 0x03u
+#define TYPE_CLEAR 0x04u
+#define TYPE_ERASED 0xFFu
+
+#define FRAME 5u /* type, length (2), CRC (2) */
+#define CHUNK 32u
+
+#define REC_VALID 0
+#define REC_END 1
+#define REC_DAMAGED 2
+
+typedef struct
+{
+    bool valid;          /* Header and a checkpoint found */
+    bool damaged;        /* Scan stopped at a record with a bad CRC */
+    uint32_t seq;        /* Generation from the header */
+    uint32_t checkpoint; /* Offset of the last checkpoint */
+    uint32_t end;        /* Offset after the last valid record */
+} journal_scan_t;
+
+/* --- Internal Helpers --- */
+
+/* CRC-16/CCITT-FALSE, four bits at a time */
+static uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+    static const uint16_t nibble[16] = {0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u,
+                                        0x60C6u, 0x70E7u, 0x8108u, 0x9129u, 0xA14Au, 0xB16Bu,
+                                        0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu};
+    for (uint32_t i = 0u; i < len; i++) {
+        crc = (uint16_t) ((crc << 4u) ^ nibble[((crc >> 12u) ^ (data[i] >> 4u)) & 0x0Fu]);
+        crc = (uint16_t) ((crc << 4u) ^ nibble[((crc >> 12u) ^ data[i]) & 0x0Fu]);
+    }
+    return crc;
+}
+
+static uint16_t chunk_len(uint32_t left)
+{
+    return (uint16_t) ((left < CHUNK) ? left : CHUNK);
+}
+
+static uint32_t sector_base(const uds_nvm_journal_t *journal, uint8_t sector)
+{
+    return (uint32_t) sector * journal->flash->sector_size;
+}
+
+/* Write len bytes at *addr and fold them into *crc */
+static int emit(const uds_nvm_journal_t *journal, uint32_t *addr, const uint8_t *data,
+                uint16_t len, uint16_t *crc)
+{
+    int res = journal->flash->fn_write(journal->flash->dev, *addr, data, len);
+    if (res == UDS_OK) {
+        *addr += len;
+        *crc = crc16(*crc, data, len);
+    }
+    return res;
+}
+
+/* Write a small record at *addr with one flash write */
+static int put_record(const uds_nvm_journal_t *journal, uint32_t *addr, uint8_t type,
+                      const uint8_t *payload, uint8_t len)
+{
+    uint8_t buf[FRAME + 8u];
+    buf[0] = type;
+    buf[1] = 0u;
+    buf[2] = len;
+    if (len > 0u) {
+        memcpy(&buf[3], payload, len);
+    }
+    uint16_t crc = crc16(0xFFFFu, buf, 3u + (uint32_t) len);
+    buf[3u + len] = (uint8_t) (crc >> 8u);
+    buf[4u + len] = (uint8_t) crc;
+
+    int res = journal->flash->fn_write(journal->flash->dev, *addr, buf, (uint16_t) (len + FRAME));
+    if (res == UDS_OK) {
+        *addr += (uint32_t) len + FRAME;
+    }
+    return res;
+}
+
+/* Checkpoint of the whole store at *addr, streamed from the store arrays */
+static int put_checkpoint(const uds_nvm_journal_t *journal, const uds_dtc_store_t *store,
+                          uint32_t *addr)
+{
+    static const uint8_t zeros[CHUNK] = {0};
+    uint32_t len = UDS_NVM_JOURNAL_CHECKPOINT(store->count) - FRAME;
+    const uint8_t head[5] = {TYPE_CHECKPOINT, (uint8_t) (len >> 8u), (uint8_t) len,
+                             (uint8_t) (store->count >> 8u), (uint8_t) store->count};
+    const uint8_t *occurrences = (store->records != NULL) ? store->records->occurrences : NULL;
+    uint16_t crc = 0xFFFFu;
+
+    int res = emit(journal, addr, head, sizeof(head), &crc);
+    if ((res == UDS_OK) && (store->count > 0u)) {
+        res = emit(journal, addr, store->status, store->count, &crc);
+    }
+    if ((res == UDS_OK) && (occurrences != NULL) && (store->count > 0u)) {
+        res = emit(journal, addr, occurrences, store->count, &crc);
+    }
+    for (uint16_t done = 0u; (res == UDS_OK) && (occurrences == NULL) && (done < store->count);) {
+        uint16_t n = chunk_len((uint32_t) store->count - done);
+        res = emit(journal, addr, zeros, n, &crc);
+        done = (uint16_t) (done + n);
+    }
+    if (res == UDS_OK) {
+        const uint8_t tail[2] = {(uint8_t) (crc >> 8u), (uint8_t) crc};
+        res = journal->flash->fn_write(journal->flash->dev, *addr, tail, sizeof(tail));
+        *addr += (res == UDS_OK) ? 2u : 0u;
+    }
+    return res;
+}
+
+/* Type and payload length of the record at addr, with its CRC checked */
+static int check_record(const uds_nvm_journal_t *journal, uint32_t addr, uint32_t room,
+                        uint8_t *type, uint16_t *len)
+{
+    const uds_nvm_flash_t *flash = journal->flash;
+    uint8_t buf[CHUNK];
+
+    if (room < FRAME) {
+        return REC_END;
+    }
+    int res = flash->fn_read(flash->dev, addr, buf, 3u);
+    if (res != UDS_OK) {
+        return res;
+    }
+    if (buf[0] == TYPE_ERASED) {
+        return REC_END;
+    }
+    *type = buf[0];
+    *len = (uint16_t) ((buf[1] << 8u) | buf[2]);
+    if ((uint32_t) *len + FRAME > room) {
+        return REC_DAMAGED;
+    }
+
+    uint16_t crc = crc16(0xFFFFu, buf, 3u);
+    uint32_t left = *len;
+    addr += 3u;
+    while (left > 0u) {
+        uint16_t n = chunk_len(left);
+        res = flash->fn_read(flash->dev, addr, buf, n);
+        if (res != UDS_OK) {
+            return res;
+        }
+        crc = crc16(crc, buf, n);
+        addr += n;
+        left -= n;
+    }
+    res = flash->fn_read(flash->dev, addr, buf, 2u);
+    if (res != UDS_OK) {
+        return res;
+    }
+    return (crc == (uint16_t) ((buf[0] << 8u) | buf[1])) ? REC_VALID : REC_DAMAGED;
+}
+
+/* Find the header, the last checkpoint and the end of the log of a sector */
+static int scan(const uds_nvm_journal_t *journal, uint8_t sector, journal_scan_t *out)
+{
+    uint32_t base = sector_base(journal, sector);
+    uint32_t size = journal->flash->sector_size;
+    uint8_t type = 0u;
+    uint16_t len = 0u;
+
+    memset(out, 0, sizeof(*out));
+    int res = check_record(journal, base, size, &type, &len);
+    if (res < 0) {
+        return res;
+    }
+    if ((res != REC_VALID) || (type != TYPE_HEADER) || (len != UDS_NVM_JOURNAL_HEADER - FRAME)) {
+        return UDS_OK; /* Blank or not a journal */
+    }
+    uint8_t hdr[6];
+    res = journal->flash->fn_read(journal->flash->dev, base + 3u, hdr, sizeof(hdr));
+    if (res != UDS_OK) {
+        return res;
+    }
+    if ((hdr[0] != 'U') || (hdr[1] != 'J')) {
+        return UDS_OK;
+    }
+    out->seq = ((uint32_t) hdr[2] << 24u) | ((uint32_t) hdr[3] << 16u) |
+               ((uint32_t) hdr[4] << 8u) | hdr[5];
+
+    uint32_t pos = UDS_NVM_JOURNAL_HEADER;
+    for (;;) {
+        res = check_record(journal, base + pos, size - pos, &type, &len);
+        if (res < 0) {
+            return res;
+        }
+        if (res != REC_VALID) {
+            out->damaged = (res == REC_DAMAGED);
+            break;
+        }
+        if (type == TYPE_CHECKPOINT) {
+            out->checkpoint = pos;
+            out->valid = true;
+        }
+        pos += (uint32_t) len + FRAME;
+    }
+    out->end = pos;
+    return UDS_OK;
+}
+
+/* Apply the checkpoint and the records after it; *mismatch if the DTC count differs */
+static int load(uds_nvm_journal_t *journal, uds_dtc_store_t *store, uint8_t sector,
+                const journal_scan_t *sc, bool *mismatch)
+{
+    const uds_nvm_flash_t *flash = journal->flash;
+    uint8_t *occurrences = (store->records != NULL) ? store->records->occurrences : NULL;
+    uint32_t base = sector_base(journal, sector);
+    uint8_t buf[CHUNK];
+
+    int res = flash->fn_read(flash->dev, base + sc->checkpoint + 3u, buf, 2u);
+    if (res != UDS_OK) {
+        return res;
+    }
+    uint16_t count = (uint16_t) ((buf[0] << 8u) | buf[1]);
+    uint16_t used = (count < store->count) ? count : store->count;
+    *mismatch = (count != store->count);
+
+    /* Status bytes, then occurrence counters, CHUNK at a time */
+    uint32_t addr = base + sc->checkpoint + 5u;
+    for (uint8_t part = 0u; part < 2u; part++) {
+        for (uint16_t i = 0u; i < used;) {
+            uint16_t n = chunk_len((uint32_t) used - i);
+            res = flash->fn_read(flash->dev, addr + i, buf, n);
+            if (res != UDS_OK) {
+                return res;
+            }
+            for (uint16_t k = 0u; k < n; k++) {
+                if (part == 0u) {
+                    uds_internal_dtc_load(store, (uint16_t) (i + k), buf[k]);
+                }
+                else if (occurrences != NULL) {
+                    occurrences[i + k] = buf[k];
+                }
+            }
+            i = (uint16_t) (i + n);
+        }
+        addr += count;
+    }
+
+    addr = sc->checkpoint + UDS_NVM_JOURNAL_CHECKPOINT(count);
+    journal->replayed = 0u;
+    while (addr < sc->end) {
+        res = flash->fn_read(flash->dev, base + addr, buf, 3u);
+        if (res != UDS_OK) {
+            return res;
+        }
+        uint8_t type = buf[0];
+        uint16_t len = (uint16_t) ((buf[1] << 8u) | buf[2]);
+        if ((type == TYPE_STATUS) && (len == 4u)) {
+            res = flash->fn_read(flash->dev, base + addr + 3u, buf, 4u);
+            if (res != UDS_OK) {
+                return res;
+            }
+            uint16_t idx = (uint16_t) ((buf[0] << 8u) | buf[1]);
+            if (idx < store->count) {
+                uds_internal_dtc_load(store, idx, buf[2]);
+                if (occurrences != NULL) {
+                    occurrences[idx] = buf[3];
+                }
+            }
+            journal->replayed++;
+        }
+        else if (type == TYPE_CLEAR) {
+            uint8_t cleared = (uint8_t) (UDS_DTC_STATUS_CLEARED & store->availability_mask);
+            for (uint16_t i = 0u; i < store->count; i++) {
+                uds_internal_dtc_load(store, i, cleared);
+            }
+            if (occurrences != NULL) {
+                memset(occurrences, 0, store->count);
+            }
+            journal->replayed++;
+        }
+        addr += (uint32_t) len + FRAME;
+    }
+    return UDS_OK;
+}
+
+/* Erase the sector the next checkpoint goes to */
+static int erase_target(const uds_nvm_journal_t *journal)
+{
+    return journal->flash->fn_erase(journal->flash->dev,
+                                    sector_base(journal, (uint8_t) (journal->active ^ 1u)));
+}
+
+/* Header and checkpoint in the erased other sector, which then becomes the active one */
+static int write_checkpoint(uds_nvm_journal_t *journal, const uds_dtc_store_t *store)
+{
+    uint8_t target = (uint8_t) (journal->active ^ 1u);
+    uint32_t base = sector_base(journal, target);
+    uint32_t seq = journal->seq + 1u;
+    const uint8_t hdr[6] = {'U', 'J', (uint8_t) (seq >> 24u), (uint8_t) (seq >> 16u),
+                            (uint8_t) (seq >> 8u), (uint8_t) seq};
+    uint32_t addr = base;
+
+    int res = put_record(journal, &addr, TYPE_HEADER, hdr, sizeof(hdr));
+    if (res == UDS_OK) {
+        res = put_checkpoint(journal, store, &addr);
+    }
+    if (res != UDS_OK) {
+        journal->errors++;
+        journal->compact_due = true;
+        return res;
+    }
+    journal->active = target;
+    journal->seq = seq;
+    journal->pos = addr - base;
+    journal->compact_due = false;
+    journal->compactions++;
+    return UDS_OK;
+}
+
+static int compact(uds_nvm_journal_t *journal, const uds_dtc_store_t *store)
+{
+    int res = erase_target(journal);
+    if (res != UDS_OK) {
+        journal->errors++;
+        journal->compact_due = true;
+        return res;
+    }
+    return write_checkpoint(journal, store);
+}
+
+#if UDS_CFG_FEATURE_JOB
+/* Executor side: the slow part of a compaction */
+static int erase_work(uds_job_t *job)
+{
+    return erase_target((const uds_nvm_journal_t *) job->user_data);
+}
+
+/* Context side: checkpoint into the erased sector; a failed erase is retried */
+static int erase_complete(uds_ctx_t *ctx, uds_job_t *job, int result)
+{
+    uds_nvm_journal_t *journal = (uds_nvm_journal_t *) job->user_data;
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+
+    journal->erasing = false;
+    if (result != UDS_OK) {
+        journal->errors++;
+    }
+    else if ((store != NULL) && (store->journal == journal)) {
+        (void) write_checkpoint(journal, store);
+    }
+    return 0;
+}
+#endif
+
+/* --- Internal API --- */
+
+void uds_internal_nvm_journal_append(uds_dtc_store_t *store, int idx)
+{
+    uds_nvm_journal_t *journal = store->journal;
+    if (!journal->ready) {
+        return;
+    }
+    uint32_t size = journal->flash->sector_size;
+    if (journal->pos + UDS_NVM_JOURNAL_RECORD > size) {
+        /* No room left: the next checkpoint carries the change */
+        journal->compact_due = true;
+        return;
+    }
+
+    uint32_t addr = sector_base(journal, journal->active) + journal->pos;
+    int res;
+    if (idx < 0) {
+        res = put_record(journal, &addr, TYPE_CLEAR, NULL, 0u);
+    }
+    else {
+        const uint8_t *occurrences =
+            (store->records != NULL) ? store->records->occurrences : NULL;
+        const uint8_t payload[4] = {(uint8_t) ((uint32_t) idx >> 8u), (uint8_t) idx,
+                                    store->status[idx],
+                                    (occurrences != NULL) ? occurrences[idx] : 0u};
+        res = put_record(journal, &addr, TYPE_STATUS, payload, sizeof(payload));
+    }
+    if (res != UDS_OK) {
+        /* The bytes after pos may be half written: stop appending to this sector */
+        journal->errors++;
+        journal->pos = size;
+        journal->compact_due = true;
+        return;
+    }
+    journal->pos = addr - sector_base(journal, journal->active);
+    journal->appended++;
+    if (size - journal->pos < journal->reserve) {
+        journal->compact_due = true;
+    }
+}
+
+void uds_internal_nvm_journal_process(uds_ctx_t *ctx)
+{
+    uds_dtc_store_t *store = ctx->config->dtc_store;
+    if ((store == NULL) || (store->journal == NULL) || !store->journal->ready ||
+        !store->journal->compact_due) {
+        return;
+    }
+    uds_nvm_journal_t *journal = store->journal;
+
+#if UDS_CFG_FEATURE_JOB
+    /* The erase takes the longest: keep it off the context lock */
+    if (journal->erasing) {
+        return;
+    }
+    journal->erasing = true;
+    journal->job.work = erase_work;
+    journal->job.complete = erase_complete;
+    journal->job.user_data = journal;
+    if (!uds_internal_job_start(ctx, &journal->job)) {
+        journal->erasing = false; /* Executor full: retried by the next uds_process() */
+    }
+#else
+    (void) compact(journal, store);
+#endif
+}
+
+/* --- Public API --- */
+
+void uds_nvm_journal_init(uds_nvm_journal_t *journal, const uds_nvm_flash_t *flash)
+{
+    if (journal == NULL) {
+        return;
+    }
+    memset(journal, 0, sizeof(*journal));
+    journal->flash = flash;
+    journal->reserve = (uint16_t) (16u * UDS_NVM_JOURNAL_RECORD);
+}
+
+int uds_nvm_journal_restore(uds_dtc_store_t *store)
+{
+    if ((store == NULL) || (store->journal == NULL) || (store->journal->flash == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    uds_nvm_journal_t *journal = store->journal;
+    const uds_nvm_flash_t *flash = journal->flash;
+    if ((flash->fn_read == NULL) || (flash->fn_write == NULL) || (flash->fn_erase == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    uint32_t checkpoint = UDS_NVM_JOURNAL_CHECKPOINT(store->count);
+    if ((checkpoint - FRAME > 0xFFFFu) ||
+        (UDS_NVM_JOURNAL_HEADER + checkpoint + journal->reserve + UDS_NVM_JOURNAL_RECORD >
+         flash->sector_size)) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    journal_scan_t sc[2];
+    for (uint8_t s = 0u; s < 2u; s++) {
+        int res = scan(journal, s, &sc[s]);
+        if (res != UDS_OK) {
+            return res;
+        }
+    }
+
+    /* Newest sector with a complete checkpoint; an interrupted compaction has none */
+    uint8_t first = (sc[1].seq > sc[0].seq) ? 1u : 0u;
+    uint8_t order[2] = {first, (uint8_t) (first ^ 1u)};
+    bool found = false;
+    bool mismatch = false;
+    journal->ready = false;
+    journal->replayed = 0u;
+    for (uint8_t i = 0u; (i < 2u) && !found; i++) {
+        const journal_scan_t *cand = &sc[order[i]];
+        if (cand->valid) {
+            int res = load(journal, store, order[i], cand, &mismatch);
+            if (res != UDS_OK) {
+                return res;
+            }
+            journal->active = order[i];
+            journal->seq = cand->seq;
+            journal->pos = cand->end;
+            found = true;
+        }
+    }
+    if (!found) {
+        /* Blank flash: the first compaction formats sector 0 */
+        journal->active = 1u;
+        journal->seq = (sc[0].seq > sc[1].seq) ? sc[0].seq : sc[1].seq;
+    }
+    journal->ready = true;
+
+    if (!found || mismatch || sc[journal->active].damaged ||
+        (flash->sector_size - journal->pos < journal->reserve)) {
+        return compact(journal, store);
+    }
+    journal->compact_due = false;
+    return UDS_OK;
+}
+
+int uds_nvm_journal_compact(uds_dtc_store_t *store)
+{
+    if ((store == NULL) || (store->journal == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (!store->journal->ready) {
+        return UDS_ERR_NOT_INIT;
+    }
+#if UDS_CFG_FEATURE_JOB
+    if (store->journal->erasing) {
+        return UDS_ERR_BUSY;
+    }
+#endif
+    return compact(store->journal, store);
+}
+
+#endif /* UDS_CFG_FEATURE_DTC */
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_periodic.c
+ * @brief Periodic Data Scheduler (SID 0x2A)
+ *
+ * Binary min-heap of the scheduled IDs keyed by deadline: the next due ID is
+ * entries[0], a transmission is one sift-down. Start and stop look the ID up
+ * linearly; they only run on 0x2A requests.
+ */
+
+#include <string.h>
+
+#include "uds/uds_periodic.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_PERIODIC
+
+/* --- Internal Helpers --- */
+
+/* Scheduler in use: the configured one or the built-in slots of the context */
+static uds_periodic_entry_t *heap_of(uds_ctx_t *ctx, uint16_t **count, uint16_t *capacity)
+{
+    uds_periodic_t *sched = ctx->config->periodic;
+    if (sched != NULL) {
+        *count = &sched->count;
+        *capacity = sched->capacity;
+        return sched->entries;
+    }
+    *count = &ctx->periodic_count;
+    *capacity = UDS_PERIODIC_BUILTIN_SLOTS;
+    return ctx->periodic_slots;
+}
+
+static bool due_before(const uds_periodic_entry_t *a, const uds_periodic_entry_t *b)
+{
+    return (int32_t) (a->deadline - b->deadline) < 0;
+}
+
+static void swap(uds_periodic_entry_t *heap, uint16_t a, uint16_t b)
+{
+    uds_periodic_entry_t tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+static void sift_up(uds_periodic_entry_t *heap, uint16_t i)
+{
+    while (i > 0u) {
+        uint16_t parent = (uint16_t) ((i - 1u) / 2u);
+        if (!due_before(&heap[i], &heap[parent])) {
+            break;
+        }
+        swap(heap, i, parent);
+        i = parent;
+    }
+}
+
+static void sift_down(uds_periodic_entry_t *heap, uint16_t count, uint16_t i)
+{
+    for (;;) {
+        uint32_t child = (2u * (uint32_t) i) + 1u;
+        if (child >= count) {
+            break;
+        }
+        if (((child + 1u) < count) && due_before(&heap[child + 1u], &heap[child])) {
+            child++;
+        }
+        if (!due_before(&heap[child], &heap[i])) {
+            break;
+        }
+        swap(heap, i, (uint16_t) child);
+        i = (uint16_t) child;
+    }
+}
+
+static int find(const uds_periodic_entry_t *heap, uint16_t count, uint8_t periodic_id)
+{
+    for (uint16_t i = 0u; i < count; i++) {
+        if (heap[i].id == periodic_id) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+static uint32_t interval_of(const uds_ctx_t *ctx, uint8_t rate)
+{
+    static const uint16_t defaults[3] = {UDS_PERIODIC_FAST_INTERVAL_MS,
+                                         UDS_PERIODIC_MEDIUM_INTERVAL_MS,
+                                         UDS_PERIODIC_SLOW_INTERVAL_MS};
+    const uds_periodic_t *sched = ctx->config->periodic;
+    uint8_t mode = (uint8_t) (rate - 1u);
+
+    if ((sched != NULL) && (sched->interval_ms[mode] != 0u)) {
+        return sched->interval_ms[mode];
+    }
+    return defaults[mode];
+}
+
+/* Buffer of the next message: the frames of the scheduler in turn, else the built-in one */
+static uint8_t *next_frame(uds_ctx_t *ctx, uint16_t *size)
+{
+    uds_periodic_t *sched = ctx->config->periodic;
+    if ((sched == NULL) || (sched->frames == NULL)) {
+        *size = UDS_PERIODIC_FRAME_LEN;
+        return ctx->periodic_frame;
+    }
+    uint8_t *frame = &sched->frames[(uint32_t) sched->frame_next * sched->frame_size];
+    sched->frame_next = (uint8_t) ((sched->frame_next + 1u) % sched->frame_count);
+    *size = sched->frame_size;
+    return frame;
+}
+
+/* [periodic_id][data] straight from the read callback into a periodic frame; false if missed */
+static bool transmit(uds_ctx_t *ctx, uds_periodic_entry_t *entry, uint32_t late)
+{
+    const uds_periodic_t *sched = ctx->config->periodic;
+    uint16_t size;
+    uint8_t *frame = next_frame(ctx, &size);
+    uint16_t max_len = (uint16_t) (size - 1u);
+    if ((sched != NULL) && (sched->max_len != 0u) && (sched->max_len < max_len)) {
+        max_len = sched->max_len;
+    }
+
+    int written = ctx->config->fn_periodic_read(ctx, entry->id, &frame[1], max_len);
+    if ((written <= 0) || (written > (int) max_len)) {
+        return true; /* Nothing to send this period */
+    }
+    frame[0] = entry->id;
+
+    /* Raw hook: no ISO-TP, no contention with a response in progress */
+    int res = (ctx->config->fn_periodic_send != NULL)
+                  ? ctx->config->fn_periodic_send(ctx, frame, (uint16_t) (written + 1))
+                  : ctx->config->fn_tp_send(ctx, frame, (uint16_t) (written + 1));
+    if (res < 0) {
+        return false;
+    }
+
+    entry->sent++;
+    entry->last_jitter_ms = (late > 0xFFFFu) ? 0xFFFFu : (uint16_t) late;
+    if (entry->last_jitter_ms > entry->max_jitter_ms) {
+        entry->max_jitter_ms = entry->last_jitter_ms;
+    }
+    return true;
+}
+
+/* --- Internal API --- */
+
+int uds_internal_periodic_start(uds_ctx_t *ctx, uint8_t periodic_id, uint8_t rate, uint32_t now)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    uds_periodic_entry_t *heap = heap_of(ctx, &count, &capacity);
+
+    int i = find(heap, *count, periodic_id);
+    if (i >= 0) {
+        /* New rate from the next transmission on */
+        heap[i].rate = rate;
+        return UDS_OK;
+    }
+    if (*count >= capacity) {
+        return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+    }
+
+    uds_periodic_entry_t *entry = &heap[*count];
+    memset(entry, 0, sizeof(*entry));
+    entry->id = periodic_id;
+    entry->rate = rate;
+    entry->deadline = now;
+    sift_up(heap, (*count)++);
+    return UDS_OK;
+}
+
+bool uds_internal_periodic_active(uds_ctx_t *ctx, uint8_t periodic_id)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    const uds_periodic_entry_t *heap = heap_of(ctx, &count, &capacity);
+    return find(heap, *count, periodic_id) >= 0;
+}
+
+uint16_t uds_internal_periodic_free(uds_ctx_t *ctx)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    (void) heap_of(ctx, &count, &capacity);
+    return (uint16_t) (capacity - *count);
+}
+
+void uds_internal_periodic_stop(uds_ctx_t *ctx, uint8_t periodic_id)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    uds_periodic_entry_t *heap = heap_of(ctx, &count, &capacity);
+
+    int i = find(heap, *count, periodic_id);
+    if (i < 0) {
+        return;
+    }
+    (*count)--;
+    if ((uint16_t) i < *count) {
+        heap[i] = heap[*count];
+        sift_down(heap, *count, (uint16_t) i);
+        sift_up(heap, (uint16_t) i);
+    }
+}
+
+void uds_internal_periodic_stop_all(uds_ctx_t *ctx)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    (void) heap_of(ctx, &count, &capacity);
+    *count = 0u;
+}
+
+void uds_internal_periodic_process(uds_ctx_t *ctx, uint32_t now)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    uds_periodic_entry_t *heap = heap_of(ctx, &count, &capacity);
+
+    if (ctx->config->fn_periodic_read == NULL) {
+        return;
+    }
+
+    /* Every rescheduled deadline is after now: each ID is sent at most once per call */
+    while ((*count > 0u) && ((int32_t) (now - heap[0].deadline) >= 0)) {
+        uds_periodic_entry_t *entry = &heap[0];
+        uint32_t late = now - entry->deadline;
+        uint32_t interval = interval_of(ctx, entry->rate);
+
+        /* Behind by whole intervals: serve the latest slot only, the others are missed */
+        if (late >= interval) {
+            uint32_t missed = late / interval;
+            entry->overruns += missed;
+            entry->deadline += missed * interval;
+            late -= missed * interval;
+        }
+
+        if (!transmit(ctx, entry, late)) {
+            entry->overruns++;
+        }
+
+        /* Next slot of the same grid: a late tick does not shift it */
+        entry->deadline += interval;
+        sift_down(heap, *count, 0u);
+    }
+}
+
+bool uds_internal_periodic_next(uds_ctx_t *ctx, uint32_t *deadline)
+{
+    uint16_t *count;
+    uint16_t capacity;
+    const uds_periodic_entry_t *heap = heap_of(ctx, &count, &capacity);
+
+    if (*count == 0u) {
+        return false;
+    }
+    *deadline = heap[0].deadline;
+    return true;
+}
+
+#endif /* UDS_CFG_FEATURE_PERIODIC */
+
+/* --- Public API --- */
+
+void uds_periodic_init(uds_periodic_t *sched, uds_periodic_entry_t *entries, uint16_t capacity)
+{
+    if (sched == NULL) {
+        return;
+    }
+    memset(sched, 0, sizeof(*sched));
+    sched->entries = entries;
+    sched->capacity = capacity;
+    sched->interval_ms[0] = UDS_PERIODIC_FAST_INTERVAL_MS;
+    sched->interval_ms[1] = UDS_PERIODIC_MEDIUM_INTERVAL_MS;
+    sched->interval_ms[2] = UDS_PERIODIC_SLOW_INTERVAL_MS;
+}
+
+int uds_periodic_get(const uds_ctx_t *ctx, uint8_t periodic_id, uds_periodic_entry_t *out)
+{
+#if UDS_CFG_FEATURE_PERIODIC
+    if ((ctx == NULL) || (ctx->config == NULL) || (out == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    const uds_periodic_t *sched = ctx->config->periodic;
+    const uds_periodic_entry_t *heap = (sched != NULL) ? sched->entries : ctx->periodic_slots;
+    uint16_t count = (sched != NULL) ? sched->count : ctx->periodic_count;
+
+    int i = find(heap, count, periodic_id);
+    if (i < 0) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    *out = heap[i];
+    return UDS_OK;
+#else
+    (void) ctx;
+    (void) periodic_id;
+    (void) out;
+    return UDS_ERR_INVALID_ARG;
+#endif
+}
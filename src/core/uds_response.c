@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_response.c
+ * @brief Zero-Copy Response Writer Implementation
+ */
+
+#include <string.h>
+
+#include "uds/uds_response.h"
+#include "uds_internal.h"
+
+/* --- Public API --- */
+
+int uds_response_begin(uds_response_t *resp, uds_ctx_t *ctx, uint8_t sid)
+{
+    if ((resp == NULL) || (ctx == NULL) || (ctx->config == NULL) ||
+        (uds_tx_buffer(ctx) == NULL) || (uds_tx_buffer_size(ctx) == 0u)) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    memset(resp, 0, sizeof(*resp));
+    resp->ctx = ctx;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (sid + UDS_RESPONSE_OFFSET);
+    resp->seg[0].base = uds_tx_buffer(ctx);
+    resp->seg[0].len = 1u;
+    resp->count = 1u;
+    resp->used = 1u;
+    resp->total = 1u;
+    return UDS_OK;
+}
+
+uint8_t *uds_response_reserve(uds_response_t *resp, uint16_t len)
+{
+    uint8_t *tx = uds_tx_buffer(resp->ctx);
+
+    if ((resp->stream_fn != NULL) ||
+        ((uint32_t) resp->used + len > uds_tx_buffer_size(resp->ctx)) ||
+        ((uint32_t) resp->total + len > 0xFFFFu)) {
+        resp->overflow = true;
+        return NULL;
+    }
+
+    uint8_t *dst = &tx[resp->used];
+    uds_iovec_t *last = &resp->seg[resp->count - 1u];
+
+    if ((last->base + last->len) == dst) {
+        /* Contiguous with the previous tx_buffer piece */
+        last->len = (uint16_t) (last->len + len);
+    }
+    else if (resp->count < UDS_RESPONSE_MAX_SEGMENTS) {
+        resp->seg[resp->count].base = dst;
+        resp->seg[resp->count].len = len;
+        resp->count++;
+    }
+    else {
+        resp->overflow = true;
+        return NULL;
+    }
+
+    resp->used = (uint16_t) (resp->used + len);
+    resp->total = (uint16_t) (resp->total + len);
+    return dst;
+}
+
+int uds_response_append(uds_response_t *resp, const uint8_t *data, uint16_t len)
+{
+    uint8_t *dst = uds_response_reserve(resp, len);
+    if (dst == NULL) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+    if (len > 0u) {
+        memcpy(dst, data, len);
+    }
+    return UDS_OK;
+}
+
+int uds_response_ref(uds_response_t *resp, const uint8_t *data, uint16_t len)
+{
+    if ((resp->ctx->config->fn_tp_sendv == NULL) || (resp->count >= UDS_RESPONSE_MAX_SEGMENTS)) {
+        return uds_response_append(resp, data, len);
+    }
+
+    if (resp->stream_fn != NULL) {
+        resp->overflow = true;
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    if ((uint32_t) resp->total + len > 0xFFFFu) {
+        resp->overflow = true;
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    resp->seg[resp->count].base = data;
+    resp->seg[resp->count].len = len;
+    resp->count++;
+    resp->total = (uint16_t) (resp->total + len);
+    return UDS_OK;
+}
+
+int uds_response_stream(uds_response_t *resp, uint32_t start, uint32_t len, uds_stream_fn fn,
+                        void *arg)
+{
+    uds_ctx_t *ctx = resp->ctx;
+
+    if ((resp->stream_fn != NULL) || (fn == NULL)) {
+        resp->overflow = true;
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    if ((uint32_t) resp->used + len <= uds_tx_buffer_size(ctx)) {
+        /* Fits: produce the body in place */
+        uint8_t *dst = uds_response_reserve(resp, (uint16_t) len);
+        if (dst == NULL) {
+            return UDS_ERR_BUFFER_TOO_SMALL;
+        }
+        int res = (len > 0u) ? fn(ctx, arg, start, dst, (uint16_t) len) : UDS_OK;
+        if (res < 0) {
+            resp->nrc = (uint8_t) - (int32_t) res;
+            return UDS_ERR_INVALID_ARG;
+        }
+        return UDS_OK;
+    }
+
+    if (!uds_internal_can_stream(ctx) || (resp->count != 1u) ||
+        (resp->used > UDS_STREAM_HEAD_MAX) || ((uint32_t) resp->used + len < len)) {
+        resp->overflow = true;
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    resp->stream_fn = fn;
+    resp->stream_arg = arg;
+    resp->stream_start = start;
+    resp->stream_len = len;
+    return UDS_OK;
+}
+
+int uds_response_commit(uds_response_t *resp)
+{
+    uds_ctx_t *ctx = resp->ctx;
+    uint8_t sid = (uint8_t) (uds_tx_buffer(ctx)[0] - UDS_RESPONSE_OFFSET);
+
+    if (resp->nrc != 0u) {
+        return uds_send_nrc(ctx, sid, resp->nrc);
+    }
+
+    if (resp->overflow) {
+        return uds_send_nrc(ctx, sid, UDS_NRC_RESPONSE_TOO_LONG);
+    }
+
+#if UDS_CFG_FEATURE_STREAM
+    if (resp->stream_fn != NULL) {
+        uds_stream_t *st = &ctx->stream;
+        uint32_t total = resp->used + resp->stream_len;
+
+        if (!uds_internal_response_prepare(ctx, (uint16_t) ((total > 0xFFFFu) ? 0xFFFFu : total))) {
+            return UDS_OK; /* Suppressed */
+        }
+
+        memcpy(st->head, uds_tx_buffer(ctx), resp->used);
+        st->head_len = (uint8_t) resp->used;
+        st->fn = resp->stream_fn;
+        st->arg = resp->stream_arg;
+        st->start = resp->stream_start;
+        st->len = total;
+        st->pos = 0u;
+        st->active = true;
+
+        int res = ctx->config->fn_tp_send_stream(ctx, total);
+        if (res != 0) {
+            st->active = false;
+        }
+        return res;
+    }
+#endif
+
+    if (resp->count == 1u) {
+        /* Everything is in the tx_buffer: regular send */
+        return uds_send_response(ctx, resp->used);
+    }
+
+    if (!uds_internal_response_prepare(ctx, resp->total)) {
+        return UDS_OK; /* Suppressed */
+    }
+    return ctx->config->fn_tp_sendv(ctx, resp->seg, resp->count, resp->total);
+}
+
+#if UDS_CFG_FEATURE_STREAM
+int uds_stream_pull(uds_ctx_t *ctx, uint8_t *buf, uint16_t max)
+{
+    if ((ctx == NULL) || (buf == NULL) || !ctx->stream.active) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    uds_stream_t *st = &ctx->stream;
+    uint32_t left = st->len - st->pos;
+    uint16_t n = (left < max) ? (uint16_t) left : max;
+    uint16_t done = 0u;
+
+    /* Bytes written before the body */
+    while ((done < n) && (st->pos < st->head_len)) {
+        buf[done++] = st->head[st->pos++];
+    }
+
+    if (done < n) {
+        uint16_t body = (uint16_t) (n - done);
+        int res = st->fn(ctx, st->arg, st->start + (st->pos - st->head_len), &buf[done], body);
+        if (res < 0) {
+            st->active = false;
+            return UDS_ERR_INVALID_ARG;
+        }
+        st->pos += body;
+    }
+
+    if (st->pos == st->len) {
+        st->active = false;
+    }
+    return n;
+}
+
+int uds_stream_pull_locked(uds_ctx_t *ctx, uint8_t *buf, uint16_t max)
+{
+    if ((ctx == NULL) || (ctx->config == NULL)) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    /* The producer reads server state that handlers change under the lock */
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    int n = uds_stream_pull(ctx, buf, max);
+
+    if (ctx->config->fn_mutex_unlock != NULL) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+    return n;
+}
+#endif /* UDS_CFG_FEATURE_STREAM */
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_roe.c
+ * @brief ResponseOnEvent Engine (SID 0x86)
+ *
+ * Events are evaluated in uds_process(). A DID is read only when one of its
+ * events is dirty or polled, and its value is reduced to an FNV-1a hash: an
+ * unchanged value costs one read and one hash, never a compare of the whole
+ * value or a response.
+ */
+
+#include <string.h>
+
+#include "uds/uds_roe.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_SERVICE_86
+
+/* --- Internal Helpers --- */
+
+static uint32_t hash_value(const uint8_t *data, uint16_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0u; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool watches_did(const uds_roe_event_t *event)
+{
+    return (event->type == UDS_ROE_ON_CHANGE_OF_DID) || (event->type == UDS_ROE_ON_COMPARISON);
+}
+
+static uint16_t event_did(const uds_roe_event_t *event)
+{
+    return (uint16_t) (((uint16_t) event->record[0] << 8u) | event->record[1]);
+}
+
+/* Current value of a table DID: its storage in place, else read into buf; NULL on failure */
+static const uint8_t *did_value(uds_ctx_t *ctx, uint16_t did, uint8_t *buf, uint16_t max_len,
+                                uint16_t *len)
+{
+    const uds_did_entry_t *entry = uds_internal_find_did(ctx, did);
+    if (entry == NULL) {
+        return NULL;
+    }
+    *len = entry->size;
+    if (entry->read == NULL) {
+        return (const uint8_t *) entry->storage;
+    }
+    if ((entry->size > max_len) || (entry->read(ctx, did, buf, entry->size) < 0)) {
+        return NULL;
+    }
+    return buf;
+}
+
+/*
+ * Localization (ISO 14229-1 onComparisonOfValues): bit 15 signed, bits 14-10
+ * length in bits (0 = 32), bits 9-0 offset of the first (most significant)
+ * bit in the DID record.
+ */
+static bool value_at(const uint8_t *value, uint16_t len, uint16_t loc, int64_t *out)
+{
+    uint32_t bits = (loc >> 10u) & 0x1Fu;
+    uint32_t offset = loc & 0x3FFu;
+    uint32_t raw = 0u;
+
+    if (bits == 0u) {
+        bits = 32u;
+    }
+    if ((offset + bits) > ((uint32_t) len * 8u)) {
+        return false;
+    }
+    for (uint32_t i = 0u; i < bits; i++) {
+        uint32_t pos = offset + i;
+        raw = (raw << 1u) | ((uint32_t) (value[pos >> 3u] >> (7u - (pos & 7u))) & 1u);
+    }
+
+    if ((loc & 0x8000u) != 0u) {
+        if ((bits < 32u) && ((raw & (1uL << (bits - 1u))) != 0u)) {
+            raw |= ~0uL << bits;
+        }
+        *out = (int32_t) raw;
+    }
+    else {
+        *out = raw;
+    }
+    return true;
+}
+
+/* Condition of a comparison event; *rearm once the value left it by the hysteresis */
+static bool compare(const uds_roe_event_t *event, int64_t value, bool *rearm)
+{
+    const uint8_t *rec = event->record;
+    uint32_t raw = ((uint32_t) rec[3] << 24u) | ((uint32_t) rec[4] << 16u) |
+                   ((uint32_t) rec[5] << 8u) | rec[6];
+    bool is_signed = (rec[8] & 0x80u) != 0u;
+    int64_t ref = is_signed ? (int64_t) (int32_t) raw : (int64_t) raw;
+    int64_t band = ((ref < 0) ? -ref : ref) * rec[7] / 100;
+    int64_t diff = (value > ref) ? (value - ref) : (ref - value);
+
+    switch (rec[2]) {
+        case UDS_ROE_CMP_LESS:
+            *rearm = value >= (ref + band);
+            return value < ref;
+        case UDS_ROE_CMP_GREATER:
+            *rearm = value <= (ref - band);
+            return value > ref;
+        case UDS_ROE_CMP_EQUAL:
+            *rearm = diff > band;
+            return value == ref;
+        default: /* UDS_ROE_CMP_NOT_EQUAL */
+            *rearm = diff <= band;
+            return value != ref;
+    }
+}
+
+/* True if a DID event occurred since the last evaluation */
+static bool evaluate(uds_ctx_t *ctx, uds_roe_event_t *event)
+{
+    uint16_t len = 0u;
+    const uint8_t *value =
+        did_value(ctx, event_did(event), uds_tx_buffer(ctx), uds_tx_buffer_size(ctx), &len);
+    if (value == NULL) {
+        return false;
+    }
+
+    uint32_t hash = hash_value(value, len);
+    bool first = !event->primed;
+    if (!first && (hash == event->hash)) {
+        return false;
+    }
+    event->hash = hash;
+    event->primed = true;
+
+    if (event->type == UDS_ROE_ON_CHANGE_OF_DID) {
+        return !first; /* The value at start is the reference */
+    }
+
+    int64_t current;
+    bool rearm = false;
+    uint16_t loc = (uint16_t) (((uint16_t) event->record[8] << 8u) | event->record[9]);
+    if (!value_at(value, len, loc, &current)) {
+        return false;
+    }
+    bool hit = compare(event, current, &rearm);
+    if (event->armed && hit) {
+        event->armed = false;
+        return true;
+    }
+    if (!event->armed && rearm) {
+        event->armed = true;
+    }
+    return false;
+}
+
+/* Final response of a finite window: the event and the number of identified events */
+static void close_window(uds_ctx_t *ctx, uds_roe_event_t *event)
+{
+    uint8_t *tx = uds_tx_buffer(ctx);
+
+    event->active = false;
+    tx[0] = (uint8_t) (UDS_SID_RESPONSE_ON_EVENT + UDS_RESPONSE_OFFSET);
+    tx[1] = event->type;
+    tx[2] = event->identified;
+    uint16_t len = (uint16_t) (3u + uds_internal_roe_encode(event, &tx[3]));
+    ctx->suppress_pos_resp = false;
+    uds_send_response(ctx, len);
+}
+
+/* --- Internal API --- */
+
+uint16_t uds_internal_roe_encode(const uds_roe_event_t *event, uint8_t *out)
+{
+    out[0] = event->window;
+    memcpy(&out[1], event->record, event->record_len);
+    memcpy(&out[1u + event->record_len], event->strr, event->strr_len);
+    return (uint16_t) (1u + event->record_len + event->strr_len);
+}
+
+void uds_internal_roe_start(uds_ctx_t *ctx, uds_roe_event_t *event, uint32_t now)
+{
+    const uds_roe_t *roe = ctx->config->roe;
+
+    event->active = true;
+    event->identified = 0u;
+    event->primed = false;
+    event->armed = true;
+    event->dirty = watches_did(event); /* First evaluation records the value at start */
+    if ((event->window >= UDS_ROE_WINDOW_SHORT) && (event->window <= UDS_ROE_WINDOW_LONG)) {
+        event->window_end = now + roe->window_ms[event->window - UDS_ROE_WINDOW_SHORT];
+    }
+}
+
+void uds_internal_roe_process(uds_ctx_t *ctx, uint32_t now)
+{
+    uds_roe_t *roe = ctx->config->roe;
+
+    if (roe == NULL) {
+        return;
+    }
+
+    bool poll = (roe->poll_ms != 0u) && ((int32_t) (now - roe->next_poll) >= 0);
+    if (poll) {
+        roe->next_poll = now + roe->poll_ms;
+    }
+
+    /* Each event is read and answered with the session and security of its tester */
+    uint16_t loaded = ctx->tester_addr;
+
+    for (uint8_t i = 0u; i < roe->count; i++) {
+        uds_roe_event_t *event = &roe->events[i];
+        if (!event->active || !uds_internal_tester_select(ctx, event->tester_addr)) {
+            continue;
+        }
+        /* Responses to requests come first; nothing is lost, dirty events wait */
+        if (ctx->p2_msg_pending) {
+            continue;
+        }
+        if (!uds_internal_tx_acquire(ctx)) {
+            break;
+        }
+
+        if ((event->window != UDS_ROE_WINDOW_INFINITE) &&
+            ((int32_t) (now - event->window_end) >= 0)) {
+            close_window(ctx, event);
+            continue;
+        }
+
+        bool occurred;
+        if (event->type == UDS_ROE_ON_DTC_STATUS_CHANGE) {
+            occurred = event->dirty;
+        }
+        else {
+            occurred = (event->dirty || poll) && evaluate(ctx, event);
+        }
+        event->dirty = false;
+
+        if (occurred) {
+            if (event->identified < 0xFFu) {
+                event->identified++;
+            }
+            roe->responses++;
+            uds_internal_execute_request(ctx, event->strr, event->strr_len);
+        }
+    }
+
+    (void) uds_internal_tester_select(ctx, loaded);
+}
+
+bool uds_internal_roe_next(uds_ctx_t *ctx, uint32_t now, uint32_t *deadline)
+{
+    const uds_roe_t *roe = ctx->config->roe;
+    bool has_deadline = false;
+    bool polled = false;
+
+    if (roe == NULL) {
+        return false;
+    }
+    for (uint8_t i = 0u; i < roe->count; i++) {
+        const uds_roe_event_t *event = &roe->events[i];
+        if (!event->active) {
+            continue;
+        }
+        uint32_t next = now;
+        if (!event->dirty) {
+            if (event->window == UDS_ROE_WINDOW_INFINITE) {
+                polled = polled || watches_did(event);
+                continue;
+            }
+            next = event->window_end;
+        }
+        if (!has_deadline || ((int32_t) (next - *deadline) < 0)) {
+            *deadline = next;
+        }
+        has_deadline = true;
+    }
+
+    if (polled && (roe->poll_ms != 0u) &&
+        (!has_deadline || ((int32_t) (roe->next_poll - *deadline) < 0))) {
+        *deadline = roe->next_poll;
+        has_deadline = true;
+    }
+    return has_deadline;
+}
+
+#endif /* UDS_CFG_SERVICE_86 */
+
+/* --- Public API --- */
+
+void uds_roe_init(uds_roe_t *roe, uds_roe_event_t *events, uint8_t count)
+{
+    if (roe == NULL) {
+        return;
+    }
+    memset(roe, 0, sizeof(*roe));
+    if (events != NULL) {
+        memset(events, 0, (size_t) count * sizeof(*events));
+    }
+    roe->events = events;
+    roe->count = count;
+    roe->window_ms[0] = 10000u;
+    roe->window_ms[1] = 60000u;
+    roe->window_ms[2] = 600000u;
+}
+
+void uds_roe_notify_did(uds_ctx_t *ctx, uint16_t did)
+{
+#if UDS_CFG_SERVICE_86
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->roe == NULL)) {
+        return;
+    }
+    uds_roe_t *roe = ctx->config->roe;
+    bool marked = false;
+
+    for (uint8_t i = 0u; i < roe->count; i++) {
+        uds_roe_event_t *event = &roe->events[i];
+        if (event->active && watches_did(event) && (event_did(event) == did)) {
+            event->dirty = true;
+            marked = true;
+        }
+    }
+    if (marked && uds_internal_on_wheel(ctx)) {
+        uds_internal_timer_kick(ctx);
+    }
+#else
+    (void) ctx;
+    (void) did;
+#endif
+}
+
+void uds_roe_notify_dtc(uds_ctx_t *ctx, uint32_t dtc, uint8_t old_status, uint8_t new_status)
+{
+    (void) dtc;
+#if UDS_CFG_SERVICE_86
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->roe == NULL)) {
+        return;
+    }
+    uds_roe_t *roe = ctx->config->roe;
+    bool marked = false;
+
+    for (uint8_t i = 0u; i < roe->count; i++) {
+        uds_roe_event_t *event = &roe->events[i];
+        if (event->active && (event->type == UDS_ROE_ON_DTC_STATUS_CHANGE) &&
+            (((old_status ^ new_status) & event->record[0]) != 0u)) {
+            event->dirty = true;
+            marked = true;
+        }
+    }
+    if (marked && uds_internal_on_wheel(ctx)) {
+        uds_internal_timer_kick(ctx);
+    }
+#else
+    (void) ctx;
+    (void) old_status;
+    (void) new_status;
+#endif
+}
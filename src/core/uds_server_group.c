@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_server_group.c
+ * @brief Multi-ECU Server Group Implementation
+ *
+ * Each shard keeps a lock-free stack of members with posted mail. Producers
+ * (RX threads) push a member at most once, guarded by its queued flag; the
+ * shard thread takes the whole stack with one exchange, so there is no ABA
+ * problem and no lock between RX and shard threads.
+ */
+
+#include <string.h>
+
+#include "uds/uds_server_group.h"
+#include "uds_atomic.h"
+
+#if UDS_CFG_FEATURE_TIMER_WHEEL && UDS_CFG_FEATURE_MAILBOX
+
+/* --- Internal Helpers --- */
+
+/* Index of the first member with an address >= addr */
+static uint16_t lower_bound(const uds_server_group_t *group, uint16_t addr)
+{
+    uint16_t lo = 0u;
+    uint16_t hi = group->count;
+
+    while (lo < hi) {
+        uint16_t mid = (uint16_t) (lo + ((hi - lo) / 2u));
+        if (group->members[mid].addr < addr) {
+            lo = (uint16_t) (mid + 1u);
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void member_deliver(uds_server_group_t *group, uds_server_member_t *member,
+                           uint16_t tester_addr, const uint8_t *data, uint16_t len)
+{
+    uds_input_sdu_from(member->ctx, tester_addr, data, len);
+
+    if (member->ctx->config->mailbox == NULL) {
+        return; /* Executed on the caller's thread */
+    }
+
+    /* Posted: make sure the owning shard visits the member once */
+    uint32_t idle = 0u;
+    if (UDS_ATOMIC_CAS(&member->queued, &idle, 1u)) {
+        uds_server_shard_t *shard = &group->shards[member->shard];
+        member->next_ready = NULL;
+        while (!UDS_ATOMIC_CAS_PTR(&shard->ready, &member->next_ready, member)) {
+            /* A failed CAS loaded the current head into next_ready: retry */
+        }
+        if (shard->fn_wake != NULL) {
+            shard->fn_wake(shard->wake_arg);
+        }
+    }
+}
+
+/* --- Public API --- */
+
+int uds_server_group_init(uds_server_group_t *group, uds_server_member_t *members,
+                          uint16_t capacity, uds_server_shard_t *shards, uint8_t shard_count,
+                          uint32_t now_ms)
+{
+    if ((group == NULL) || (members == NULL) || (capacity == 0u) || (shards == NULL) ||
+        (shard_count == 0u)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memset(group, 0, sizeof(*group));
+    group->members = members;
+    group->capacity = capacity;
+    group->shards = shards;
+    group->shard_count = shard_count;
+
+    for (uint8_t i = 0u; i < shard_count; i++) {
+        memset(&shards[i], 0, sizeof(shards[i]));
+        uds_timer_wheel_init(&shards[i].wheel, now_ms);
+    }
+    return UDS_OK;
+}
+
+int uds_server_group_add(uds_server_group_t *group, uds_ctx_t *ctx, uint16_t addr, uint8_t shard)
+{
+    if ((group == NULL) || (ctx == NULL) || (shard >= group->shard_count)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (ctx->config == NULL) {
+        return UDS_ERR_NOT_INIT;
+    }
+    if ((group->shard_count > 1u) && (ctx->config->mailbox == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (group->count >= group->capacity) {
+        return UDS_ERR_BUFFER_TOO_SMALL;
+    }
+
+    uint16_t pos = lower_bound(group, addr);
+    if ((pos < group->count) && (group->members[pos].addr == addr)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memmove(&group->members[pos + 1u], &group->members[pos],
+            (size_t) (group->count - pos) * sizeof(group->members[0]));
+    uds_server_member_t *member = &group->members[pos];
+    memset(member, 0, sizeof(*member));
+    member->ctx = ctx;
+    member->addr = addr;
+    member->shard = shard;
+    group->count++;
+
+    return uds_timer_wheel_attach(&group->shards[shard].wheel, ctx);
+}
+
+uds_ctx_t *uds_server_group_find(const uds_server_group_t *group, uint16_t addr)
+{
+    if (group == NULL) {
+        return NULL;
+    }
+    uint16_t pos = lower_bound(group, addr);
+    if ((pos < group->count) && (group->members[pos].addr == addr)) {
+        return group->members[pos].ctx;
+    }
+    return NULL;
+}
+
+int uds_server_group_input(uds_server_group_t *group, uint16_t addr, uint16_t tester_addr,
+                           const uint8_t *data, uint16_t len)
+{
+    if (group == NULL) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    uint16_t pos = lower_bound(group, addr);
+    if ((pos >= group->count) || (group->members[pos].addr != addr)) {
+        (void) UDS_ATOMIC_FETCH_ADD(&group->unknown, 1u);
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    member_deliver(group, &group->members[pos], tester_addr, data, len);
+    return UDS_OK;
+}
+
+void uds_server_group_input_functional(uds_server_group_t *group, uint16_t tester_addr,
+                                       const uint8_t *data, uint16_t len)
+{
+    if (group == NULL) {
+        return;
+    }
+    for (uint16_t i = 0u; i < group->count; i++) {
+        member_deliver(group, &group->members[i], tester_addr, data, len);
+    }
+}
+
+uint32_t uds_server_group_process_shard(uds_server_group_t *group, uint8_t shard, uint32_t now_ms)
+{
+    if ((group == NULL) || (shard >= group->shard_count)) {
+        return 0u;
+    }
+
+    uds_server_shard_t *s = &group->shards[shard];
+    uint32_t processed = 0u;
+
+    /* Members with mail: execute it now rather than at their next deadline */
+    uds_server_member_t *member = UDS_ATOMIC_XCHG_PTR(&s->ready, NULL);
+    while (member != NULL) {
+        uds_server_member_t *next = member->next_ready;
+        /* Re-arm before draining, so a post during uds_process() is not lost */
+        UDS_ATOMIC_STORE_RELEASE(&member->queued, 0u);
+        uds_process(member->ctx);
+        processed++;
+        member = next;
+    }
+
+    return processed + uds_timer_wheel_process(&s->wheel, now_ms);
+}
+
+uint32_t uds_server_group_process(uds_server_group_t *group, uint32_t now_ms)
+{
+    uint32_t processed = 0u;
+
+    if (group == NULL) {
+        return 0u;
+    }
+    for (uint8_t i = 0u; i < group->shard_count; i++) {
+        processed += uds_server_group_process_shard(group, i, now_ms);
+    }
+    return processed;
+}
+
+#endif /* UDS_CFG_FEATURE_TIMER_WHEEL && UDS_CFG_FEATURE_MAILBOX */
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_stats.c
+ * @brief Per-SID Performance Counters Implementation
+ */
+
+#include <string.h>
+
+#include "uds/uds_stats.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_STATS
+
+/** NRCs with a dedicated bucket, in bucket order */
+static const uint8_t stats_nrc_codes[UDS_STATS_NRC_OTHER] = {
+    0x10u, 0x11u, 0x12u, 0x13u, 0x14u, 0x21u, 0x22u, 0x24u,
+    0x31u, 0x33u, 0x35u, 0x36u, 0x37u, 0x70u, 0x72u, 0x7Fu,
+};
+
+/* --- Internal Helpers --- */
+
+static uds_sid_stats_t *uds_internal_stats_entry(uds_ctx_t *ctx, uint8_t sid)
+{
+    uds_stats_t *stats = ctx->config->stats;
+
+    for (uint8_t i = 0u; i < UDS_STATS_MAX_SIDS; i++) {
+        if (stats->sids[i].sid == sid) {
+            return &stats->sids[i];
+        }
+        if (stats->sids[i].sid == 0u) {
+            /* Entries are claimed in order: the first free one ends the search */
+            stats->sids[i].sid = sid;
+            return &stats->sids[i];
+        }
+    }
+
+    stats->dropped++;
+    return NULL;
+}
+
+static uint8_t uds_internal_stats_log2(uint32_t value)
+{
+    uint8_t bucket = 0u;
+    while ((value > 1u) && (bucket < (UDS_STATS_HIST_BUCKETS - 1u))) {
+        value >>= 1u;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void uds_internal_stats_put_u32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t) (value >> 24u);
+    buf[1] = (uint8_t) (value >> 16u);
+    buf[2] = (uint8_t) (value >> 8u);
+    buf[3] = (uint8_t) value;
+}
+
+/* --- Internal API (used by the core) --- */
+
+void uds_internal_stats_request(uds_ctx_t *ctx, uint8_t sid)
+{
+    if (ctx->config->stats == NULL) {
+        return;
+    }
+    uds_sid_stats_t *entry = uds_internal_stats_entry(ctx, sid);
+    if (entry != NULL) {
+        entry->requests++;
+    }
+}
+
+void uds_internal_stats_response(uds_ctx_t *ctx, uint8_t sid, uint8_t nrc)
+{
+    if (ctx->config->stats == NULL) {
+        return;
+    }
+    uds_sid_stats_t *entry = uds_internal_stats_entry(ctx, sid);
+    if (entry == NULL) {
+        return;
+    }
+
+    if (nrc == 0u) {
+        entry->positive++;
+    }
+    else if (nrc == UDS_NRC_RESPONSE_PENDING) {
+        entry->rcrrp++;
+    }
+    else {
+        entry->negative++;
+        entry->nrc[uds_stats_nrc_bucket(nrc)]++;
+    }
+}
+
+void uds_internal_stats_handler(uds_ctx_t *ctx, uint8_t sid, uint32_t elapsed_us)
+{
+    if (ctx->config->stats == NULL) {
+        return;
+    }
+    uds_sid_stats_t *entry = uds_internal_stats_entry(ctx, sid);
+    if ((entry != NULL) && (elapsed_us > entry->max_handler_us)) {
+        entry->max_handler_us = elapsed_us;
+    }
+}
+
+void uds_internal_stats_latency(uds_ctx_t *ctx, uint8_t sid, uint32_t latency_us)
+{
+    if (ctx->config->stats == NULL) {
+        return;
+    }
+    uds_sid_stats_t *entry = uds_internal_stats_entry(ctx, sid);
+    if (entry == NULL) {
+        return;
+    }
+
+    entry->latency_hist[uds_internal_stats_log2(latency_us)]++;
+    if (latency_us > entry->max_latency_us) {
+        entry->max_latency_us = latency_us;
+    }
+    if (latency_us >= ((uint32_t) ctx->p2_ms * (10u * UDS_STATS_P2_NEAR_MISS_PCT))) {
+        entry->p2_near_miss++;
+    }
+}
+
+/* --- Public API --- */
+
+const uds_sid_stats_t *uds_stats_get(const uds_ctx_t *ctx, uint8_t sid)
+{
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->stats == NULL) || (sid == 0u)) {
+        return NULL;
+    }
+    const uds_stats_t *stats = ctx->config->stats;
+    for (uint8_t i = 0u; i < UDS_STATS_MAX_SIDS; i++) {
+        if (stats->sids[i].sid == sid) {
+            return &stats->sids[i];
+        }
+    }
+    return NULL;
+}
+
+void uds_stats_reset(uds_ctx_t *ctx)
+{
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->stats == NULL)) {
+        return;
+    }
+
+    if (ctx->config->fn_mutex_lock != NULL) {
+        ctx->config->fn_mutex_lock(ctx->config->mutex_handle);
+    }
+
+    memset(ctx->config->stats, 0, sizeof(uds_stats_t));
+
+    if (ctx->config->fn_mutex_unlock != NULL) {
+        ctx->config->fn_mutex_unlock(ctx->config->mutex_handle);
+    }
+}
+
+uint8_t uds_stats_nrc_bucket(uint8_t nrc)
+{
+    for (uint8_t i = 0u; i < UDS_STATS_NRC_OTHER; i++) {
+        if (stats_nrc_codes[i] == nrc) {
+            return i;
+        }
+    }
+    return (uint8_t) UDS_STATS_NRC_OTHER;
+}
+
+int uds_stats_read_did(struct uds_ctx *ctx, uint16_t did, uint8_t *buf, uint16_t max_len)
+{
+    (void) did;
+
+    if ((ctx == NULL) || (ctx->config == NULL) || (ctx->config->stats == NULL)) {
+        return -(int) UDS_NRC_CONDITIONS_NOT_CORRECT;
+    }
+    if (max_len < UDS_STATS_DID_SIZE) {
+        return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+    }
+
+    /* Called from the 0x22 handler: the context lock is already held */
+    const uds_stats_t *stats = ctx->config->stats;
+    memset(buf, 0, UDS_STATS_DID_SIZE);
+
+    for (uint8_t i = 0u; i < UDS_STATS_MAX_SIDS; i++) {
+        const uds_sid_stats_t *entry = &stats->sids[i];
+        uint8_t *rec = &buf[(uint16_t) i * UDS_STATS_DID_RECORD_SIZE];
+        rec[0] = entry->sid;
+        uds_internal_stats_put_u32(&rec[1], entry->requests);
+        uds_internal_stats_put_u32(&rec[5], entry->positive);
+        uds_internal_stats_put_u32(&rec[9], entry->negative);
+        uds_internal_stats_put_u32(&rec[13], entry->rcrrp);
+        uds_internal_stats_put_u32(&rec[17], entry->max_latency_us);
+        uds_internal_stats_put_u32(&rec[21], entry->max_handler_us);
+    }
+
+    return (int) UDS_STATS_DID_SIZE;
+}
+
+#endif /* UDS_CFG_FEATURE_STATS */
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_timer_wheel.c
+ * @brief Shared Hierarchical Timer Wheel Implementation
+ */
+
+#include <string.h>
+
+#include "uds/uds_timer_wheel.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_TIMER_WHEEL
+
+#define UDS_TW_SLOT_MASK (UDS_TIMER_WHEEL_SLOTS - 1u)
+
+/* --- Internal Helpers --- */
+
+static void uds_internal_tw_link(uds_timer_node_t **head, uds_timer_node_t *node)
+{
+    node->next = *head;
+    if (*head != NULL) {
+        (*head)->pprev = &node->next;
+    }
+    node->pprev = head;
+    *head = node;
+}
+
+static void uds_internal_tw_unlink(uds_timer_node_t *node)
+{
+    *node->pprev = node->next;
+    if (node->next != NULL) {
+        node->next->pprev = node->pprev;
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+/**
+ * @brief Place a node into the slot matching its distance from the wheel time.
+ */
+static void uds_internal_tw_place(uds_timer_wheel_t *wheel, uds_timer_node_t *node)
+{
+    uint32_t delta = node->expires - wheel->current;
+
+    if ((delta == 0u) || (delta > 0x80000000uL)) {
+        /* Deadline already reached: fire on the next process call */
+        uds_internal_tw_link(&wheel->due, node);
+        return;
+    }
+
+    if (delta > UDS_TIMER_WHEEL_MAX_MS) {
+        delta = UDS_TIMER_WHEEL_MAX_MS;
+    }
+
+    uint32_t target = wheel->current + delta;
+    uint8_t level = 0u;
+    while ((level < (UDS_TIMER_WHEEL_LEVELS - 1u)) &&
+           (delta >= (1uL << (UDS_TIMER_WHEEL_SLOT_BITS * (uint32_t) (level + 1u))))) {
+        level++;
+    }
+
+    uint32_t index = (target >> (UDS_TIMER_WHEEL_SLOT_BITS * (uint32_t) level)) & UDS_TW_SLOT_MASK;
+    uds_internal_tw_link(&wheel->slots[level][index], node);
+}
+
+/**
+ * @brief Re-distribute one higher-level slot into the lower levels.
+ * @return The slot index that was cascaded.
+ */
+static uint32_t uds_internal_tw_cascade(uds_timer_wheel_t *wheel, uint8_t level)
+{
+    uint32_t index =
+        (wheel->current >> (UDS_TIMER_WHEEL_SLOT_BITS * (uint32_t) level)) & UDS_TW_SLOT_MASK;
+    uds_timer_node_t *node = wheel->slots[level][index];
+    wheel->slots[level][index] = NULL;
+
+    while (node != NULL) {
+        uds_timer_node_t *next = node->next;
+        uds_internal_tw_place(wheel, node);
+        node = next;
+    }
+    return index;
+}
+
+/**
+ * @brief Fire every node of a detached list.
+ * @return Number of contexts processed.
+ */
+static uint32_t uds_internal_tw_fire(uds_timer_wheel_t *wheel, uds_timer_node_t **head)
+{
+    uint32_t fired = 0u;
+    uds_timer_node_t *node = *head;
+    *head = NULL;
+
+    while (node != NULL) {
+        uds_timer_node_t *next = node->next;
+        node->next = NULL;
+        node->pprev = NULL;
+
+        if ((node->expires - wheel->current) > 0u &&
+            (node->expires - wheel->current) <= 0x80000000uL) {
+            /* Clamped long deadline not reached yet: keep it in the wheel */
+            uds_internal_tw_place(wheel, node);
+        }
+        else {
+            node->armed = false;
+            wheel->armed--;
+            uds_process(node->owner); /* Re-arms the node with its next deadline */
+            fired++;
+        }
+        node = next;
+    }
+    return fired;
+}
+
+/**
+ * @brief Distance to the next tick that fires a level-0 slot or cascades a
+ *        non-empty higher-level slot.
+ *
+ * Every tick in between would be a no-op, so the wheel can skip it.
+ *
+ * @param limit Largest distance of interest.
+ * @return Distance in ms, at most limit.
+ */
+static uint32_t uds_internal_tw_next(const uds_timer_wheel_t *wheel, uint32_t limit)
+{
+    uint32_t best = limit;
+
+    for (uint32_t d = 1u; (d <= UDS_TIMER_WHEEL_SLOTS) && (d < best); d++) {
+        if (wheel->slots[0][(wheel->current + d) & UDS_TW_SLOT_MASK] != NULL) {
+            best = d;
+            break;
+        }
+    }
+
+    /* Level L cascades the slot of the tick at every multiple of 2^(SLOT_BITS * L) */
+    for (uint8_t level = 1u; level < UDS_TIMER_WHEEL_LEVELS; level++) {
+        uint32_t shift = UDS_TIMER_WHEEL_SLOT_BITS * (uint32_t) level;
+        uint32_t span = 1uL << shift;
+        uint32_t d = span - (wheel->current & (span - 1u));
+
+        for (uint32_t n = 0u; (n < UDS_TIMER_WHEEL_SLOTS) && (d < best); n++) {
+            if (wheel->slots[level][((wheel->current + d) >> shift) & UDS_TW_SLOT_MASK] != NULL) {
+                best = d;
+                break;
+            }
+            d += span;
+        }
+    }
+    return best;
+}
+
+/* --- Internal API (used by the core) --- */
+
+void uds_internal_timer_arm(uds_ctx_t *ctx, uint32_t expires)
+{
+    uds_timer_wheel_t *wheel = ctx->timer_wheel;
+    uds_timer_node_t *node = &ctx->timer_node;
+
+    if (node->armed) {
+        uds_internal_tw_unlink(node);
+    }
+    else {
+        wheel->armed++;
+    }
+
+    node->expires = expires;
+    node->armed = true;
+    uds_internal_tw_place(wheel, node);
+}
+
+void uds_internal_timer_cancel(uds_ctx_t *ctx)
+{
+    uds_timer_node_t *node = &ctx->timer_node;
+
+    if (node->armed) {
+        uds_internal_tw_unlink(node);
+        node->armed = false;
+        ctx->timer_wheel->armed--;
+    }
+}
+
+void uds_internal_timer_kick(uds_ctx_t *ctx)
+{
+    /* Due on the next uds_timer_wheel_process() call */
+    uds_internal_timer_arm(ctx, ctx->timer_wheel->current);
+}
+
+/* --- Public API --- */
+
+void uds_timer_wheel_init(uds_timer_wheel_t *wheel, uint32_t now_ms)
+{
+    if (wheel == NULL) {
+        return;
+    }
+    memset(wheel, 0, sizeof(uds_timer_wheel_t));
+    wheel->current = now_ms;
+}
+
+int uds_timer_wheel_attach(uds_timer_wheel_t *wheel, uds_ctx_t *ctx)
+{
+    if ((wheel == NULL) || (ctx == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    if (ctx->config == NULL) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    if (ctx->timer_wheel != NULL) {
+        uds_timer_wheel_detach(ctx);
+    }
+
+    memset(&ctx->timer_node, 0, sizeof(uds_timer_node_t));
+    ctx->timer_node.owner = ctx;
+    ctx->timer_wheel = wheel;
+    uds_internal_timer_rearm(ctx, wheel->current);
+    return UDS_OK;
+}
+
+void uds_timer_wheel_detach(uds_ctx_t *ctx)
+{
+    if ((ctx == NULL) || (ctx->timer_wheel == NULL)) {
+        return;
+    }
+    uds_internal_timer_cancel(ctx);
+    ctx->timer_wheel = NULL;
+}
+
+uint32_t uds_timer_wheel_process(uds_timer_wheel_t *wheel, uint32_t now_ms)
+{
+    if (wheel == NULL) {
+        return 0u;
+    }
+
+    uint32_t fired = uds_internal_tw_fire(wheel, &wheel->due);
+
+    while ((now_ms - wheel->current) != 0u && (now_ms - wheel->current) <= 0x80000000uL) {
+        if (wheel->armed == 0u) {
+            /* Nothing to expire: jump straight to the current time */
+            wheel->current = now_ms;
+            break;
+        }
+
+        /* Skip the ticks that neither fire nor cascade anything */
+        wheel->current += uds_internal_tw_next(wheel, now_ms - wheel->current);
+
+        /* Cascade higher levels whenever a lower level wraps */
+        uint8_t level = 1u;
+        while ((level < UDS_TIMER_WHEEL_LEVELS) &&
+               (((wheel->current >> (UDS_TIMER_WHEEL_SLOT_BITS * (uint32_t) (level - 1u))) &
+                 UDS_TW_SLOT_MASK) == 0u)) {
+            (void) uds_internal_tw_cascade(wheel, level);
+            level++;
+        }
+
+        fired += uds_internal_tw_fire(wheel, &wheel->slots[0][wheel->current & UDS_TW_SLOT_MASK]);
+        fired += uds_internal_tw_fire(wheel, &wheel->due);
+    }
+
+    return fired;
+}
+
+#endif /* UDS_CFG_FEATURE_TIMER_WHEEL */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_trace.c
+ * @brief Binary Event Trace Ring Buffer Implementation
+ */
+
+#include <string.h>
+
+#include "uds/uds_trace.h"
+#include "uds_atomic.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_TRACE
+
+/* --- Internal API (used by the core) --- */
+
+void uds_internal_trace(uds_ctx_t *ctx, uint8_t event, uint8_t sid, uint16_t arg)
+{
+    if (ctx->config->trace == NULL) {
+        return;
+    }
+    uds_trace_write(ctx->config->trace, uds_internal_now_us(ctx), event, sid, arg);
+}
+
+/* --- Public API --- */
+
+int uds_trace_init(uds_trace_ring_t *ring, uds_trace_record_t *records, uint32_t capacity)
+{
+    if ((ring == NULL) || (records == NULL) || (capacity == 0u) ||
+        ((capacity & (capacity - 1u)) != 0u)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->records = records;
+    ring->mask = capacity - 1u;
+    return UDS_OK;
+}
+
+void uds_trace_write(uds_trace_ring_t *ring, uint32_t timestamp, uint8_t event, uint8_t sid,
+                     uint16_t arg)
+{
+    uint32_t head = UDS_ATOMIC_LOAD_RELAXED(&ring->head);
+    uint32_t tail = UDS_ATOMIC_LOAD_ACQUIRE(&ring->tail);
+
+    if ((head - tail) > ring->mask) {
+        ring->dropped++;
+        return;
+    }
+
+    uds_trace_record_t *rec = &ring->records[head & ring->mask];
+    rec->timestamp = timestamp;
+    rec->event = event;
+    rec->sid = sid;
+    rec->arg = arg;
+
+    /* Publish the record only after it is complete */
+    UDS_ATOMIC_STORE_RELEASE(&ring->head, head + 1u);
+}
+
+uint32_t uds_trace_read(uds_trace_ring_t *ring, uds_trace_record_t *out, uint32_t max)
+{
+    if ((ring == NULL) || (out == NULL)) {
+        return 0u;
+    }
+
+    uint32_t tail = UDS_ATOMIC_LOAD_RELAXED(&ring->tail);
+    uint32_t head = UDS_ATOMIC_LOAD_ACQUIRE(&ring->head);
+    uint32_t count = 0u;
+
+    while ((tail != head) && (count < max)) {
+        out[count] = ring->records[tail & ring->mask];
+        tail++;
+        count++;
+    }
+
+    /* Hand the slots back to the producer */
+    UDS_ATOMIC_STORE_RELEASE(&ring->tail, tail);
+    return count;
+}
+
+#endif /* UDS_CFG_FEATURE_TRACE */
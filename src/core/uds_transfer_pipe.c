@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_transfer_pipe.c
+ * @brief Pipelined TransferData (SID 0x36) Implementation
+ *
+ * The slots form a ring: count staged blocks starting at head, written in
+ * that order by one background job at a time. A write frees its slot when it
+ * completes, which starts the next write and, if a request waits for room or
+ * for the end of the transfer, sends its response.
+ */
+
+#include <string.h>
+
+#include "uds/uds_transfer_pipe.h"
+#include "uds_internal.h"
+
+#if UDS_CFG_FEATURE_FLASH
+
+/* --- Internal Helpers --- */
+
+/* Executor side: program the head slot */
+static int write_work(uds_job_t *job)
+{
+    uds_ctx_t *ctx = job->ctx;
+    const uds_transfer_pipe_t *pipe = ctx->config->transfer_pipe;
+    uint8_t slot = pipe->head;
+
+    return ctx->config->fn_transfer_data(ctx, pipe->seq[slot],
+                                         &pipe->slots[(uint32_t) slot * pipe->slot_size],
+                                         pipe->len[slot]);
+}
+
+/* Response of the waiting request */
+static int waiter_complete(uds_ctx_t *ctx, uds_job_t *job, int result)
+{
+    const uds_transfer_pipe_t *pipe = ctx->config->transfer_pipe;
+
+    if (result < 0) {
+        return result;
+    }
+
+    if (job->sid == UDS_SID_TRANSFER_DATA) {
+        uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_TRANSFER_DATA + UDS_RESPONSE_OFFSET);
+        uds_tx_buffer(ctx)[1] = pipe->wait_seq;
+        return 2;
+    }
+
+    /* RequestTransferExit: every block is written */
+    int res = ctx->config->fn_transfer_exit(ctx);
+    if (res < 0) {
+        return res;
+    }
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_TRANSFER_EXIT + UDS_RESPONSE_OFFSET);
+    return 1;
+}
+
+/* Complete the waiting request once its condition holds */
+static void wake(uds_ctx_t *ctx, uds_transfer_pipe_t *pipe)
+{
+    int result = UDS_OK;
+
+    if (pipe->error != 0u) {
+        result = -(int) pipe->error;
+    }
+    else if (pipe->waiter.sid == UDS_SID_TRANSFER_DATA) {
+        if (pipe->count >= pipe->slot_count) {
+            return; /* Still no free slot */
+        }
+    }
+    else if (pipe->count > 0u) {
+        return; /* 0x37: blocks left to write */
+    }
+
+    pipe->waiting = false;
+    (void) uds_internal_job_complete_owned(ctx, &pipe->waiter, result);
+}
+
+static int write_complete(uds_ctx_t *ctx, uds_job_t *job, int result);
+
+/* Start writing the head slot unless a write runs or the transfer failed */
+static void kick(uds_ctx_t *ctx, uds_transfer_pipe_t *pipe)
+{
+    if (pipe->busy || (pipe->count == 0u) || (pipe->error != 0u)) {
+        return;
+    }
+
+    pipe->busy = true;
+    pipe->write.work = write_work;
+    pipe->write.complete = write_complete;
+    pipe->write.user_data = pipe;
+    if (!uds_internal_job_start(ctx, &pipe->write)) {
+        pipe->busy = false; /* Executor full: retried by uds_process() */
+        uds_internal_log(ctx, UDS_LOG_ERROR, "TransferData write not accepted by executor");
+    }
+}
+
+/* Context side: release the written slot */
+static int write_complete(uds_ctx_t *ctx, uds_job_t *job, int result)
+{
+    uds_transfer_pipe_t *pipe = (uds_transfer_pipe_t *) job->user_data;
+
+    pipe->busy = false;
+    if (result < 0) {
+        /* The transfer is broken: later blocks would leave a gap in flash */
+        pipe->error = (uint8_t) - (int32_t) result;
+        pipe->count = 0u;
+        uds_internal_log(ctx, UDS_LOG_ERROR, "TransferData background write failed");
+    }
+    else {
+        pipe->head = (uint8_t) ((pipe->head + 1u) % pipe->slot_count);
+        pipe->count--;
+        pipe->written++;
+    }
+
+    kick(ctx, pipe);
+    if (pipe->waiting) {
+        wake(ctx, pipe);
+    }
+    return 0;
+}
+
+/* Make the dispatched request wait for the pipe */
+static int wait_for(uds_ctx_t *ctx, uds_transfer_pipe_t *pipe, uint8_t sid)
+{
+    pipe->waiter.work = NULL;
+    pipe->waiter.complete = waiter_complete;
+    pipe->waiter.user_data = pipe;
+    pipe->waiting = true;
+    return uds_internal_job_claim(ctx, sid, &pipe->waiter);
+}
+
+/* --- Internal API --- */
+
+int uds_internal_pipe_transfer(uds_ctx_t *ctx, uint8_t sequence, const uint8_t *data,
+                               uint16_t len)
+{
+    uds_transfer_pipe_t *pipe = ctx->config->transfer_pipe;
+
+    if (pipe->error != 0u) {
+        return -(int) pipe->error;
+    }
+    if (len > pipe->slot_size) {
+        return -(int) UDS_NRC_INCORRECT_LENGTH;
+    }
+    if (pipe->count >= pipe->slot_count) {
+        return -(int) UDS_NRC_BUSY_REPEAT_REQUEST;
+    }
+
+    uint8_t slot = (uint8_t) ((pipe->head + pipe->count) % pipe->slot_count);
+    if (len > 0u) {
+        memcpy(&pipe->slots[(uint32_t) slot * pipe->slot_size], data, len);
+    }
+    pipe->len[slot] = len;
+    pipe->seq[slot] = sequence;
+    pipe->count++;
+
+    kick(ctx, pipe);
+    if (pipe->error != 0u) {
+        return -(int) pipe->error; /* Written inline and failed */
+    }
+    if (pipe->count < pipe->slot_count) {
+        return UDS_OK; /* The next block has room */
+    }
+
+    pipe->stalls++;
+    pipe->wait_seq = sequence;
+    return wait_for(ctx, pipe, UDS_SID_TRANSFER_DATA);
+}
+
+int uds_internal_pipe_exit(uds_ctx_t *ctx)
+{
+    uds_transfer_pipe_t *pipe = ctx->config->transfer_pipe;
+
+    if (pipe->error != 0u) {
+        return -(int) pipe->error;
+    }
+    if (pipe->count == 0u) {
+        return UDS_OK;
+    }
+    return wait_for(ctx, pipe, UDS_SID_TRANSFER_EXIT);
+}
+
+int uds_internal_pipe_reset(uds_ctx_t *ctx)
+{
+    uds_transfer_pipe_t *pipe = ctx->config->transfer_pipe;
+
+    if (pipe->busy) {
+        return -(int) UDS_NRC_BUSY_REPEAT_REQUEST;
+    }
+    pipe->head = 0u;
+    pipe->count = 0u;
+    pipe->error = 0u;
+    pipe->waiting = false;
+    return UDS_OK;
+}
+
+void uds_internal_pipe_process(uds_ctx_t *ctx)
+{
+    uds_transfer_pipe_t *pipe = ctx->config->transfer_pipe;
+    if (pipe != NULL) {
+        kick(ctx, pipe);
+    }
+}
+
+#endif /* UDS_CFG_FEATURE_FLASH */
+
+/* --- Public API --- */
+
+void uds_transfer_pipe_init(uds_transfer_pipe_t *pipe, uint8_t *slots, uint16_t slot_size,
+                            uint8_t slot_count)
+{
+    if (pipe == NULL) {
+        return;
+    }
+    memset(pipe, 0, sizeof(*pipe));
+    pipe->slots = slots;
+    pipe->slot_size = slot_size;
+    pipe->slot_count = slot_count;
+}
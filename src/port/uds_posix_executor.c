@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_posix_executor.c
+ * @brief POSIX Thread Pool Executor Implementation
+ */
+
+#include <string.h>
+
+#include "uds/uds_posix_executor.h"
+
+static void *uds_posix_executor_worker(void *arg)
+{
+    uds_posix_executor_t *pool = (uds_posix_executor_t *) arg;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while ((pool->count == 0u) && !pool->stop) {
+            pthread_cond_wait(&pool->cond, &pool->lock);
+        }
+        if (pool->count == 0u) {
+            /* Stopped and drained */
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+
+        uds_job_t *job = pool->queue[pool->head];
+        pool->head = (uint8_t) ((pool->head + 1u) % UDS_POSIX_EXECUTOR_QUEUE_DEPTH);
+        pool->count--;
+        pthread_mutex_unlock(&pool->lock);
+
+        /* Runs the work without any lock, then completes under the context lock */
+        uds_job_execute(job);
+    }
+
+    return NULL;
+}
+
+int uds_posix_executor_init(uds_posix_executor_t *pool, uint8_t threads)
+{
+    if ((pool == NULL) || (threads == 0u) || (threads > UDS_POSIX_EXECUTOR_MAX_THREADS)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memset(pool, 0, sizeof(uds_posix_executor_t));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    for (uint8_t i = 0u; i < threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, uds_posix_executor_worker, pool) != 0) {
+            uds_posix_executor_shutdown(pool);
+            return UDS_ERR_INVALID_ARG;
+        }
+        pool->thread_count++;
+    }
+
+    return UDS_OK;
+}
+
+int uds_posix_executor_submit(void *executor, uds_job_t *job)
+{
+    uds_posix_executor_t *pool = (uds_posix_executor_t *) executor;
+    int result = UDS_OK;
+
+    if ((pool == NULL) || (job == NULL)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->stop || (pool->count >= UDS_POSIX_EXECUTOR_QUEUE_DEPTH)) {
+        result = UDS_ERR_BUFFER_TOO_SMALL;
+    }
+    else {
+        pool->queue[(pool->head + pool->count) % UDS_POSIX_EXECUTOR_QUEUE_DEPTH] = job;
+        pool->count++;
+        pthread_cond_signal(&pool->cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return result;
+}
+
+void uds_posix_executor_shutdown(uds_posix_executor_t *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint8_t i = 0u; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pool->thread_count = 0u;
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_posix_group.c
+ * @brief POSIX Shard Threads Implementation
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* pthread_setaffinity_np() */
+#endif
+
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+#include "uds/uds_posix_group.h"
+
+static void uds_posix_group_wake(void *arg)
+{
+    uds_posix_group_shard_t *shard = (uds_posix_group_shard_t *) arg;
+
+    pthread_mutex_lock(&shard->lock);
+    shard->kicked = true;
+    pthread_cond_signal(&shard->cond);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+static void *uds_posix_group_worker(void *arg)
+{
+    uds_posix_group_shard_t *shard = (uds_posix_group_shard_t *) arg;
+    uds_posix_group_t *runner = shard->runner;
+
+    for (;;) {
+        uds_server_group_process_shard(runner->group, shard->shard, runner->get_time_ms());
+
+        pthread_mutex_lock(&shard->lock);
+        if (!shard->kicked && !shard->stop) {
+            struct timespec until;
+            clock_gettime(CLOCK_REALTIME, &until);
+            until.tv_nsec += (long) UDS_POSIX_GROUP_TICK_MS * 1000000L;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000L;
+            }
+            (void) pthread_cond_timedwait(&shard->cond, &shard->lock, &until);
+        }
+        shard->kicked = false;
+        bool stop = shard->stop;
+        pthread_mutex_unlock(&shard->lock);
+
+        if (stop) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static void uds_posix_group_pin(pthread_t thread, int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    (void) pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+    (void) thread;
+    (void) cpu;
+#endif
+}
+
+int uds_posix_group_start(uds_posix_group_t *runner, uds_server_group_t *group,
+                          uint32_t (*get_time_ms)(void), const int *cpus)
+{
+    if ((runner == NULL) || (group == NULL) || (get_time_ms == NULL) ||
+        (group->shard_count > UDS_POSIX_GROUP_MAX_SHARDS)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memset(runner, 0, sizeof(uds_posix_group_t));
+    runner->group = group;
+    runner->get_time_ms = get_time_ms;
+
+    for (uint8_t i = 0u; i < group->shard_count; i++) {
+        uds_posix_group_shard_t *shard = &runner->shards[i];
+        shard->runner = runner;
+        shard->shard = i;
+        pthread_mutex_init(&shard->lock, NULL);
+        pthread_cond_init(&shard->cond, NULL);
+        group->shards[i].wake_arg = shard;
+        group->shards[i].fn_wake = uds_posix_group_wake;
+    }
+
+    for (uint8_t i = 0u; i < group->shard_count; i++) {
+        if (pthread_create(&runner->threads[i], NULL, uds_posix_group_worker,
+                           &runner->shards[i]) != 0) {
+            uds_posix_group_stop(runner);
+            return UDS_ERR_INVALID_ARG;
+        }
+        runner->thread_count++;
+        if ((cpus != NULL) && (cpus[i] >= 0)) {
+            uds_posix_group_pin(runner->threads[i], cpus[i]);
+        }
+    }
+
+    return UDS_OK;
+}
+
+void uds_posix_group_stop(uds_posix_group_t *runner)
+{
+    if ((runner == NULL) || (runner->group == NULL)) {
+        return;
+    }
+
+    for (uint8_t i = 0u; i < runner->group->shard_count; i++) {
+        uds_posix_group_shard_t *shard = &runner->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        shard->stop = true;
+        pthread_cond_signal(&shard->cond);
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    for (uint8_t i = 0u; i < runner->thread_count; i++) {
+        pthread_join(runner->threads[i], NULL);
+    }
+    runner->thread_count = 0u;
+
+    for (uint8_t i = 0u; i < runner->group->shard_count; i++) {
+        runner->group->shards[i].fn_wake = NULL;
+        runner->group->shards[i].wake_arg = NULL;
+        pthread_cond_destroy(&runner->shards[i].cond);
+        pthread_mutex_destroy(&runner->shards[i].lock);
+    }
+    runner->group = NULL;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file uds_posix_nvm.c
+ * @brief File-Backed Flash Implementation
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "uds/uds_posix_nvm.h"
+
+#define NVM_CHUNK 256u
+
+static uint16_t chunk_len(uint32_t left)
+{
+    return (uint16_t) ((left < NVM_CHUNK) ? left : NVM_CHUNK);
+}
+
+static int nvm_io(int fd, uint32_t addr, uint8_t *buf, uint16_t len, bool write)
+{
+    ssize_t n = write ? pwrite(fd, buf, len, (off_t) addr) : pread(fd, buf, len, (off_t) addr);
+    return (n == (ssize_t) len) ? UDS_OK : UDS_ERR_INVALID_ARG;
+}
+
+static int nvm_read(void *dev, uint32_t addr, uint8_t *buf, uint16_t len)
+{
+    const uds_posix_nvm_t *nvm = (const uds_posix_nvm_t *) dev;
+    if ((uint64_t) addr + len > 2u * (uint64_t) nvm->flash.sector_size) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    return nvm_io(nvm->fd, addr, buf, len, false);
+}
+
+/* Programming can only clear bits: the new bytes are ANDed into the old ones */
+static int nvm_write(void *dev, uint32_t addr, const uint8_t *data, uint16_t len)
+{
+    const uds_posix_nvm_t *nvm = (const uds_posix_nvm_t *) dev;
+    uint8_t buf[NVM_CHUNK];
+
+    if ((uint64_t) addr + len > 2u * (uint64_t) nvm->flash.sector_size) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    for (uint16_t done = 0u; done < len;) {
+        uint16_t n = chunk_len((uint32_t) len - done);
+        int res = nvm_io(nvm->fd, addr + done, buf, n, false);
+        for (uint16_t i = 0u; (res == UDS_OK) && (i < n); i++) {
+            buf[i] &= data[done + i];
+        }
+        if (res == UDS_OK) {
+            res = nvm_io(nvm->fd, addr + done, buf, n, true);
+        }
+        if (res != UDS_OK) {
+            return res;
+        }
+        done = (uint16_t) (done + n);
+    }
+    return UDS_OK;
+}
+
+static int fill_erased(int fd, uint32_t addr, uint32_t len)
+{
+    uint8_t buf[NVM_CHUNK];
+    memset(buf, 0xFF, sizeof(buf));
+    for (uint32_t done = 0u; done < len;) {
+        uint16_t n = chunk_len((uint32_t) len - done);
+        int res = nvm_io(fd, addr + done, buf, n, true);
+        if (res != UDS_OK) {
+            return res;
+        }
+        done += n;
+    }
+    return UDS_OK;
+}
+
+static int nvm_erase(void *dev, uint32_t addr)
+{
+    const uds_posix_nvm_t *nvm = (const uds_posix_nvm_t *) dev;
+    if (((addr % nvm->flash.sector_size) != 0u) || (addr >= (2u * nvm->flash.sector_size))) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    return fill_erased(nvm->fd, addr, nvm->flash.sector_size);
+}
+
+int uds_posix_nvm_open(uds_posix_nvm_t *nvm, const char *path, uint32_t sector_size)
+{
+    if ((nvm == NULL) || (path == NULL) || (sector_size == 0u)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    memset(nvm, 0, sizeof(uds_posix_nvm_t));
+    nvm->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (nvm->fd < 0) {
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    struct stat st;
+    uint32_t area = 2u * sector_size;
+    uint32_t size = (fstat(nvm->fd, &st) == 0) ? (uint32_t) st.st_size : 0u;
+    if ((size < area) && (fill_erased(nvm->fd, size, area - size) != UDS_OK)) {
+        close(nvm->fd);
+        nvm->fd = -1;
+        return UDS_ERR_INVALID_ARG;
+    }
+
+    nvm->flash.fn_read = nvm_read;
+    nvm->flash.fn_write = nvm_write;
+    nvm->flash.fn_erase = nvm_erase;
+    nvm->flash.dev = nvm;
+    nvm->flash.sector_size = sector_size;
+    return UDS_OK;
+}
+
+void uds_posix_nvm_close(uds_posix_nvm_t *nvm)
+{
+    if ((nvm == NULL) || (nvm->fd < 0)) {
+        return;
+    }
+    (void) fsync(nvm->fd);
+    (void) close(nvm->fd);
+    nvm->fd = -1;
+}
@@ -5,64 +5,153 @@
 
 /**
  * @file uds_service_data.c
- * @brief Read Data By ID (0x22) & Write Data By ID (0x2E)
+ * @brief Read Data By ID (0x22), Dynamically Define Data ID (0x2C) & Write Data By ID (0x2E)
  */
 
 #include <string.h>
 #include "uds_internal.h"
+#include "uds/uds_dyn_did.h"
+#include "uds/uds_response.h"
+#include "uds/uds_roe.h"
+
+#if UDS_CFG_SERVICE_22 && UDS_CFG_SERVICE_2C
+/* [DID hi][DID lo][data] of a dynamic DID; 0 or a negative NRC */
+static int read_dynamic_did(uds_ctx_t *ctx, uds_response_t *resp, const uds_dyn_did_t *dyn)
+{
+    uint8_t *out = uds_response_reserve(resp, (uint16_t) (2u + dyn->size));
+    if (out == NULL) {
+        return -(int) UDS_NRC_RESPONSE_TOO_LONG;
+    }
+    out[0] = (uint8_t) (dyn->id >> 8u);
+    out[1] = (uint8_t) dyn->id;
+
+    /* Values of read-callback sources go to the tx_buffer space after the response */
+    return uds_internal_dyn_did_read(ctx, dyn, &out[2], &uds_tx_buffer(ctx)[resp->used],
+                                     (uint16_t) (uds_tx_buffer_size(ctx) - resp->used));
+}
+#endif
+
+#if UDS_CFG_SERVICE_22
+/* Storage of a DID larger than the tx_buffer, pulled by the transport */
+static int read_did_storage(uds_ctx_t *ctx, void *arg, uint32_t pos, uint8_t *buf, uint16_t len)
+{
+    (void) ctx;
+    memcpy(buf, &((const uint8_t *) arg)[pos], len);
+    return UDS_OK;
+}
 
 int uds_internal_handle_read_data_by_id(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
-    uint16_t tx_len = 1u; /* SID 0x62 set later */
+    uds_response_t resp;
     uint16_t i = 1u;
     bool any_error = false;
     uint8_t nrc_code = UDS_NRC_REQUEST_OUT_OF_RANGE;
+    bool cache = uds_internal_did_cache_enabled(ctx);
+    bool all_cached = cache;
+
+    if (uds_response_begin(&resp, ctx, UDS_SID_READ_DATA_BY_ID) != UDS_OK) {
+        return UDS_ERR_NOT_INIT;
+    }
+
+    if (cache) {
+        /* Repeated identification request: one pre-assembled response */
+        uint16_t asm_len = 0u;
+        const uint8_t *assembled = uds_internal_did_cache_begin(ctx, data, len, &asm_len);
+        if (assembled != NULL) {
+            if (uds_response_ref(&resp, assembled, asm_len) != UDS_OK) {
+                return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, UDS_NRC_RESPONSE_TOO_LONG);
+            }
+            return uds_response_commit(&resp);
+        }
+    }
 
     while (i + 1u < len) {
         uint16_t did = (uint16_t) (((uint16_t) data[i] << 8u) | (uint16_t) data[i + 1u]);
         const uds_did_entry_t *entry = uds_internal_find_did(ctx, did);
 
+#if UDS_CFG_SERVICE_2C
+        if ((entry == NULL) && (ctx->config->dyn_dids != NULL)) {
+            const uds_dyn_did_t *dyn = uds_internal_dyn_did_find(ctx, did);
+            if (dyn != NULL) {
+                int res = read_dynamic_did(ctx, &resp, dyn);
+                if (res < 0) {
+                    return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, (uint8_t) - (int32_t) res);
+                }
+                all_cached = false;
+                i += 2u;
+                continue;
+            }
+        }
+#endif
+
         if (entry != NULL) {
             /* C-18: Security & Session Validation per DID */
-            /* Session Check */
-            if ((entry->session_mask != 0u) &&
-                !((1u << (ctx->active_session - 1u)) & entry->session_mask)) {
+            int access = uds_internal_did_access(ctx, entry);
+            if (access == UDS_ACCESS_DENIED_SESSION) {
                 any_error = true;
                 nrc_code = UDS_NRC_REQUEST_OUT_OF_RANGE; /* 0x31 per ISO 14229-1 */
                 break;
             }
-
-            /* Security Check */
-            if ((entry->security_mask != 0u) &&
-                !((1u << ctx->security_level) & entry->security_mask)) {
+            if (access == UDS_ACCESS_DENIED_SECURITY) {
                 any_error = true;
                 nrc_code = UDS_NRC_SECURITY_ACCESS_DENIED;
                 break;
             }
 
-            /* C-12: Buffer Overflow Vulnerability Check */
-            if ((uint32_t) tx_len + (uint32_t) entry->size + 2u > /* +2 for DID ID */
-                (uint32_t) ctx->config->tx_buffer_size) {
-                return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, UDS_NRC_RESPONSE_TOO_LONG);
+            if (cache) {
+                uint16_t frag_len = 0u;
+                const uint8_t *frag = uds_internal_did_cache_get(ctx, entry, &frag_len);
+                if (frag != NULL) {
+                    if (uds_response_ref(&resp, frag, frag_len) != UDS_OK) {
+                        return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID,
+                                            UDS_NRC_RESPONSE_TOO_LONG);
+                    }
+                    i += 2u;
+                    continue;
+                }
+                if ((entry->flags & (UDS_DID_FLAG_IMMUTABLE | UDS_DID_FLAG_VERSIONED)) == 0u) {
+                    all_cached = false;
+                }
             }
 
-            ctx->config->tx_buffer[tx_len] = (uint8_t) ((did >> 8u) & 0xFFu);
-            tx_len++;
-            ctx->config->tx_buffer[tx_len] = (uint8_t) (did & 0xFFu);
-            tx_len++;
+            /* C-12: Buffer Overflow Vulnerability Check (done by the response writer) */
+            uint8_t *hdr = uds_response_reserve(&resp, 2u);
+            if (hdr == NULL) {
+                return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, UDS_NRC_RESPONSE_TOO_LONG);
+            }
+            hdr[0] = (uint8_t) ((did >> 8u) & 0xFFu);
+            hdr[1] = (uint8_t) (did & 0xFFu);
 
             if (entry->read != NULL) {
-                int res = entry->read(ctx, did, &ctx->config->tx_buffer[tx_len], entry->size);
-                if (res >= 0) {
-                    tx_len += (uint16_t) entry->size;
+                uint8_t *out = uds_response_reserve(&resp, entry->size);
+                if (out == NULL) {
+                    return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, UDS_NRC_RESPONSE_TOO_LONG);
                 }
-                else {
+                int res = entry->read(ctx, did, out, entry->size);
+                if (res < 0) {
                     return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, (uint8_t) - (int32_t) res);
                 }
+                if (cache) {
+                    uds_internal_did_cache_put(ctx, entry, out);
+                }
+            }
+            else if ((entry->storage != NULL) && (i + 3u >= len) &&
+                     uds_internal_can_stream(ctx) &&
+                     ((uint32_t) resp.used + entry->size > uds_tx_buffer_size(ctx))) {
+                /* Last DID and larger than the tx_buffer: streamed from its storage */
+                (void) uds_response_stream(&resp, 0u, entry->size, read_did_storage,
+                                           entry->storage);
+                all_cached = false;
             }
             else if (entry->storage != NULL) {
-                memcpy(&ctx->config->tx_buffer[tx_len], entry->storage, entry->size);
-                tx_len += (uint16_t) entry->size;
+                /* Static data goes out by reference when the transport supports it */
+                if (uds_response_ref(&resp, (const uint8_t *) entry->storage, entry->size) !=
+                    UDS_OK) {
+                    return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, UDS_NRC_RESPONSE_TOO_LONG);
+                }
+                if (cache) {
+                    uds_internal_did_cache_put(ctx, entry, (const uint8_t *) entry->storage);
+                }
             }
             else {
                 /* No read handler and no storage - invalid DID config */
@@ -82,12 +171,162 @@ int uds_internal_handle_read_data_by_id(uds_ctx_t *ctx, const uint8_t *data, uin
     if (any_error) {
         return uds_send_nrc(ctx, UDS_SID_READ_DATA_BY_ID, nrc_code);
     }
+
+    int result = uds_response_commit(&resp);
+    if (all_cached) {
+        /* After the commit: the fragments referenced by this response stay untouched */
+        uds_internal_did_cache_assemble(ctx, data, len);
+    }
+    return result;
+}
+#endif
+
+#if UDS_CFG_SERVICE_2C
+/* defineByIdentifier: [sourceDID hi][sourceDID lo][position][memorySize]... */
+static int define_by_identifier(uds_ctx_t *ctx, uds_dyn_did_t *dyn, const uint8_t *data,
+                                uint16_t len)
+{
+    if ((len < 8u) || (((len - 4u) % 4u) != 0u)) {
+        return -(int) UDS_NRC_INCORRECT_LENGTH;
+    }
+
+    for (uint16_t i = 4u; i < len; i += 4u) {
+        uint16_t src_id = (uint16_t) (((uint16_t) data[i] << 8u) | data[i + 1u]);
+        uint8_t position = data[i + 2u]; /* 1-based */
+        uint8_t size = data[i + 3u];
+
+        const uds_did_entry_t *entry = uds_internal_find_did(ctx, src_id);
+        if (entry == NULL) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+        int access = uds_internal_did_access(ctx, entry);
+        if (access == UDS_ACCESS_DENIED_SESSION) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+        if (access == UDS_ACCESS_DENIED_SECURITY) {
+            return -(int) UDS_NRC_SECURITY_ACCESS_DENIED;
+        }
+        if ((position == 0u) || (size == 0u) ||
+            (((uint16_t) position - 1u + size) > entry->size)) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+
+        int res = uds_internal_dyn_did_add_did(ctx, dyn, entry, (uint16_t) (position - 1u), size);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return UDS_OK;
+}
+
+/* defineByMemoryAddress: [ALFID][address][memorySize]... */
+static int define_by_memory(uds_ctx_t *ctx, uds_dyn_did_t *dyn, const uint8_t *data,
+                            uint16_t len)
+{
+    if (len < 5u) {
+        return -(int) UDS_NRC_INCORRECT_LENGTH;
+    }
+    uint8_t format = data[4];
+    uint8_t addr_len = (uint8_t) (format & 0x0Fu);
+    uint8_t size_len = (uint8_t) ((format >> 4u) & 0x0Fu);
+    if ((addr_len == 0u) || (size_len == 0u) || (addr_len > 4u) || (size_len > 4u)) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+    uint16_t record = (uint16_t) (addr_len + size_len);
+    if ((len == 5u) || (((len - 5u) % record) != 0u)) {
+        return -(int) UDS_NRC_INCORRECT_LENGTH;
+    }
+
+    for (uint16_t i = 5u; i < len; i = (uint16_t) (i + record)) {
+        uint32_t addr;
+        uint32_t size;
+        if (!uds_internal_parse_addr_len(&data[i], record, format, &addr, &size) ||
+            (size == 0u) || (size > 0xFFFFu)) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+        int res = uds_internal_dyn_did_add_memory(ctx, dyn, addr, (uint16_t) size);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return UDS_OK;
+}
+
+int uds_internal_handle_dynamic_define_did(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    uint8_t sub = (uint8_t) (data[1] & UDS_MASK_SUBFUNCTION);
+
+    if (ctx->config->dyn_dids == NULL) {
+        return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, UDS_NRC_CONDITIONS_NOT_CORRECT);
+    }
+    if ((len != 2u) && (len < 4u)) {
+        return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, UDS_NRC_INCORRECT_LENGTH);
+    }
+
+    uint16_t id = 0u;
+    if (len >= 4u) {
+        id = (uint16_t) (((uint16_t) data[2] << 8u) | data[3]);
+        if ((id < UDS_DYN_DID_FIRST) || (id > UDS_DYN_DID_LAST)) {
+            return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, UDS_NRC_REQUEST_OUT_OF_RANGE);
+        }
+    }
+
+    if (sub == 0x03u) {
+        /* clearDynamicallyDefinedDataIdentifier: one DID, or all without one */
+        if (len == 2u) {
+            uds_dyn_did_clear(ctx);
+        }
+        else if (len == 4u) {
+            uds_dyn_did_t *dyn = uds_internal_dyn_did_find(ctx, id);
+            if (dyn != NULL) {
+                uds_internal_dyn_did_free(dyn);
+            }
+        }
+        else {
+            return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, UDS_NRC_INCORRECT_LENGTH);
+        }
+    }
     else {
-        ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_READ_DATA_BY_ID + UDS_RESPONSE_OFFSET);
-        return uds_send_response(ctx, tx_len);
+        if (len == 2u) {
+            return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, UDS_NRC_INCORRECT_LENGTH);
+        }
+        uds_dyn_did_t *dyn = uds_internal_dyn_did_open(ctx, id);
+        if (dyn == NULL) {
+            return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, UDS_NRC_REQUEST_OUT_OF_RANGE);
+        }
+
+        /* A request is applied completely or not at all */
+        uint8_t count = dyn->count;
+        uint16_t size = dyn->size;
+        uds_dyn_did_step_t last = (count > 0u) ? dyn->steps[count - 1u] : dyn->steps[0];
+
+        int res = (sub == 0x01u) ? define_by_identifier(ctx, dyn, data, len)
+                                 : define_by_memory(ctx, dyn, data, len);
+        if (res < 0) {
+            dyn->count = count;
+            dyn->size = size;
+            if (count > 0u) {
+                dyn->steps[count - 1u] = last; /* May have been extended by a merge */
+            }
+            else {
+                uds_internal_dyn_did_free(dyn);
+            }
+            return uds_send_nrc(ctx, UDS_SID_DYN_DEFINE_DID, (uint8_t) - (int32_t) res);
+        }
+    }
+
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_DYN_DEFINE_DID + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = data[1];
+    if (len == 2u) {
+        return uds_send_response(ctx, 2u);
     }
+    uds_tx_buffer(ctx)[2] = data[2];
+    uds_tx_buffer(ctx)[3] = data[3];
+    return uds_send_response(ctx, 4u);
 }
+#endif
 
+#if UDS_CFG_SERVICE_2E
 int uds_internal_handle_write_data_by_id(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 3u) {
@@ -101,14 +340,11 @@ int uds_internal_handle_write_data_by_id(uds_ctx_t *ctx, const uint8_t *data, ui
     }
 
     /* C-18: Security & Session Validation per DID */
-    /* Session Check */
-    if ((entry->session_mask != 0u) &&
-        !((1u << (ctx->active_session - 1u)) & entry->session_mask)) {
+    int access = uds_internal_did_access(ctx, entry);
+    if (access == UDS_ACCESS_DENIED_SESSION) {
         return uds_send_nrc(ctx, UDS_SID_WRITE_DATA_BY_ID, UDS_NRC_REQUEST_OUT_OF_RANGE);
     }
-
-    /* Security Check */
-    if ((entry->security_mask != 0u) && !((1u << ctx->security_level) & entry->security_mask)) {
+    if (access == UDS_ACCESS_DENIED_SECURITY) {
         return uds_send_nrc(ctx, UDS_SID_WRITE_DATA_BY_ID, UDS_NRC_SECURITY_ACCESS_DENIED);
     }
 
@@ -130,15 +366,21 @@ int uds_internal_handle_write_data_by_id(uds_ctx_t *ctx, const uint8_t *data, ui
     }
 
     if (write_ok) {
-        ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_WRITE_DATA_BY_ID + UDS_RESPONSE_OFFSET);
-        ctx->config->tx_buffer[1] = data[1];
-        ctx->config->tx_buffer[2] = data[2];
+        if (uds_internal_did_cache_enabled(ctx)) {
+            uds_internal_did_cache_drop(ctx, entry);
+        }
+        uds_roe_notify_did(ctx, did);
+        uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_WRITE_DATA_BY_ID + UDS_RESPONSE_OFFSET);
+        uds_tx_buffer(ctx)[1] = data[1];
+        uds_tx_buffer(ctx)[2] = data[2];
         return uds_send_response(ctx, 3u);
     }
 
     return uds_send_nrc(ctx, UDS_SID_WRITE_DATA_BY_ID, UDS_NRC_CONDITIONS_NOT_CORRECT);
 }
+#endif
 
+#if UDS_CFG_SERVICE_2A
 int uds_internal_handle_periodic_read(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     /* ISO 14229-1: 0x2A [transmissionMode] [periodicDataIdentifier...] */
@@ -152,22 +394,15 @@ int uds_internal_handle_periodic_read(uds_ctx_t *ctx, const uint8_t *data, uint1
         /* Stop Sending */
         if (len == 2u) {
             /* Stop all */
-            memset(ctx->periodic_ids, 0, sizeof(ctx->periodic_ids));
-            ctx->periodic_count = 0u;
+            uds_internal_periodic_stop_all(ctx);
         }
         else {
             /* Stop specific IDs */
             for (uint16_t i = 2u; i < len; i++) {
-                uint8_t id = data[i];
-                for (uint8_t j = 0u; j < 8u; j++) {
-                    if (ctx->periodic_ids[j] == id) {
-                        ctx->periodic_ids[j] = 0u;
-                        ctx->periodic_count--;
-                    }
-                }
+                uds_internal_periodic_stop(ctx, data[i]);
             }
         }
-        ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_READ_BY_PER_ID + UDS_RESPONSE_OFFSET);
+        uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_READ_BY_PER_ID + UDS_RESPONSE_OFFSET);
         return uds_send_response(ctx, 1u);
     }
 
@@ -175,34 +410,31 @@ int uds_internal_handle_periodic_read(uds_ctx_t *ctx, const uint8_t *data, uint1
         return uds_send_nrc(ctx, UDS_SID_READ_BY_PER_ID, UDS_NRC_REQUEST_OUT_OF_RANGE);
     }
 
-    /* Add/Update Periodic IDs */
+    /* All or nothing: the new IDs (listed twice count once) must all fit */
+    uint16_t added = 0u;
     for (uint16_t i = 2u; i < len; i++) {
-        uint8_t id = data[i];
-        bool found = false;
-        for (uint8_t j = 0u; j < 8u; j++) {
-            if (ctx->periodic_ids[j] == id) {
-                ctx->periodic_rates[j] = mode;
-                found = true;
-                break;
-            }
+        bool seen = uds_internal_periodic_active(ctx, data[i]);
+        for (uint16_t j = 2u; !seen && (j < i); j++) {
+            seen = (data[j] == data[i]);
         }
-        if (!found) {
-            if (ctx->periodic_count >= 8u) {
-                return uds_send_nrc(ctx, UDS_SID_READ_BY_PER_ID, UDS_NRC_RESPONSE_TOO_LONG);
-            }
-            for (uint8_t j = 0u; j < 8u; j++) {
-                if (ctx->periodic_ids[j] == 0u) {
-                    ctx->periodic_ids[j] = id;
-                    ctx->periodic_rates[j] = mode;
-                    ctx->periodic_timers[j] =
-                        ctx->config->get_time_ms(); /* Start immediately or after interval */
-                    ctx->periodic_count++;
-                    break;
-                }
-            }
+        if (!seen) {
+            added++;
+        }
+    }
+    if (added > uds_internal_periodic_free(ctx)) {
+        return uds_send_nrc(ctx, UDS_SID_READ_BY_PER_ID, UDS_NRC_RESPONSE_TOO_LONG);
+    }
+
+    /* Add/Update Periodic IDs; new ones are sent on the next uds_process() */
+    uint32_t now = (added > 0u) ? ctx->config->get_time_ms() : 0u;
+    for (uint16_t i = 2u; i < len; i++) {
+        int res = uds_internal_periodic_start(ctx, data[i], mode, now);
+        if (res < 0) {
+            return uds_send_nrc(ctx, UDS_SID_READ_BY_PER_ID, (uint8_t) - (int32_t) res);
         }
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_READ_BY_PER_ID + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_READ_BY_PER_ID + UDS_RESPONSE_OFFSET);
     return uds_send_response(ctx, 1u);
 }
+#endif
@@ -10,8 +10,10 @@
  */
 
 #include <string.h>
+#include "uds/uds_transfer_pipe.h"
 #include "uds_internal.h"
 
+#if UDS_CFG_SERVICE_31
 int uds_internal_handle_routine_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 4u) {
@@ -27,8 +29,8 @@ int uds_internal_handle_routine_control(uds_ctx_t *ctx, const uint8_t *data, uin
                             UDS_NRC_CONDITIONS_NOT_CORRECT); /* Conditions Not Correct */
     }
 
-    uint8_t *out_payload = &ctx->config->tx_buffer[4];
-    uint16_t max_payload = (uint16_t) (ctx->config->tx_buffer_size - 4u);
+    uint8_t *out_payload = &uds_tx_buffer(ctx)[4];
+    uint16_t max_payload = (uint16_t) (uds_tx_buffer_size(ctx) - 4u);
 
     int written = ctx->config->fn_routine_control(ctx, type, id, &data[4], (uint16_t) (len - 4u),
                                                   out_payload, max_payload);
@@ -37,13 +39,48 @@ int uds_internal_handle_routine_control(uds_ctx_t *ctx, const uint8_t *data, uin
         return uds_send_nrc(ctx, UDS_SID_ROUTINE_CONTROL, (uint8_t) - (int32_t) written);
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_ROUTINE_CONTROL + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = type;
-    ctx->config->tx_buffer[2] = data[2];
-    ctx->config->tx_buffer[3] = data[3];
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_ROUTINE_CONTROL + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = type;
+    uds_tx_buffer(ctx)[2] = data[2];
+    uds_tx_buffer(ctx)[3] = data[3];
     return uds_send_response(ctx, (uint16_t) ((uint16_t) written + 4u));
 }
+#endif
 
+#if UDS_CFG_SERVICE_34 || UDS_CFG_SERVICE_35
+/**
+ * @brief Positive 0x34 / 0x35 response: maxNumberOfBlockLength.
+ *
+ * The block length (whole 0x36 message) is the smallest of limit, the
+ * transport SDU and the application cap, sent in as few bytes as it needs.
+ */
+static int send_block_length(uds_ctx_t *ctx, uint8_t sid, uint32_t limit, bool response)
+{
+    if (ctx->config->fn_tp_max_sdu != NULL) {
+        uint32_t sdu = ctx->config->fn_tp_max_sdu(ctx, response);
+        if (sdu < limit) {
+            limit = sdu;
+        }
+    }
+    if ((ctx->config->max_block_length != 0u) && (ctx->config->max_block_length < limit)) {
+        limit = ctx->config->max_block_length;
+    }
+
+    uint8_t n = 1u;
+    while ((n < 4u) && ((limit >> (8u * n)) != 0u)) {
+        n++;
+    }
+
+    uds_tx_buffer(ctx)[0] = (uint8_t) (sid + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = (uint8_t) (n << 4u); /* lengthFormatIdentifier */
+    for (uint8_t i = 0u; i < n; i++) {
+        uds_tx_buffer(ctx)[2u + i] = (uint8_t) (limit >> (8u * (uint8_t) (n - 1u - i)));
+    }
+    return uds_send_response(ctx, (uint16_t) (2u + n));
+}
+#endif
+
+#if UDS_CFG_SERVICE_34
 int uds_internal_handle_request_download(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     /* ISO 14229-1: 0x34 [dataFormatIdentifier] [addressAndLengthFormatIdentifier] [address...]
@@ -72,6 +109,14 @@ int uds_internal_handle_request_download(uds_ctx_t *ctx, const uint8_t *data, ui
         return uds_send_nrc(ctx, UDS_SID_REQUEST_DOWNLOAD, UDS_NRC_CONDITIONS_NOT_CORRECT);
     }
 
+    if (ctx->config->transfer_pipe != NULL) {
+        /* Pipelined 0x36: the previous transfer must be fully written */
+        int busy = uds_internal_pipe_reset(ctx);
+        if (busy < 0) {
+            return uds_send_nrc(ctx, UDS_SID_REQUEST_DOWNLOAD, (uint8_t) - (int32_t) busy);
+        }
+    }
+
     int res = ctx->config->fn_request_download(ctx, addr, size);
     if (res < 0) {
         return uds_send_nrc(ctx, UDS_SID_REQUEST_DOWNLOAD, (uint8_t) - (int32_t) res);
@@ -80,16 +125,17 @@ int uds_internal_handle_request_download(uds_ctx_t *ctx, const uint8_t *data, ui
     /* ISO 14229-1: Reset sequence counter for new transfer */
     ctx->flash_sequence = 0u;
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_REQUEST_DOWNLOAD + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] =
-        0x20u; /* Length format identifier (4 bytes for maxNumberOfBlockLength) */
-    ctx->config->tx_buffer[2] = 0x00u; /* Placeholder max block length */
-    ctx->config->tx_buffer[3] = 0x00u;
-    ctx->config->tx_buffer[4] = 0x04u;
-    ctx->config->tx_buffer[5] = 0x00u;
-    return uds_send_response(ctx, 6u);
+    /* A block is received into the rx_buffer, then staged in a pipe slot */
+    uint32_t limit = ctx->config->rx_buffer_size;
+    if ((ctx->config->transfer_pipe != NULL) &&
+        ((uint32_t) ctx->config->transfer_pipe->slot_size + 2u < limit)) {
+        limit = (uint32_t) ctx->config->transfer_pipe->slot_size + 2u;
+    }
+    return send_block_length(ctx, UDS_SID_REQUEST_DOWNLOAD, limit, false);
 }
+#endif
 
+#if UDS_CFG_SERVICE_36
 int uds_internal_handle_transfer_data(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 2u) {
@@ -116,26 +162,38 @@ int uds_internal_handle_transfer_data(uds_ctx_t *ctx, const uint8_t *data, uint1
             /* Optional interoperability: accept last-block replay without re-processing data. */
             if (ctx->config->transfer_accept_last_block_replay &&
                 (sequence == ctx->flash_sequence)) {
-                ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_TRANSFER_DATA + UDS_RESPONSE_OFFSET);
-                ctx->config->tx_buffer[1] = sequence;
+                uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_TRANSFER_DATA + UDS_RESPONSE_OFFSET);
+                uds_tx_buffer(ctx)[1] = sequence;
                 return uds_send_response(ctx, 2u);
             }
             return uds_send_nrc(ctx, UDS_SID_TRANSFER_DATA, UDS_NRC_REQUEST_SEQUENCE_ERROR);
         }
     }
 
-    int res = ctx->config->fn_transfer_data(ctx, sequence, &data[2], (uint16_t) (len - 2u));
+    int res;
+    if (ctx->config->transfer_pipe != NULL) {
+        /* Acknowledged once staged; written in the background */
+        res = uds_internal_pipe_transfer(ctx, sequence, &data[2], (uint16_t) (len - 2u));
+    }
+    else {
+        res = ctx->config->fn_transfer_data(ctx, sequence, &data[2], (uint16_t) (len - 2u));
+    }
     if (res < 0) {
         return uds_send_nrc(ctx, UDS_SID_TRANSFER_DATA, (uint8_t) - (int32_t) res);
     }
 
     ctx->flash_sequence = sequence;
+    if (res == UDS_PENDING) {
+        return UDS_PENDING; /* Answered when a slot frees */
+    }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_TRANSFER_DATA + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = sequence;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_TRANSFER_DATA + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = sequence;
     return uds_send_response(ctx, 2u);
 }
+#endif
 
+#if UDS_CFG_SERVICE_37
 int uds_internal_handle_request_transfer_exit(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     (void) data;
@@ -145,15 +203,28 @@ int uds_internal_handle_request_transfer_exit(uds_ctx_t *ctx, const uint8_t *dat
         return uds_send_nrc(ctx, UDS_SID_TRANSFER_EXIT, UDS_NRC_CONDITIONS_NOT_CORRECT);
     }
 
+    if (ctx->config->transfer_pipe != NULL) {
+        /* Wait for the staged blocks: fn_transfer_exit() runs after the last write */
+        int drained = uds_internal_pipe_exit(ctx);
+        if (drained < 0) {
+            return uds_send_nrc(ctx, UDS_SID_TRANSFER_EXIT, (uint8_t) - (int32_t) drained);
+        }
+        if (drained == UDS_PENDING) {
+            return UDS_PENDING;
+        }
+    }
+
     int res = ctx->config->fn_transfer_exit(ctx);
     if (res < 0) {
         return uds_send_nrc(ctx, UDS_SID_TRANSFER_EXIT, (uint8_t) - (int32_t) res);
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_TRANSFER_EXIT + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_TRANSFER_EXIT + UDS_RESPONSE_OFFSET);
     return uds_send_response(ctx, 1u);
 }
+#endif
 
+#if UDS_CFG_SERVICE_35
 int uds_internal_handle_request_upload(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     /* ISO 14229-1: 0x35 [dataFormatIdentifier] [addressAndLengthFormatIdentifier] [address...]
@@ -182,11 +253,7 @@ int uds_internal_handle_request_upload(uds_ctx_t *ctx, const uint8_t *data, uint
     /* Reset sequence counter for new transfer */
     ctx->flash_sequence = 0u;
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_REQUEST_UPLOAD + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = 0x20u; /* Length format identifier (4 bytes) */
-    ctx->config->tx_buffer[2] = 0x00u; /* Placeholder max block length */
-    ctx->config->tx_buffer[3] = 0x00u;
-    ctx->config->tx_buffer[4] = 0x04u;
-    ctx->config->tx_buffer[5] = 0x00u;
-    return uds_send_response(ctx, 6u);
+    /* A block is sent from the tx_buffer */
+    return send_block_length(ctx, UDS_SID_REQUEST_UPLOAD, ctx->config->tx_buffer_size, true);
 }
+#endif
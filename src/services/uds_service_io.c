@@ -11,6 +11,7 @@
 #include <string.h>
 #include "uds_internal.h"
 
+#if UDS_CFG_SERVICE_2F
 int uds_internal_handle_io_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     /* ISO 14229-1: 0x2F [DID high] [DID low] [controlOptionRecord...] [controlEnableMaskRecord...]
@@ -33,15 +34,16 @@ int uds_internal_handle_io_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t
     }
 
     /* Security/Session check for the DID */
-    if (entry->session_mask != 0u && !((1u << (ctx->active_session - 1u)) & entry->session_mask)) {
+    int access = uds_internal_did_access(ctx, entry);
+    if (access == UDS_ACCESS_DENIED_SESSION) {
         return uds_send_nrc(ctx, UDS_SID_IO_CONTROL_BY_ID, UDS_NRC_SERVICE_NOT_SUPP_IN_SESS);
     }
-    if (entry->security_mask != 0u && !((1u << ctx->security_level) & entry->security_mask)) {
+    if (access == UDS_ACCESS_DENIED_SECURITY) {
         return uds_send_nrc(ctx, UDS_SID_IO_CONTROL_BY_ID, UDS_NRC_SECURITY_ACCESS_DENIED);
     }
 
-    uint8_t *out_payload = &ctx->config->tx_buffer[3];
-    uint16_t max_payload = (uint16_t) (ctx->config->tx_buffer_size - 3u);
+    uint8_t *out_payload = &uds_tx_buffer(ctx)[3];
+    uint16_t max_payload = (uint16_t) (uds_tx_buffer_size(ctx) - 3u);
 
     /* controlOptionRecord starts at data[4] */
     int written = ctx->config->fn_io_control(ctx, id, ctrl_type, &data[4], (uint16_t) (len - 4u),
@@ -51,8 +53,9 @@ int uds_internal_handle_io_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t
         return uds_send_nrc(ctx, UDS_SID_IO_CONTROL_BY_ID, (uint8_t) - (int32_t) written);
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_IO_CONTROL_BY_ID + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = data[1];
-    ctx->config->tx_buffer[2] = data[2];
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_IO_CONTROL_BY_ID + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = data[1];
+    uds_tx_buffer(ctx)[2] = data[2];
     return uds_send_response(ctx, (uint16_t) ((uint16_t) written + 3u));
 }
+#endif
@@ -5,13 +5,17 @@
 
 /**
  * @file uds_service_maintenance.c
- * @brief Maintenance Services: ECU Reset (0x11), Comm Control (0x28), and DTC Management (0x14,
- * 0x19, 0x85)
+ * @brief Maintenance Services: ECU Reset (0x11), Comm Control (0x28), DTC Management (0x14,
+ * 0x19, 0x85) and ResponseOnEvent (0x86)
  */
 
+#include "uds/uds_dtc.h"
+#include "uds/uds_response.h"
+#include "uds/uds_roe.h"
 #include "uds_internal.h"
 #include <string.h>
 
+#if UDS_CFG_SERVICE_11
 int uds_internal_handle_ecu_reset(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 2u) {
@@ -40,11 +44,13 @@ int uds_internal_handle_ecu_reset(uds_ctx_t *ctx, const uint8_t *data, uint16_t
         return UDS_OK;
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_ECU_RESET + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = sub;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_ECU_RESET + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = sub;
     return uds_send_response(ctx, 2u);
 }
+#endif
 
+#if UDS_CFG_SERVICE_28
 int uds_internal_handle_comm_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     /* C-11: Minimum length is 3 bytes (SI+Control+Comm) */
@@ -86,12 +92,14 @@ int uds_internal_handle_comm_control(uds_ctx_t *ctx, const uint8_t *data, uint16
         return UDS_OK;
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_COMM_CONTROL + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = ctrl_type;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_COMM_CONTROL + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = ctrl_type;
 
     return uds_send_response(ctx, 2u);
 }
+#endif
 
+#if UDS_CFG_SERVICE_14
 int uds_internal_handle_clear_dtc(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 4u) {
@@ -99,7 +107,12 @@ int uds_internal_handle_clear_dtc(uds_ctx_t *ctx, const uint8_t *data, uint16_t
                             UDS_NRC_INCORRECT_LENGTH); /* Incorrect Msg Length */
     }
 
-    if (!ctx->config->fn_dtc_clear) {
+#if UDS_CFG_FEATURE_DTC
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+#else
+    const void *store = NULL;
+#endif
+    if (!ctx->config->fn_dtc_clear && (store == NULL)) {
         return uds_send_nrc(
             ctx, UDS_SID_CLEAR_DTC,
             UDS_NRC_CONDITIONS_NOT_CORRECT); /* Conditions Not Correct (No clear hook) */
@@ -107,16 +120,34 @@ int uds_internal_handle_clear_dtc(uds_ctx_t *ctx, const uint8_t *data, uint16_t
 
     uint32_t group = (uint32_t) ((uint32_t) data[1] << 16u) |
                      (uint32_t) ((uint32_t) data[2] << 8u) | (uint32_t) data[3];
-    int res = ctx->config->fn_dtc_clear(ctx, group);
 
-    if (res != UDS_OK) {
-        return uds_send_nrc(ctx, UDS_SID_CLEAR_DTC, (uint8_t) - (int32_t) res);
+#if UDS_CFG_FEATURE_DTC
+    /* Built-in store: all DTCs or one registered DTC */
+    if ((store != NULL) && (group != UDS_DTC_GROUP_ALL) &&
+        (uds_internal_dtc_find(store, group) < 0)) {
+        return uds_send_nrc(ctx, UDS_SID_CLEAR_DTC, UDS_NRC_REQUEST_OUT_OF_RANGE);
     }
+#endif
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_CLEAR_DTC + UDS_RESPONSE_OFFSET);
+    /* The application clears its own records first; the store is kept if it fails */
+    if (ctx->config->fn_dtc_clear) {
+        int res = ctx->config->fn_dtc_clear(ctx, group);
+        if (res != UDS_OK) {
+            return uds_send_nrc(ctx, UDS_SID_CLEAR_DTC, (uint8_t) - (int32_t) res);
+        }
+    }
+#if UDS_CFG_FEATURE_DTC
+    if (store != NULL) {
+        uds_internal_dtc_clear(ctx, group);
+    }
+#endif
+
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_CLEAR_DTC + UDS_RESPONSE_OFFSET);
     return uds_send_response(ctx, 1u);
 }
+#endif
 
+#if UDS_CFG_SERVICE_19
 int uds_internal_handle_read_dtc_info(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 2u) {
@@ -135,19 +166,53 @@ int uds_internal_handle_read_dtc_info(uds_ctx_t *ctx, const uint8_t *data, uint1
         return uds_send_nrc(ctx, UDS_SID_READ_DTC_INFO, UDS_NRC_INCORRECT_LENGTH);
     }
 
-    if (!ctx->config->fn_dtc_read) {
-        return uds_send_nrc(ctx, UDS_SID_READ_DTC_INFO, UDS_NRC_CONDITIONS_NOT_CORRECT);
+#if UDS_CFG_FEATURE_DTC
+    const uds_dtc_store_t *store = ctx->config->dtc_store;
+    bool from_store = (store != NULL) && uds_internal_dtc_reports(store, sub);
+#else
+    const void *store = NULL;
+    bool from_store = false;
+#endif
+    if (!from_store && !ctx->config->fn_dtc_read) {
+        return uds_send_nrc(ctx, UDS_SID_READ_DTC_INFO,
+                            (store != NULL) ? UDS_NRC_SUBFUNCTION_NOT_SUPPORTED
+                                            : UDS_NRC_CONDITIONS_NOT_CORRECT);
     }
 
     if (suppress_pos_resp) {
         ctx->suppress_pos_resp = true;
     }
 
-    uint8_t *out_payload = &ctx->config->tx_buffer[2];
-    uint16_t max_payload = (uint16_t) (ctx->config->tx_buffer_size - 2u);
-
-    /* Pass subfunction and optional mask (data[2]) to the application */
+    uint8_t *out_payload = &uds_tx_buffer(ctx)[2];
+    uint16_t max_payload = (uint16_t) (uds_tx_buffer_size(ctx) - 2u);
+
+#if UDS_CFG_FEATURE_DTC
+    /* Built-in store, else the application; optional mask in data[2] */
+    int written = from_store ? uds_internal_dtc_report(ctx, sub, data, len, out_payload,
+                                                       max_payload)
+                             : ctx->config->fn_dtc_read(ctx, sub, out_payload, max_payload);
+    if ((written == -(int) UDS_NRC_RESPONSE_TOO_LONG) && from_store &&
+        ((sub == 0x02u) || (sub == 0x0Au)) && uds_internal_can_stream(ctx)) {
+        /* Stream the DTC records while the transport sends them */
+        uint8_t mask = (len > 2u) ? data[2] : 0u;
+        uds_response_t resp;
+        if (uds_response_begin(&resp, ctx, UDS_SID_READ_DTC_INFO) != UDS_OK) {
+            return UDS_ERR_NOT_INIT;
+        }
+        uint8_t *hdr = uds_response_reserve(&resp, 2u);
+        if (hdr != NULL) {
+            hdr[0] = sub;
+            hdr[1] = store->availability_mask;
+        }
+        (void) uds_response_stream(&resp, 0u, 4u * uds_internal_dtc_matches(store, sub, mask),
+                                   uds_internal_dtc_stream,
+                                   (void *) (uintptr_t) (((uint32_t) sub << 8u) | mask));
+        return uds_response_commit(&resp);
+    }
+#else
     int written = ctx->config->fn_dtc_read(ctx, sub, out_payload, max_payload);
+#endif
+
     if (written < 0) {
         return uds_send_nrc(ctx, UDS_SID_READ_DTC_INFO, (uint8_t) - (int32_t) written);
     }
@@ -156,11 +221,13 @@ int uds_internal_handle_read_dtc_info(uds_ctx_t *ctx, const uint8_t *data, uint1
         return UDS_OK;
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_READ_DTC_INFO + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = sub;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_READ_DTC_INFO + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = sub;
     return uds_send_response(ctx, (uint16_t) ((uint16_t) written + 2u));
 }
+#endif
 
+#if UDS_CFG_SERVICE_85
 int uds_internal_handle_control_dtc_setting(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 2u) {
@@ -179,10 +246,183 @@ int uds_internal_handle_control_dtc_setting(uds_ctx_t *ctx, const uint8_t *data,
         ctx->suppress_pos_resp = true;
     }
 
-    /* Process DTC Setting Control (usually global flag in ctx or config) */
-    /* ... application should probably handle this via a hook if needed ... */
+#if UDS_CFG_FEATURE_DTC
+    /* Built-in store: freeze the status bytes while off */
+    if (ctx->config->dtc_store != NULL) {
+        ctx->config->dtc_store->setting_off = (sub == 0x02u);
+    }
+#endif
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_CONTROL_DTC_SETTING + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = sub;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_CONTROL_DTC_SETTING + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = sub;
     return uds_send_response(ctx, 2u);
 }
+#endif
+
+#if UDS_CFG_SERVICE_86
+/* eventTypeRecord length of a set-up event type, 0 if the type sets up nothing */
+static uint8_t roe_record_len(uint8_t type)
+{
+    switch (type) {
+        case UDS_ROE_ON_DTC_STATUS_CHANGE:
+            return 1u; /* DTCStatusMask */
+        case UDS_ROE_ON_CHANGE_OF_DID:
+            return 2u; /* DID */
+        case UDS_ROE_ON_COMPARISON:
+            return 10u; /* DID, logic, reference, hysteresis, localization */
+        default:
+            return 0u;
+    }
+}
+
+/* Validate a set-up request and store its event; UDS_OK or negative NRC */
+static int roe_setup(uds_ctx_t *ctx, uint8_t type, const uint8_t *data, uint16_t len,
+                     uds_roe_event_t **out)
+{
+    uds_roe_t *roe = ctx->config->roe;
+    uint8_t record_len = roe_record_len(type);
+    const uint8_t *record = &data[3];
+    const uint8_t *strr = &data[3u + record_len];
+
+    if (len < (4u + record_len)) {
+        return -(int) UDS_NRC_INCORRECT_LENGTH;
+    }
+    uint16_t strr_len = (uint16_t) (len - 3u - record_len);
+
+    /* serviceToRespondTo: reads the server can answer on its own */
+    if ((strr_len > UDS_ROE_MAX_STRR) ||
+        ((strr[0] != UDS_SID_READ_DATA_BY_ID) && (strr[0] != UDS_SID_READ_DTC_INFO))) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+
+    if (type != UDS_ROE_ON_DTC_STATUS_CHANGE) {
+        const uds_did_entry_t *entry =
+            uds_internal_find_did(ctx, (uint16_t) (((uint16_t) record[0] << 8u) | record[1]));
+        if (entry == NULL) {
+            return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+        }
+        if (type == UDS_ROE_ON_COMPARISON) {
+            uint32_t bits = (uint32_t) (record[8] >> 2u) & 0x1Fu;
+            uint32_t offset = ((uint32_t) (record[8] & 0x03u) << 8u) | record[9];
+            if ((record[2] < UDS_ROE_CMP_LESS) || (record[2] > UDS_ROE_CMP_NOT_EQUAL) ||
+                (record[7] > 100u) ||
+                ((offset + ((bits == 0u) ? 32u : bits)) > ((uint32_t) entry->size * 8u))) {
+                return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+            }
+        }
+    }
+
+    /* The same event set up again replaces the old one, else a free slot */
+    uds_roe_event_t *slot = NULL;
+    for (uint8_t i = 0u; i < roe->count; i++) {
+        uds_roe_event_t *event = &roe->events[i];
+        if ((event->type == type) && (memcmp(event->record, record, record_len) == 0)) {
+            slot = event;
+            break;
+        }
+        if ((slot == NULL) && (event->type == 0u)) {
+            slot = event;
+        }
+    }
+    if (slot == NULL) {
+        return -(int) UDS_NRC_REQUEST_OUT_OF_RANGE;
+    }
+
+    memset(slot, 0, sizeof(*slot));
+    slot->type = type;
+    slot->window = data[2];
+    memcpy(slot->record, record, record_len);
+    slot->record_len = record_len;
+    memcpy(slot->strr, strr, strr_len);
+    slot->strr_len = (uint8_t) strr_len;
+    slot->tester_addr = ctx->tester_addr;
+    *out = slot;
+    return UDS_OK;
+}
+
+int uds_internal_handle_response_on_event(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    /* ISO 14229-1: 0x86 [eventType] [eventWindowTime] [eventTypeRecord] [serviceToRespondTo] */
+    uds_roe_t *roe = ctx->config->roe;
+    uint8_t sub = (uint8_t) (data[1] & UDS_MASK_SUBFUNCTION);
+    uint8_t type = (uint8_t) (sub & 0x3Fu); /* storageState (bit 6): events are not persisted */
+    uint8_t *tx = uds_tx_buffer(ctx);
+    uint16_t pos = 3u;
+
+    if (roe == NULL) {
+        return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_CONDITIONS_NOT_CORRECT);
+    }
+
+    tx[0] = (uint8_t) (UDS_SID_RESPONSE_ON_EVENT + UDS_RESPONSE_OFFSET);
+    tx[1] = sub;
+    tx[2] = 0u; /* numberOfIdentifiedEvents / numberOfActivatedEvents */
+
+    if (type == UDS_ROE_REPORT_ACTIVATED) {
+        if (len != 2u) {
+            return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_INCORRECT_LENGTH);
+        }
+        for (uint8_t i = 0u; i < roe->count; i++) {
+            const uds_roe_event_t *event = &roe->events[i];
+            if (!event->active) {
+                continue;
+            }
+            if ((pos + 2u + event->record_len + event->strr_len) > uds_tx_buffer_size(ctx)) {
+                return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_RESPONSE_TOO_LONG);
+            }
+            tx[pos++] = event->type;
+            pos = (uint16_t) (pos + uds_internal_roe_encode(event, &tx[pos]));
+            tx[2]++;
+        }
+        return uds_send_response(ctx, pos);
+    }
+
+    if (len < 3u) {
+        return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_INCORRECT_LENGTH);
+    }
+    if ((data[2] < UDS_ROE_WINDOW_INFINITE) || (data[2] > UDS_ROE_WINDOW_LONG)) {
+        return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_REQUEST_OUT_OF_RANGE);
+    }
+
+    if (roe_record_len(type) != 0u) {
+        uds_roe_event_t *event = NULL;
+        int res = roe_setup(ctx, type, data, len, &event);
+        if (res < 0) {
+            return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, (uint8_t) - (int32_t) res);
+        }
+        pos = (uint16_t) (pos + uds_internal_roe_encode(event, &tx[pos]));
+        return uds_send_response(ctx, pos);
+    }
+
+    /* Stop, start and clear act on every event */
+    if (len != 3u) {
+        return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_INCORRECT_LENGTH);
+    }
+    if (type == UDS_ROE_START) {
+        bool any = false;
+        for (uint8_t i = 0u; i < roe->count; i++) {
+            any = any || (roe->events[i].type != 0u);
+        }
+        if (!any) {
+            return uds_send_nrc(ctx, UDS_SID_RESPONSE_ON_EVENT, UDS_NRC_REQUEST_SEQUENCE_ERROR);
+        }
+        uint32_t now = ctx->config->get_time_ms();
+        roe->next_poll = now + roe->poll_ms;
+        for (uint8_t i = 0u; i < roe->count; i++) {
+            if (roe->events[i].type != 0u) {
+                uds_internal_roe_start(ctx, &roe->events[i], now);
+                tx[2]++;
+            }
+        }
+    }
+    else {
+        for (uint8_t i = 0u; i < roe->count; i++) {
+            if (type == UDS_ROE_CLEAR) {
+                memset(&roe->events[i], 0, sizeof(roe->events[i]));
+            }
+            roe->events[i].active = false;
+        }
+    }
+    tx[3] = data[2];
+    return uds_send_response(ctx, 4u);
+}
+#endif
@@ -9,8 +9,20 @@
  */
 
 #include "uds_internal.h"
+#include "uds/uds_response.h"
 #include <string.h>
 
+#if UDS_CFG_SERVICE_23
+/**
+ * @brief Producer of a streamed 0x23 response: one fn_mem_read() per frame.
+ */
+static int read_memory_chunk(uds_ctx_t *ctx, void *arg, uint32_t pos, uint8_t *buf,
+                             uint16_t len)
+{
+    (void) arg;
+    return ctx->config->fn_mem_read(ctx, pos, len, buf);
+}
+
 int uds_internal_handle_read_memory_by_addr(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 3u) {
@@ -32,23 +44,45 @@ int uds_internal_handle_read_memory_by_addr(uds_ctx_t *ctx, const uint8_t *data,
         return uds_send_nrc(ctx, UDS_SID_READ_MEM_BY_ADDR, UDS_NRC_INCORRECT_LENGTH);
     }
 
+    /* Zero-copy path: send directly readable memory by reference */
+    if ((ctx->config->fn_mem_map != NULL) && (ctx->config->fn_tp_sendv != NULL) &&
+        (size < 0xFFFFu)) {
+        const uint8_t *mem = ctx->config->fn_mem_map(ctx, addr, size);
+        if (mem != NULL) {
+            uds_response_t resp;
+            if (uds_response_begin(&resp, ctx, UDS_SID_READ_MEM_BY_ADDR) != UDS_OK) {
+                return UDS_ERR_NOT_INIT;
+            }
+            (void) uds_response_ref(&resp, mem, (uint16_t) size);
+            return uds_response_commit(&resp);
+        }
+    }
+
     if (ctx->config->fn_mem_read == NULL) {
         return uds_send_nrc(ctx, UDS_SID_READ_MEM_BY_ADDR, UDS_NRC_CONDITIONS_NOT_CORRECT);
     }
 
-    if (size > (uint32_t) (ctx->config->tx_buffer_size - 1u)) {
-        return uds_send_nrc(ctx, UDS_SID_READ_MEM_BY_ADDR, UDS_NRC_RESPONSE_TOO_LONG);
+    if (size > (uint32_t) (uds_tx_buffer_size(ctx) - 1u)) {
+        /* Streamed while the transport sends, or NRC 0x14 without fn_tp_send_stream */
+        uds_response_t resp;
+        if (uds_response_begin(&resp, ctx, UDS_SID_READ_MEM_BY_ADDR) != UDS_OK) {
+            return UDS_ERR_NOT_INIT;
+        }
+        (void) uds_response_stream(&resp, addr, size, read_memory_chunk, NULL);
+        return uds_response_commit(&resp);
     }
 
-    int res = ctx->config->fn_mem_read(ctx, addr, size, &ctx->config->tx_buffer[1]);
+    int res = ctx->config->fn_mem_read(ctx, addr, size, &uds_tx_buffer(ctx)[1]);
     if (res < 0) {
         return uds_send_nrc(ctx, UDS_SID_READ_MEM_BY_ADDR, (uint8_t) - (int32_t) res);
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_READ_MEM_BY_ADDR + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_READ_MEM_BY_ADDR + UDS_RESPONSE_OFFSET);
     return uds_send_response(ctx, (uint16_t) (size + 1u));
 }
+#endif
 
+#if UDS_CFG_SERVICE_3D
 int uds_internal_handle_write_memory_by_addr(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 3u) {
@@ -89,13 +123,14 @@ int uds_internal_handle_write_memory_by_addr(uds_ctx_t *ctx, const uint8_t *data
         return uds_send_nrc(ctx, UDS_SID_WRITE_MEM_BY_ADDR, (uint8_t) - (int32_t) res);
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_WRITE_MEM_BY_ADDR + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = format;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_WRITE_MEM_BY_ADDR + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = format;
 
     /* C-20: ISO 14229-1: Server shall echo the address and size if successfully written */
     for (uint16_t i = 0u; i < (uint16_t) ((uint16_t) addr_len + (uint16_t) size_len); i++) {
-        ctx->config->tx_buffer[2u + i] = data[2u + i];
+        uds_tx_buffer(ctx)[2u + i] = data[2u + i];
     }
 
     return uds_send_response(ctx, (uint16_t) (2u + (uint16_t) addr_len + (uint16_t) size_len));
 }
+#endif
@@ -10,6 +10,7 @@
 
 #include "uds_internal.h"
 
+#if UDS_CFG_SERVICE_27
 int uds_internal_handle_security_access(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 2u) {
@@ -35,12 +36,12 @@ int uds_internal_handle_security_access(uds_ctx_t *ctx, const uint8_t *data, uin
             return uds_send_nrc(ctx, UDS_SID_SECURITY_ACCESS, UDS_NRC_CONDITIONS_NOT_CORRECT);
         }
 
-        ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_SECURITY_ACCESS + UDS_RESPONSE_OFFSET);
-        ctx->config->tx_buffer[1] = sub_raw;
+        uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_SECURITY_ACCESS + UDS_RESPONSE_OFFSET);
+        uds_tx_buffer(ctx)[1] = sub_raw;
 
         int seed_len = ctx->config->fn_security_seed(ctx, (uint8_t) (((uint16_t) sub + 1u) / 2u),
-                                                     &ctx->config->tx_buffer[2],
-                                                     (uint16_t) (ctx->config->tx_buffer_size - 2u));
+                                                     &uds_tx_buffer(ctx)[2],
+                                                     (uint16_t) (uds_tx_buffer_size(ctx) - 2u));
         if (seed_len < 0) {
             return uds_send_nrc(ctx, UDS_SID_SECURITY_ACCESS, (uint8_t) - (int32_t) seed_len);
         }
@@ -65,8 +66,8 @@ int uds_internal_handle_security_access(uds_ctx_t *ctx, const uint8_t *data, uin
                 ctx->config->fn_nvm_save(ctx, state, 2u);
             }
 
-            ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_SECURITY_ACCESS + UDS_RESPONSE_OFFSET);
-            ctx->config->tx_buffer[1] = sub_raw;
+            uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_SECURITY_ACCESS + UDS_RESPONSE_OFFSET);
+            uds_tx_buffer(ctx)[1] = sub_raw;
             return uds_send_response(ctx, 2u);
         }
         else {
@@ -88,7 +89,9 @@ int uds_internal_handle_security_access(uds_ctx_t *ctx, const uint8_t *data, uin
         }
     }
 }
+#endif
 
+#if UDS_CFG_SERVICE_29
 int uds_internal_handle_authentication(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     if (len < 2u) {
@@ -102,8 +105,8 @@ int uds_internal_handle_authentication(uds_ctx_t *ctx, const uint8_t *data, uint
     }
 
     /* Payload begins at data[2]. Output payload at tx_buffer[2] */
-    uint8_t *out_payload = &ctx->config->tx_buffer[2];
-    uint16_t max_payload = (uint16_t) (ctx->config->tx_buffer_size - 2u);
+    uint8_t *out_payload = &uds_tx_buffer(ctx)[2];
+    uint16_t max_payload = (uint16_t) (uds_tx_buffer_size(ctx) - 2u);
 
     int written =
         ctx->config->fn_auth(ctx, sub, &data[2], (uint16_t) (len - 2u), out_payload, max_payload);
@@ -112,7 +115,8 @@ int uds_internal_handle_authentication(uds_ctx_t *ctx, const uint8_t *data, uint
         return uds_send_nrc(ctx, UDS_SID_AUTHENTICATION, (uint8_t) - (int32_t) written);
     }
 
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_AUTHENTICATION + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = data[1];
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_AUTHENTICATION + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = data[1];
     return uds_send_response(ctx, (uint16_t) ((uint16_t) written + 2u));
 }
+#endif
@@ -10,6 +10,7 @@
 
 #include "uds_internal.h"
 
+#if UDS_CFG_SERVICE_10
 int uds_internal_handle_session_control(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     (void) len;
@@ -32,8 +33,8 @@ int uds_internal_handle_session_control(uds_ctx_t *ctx, const uint8_t *data, uin
     ctx->active_session = sub;
 
     /* Prepare Response */
-    ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_SESSION_CONTROL + UDS_RESPONSE_OFFSET);
-    ctx->config->tx_buffer[1] = sub;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_SESSION_CONTROL + UDS_RESPONSE_OFFSET);
+    uds_tx_buffer(ctx)[1] = sub;
 
     /* C-19: Use Configured P2 Timings */
     /* Default fallback if not configured: P2=50ms, P2*=5000ms */
@@ -42,10 +43,10 @@ int uds_internal_handle_session_control(uds_ctx_t *ctx, const uint8_t *data, uin
         ctx->config->p2_star_server_max > 0 ? ctx->config->p2_star_server_max : 5000u;
     uint16_t p2_star_val = p2_star_ms / 10u; /* P2* resolution is 10ms */
 
-    ctx->config->tx_buffer[2] = (uint8_t) ((p2 >> 8) & 0xFFu);
-    ctx->config->tx_buffer[3] = (uint8_t) (p2 & 0xFFu);
-    ctx->config->tx_buffer[4] = (uint8_t) ((p2_star_val >> 8) & 0xFFu);
-    ctx->config->tx_buffer[5] = (uint8_t) (p2_star_val & 0xFFu);
+    uds_tx_buffer(ctx)[2] = (uint8_t) ((p2 >> 8) & 0xFFu);
+    uds_tx_buffer(ctx)[3] = (uint8_t) (p2 & 0xFFu);
+    uds_tx_buffer(ctx)[4] = (uint8_t) ((p2_star_val >> 8) & 0xFFu);
+    uds_tx_buffer(ctx)[5] = (uint8_t) (p2_star_val & 0xFFu);
 
     uds_send_response(ctx, 6u);
 
@@ -57,15 +58,18 @@ int uds_internal_handle_session_control(uds_ctx_t *ctx, const uint8_t *data, uin
 
     return UDS_OK;
 }
+#endif
 
+#if UDS_CFG_SERVICE_3E
 int uds_internal_handle_tester_present(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
 {
     (void) len;
     uint8_t sub = (uint8_t) (data[1] & UDS_MASK_SUBFUNCTION);
     if (sub == 0x00u) {
-        ctx->config->tx_buffer[0] = (uint8_t) (UDS_SID_TESTER_PRESENT + UDS_RESPONSE_OFFSET);
-        ctx->config->tx_buffer[1] = 0x00u;
+        uds_tx_buffer(ctx)[0] = (uint8_t) (UDS_SID_TESTER_PRESENT + UDS_RESPONSE_OFFSET);
+        uds_tx_buffer(ctx)[1] = 0x00u;
         return uds_send_response(ctx, 2u);
     }
     return uds_send_nrc(ctx, UDS_SID_TESTER_PRESENT, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
 }
+#endif
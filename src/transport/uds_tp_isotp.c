@@ -10,8 +10,10 @@
 
 #include <string.h>
 
+#include "uds/uds_buffer_pool.h"
 #include "uds/uds_core.h"
 #include "uds/uds_isotp.h"
+#include "uds/uds_response.h"
 
 /* --- Internal State --- */
 
@@ -24,8 +26,68 @@ static uint8_t g_pending_tx_sdu[1024];
 /** Length of cached multi-frame SDU */
 static uint16_t g_pending_tx_len = 0;
 
+#if UDS_CFG_FEATURE_STREAM
+/** Context whose streamed response is being sent (NULL = g_pending_tx_sdu) */
+static struct uds_ctx *g_stream_ctx = NULL;
+
+/** Payload of the next streamed consecutive frame, pulled but not yet sent */
+static uint8_t g_stream_cf[ISOTP_MAX_DL_CANFD - 1u];
+
+/** Bytes held in g_stream_cf */
+static uint8_t g_stream_cf_len = 0;
+#endif
+
+#if UDS_CFG_FEATURE_BUFFER_POOL
+/** Reassembly buffer borrowed from uds_config_t::buffer_pool (pool mode only) */
+static uint8_t *g_rx_lease = NULL;
+#endif
+
+/** Context of the multi-frame being received (owner of g_rx_lease) */
+static struct uds_ctx *g_rx_ctx = NULL;
+
+/** A frame of the multi-frame was received: restart N_Cr at the next tick */
+static bool g_rx_restart = false;
+
 /* --- Internal Helpers --- */
 
+/**
+ * @brief Internal Helper: Reassembly buffer of the current multi-frame.
+ */
+static uint8_t *uds_rx_buffer(const struct uds_ctx *uds_ctx)
+{
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    if (g_rx_lease != NULL) {
+        return g_rx_lease;
+    }
+#endif
+    return uds_ctx->config->rx_buffer;
+}
+
+/**
+ * @brief Internal Helper: Give a borrowed reassembly buffer back to the pool.
+ */
+static void uds_rx_release(const struct uds_ctx *uds_ctx)
+{
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    if (g_rx_lease != NULL) {
+        uds_buffer_pool_return(uds_ctx->config->buffer_pool, g_rx_lease);
+        g_rx_lease = NULL;
+    }
+#else
+    (void) uds_ctx;
+#endif
+}
+
+/**
+ * @brief Internal Helper: Forget the streamed response (the next SDU is not streamed).
+ */
+static void uds_stream_stop(void)
+{
+#if UDS_CFG_FEATURE_STREAM
+    g_stream_ctx = NULL;
+#endif
+}
+
 /**
  * @brief Internal Helper: Raw CAN Frame Transmitter.
  *
@@ -71,6 +133,7 @@ void uds_tp_isotp_init(uds_can_send_fn can_send, uint32_t tx_id, uint32_t rx_id)
     g_isotp_ctx.st_min = 0;               /* Default No Delay */
     g_isotp_ctx.use_can_fd = 0;           /* Default: Classic CAN */
     g_isotp_ctx.tx_dl = ISOTP_MAX_DL_CAN; /* Default: 8 bytes */
+    uds_stream_stop();
 }
 
 void uds_tp_isotp_set_fd(bool enabled)
@@ -107,16 +170,13 @@ static int uds_send_sf(const uint8_t *data, uint16_t len)
 }
 
 /**
- * @brief Internal: Start Multi-Frame Transmission.
+ * @brief Internal: Start Multi-Frame Transmission of the staged SDU.
  */
-static int uds_send_mf(const uint8_t *data, uint16_t len)
+static int uds_start_mf(uint16_t len)
 {
-    if (len > ISOTP_MAX_SDU_LEN_STD || len > sizeof(g_pending_tx_sdu)) {
-        return -2;
-    }
-
-    memcpy(g_pending_tx_sdu, data, len);
+    const uint8_t *data = g_pending_tx_sdu;
     g_pending_tx_len = len;
+    uds_stream_stop();
 
     g_isotp_ctx.msg_len = len;
     g_isotp_ctx.bytes_processed = 0;
@@ -157,6 +217,35 @@ static int uds_send_mf(const uint8_t *data, uint16_t len)
     return 0; /* Multi-Frame started successfully */
 }
 
+/**
+ * @brief Internal: Stage an SDU and start Multi-Frame Transmission.
+ */
+static int uds_send_mf(const uint8_t *data, uint16_t len)
+{
+    if (len > ISOTP_MAX_SDU_LEN_STD || len > sizeof(g_pending_tx_sdu)) {
+        return -2;
+    }
+
+    memcpy(g_pending_tx_sdu, data, len);
+    return uds_start_mf(len);
+}
+
+/**
+ * @brief Internal: Concatenate segments into a buffer of at least len bytes.
+ */
+static bool uds_gather(uint8_t *dst, const uds_iovec_t *iov, uint8_t count, uint16_t len)
+{
+    uint16_t off = 0u;
+    for (uint8_t i = 0u; i < count; i++) {
+        if ((uint32_t) off + iov[i].len > len) {
+            return false;
+        }
+        memcpy(&dst[off], iov[i].base, iov[i].len);
+        off = (uint16_t) (off + iov[i].len);
+    }
+    return off == len;
+}
+
 // cppcheck-suppress unusedFunction
 int uds_isotp_send(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
 {
@@ -166,17 +255,129 @@ int uds_isotp_send(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
     uint8_t max_sf_len = (g_isotp_ctx.use_can_fd) ? ISOTP_SF_MAX_DL_CANFD : ISOTP_SF_MAX_DL_CAN;
 
     if (len <= max_sf_len) {
+        uds_stream_stop();
         return uds_send_sf(data, len);
     }
 
     return uds_send_mf(data, len);
 }
 
+// cppcheck-suppress unusedFunction
+int uds_isotp_sendv(struct uds_ctx *ctx, const uds_iovec_t *iov, uint8_t count, uint16_t len)
+{
+    (void) ctx;
+
+    uint8_t max_sf_len = (g_isotp_ctx.use_can_fd) ? ISOTP_SF_MAX_DL_CANFD : ISOTP_SF_MAX_DL_CAN;
+
+    if (len <= max_sf_len) {
+        uint8_t sdu[ISOTP_SF_MAX_DL_CANFD];
+        if (!uds_gather(sdu, iov, count, len)) {
+            return -1;
+        }
+        uds_stream_stop();
+        return uds_send_sf(sdu, len);
+    }
+
+    if (len > ISOTP_MAX_SDU_LEN_STD || len > sizeof(g_pending_tx_sdu)) {
+        return -2;
+    }
+
+    /* Gather straight into the segmentation buffer: one copy per byte */
+    if (!uds_gather(g_pending_tx_sdu, iov, count, len)) {
+        return -1;
+    }
+    return uds_start_mf(len);
+}
+
+#if UDS_CFG_FEATURE_STREAM
+// cppcheck-suppress unusedFunction
+int uds_isotp_send_stream(struct uds_ctx *ctx, uint32_t len)
+{
+    uint8_t max_sf_len = (g_isotp_ctx.use_can_fd) ? ISOTP_SF_MAX_DL_CANFD : ISOTP_SF_MAX_DL_CAN;
+
+    g_stream_ctx = NULL;
+    if (len <= max_sf_len) {
+        uint8_t sdu[ISOTP_SF_MAX_DL_CANFD];
+        if (uds_stream_pull(ctx, sdu, (uint16_t) len) != (int) len) {
+            return -1;
+        }
+        return uds_send_sf(sdu, (uint16_t) len);
+    }
+
+    uint8_t frame[ISOTP_MAX_DL_CANFD] = {0};
+    uint8_t hdr = 2u;
+
+    if (len <= ISOTP_MAX_SDU_LEN_STD) {
+        /* FF Header: [1n] [nn] */
+        frame[0] = (uint8_t) ((uint8_t) ISOTP_PCI_FF | (uint8_t) ((len >> 8u) & 0x0Fu));
+        frame[1] = (uint8_t) (len & 0xFFu);
+    }
+    else {
+        /* Escape FF Header: [10] [00] [32-bit length] */
+        frame[0] = ISOTP_PCI_FF;
+        frame[2] = (uint8_t) (len >> 24u);
+        frame[3] = (uint8_t) (len >> 16u);
+        frame[4] = (uint8_t) (len >> 8u);
+        frame[5] = (uint8_t) len;
+        hdr = 6u;
+    }
+
+    /* The FF is full: len exceeds the single frame capacity */
+    uint8_t dl = (g_isotp_ctx.use_can_fd) ? ISOTP_MAX_DL_CANFD : ISOTP_MAX_DL_CAN;
+    uint8_t to_copy = (uint8_t) (dl - hdr);
+    if (uds_stream_pull(ctx, &frame[hdr], to_copy) != (int) to_copy) {
+        return -1;
+    }
+
+    g_isotp_ctx.msg_len = len;
+    g_isotp_ctx.bytes_processed = to_copy;
+    g_isotp_ctx.sn = 1u;
+    g_isotp_ctx.state = ISOTP_TX_WAIT_FC;
+    g_stream_ctx = ctx;
+    g_stream_cf_len = 0u;
+
+    if (uds_internal_tp_send_frame(&g_isotp_ctx, frame, dl) != 0) {
+        g_isotp_ctx.state = ISOTP_IDLE;
+        g_stream_ctx = NULL;
+        return -1;
+    }
+    return 0;
+}
+#endif /* UDS_CFG_FEATURE_STREAM */
+
+// cppcheck-suppress unusedFunction
+uint32_t uds_isotp_max_sdu(struct uds_ctx *ctx, bool response)
+{
+    (void) ctx;
+
+    if (response) {
+        /* Responses go through the segmentation buffer */
+        return sizeof(g_pending_tx_sdu);
+    }
+    /* Testers on CAN-FD implement ISO 15765-2:2016 and thus the escape FF */
+    return g_isotp_ctx.use_can_fd ? UINT32_MAX : ISOTP_MAX_SDU_LEN_STD;
+}
+
 // cppcheck-suppress unusedFunction
 void uds_tp_isotp_process(uint32_t time_ms)
 {
+    if (g_isotp_ctx.state == ISOTP_RX_WAIT_CF) {
+        if (g_rx_restart) {
+            g_rx_restart = false;
+            g_isotp_ctx.timer_n_cr = time_ms;
+        }
+        else if ((uint32_t) (time_ms - g_isotp_ctx.timer_n_cr) > ISOTP_TIMEOUT_N_CR_MS) {
+            /* N_Cr: the tester stopped sending, give the buffer back */
+            g_isotp_ctx.state = ISOTP_IDLE;
+            if (g_rx_ctx != NULL) {
+                uds_rx_release(g_rx_ctx);
+            }
+        }
+        return;
+    }
+
     if (g_isotp_ctx.state == ISOTP_TX_SENDING_CF) {
-        uint16_t remaining = g_isotp_ctx.msg_len - g_isotp_ctx.bytes_processed;
+        uint32_t remaining = g_isotp_ctx.msg_len - g_isotp_ctx.bytes_processed;
         if (remaining == 0) {
             g_isotp_ctx.state = ISOTP_IDLE;
             return;
@@ -216,7 +417,24 @@ void uds_tp_isotp_process(uint32_t time_ms)
         uint8_t to_copy = (remaining > max_cf_payload) ? max_cf_payload : (uint8_t) remaining;
         uint8_t frame[ISOTP_MAX_DL_CANFD] = {0};
         frame[0] = (uint8_t) (ISOTP_PCI_CF | g_isotp_ctx.sn);
-        memcpy(&frame[1], &g_pending_tx_sdu[g_isotp_ctx.bytes_processed], to_copy);
+#if UDS_CFG_FEATURE_STREAM
+        if (g_stream_ctx != NULL) {
+            /* Pull once per frame: a failed send retries the same bytes. The frame pump
+             * runs outside the stack, so the producer needs the context lock. */
+            if ((g_stream_cf_len == 0u) &&
+                (uds_stream_pull_locked(g_stream_ctx, g_stream_cf, to_copy) != (int) to_copy)) {
+                g_isotp_ctx.state = ISOTP_IDLE; /* Producer failed: abort the SDU */
+                g_stream_ctx = NULL;
+                return;
+            }
+            g_stream_cf_len = to_copy;
+            memcpy(&frame[1], g_stream_cf, to_copy);
+        }
+        else
+#endif
+        {
+            memcpy(&frame[1], &g_pending_tx_sdu[g_isotp_ctx.bytes_processed], to_copy);
+        }
 
         uint8_t dl = ISOTP_MAX_DL_CAN;
         if (g_isotp_ctx.use_can_fd) {
@@ -228,9 +446,13 @@ void uds_tp_isotp_process(uint32_t time_ms)
             g_isotp_ctx.sn = (g_isotp_ctx.sn + 1) & 0x0F;
             g_isotp_ctx.bs_counter++;
             g_isotp_ctx.timer_st = time_ms; /* Reset ST timer */
+#if UDS_CFG_FEATURE_STREAM
+            g_stream_cf_len = 0u;
+#endif
 
             if (g_isotp_ctx.bytes_processed >= g_isotp_ctx.msg_len) {
                 g_isotp_ctx.state = ISOTP_IDLE;
+                uds_stream_stop();
             }
         }
     }
@@ -240,6 +462,7 @@ static void uds_rx_sf(struct uds_ctx *uds_ctx, const uint8_t *data, uint8_t len)
 {
     /* Abort any active multi-frame on new Single Frame */
     g_isotp_ctx.state = ISOTP_IDLE;
+    uds_rx_release(uds_ctx);
 
     uint8_t sdu_len = (uint8_t) (data[0] & 0x0Fu);
     uint8_t data_offset = 1;
@@ -263,26 +486,42 @@ static void uds_rx_ff(struct uds_ctx *uds_ctx, const uint8_t *data, uint8_t len)
 {
     /* Abort any active multi-frame on new First Frame */
     g_isotp_ctx.state = ISOTP_IDLE;
+    uds_rx_release(uds_ctx);
+
+    if (len <= 2u) {
+        return; /* No payload after the FF header */
+    }
 
-    uint16_t sdu_len =
-        (uint16_t) ((uint16_t) ((uint16_t) data[0] & 0x0Fu) << 8u) | (uint16_t) data[1];
+    uint32_t sdu_len =
+        (uint32_t) ((uint32_t) ((uint32_t) data[0] & 0x0Fu) << 8u) | (uint32_t) data[1];
+    uint8_t hdr = 2u;
+    if (sdu_len == 0u) {
+        /* Escape FF: [10] [00] [32-bit length], only for SDUs above 4095 bytes */
+        if (len <= 6u) {
+            return; /* Length or payload missing */
+        }
+        sdu_len = ((uint32_t) data[2] << 24u) | ((uint32_t) data[3] << 16u) |
+                  ((uint32_t) data[4] << 8u) | (uint32_t) data[5];
+        if (sdu_len <= ISOTP_MAX_SDU_LEN_STD) {
+            return;
+        }
+        hdr = 6u;
+    }
     if (sdu_len < 8u) {
         return; /* Multi-frame must be > 7 bytes (Standard) or handled by SF */
     }
-
-    g_isotp_ctx.msg_len = sdu_len;
-
-    /* Determine data in FF */
-    uint8_t data_in_ff;
-    if (len > ISOTP_MAX_DL_CAN) {
-        /* CAN-FD FF */
-        data_in_ff = len - 2;
+    if (len <= hdr) {
+        return; /* No payload after the header */
     }
-    else {
-        /* Classic CAN FF */
-        data_in_ff = ISOTP_FF_MAX_DATA_CAN;
+
+    /* Payload of the FF: the whole frame after the header */
+    uint8_t data_in_ff = (uint8_t) (len - hdr);
+    if (sdu_len <= data_in_ff) {
+        return; /* Fits in the FF: invalid, ignored (ISO 15765-2) */
     }
 
+    g_isotp_ctx.msg_len = sdu_len;
+
     g_isotp_ctx.bytes_processed = data_in_ff;
     g_isotp_ctx.sn = 1;
     g_isotp_ctx.state = ISOTP_RX_WAIT_CF;
@@ -291,11 +530,28 @@ static void uds_rx_ff(struct uds_ctx *uds_ctx, const uint8_t *data, uint8_t len)
         g_isotp_ctx.state = ISOTP_IDLE;
         return;
     }
-    memcpy(uds_ctx->config->rx_buffer, &data[2], data_in_ff);
 
-    /* Send Flow Control (CTS) */
+    /* Pool mode: borrow only what the First Frame announces */
+    uint8_t fs = ISOTP_FC_CTS;
+#if UDS_CFG_FEATURE_BUFFER_POOL
+    if ((uds_ctx->config->rx_buffer == NULL) && (uds_ctx->config->buffer_pool != NULL)) {
+        g_rx_lease = uds_buffer_pool_borrow(uds_ctx->config->buffer_pool, (uint16_t) sdu_len,
+                                            NULL);
+        if (g_rx_lease == NULL) {
+            g_isotp_ctx.state = ISOTP_IDLE;
+            fs = ISOTP_FC_OVA;
+        }
+    }
+#endif
+    if (fs == ISOTP_FC_CTS) {
+        memcpy(uds_rx_buffer(uds_ctx), &data[hdr], data_in_ff);
+        g_rx_ctx = uds_ctx;
+        g_rx_restart = true;
+    }
+
+    /* Send Flow Control (CTS, or Overflow if no buffer is available) */
     uint8_t fc[8] = {0};
-    fc[0] = (uint8_t) (ISOTP_PCI_FC | ISOTP_FC_CTS);
+    fc[0] = (uint8_t) (ISOTP_PCI_FC | fs);
     fc[1] = g_isotp_ctx.block_size;
     fc[2] = g_isotp_ctx.st_min;
     uds_internal_tp_send_frame(&g_isotp_ctx, fc, 8);
@@ -310,24 +566,32 @@ static void uds_rx_cf(struct uds_ctx *uds_ctx, const uint8_t *data, uint8_t len)
     uint8_t sn = data[0] & 0x0F;
     if (sn != g_isotp_ctx.sn) {
         g_isotp_ctx.state = ISOTP_IDLE;
+        uds_rx_release(uds_ctx);
         return;
     }
     g_isotp_ctx.sn = (g_isotp_ctx.sn + 1) & 0x0F;
 
-    uint16_t remaining = g_isotp_ctx.msg_len - g_isotp_ctx.bytes_processed;
+    if ((len < 2u) || (g_isotp_ctx.bytes_processed >= g_isotp_ctx.msg_len)) {
+        g_isotp_ctx.state = ISOTP_IDLE;
+        uds_rx_release(uds_ctx);
+        return;
+    }
+    uint32_t remaining = g_isotp_ctx.msg_len - g_isotp_ctx.bytes_processed;
 
     /* Max payload in CF depends on whether we received FD frame (len > 8) or not.
         Actually receiving node infers FD from frame length. */
-    uint8_t data_capacity = len - 1; /* Byte 0 is PCI+SN */
+    uint8_t data_capacity = (uint8_t) (len - 1u); /* Byte 0 is PCI+SN */
 
     uint8_t to_copy = (remaining > data_capacity) ? data_capacity : (uint8_t) remaining;
 
-    memcpy(&uds_ctx->config->rx_buffer[g_isotp_ctx.bytes_processed], &data[1], to_copy);
+    memcpy(&uds_rx_buffer(uds_ctx)[g_isotp_ctx.bytes_processed], &data[1], to_copy);
     g_isotp_ctx.bytes_processed += to_copy;
+    g_rx_restart = true;
 
     if (g_isotp_ctx.bytes_processed >= g_isotp_ctx.msg_len) {
         g_isotp_ctx.state = ISOTP_IDLE;
-        uds_input_sdu(uds_ctx, uds_ctx->config->rx_buffer, g_isotp_ctx.msg_len);
+        uds_input_sdu(uds_ctx, uds_rx_buffer(uds_ctx), (uint16_t) g_isotp_ctx.msg_len);
+        uds_rx_release(uds_ctx); /* The SDU is consumed (or copied to the mailbox) */
     }
 }
 
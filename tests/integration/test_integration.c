@@ -74,8 +74,8 @@ static int mock_security_key(struct uds_ctx *ctx, uint8_t level, const uint8_t *
 }
 
 static const uds_did_entry_t g_dids[] = {
-    {0xF190, 17, UDS_SESSION_ALL, 0, NULL, NULL, (void *) "VIN12345678901234"}, /* VIN */
-    {0x0100, 4, UDS_SESSION_ALL, 0, NULL, mock_did_write, NULL},
+    {0xF190, 17, UDS_SESSION_ALL, 0, NULL, NULL, (void *) "VIN12345678901234", 0}, /* VIN */
+    {0x0100, 4, UDS_SESSION_ALL, 0, NULL, mock_did_write, NULL, 0},
 };
 
 static const uds_did_table_t g_did_table = {g_dids, 2};
@@ -146,7 +146,7 @@ def test_full_sequence():
         # 31 01 FF 00 (Erase)
         assert client.uds_request(bytes([0x31, 0x01, 0xFF, 0x00])) == [0x71, 0x01, 0xFF, 0x00, 0x00]
         # 34 (Download)
-        assert client.uds_request(bytes([0x34, 0x00, 0x44, 0x11, 0x22, 0x33, 0x44, 0x00, 0x00, 0x10, 0x00])) == [0x74, 0x20, 0x00, 0x00, 0x04, 0x00]
+        assert client.uds_request(bytes([0x34, 0x00, 0x44, 0x11, 0x22, 0x33, 0x44, 0x00, 0x00, 0x10, 0x00])) == [0x74, 0x20, 0x04, 0x00]
         # 36 (Transfer)
         assert client.uds_request(bytes([0x36, 0x01, 0xAA, 0xBB])) == [0x76, 0x01]
         # 37 (Exit)
@@ -177,7 +177,7 @@ def test_full_sequence():
         assert client.uds_request(bytes([0x2F, 0x01, 0x23, 0x03])) == [0x6F, 0x01, 0x23, 0x55]
         
         # 35 00 44 11 22 33 44 00 00 10 00 (Request Upload)
-        assert client.uds_request(bytes([0x35, 0x00, 0x44, 0x11, 0x22, 0x33, 0x44, 0x00, 0x00, 0x10, 0x00])) == [0x75, 0x20, 0x00, 0x00, 0x04, 0x00]
+        assert client.uds_request(bytes([0x35, 0x00, 0x44, 0x11, 0x22, 0x33, 0x44, 0x00, 0x00, 0x10, 0x00])) == [0x75, 0x20, 0x04, 0x00]
         
         # 2A 01 F1 90 (Periodic Read Fast Rate for 0xF190 - Note: Simulator mock just returns 0xAA 0xBB)
         assert client.uds_request(bytes([0x2A, 0x01, 0xF1])) == [0x6A]
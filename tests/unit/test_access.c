@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_access.c
+ * @brief Unit tests for the session / security permission matrix
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_access.h"
+
+static uint8_t g_val[2] = {0xAB, 0xCD};
+
+static const uds_did_entry_t g_dids[] = {
+    {0x0100, 2, 0, 0, NULL, NULL, g_val, 0},                    /* Open */
+    {0x0200, 2, UDS_SESSION_EXTENDED, 0, NULL, NULL, g_val, 0}, /* Extended only */
+    {0x0300, 2, UDS_SESSION_ALL, UDS_SECURITY_LEVEL(1) | UDS_SECURITY_LEVEL(3), NULL, NULL,
+     g_val, 0}, /* Levels 1 and 3 */
+};
+
+static int dummy_handler(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    uds_tx_buffer(ctx)[0] = (uint8_t) (data[0] + 0x40u);
+    return uds_send_response(ctx, 1u);
+}
+
+static const uds_service_entry_t g_services[] = {
+    {0xA0, 1, UDS_SESSION_PROGRAMMING, 2, dummy_handler, NULL}, /* Level 2 and above */
+};
+
+static uint64_t g_matrix[UDS_ACCESS_MATRIX_SIZE(1, 3)];
+
+static void setup_access(uds_ctx_t *ctx, uds_config_t *cfg, bool compiled)
+{
+    memset(g_matrix, 0, sizeof(g_matrix));
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 3;
+    cfg->user_services = g_services;
+    cfg->user_service_count = 1;
+    if (compiled) {
+        cfg->access_matrix = g_matrix;
+        cfg->access_matrix_size = UDS_ACCESS_MATRIX_SIZE(1, 3);
+        assert_int_equal(uds_access_compile(ctx), UDS_OK);
+    }
+}
+
+static void expect_rdbi(uds_ctx_t *ctx, uint8_t did_hi, uint8_t first_byte, uint16_t len)
+{
+    uint8_t request[] = {0x22, did_hi, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, request, sizeof(request));
+    assert_int_equal(g_tx_buf[0], first_byte);
+}
+
+static void test_bits_layout(void **state)
+{
+    (void) state;
+
+    /* No restriction: every cell */
+    assert_true(uds_access_did_bits(0, 0) == UINT64_MAX);
+    assert_true(uds_access_service_bits(UDS_SESSION_ALL, 0) == UINT64_MAX);
+
+    /* Extended row only, all levels */
+    assert_true(uds_access_did_bits(UDS_SESSION_EXTENDED, 0) == (0xFFFFull << 16));
+
+    /* DIDs: levels 0 (locked) and 1 in default and programming rows */
+    uint64_t bits = uds_access_did_bits(UDS_SESSION_DEFAULT | UDS_SESSION_PROGRAMMING,
+                                        UDS_SECURITY_LEVEL(0) | UDS_SECURITY_LEVEL(1));
+    assert_true(bits == ((0x3ull << 0) | (0x3ull << 32)));
+
+    /* Services: a minimum level grants every level from it on */
+    assert_true(uds_access_service_bits(UDS_SESSION_DEFAULT, 2) == 0xFFFCull);
+    assert_true(uds_access_service_bits(UDS_SESSION_DEFAULT, 15) == 0x8000ull);
+    assert_true(uds_access_service_bits(UDS_SESSION_DEFAULT, 20) == 0u);
+}
+
+static void run_did_rules(bool compiled)
+{
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_access(&ctx, &cfg, compiled);
+
+    /* Session rule uses the UDS_SESSION_* bits for DIDs too */
+    ctx.active_session = 0x02; /* Programming */
+    expect_rdbi(&ctx, 0x02, 0x7F, 3);
+    assert_int_equal(g_tx_buf[2], 0x31);
+    ctx.active_session = 0x03; /* Extended */
+    expect_rdbi(&ctx, 0x02, 0x62, 5);
+
+    /* Security rule is a set of levels */
+    ctx.security_level = 0;
+    expect_rdbi(&ctx, 0x03, 0x7F, 3);
+    assert_int_equal(g_tx_buf[2], 0x33);
+    ctx.security_level = 2;
+    expect_rdbi(&ctx, 0x03, 0x7F, 3);
+    ctx.security_level = 3;
+    expect_rdbi(&ctx, 0x03, 0x62, 5);
+
+    /* Vendor sessions are granted by "all sessions" only */
+    ctx.active_session = 0x40;
+    expect_rdbi(&ctx, 0x01, 0x62, 5);
+    expect_rdbi(&ctx, 0x02, 0x7F, 3);
+}
+
+static void test_did_rules_derived(void **state)
+{
+    (void) state;
+    run_did_rules(false);
+}
+
+static void test_did_rules_compiled(void **state)
+{
+    (void) state;
+    run_did_rules(true);
+    assert_true(g_matrix[0] == uds_access_service_bits(UDS_SESSION_PROGRAMMING, 2));
+    assert_true(g_matrix[1 + 1] == uds_access_did_bits(UDS_SESSION_EXTENDED, 0));
+}
+
+static void test_service_rules(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_access(&ctx, &cfg, true);
+    uint8_t request[] = {0xA0};
+
+    /* Wrong session: 0x7F */
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, request, sizeof(request));
+    assert_int_equal(g_tx_buf[2], 0x7F);
+
+    /* Right session, wrong level: 0x33 */
+    ctx.active_session = 0x02; /* Programming */
+    ctx.security_level = 1;
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, request, sizeof(request));
+    assert_int_equal(g_tx_buf[2], 0x33);
+
+    /* Right session, minimum level or above */
+    for (uint8_t level = 2; level <= 3; level++) {
+        ctx.security_level = level;
+        will_return(mock_get_time, 1000);
+        will_return(mock_get_time, 1000);
+        expect_any(mock_tp_send, data);
+        expect_value(mock_tp_send, len, 1);
+        will_return(mock_tp_send, 0);
+        uds_input_sdu(&ctx, request, sizeof(request));
+        assert_int_equal(g_tx_buf[0], 0xE0);
+    }
+}
+
+static void test_init_rejects_small_matrix(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_access(&ctx, &cfg, false);
+    cfg.access_matrix = g_matrix;
+    cfg.access_matrix_size = 3;
+
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_ERR_BUFFER_TOO_SMALL);
+    cfg.access_matrix_size = 4;
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_OK);
+    assert_true(g_matrix[3] == uds_access_did_bits(UDS_SESSION_ALL, 0x000A));
+}
+
+static void expect_service(uds_ctx_t *ctx, uint8_t sid, uint8_t level, uint8_t nrc)
+{
+    uint8_t request[] = {sid};
+    ctx->security_level = level;
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, (nrc == 0u) ? 1 : 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, request, sizeof(request));
+    if (nrc == 0u) {
+        assert_int_equal(g_tx_buf[0], (uint8_t) (sid + 0x40u));
+    }
+    else {
+        assert_int_equal(g_tx_buf[2], nrc);
+    }
+}
+
+static void run_level_rules(bool compiled)
+{
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    static const uds_service_entry_t services[] = {
+        {0xA2, 1, UDS_SESSION_ALL, 1, dummy_handler, NULL},  /* Security level 1 needed */
+        {0xA3, 1, UDS_SESSION_ALL, 20, dummy_handler, NULL}, /* Beyond the matrix columns */
+    };
+    static const uds_did_entry_t dids[] = {
+        {0x0100, 2, 0, 0, NULL, NULL, g_val, 0},
+        {0x0200, 2, UDS_SESSION_ALL, 1, NULL, NULL, g_val, 0}, /* Locked only */
+    };
+    static uint64_t matrix[UDS_ACCESS_MATRIX_SIZE(2, 2)];
+
+    setup_ctx(&ctx, &cfg);
+    cfg.user_services = services;
+    cfg.user_service_count = 2;
+    cfg.did_table.entries = dids;
+    cfg.did_table.count = 2;
+    if (compiled) {
+        cfg.access_matrix = matrix;
+        cfg.access_matrix_size = UDS_ACCESS_MATRIX_SIZE(2, 2);
+    }
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_OK);
+
+    /* A minimum level grants every level from it on, above 15 too */
+    expect_service(&ctx, 0xA2, 0, 0x33);
+    expect_service(&ctx, 0xA2, 1, 0);
+    expect_service(&ctx, 0xA2, 15, 0);
+    expect_service(&ctx, 0xA2, 40, 0);
+    expect_service(&ctx, 0xA3, 15, 0x33);
+    expect_service(&ctx, 0xA3, 19, 0x33);
+    expect_service(&ctx, 0xA3, 20, 0);
+
+    /* DID bit 0 is the locked level; levels above 15 need a mask of 0 */
+    ctx.security_level = 0;
+    expect_rdbi(&ctx, 0x02, 0x62, 5);
+    ctx.security_level = 1;
+    expect_rdbi(&ctx, 0x02, 0x7F, 3);
+    assert_int_equal(g_tx_buf[2], 0x33);
+    ctx.security_level = 16;
+    expect_rdbi(&ctx, 0x02, 0x7F, 3);
+    expect_rdbi(&ctx, 0x01, 0x62, 5);
+}
+
+static void test_level_rules_derived(void **state)
+{
+    (void) state;
+    run_level_rules(false);
+}
+
+static void test_level_rules_compiled(void **state)
+{
+    (void) state;
+    run_level_rules(true);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_bits_layout),
+        cmocka_unit_test(test_did_rules_derived),
+        cmocka_unit_test(test_did_rules_compiled),
+        cmocka_unit_test(test_service_rules),
+        cmocka_unit_test(test_init_rejects_small_matrix),
+        cmocka_unit_test(test_level_rules_derived),
+        cmocka_unit_test(test_level_rules_compiled),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
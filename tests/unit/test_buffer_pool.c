@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_buffer_pool.c
+ * @brief Unit tests for the shared rx/tx buffer pool
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_buffer_pool.h"
+#include "uds/uds_isotp.h"
+#include "uds/uds_job.h"
+
+static uint8_t g_small[4 * 16];
+static uint32_t g_small_used[UDS_BUFFER_POOL_WORDS(4u)];
+static uint8_t g_large[2 * 64];
+static uint32_t g_large_used[UDS_BUFFER_POOL_WORDS(2u)];
+static uds_buffer_pool_t g_pool;
+
+static void setup_pool(void)
+{
+    uds_buffer_pool_init(&g_pool);
+    /* Added out of order on purpose */
+    uds_buffer_pool_add_class(&g_pool, g_large, g_large_used, 64, 2);
+    uds_buffer_pool_add_class(&g_pool, g_small, g_small_used, 16, 4);
+}
+
+static void setup_pool_ctx(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    setup_pool();
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->get_time_ms = mock_get_time;
+    cfg->fn_tp_send = mock_tp_send;
+    cfg->rx_buffer_size = 64;
+    cfg->tx_buffer_size = 64;
+    cfg->buffer_pool = &g_pool;
+    cfg->p2_ms = 50;
+    cfg->p2_star_ms = 5000;
+    assert_int_equal(uds_init(ctx, cfg), UDS_OK);
+}
+
+static void test_borrow_smallest_fitting_class(void **state)
+{
+    (void) state;
+    setup_pool();
+    uint16_t granted = 0;
+
+    assert_int_equal(g_pool.classes[0].block_size, 16);
+    assert_int_equal(g_pool.classes[1].block_size, 64);
+
+    uint8_t *block = uds_buffer_pool_borrow(&g_pool, 10, &granted);
+    assert_ptr_equal(block, &g_small[0]);
+    assert_int_equal(granted, 16);
+
+    block = uds_buffer_pool_borrow(&g_pool, 40, &granted);
+    assert_ptr_equal(block, &g_large[0]);
+    assert_int_equal(granted, 64);
+
+    assert_null(uds_buffer_pool_borrow(&g_pool, 65, NULL));
+    assert_int_equal(g_pool.in_use, 2);
+    assert_int_equal(g_pool.exhausted, 1);
+}
+
+static void test_full_class_falls_back_and_return_frees(void **state)
+{
+    (void) state;
+    setup_pool();
+    uint8_t *small[4];
+
+    for (int i = 0; i < 4; i++) {
+        small[i] = uds_buffer_pool_borrow(&g_pool, 16, NULL);
+        assert_ptr_equal(small[i], &g_small[i * 16]);
+    }
+
+    /* Small class is full: served from the large class */
+    uint16_t granted = 0;
+    assert_ptr_equal(uds_buffer_pool_borrow(&g_pool, 8, &granted), &g_large[0]);
+    assert_int_equal(granted, 64);
+
+    uds_buffer_pool_return(&g_pool, small[2]);
+    assert_int_equal(g_pool.in_use, 4);
+    assert_ptr_equal(uds_buffer_pool_borrow(&g_pool, 8, NULL), small[2]);
+
+    /* Foreign blocks are ignored */
+    uint8_t other[4];
+    uds_buffer_pool_return(&g_pool, other);
+    assert_int_equal(g_pool.in_use, 5);
+}
+
+static void test_add_class_limits(void **state)
+{
+    (void) state;
+    setup_pool();
+
+    assert_int_equal(uds_buffer_pool_add_class(&g_pool, NULL, g_small_used, 16, 4),
+                     UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_buffer_pool_add_class(&g_pool, g_small, g_small_used, 16, 4), UDS_OK);
+    assert_int_equal(uds_buffer_pool_add_class(&g_pool, g_small, g_small_used, 16, 4), UDS_OK);
+    assert_int_equal(uds_buffer_pool_add_class(&g_pool, g_small, g_small_used, 16, 4),
+                     UDS_ERR_BUFFER_TOO_SMALL);
+}
+
+static void test_ctx_borrows_tx_per_request(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pool_ctx(&ctx, &cfg);
+    assert_null(uds_tx_buffer(&ctx));
+
+    const uint8_t req[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 2);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, req, sizeof(req));
+
+    assert_int_equal(g_tx_buf[0], 0x7E);
+    assert_null(ctx.tx_lease);
+    assert_int_equal(g_pool.in_use, 0);
+}
+
+static void test_ctx_exhausted_pool_sends_busy(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pool_ctx(&ctx, &cfg);
+
+    /* Another context holds both blocks that fit tx_buffer_size */
+    assert_non_null(uds_buffer_pool_borrow(&g_pool, 64, NULL));
+    assert_non_null(uds_buffer_pool_borrow(&g_pool, 64, NULL));
+
+    /* Rejected before P2 timing starts: one time read less */
+    const uint8_t req[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, req, sizeof(req));
+
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[1], 0x3E);
+    assert_int_equal(g_tx_buf[2], 0x21);
+    assert_int_equal(g_pool.exhausted, 1);
+    assert_int_equal(g_pool.in_use, 2);
+}
+
+static uint16_t g_sent_addr;
+
+static int addr_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    g_sent_addr = ctx->tester_addr;
+    return mock_tp_send(ctx, data, len);
+}
+
+static void test_no_tester_entry_sends_busy(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[1];
+    setup_pool_ctx(&ctx, &cfg);
+    memset(states, 0, sizeof(states));
+    cfg.tester_states = states;
+    cfg.tester_state_count = 1;
+    cfg.fn_tp_send = addr_tp_send;
+
+    /* Tester A holds the only entry (non-default session) */
+    const uint8_t extended[] = {0x10, 0x03};
+    will_return_count(mock_get_time, 1000, 2);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 6);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu_from(&ctx, 0x0E80u, extended, sizeof(extended));
+    assert_null(ctx.tx_lease);
+
+    /* Tester B gets NRC 0x21 although no tx block is borrowed */
+    const uint8_t req[] = {0x3E, 0x00};
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu_from(&ctx, 0x0F10u, req, sizeof(req));
+
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[1], 0x3E);
+    assert_int_equal(g_tx_buf[2], 0x21);
+    assert_int_equal(g_sent_addr, 0x0F10u);
+    assert_int_equal(ctx.tester_addr, 0x0E80u);
+    assert_int_equal(g_pool.in_use, 0);
+}
+
+static uds_job_t *g_submitted;
+static uds_job_t g_job;
+
+static int manual_submit(void *executor, uds_job_t *job)
+{
+    (void) executor;
+    g_submitted = job;
+    return 0;
+}
+
+static int work_ok(uds_job_t *job)
+{
+    (void) job;
+    return UDS_OK;
+}
+
+static int complete_routine(struct uds_ctx *ctx, uds_job_t *job, int result)
+{
+    (void) job;
+    (void) result;
+    uint8_t *tx = uds_tx_buffer(ctx);
+    tx[0] = 0x71;
+    tx[1] = 0x01;
+    tx[2] = 0xFF;
+    tx[3] = 0x00;
+    return 4;
+}
+
+static int job_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    return uds_submit_job(ctx, data[0], &g_job);
+}
+
+static const uds_service_entry_t g_job_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, job_handler, NULL},
+};
+
+static void test_pending_request_keeps_lease(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pool_ctx(&ctx, &cfg);
+    cfg.user_services = g_job_services;
+    cfg.user_service_count = 1;
+    cfg.fn_job_submit = manual_submit;
+    memset(&g_job, 0, sizeof(g_job));
+    g_job.work = work_ok;
+    g_job.complete = complete_routine;
+
+    const uint8_t req[] = {0x31, 0x01, 0xFF, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, req, sizeof(req));
+
+    assert_true(ctx.p2_msg_pending);
+    assert_non_null(ctx.tx_lease);
+    assert_int_equal(g_pool.in_use, 1);
+
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 4);
+    will_return(mock_tp_send, 0);
+    uds_job_execute(g_submitted);
+
+    assert_int_equal(g_tx_buf[0], 0x71);
+    assert_null(ctx.tx_lease);
+    assert_int_equal(g_pool.in_use, 0);
+}
+
+static int g_can_calls;
+static uint8_t g_can_last[8];
+
+static int mock_can_send(uint32_t id, const uint8_t *data, uint8_t len)
+{
+    (void) id;
+    memcpy(g_can_last, data, len);
+    g_can_calls++;
+    return 0;
+}
+
+static void test_isotp_borrows_reassembly_buffer(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pool_ctx(&ctx, &cfg);
+    uds_tp_isotp_init(mock_can_send, 0x7E8, 0x7E0);
+    g_can_calls = 0;
+
+    /* First Frame announcing 20 bytes: too large for the small class */
+    const uint8_t ff[8] = {0x10, 0x14, 0x2E, 0xF1, 0x90, 0x01, 0x02, 0x03};
+    uds_isotp_rx_callback(&ctx, 0x7E0, ff, 8);
+    assert_int_equal(g_pool.in_use, 1);
+    assert_int_equal(g_can_last[0], 0x30); /* FC CTS */
+
+    /* Wrong sequence number aborts the transfer and returns the buffer */
+    const uint8_t cf[8] = {0x22, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A};
+    uds_isotp_rx_callback(&ctx, 0x7E0, cf, 8);
+    assert_int_equal(g_pool.in_use, 0);
+
+    /* No block left: Flow Control Overflow */
+    assert_non_null(uds_buffer_pool_borrow(&g_pool, 64, NULL));
+    assert_non_null(uds_buffer_pool_borrow(&g_pool, 64, NULL));
+    uds_isotp_rx_callback(&ctx, 0x7E0, ff, 8);
+    assert_int_equal(g_can_last[0], 0x32);
+    assert_int_equal(g_pool.in_use, 2);
+    assert_int_equal(g_can_calls, 2);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_borrow_smallest_fitting_class),
+        cmocka_unit_test(test_full_class_falls_back_and_return_frees),
+        cmocka_unit_test(test_add_class_limits),
+        cmocka_unit_test(test_ctx_borrows_tx_per_request),
+        cmocka_unit_test(test_ctx_exhausted_pool_sends_busy),
+        cmocka_unit_test(test_no_tester_entry_sends_busy),
+        cmocka_unit_test(test_pending_request_keeps_lease),
+        cmocka_unit_test(test_isotp_borrows_reassembly_buffer),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_did_cache.c
+ * @brief Unit tests for the pre-encoded DID response cache
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_did_cache.h"
+
+static int g_reads;
+static uint8_t g_sw_version[4] = {1, 0, 0, 0};
+static uint8_t g_vin[17] = "WVWZZZ1JZXW000001";
+static uint8_t g_counter[2];
+
+static int read_sw_version(uds_ctx_t *ctx, uint16_t did, uint8_t *buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) did;
+    g_reads++;
+    memcpy(buf, g_sw_version, max_len);
+    return (int) max_len;
+}
+
+static int read_counter(uds_ctx_t *ctx, uint16_t did, uint8_t *buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) did;
+    g_reads++;
+    g_counter[1]++;
+    memcpy(buf, g_counter, max_len);
+    return (int) max_len;
+}
+
+static const uds_did_entry_t g_dids[] = {
+    {0xF190, 17, UDS_SESSION_ALL, 0, NULL, NULL, g_vin, UDS_DID_FLAG_IMMUTABLE},
+    {0xF189, 4, UDS_SESSION_ALL, 0, read_sw_version, NULL, NULL, UDS_DID_FLAG_VERSIONED},
+    {0x0100, 2, UDS_SESSION_ALL, 0, read_counter, NULL, NULL, 0},
+    {0xF18C, 4, UDS_SESSION_ALL, UDS_SECURITY_LEVEL(1), NULL, NULL, g_sw_version,
+     UDS_DID_FLAG_IMMUTABLE},
+};
+
+static uint8_t g_cache_storage[128];
+static uds_did_cache_t g_cache;
+
+static void setup_cache(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    g_reads = 0;
+    memcpy(g_vin, "WVWZZZ1JZXW000001", 17);
+    memset(g_counter, 0, sizeof(g_counter));
+    uds_did_cache_init(&g_cache, g_cache_storage, sizeof(g_cache_storage));
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 4;
+    cfg->did_cache = &g_cache;
+}
+
+static void send(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint16_t resp_len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, len);
+}
+
+static void test_flagged_did_read_once(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_cache(&ctx, &cfg);
+    const uint8_t req[] = {0x22, 0xF1, 0x89};
+
+    send(&ctx, req, sizeof(req), 7);
+    send(&ctx, req, sizeof(req), 7);
+
+    assert_int_equal(g_reads, 1);
+    assert_int_equal(g_cache.misses, 1);
+    assert_int_equal(g_cache.hits, 1);
+    assert_int_equal(g_tx_buf[0], 0x62);
+    assert_int_equal(g_tx_buf[1], 0xF1);
+    assert_int_equal(g_tx_buf[2], 0x89);
+    assert_memory_equal(&g_tx_buf[3], g_sw_version, 4);
+}
+
+static void test_unflagged_did_not_cached(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_cache(&ctx, &cfg);
+    const uint8_t req[] = {0x22, 0x01, 0x00};
+
+    send(&ctx, req, sizeof(req), 5);
+    send(&ctx, req, sizeof(req), 5);
+
+    assert_int_equal(g_reads, 2);
+    assert_int_equal(g_tx_buf[4], 2);
+    assert_int_equal(g_cache.count, 0);
+}
+
+static void test_multi_did_request_preassembled(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_cache(&ctx, &cfg);
+    const uint8_t req[] = {0x22, 0xF1, 0x90, 0xF1, 0x89};
+    uint8_t first[1 + 19 + 6];
+
+    send(&ctx, req, sizeof(req), sizeof(first));
+    memcpy(first, g_tx_buf, sizeof(first));
+    assert_int_equal(g_cache.asm_count, 2);
+    assert_int_equal(g_cache.asm_len, 19 + 6);
+
+    memset(g_tx_buf, 0, sizeof(first));
+    send(&ctx, req, sizeof(req), sizeof(first));
+    assert_memory_equal(g_tx_buf, first, sizeof(first));
+    assert_int_equal(g_reads, 1);
+    assert_int_equal(g_cache.hits, 2);
+
+    /* A mixed request is not assembled */
+    const uint8_t mixed[] = {0x22, 0xF1, 0x90, 0x01, 0x00};
+    send(&ctx, mixed, sizeof(mixed), 1 + 19 + 4);
+    assert_memory_equal(&g_cache.asm_req[0], &req[1], 4);
+}
+
+static void test_write_and_bump_invalidate(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_cache(&ctx, &cfg);
+    const uint8_t req[] = {0x22, 0xF1, 0x90, 0xF1, 0x89};
+
+    send(&ctx, req, sizeof(req), 26);
+    assert_int_equal(g_cache.asm_count, 2);
+
+    /* 0x2E on the VIN drops its fragment and the assembled response */
+    uint8_t write[3 + 17] = {0x2E, 0xF1, 0x90};
+    memset(&write[3], 'X', 17);
+    send(&ctx, write, sizeof(write), 3);
+    assert_int_equal(g_cache.asm_count, 0);
+    send(&ctx, req, sizeof(req), 26);
+    assert_int_equal(g_tx_buf[3], 'X');
+    assert_int_equal(g_reads, 1);
+
+    /* A version bump drops the versioned DID only */
+    g_sw_version[0] = 2;
+    uds_did_cache_bump(&g_cache);
+    send(&ctx, req, sizeof(req), 26);
+    assert_int_equal(g_reads, 2);
+    assert_int_equal(g_tx_buf[22], 2);
+    g_sw_version[0] = 1;
+}
+
+static void test_assembled_response_checks_access(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_cache(&ctx, &cfg);
+    const uint8_t req[] = {0x22, 0xF1, 0x90, 0xF1, 0x8C};
+
+    ctx.security_level = 1;
+    send(&ctx, req, sizeof(req), 1 + 19 + 6);
+    send(&ctx, req, sizeof(req), 1 + 19 + 6);
+    assert_int_equal(g_cache.hits, 2);
+
+    ctx.security_level = 0;
+    send(&ctx, req, sizeof(req), 3);
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[2], 0x33);
+}
+
+static void test_full_storage_cleared_next_request(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_cache(&ctx, &cfg);
+    uds_did_cache_init(&g_cache, g_cache_storage, 20);
+
+    /* VIN fits (19 bytes), the SW version does not */
+    const uint8_t req[] = {0x22, 0xF1, 0x90, 0xF1, 0x89};
+    send(&ctx, req, sizeof(req), 26);
+    assert_true(g_cache.full);
+    assert_int_equal(g_cache.count, 1);
+
+    /* Still served correctly; the cache starts over */
+    const uint8_t sw[] = {0x22, 0xF1, 0x89};
+    send(&ctx, sw, sizeof(sw), 7);
+    assert_false(g_cache.full);
+    assert_int_equal(g_cache.count, 1);
+    assert_int_equal(g_cache.entries[0].did, 0xF189);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_flagged_did_read_once),
+        cmocka_unit_test(test_unflagged_did_not_cached),
+        cmocka_unit_test(test_multi_did_request_preassembled),
+        cmocka_unit_test(test_write_and_bump_invalidate),
+        cmocka_unit_test(test_assembled_response_checks_access),
+        cmocka_unit_test(test_full_storage_cleared_next_request),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_dtc_store.c
+ * @brief Unit tests for the built-in DTC fault memory and its records (0x14, 0x19, 0x85)
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_dtc.h"
+#include "uds/uds_response.h"
+
+#define DTC_COUNT 1000u
+
+static uint32_t g_codes[DTC_COUNT];
+static uint8_t g_status[DTC_COUNT];
+static uint32_t g_bits[UDS_DTC_BITS_WORDS(DTC_COUNT)];
+static uds_dtc_store_t g_store;
+static int g_clear_result;
+static int g_clears;
+
+static uint32_t code_of(uint32_t i)
+{
+    return 0x100000u + (i * 0x10u);
+}
+
+static int app_clear(uds_ctx_t *ctx, uint32_t group)
+{
+    (void) ctx;
+    (void) group;
+    g_clears++;
+    return g_clear_result;
+}
+
+static int app_read(uds_ctx_t *ctx, uint8_t subfn, uint8_t *out_buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) max_len;
+    out_buf[0] = subfn;
+    return 1;
+}
+
+/* Every third DTC testFailed, every hundredth confirmed */
+static void setup_store(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    setup_ctx(ctx, cfg);
+    uds_dtc_init(&g_store, g_codes, g_status, g_bits, DTC_COUNT);
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        assert_int_equal(uds_dtc_add(&g_store, code_of(i)), UDS_OK);
+    }
+    cfg->dtc_store = &g_store;
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        uint8_t status = (uint8_t) (((i % 3u) == 0u) ? 0x01u : 0x00u);
+        if ((i % 100u) == 0u) {
+            status |= 0x08u;
+        }
+        assert_int_equal(uds_dtc_set_status(ctx, code_of(i), status), UDS_OK);
+    }
+    g_clear_result = UDS_OK;
+    g_clears = 0;
+}
+
+static void send(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint16_t resp_len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, len);
+}
+
+static uint16_t count_by_mask(uds_ctx_t *ctx, uint8_t mask)
+{
+    const uint8_t req[] = {0x19, 0x01, mask};
+    send(ctx, req, sizeof(req), 6);
+    assert_int_equal(g_tx_buf[0], 0x59);
+    assert_int_equal(g_tx_buf[2], g_store.availability_mask);
+    assert_int_equal(g_tx_buf[3], UDS_DTC_FORMAT_ISO14229_1);
+    return (uint16_t) ((g_tx_buf[4] << 8) | g_tx_buf[5]);
+}
+
+static void test_count_by_mask(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_store(&ctx, &cfg);
+
+    assert_int_equal(count_by_mask(&ctx, 0x01), 334);
+    assert_int_equal(count_by_mask(&ctx, 0x08), 10);
+    assert_int_equal(count_by_mask(&ctx, 0x09), 340);
+    assert_int_equal(count_by_mask(&ctx, 0x00), 0);
+
+    /* Bits outside the availability mask never match */
+    g_store.availability_mask = 0x08u;
+    assert_int_equal(count_by_mask(&ctx, 0x09), 10);
+}
+
+static void test_report_by_mask(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_store(&ctx, &cfg);
+
+    const uint8_t req[] = {0x19, 0x02, 0x08};
+    send(&ctx, req, sizeof(req), 3 + (10 * 4));
+    const uint8_t head[] = {0x59, 0x02, 0xFF, 0x10, 0x00, 0x00, 0x09, 0x10, 0x06, 0x40, 0x08};
+    assert_memory_equal(g_tx_buf, head, sizeof(head));
+
+    /* Cleared status bits leave the result */
+    assert_int_equal(uds_dtc_set_status(&ctx, code_of(100), 0x00), UDS_OK);
+    send(&ctx, req, sizeof(req), 3 + (9 * 4));
+    assert_int_equal(g_tx_buf[7], 0x10);
+    assert_int_equal(g_tx_buf[8], 0x0C);
+    assert_int_equal(g_tx_buf[9], 0x80);
+
+    /* 1000 records do not fit the 1024-byte response buffer */
+    const uint8_t supported[] = {0x19, 0x0A};
+    send(&ctx, supported, sizeof(supported), 3);
+    assert_int_equal(g_tx_buf[2], 0x14);
+}
+
+static uint8_t g_streamed[3 + (4 * DTC_COUNT)];
+static uint32_t g_streamed_len;
+
+/* Transport pulling a streamed response one classic CAN frame at a time */
+static int pull_stream(uds_ctx_t *ctx, uint32_t len)
+{
+    g_streamed_len = 0u;
+    while (g_streamed_len < len) {
+        int n = uds_stream_pull(ctx, &g_streamed[g_streamed_len], 7u);
+        assert_true(n > 0);
+        g_streamed_len += (uint32_t) n;
+    }
+    return 0;
+}
+
+static void test_report_streamed(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_store(&ctx, &cfg);
+    cfg.fn_tp_send_stream = pull_stream;
+
+    /* All 1000 records: four times the response buffer */
+    const uint8_t supported[] = {0x19, 0x0A};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, supported, sizeof(supported));
+    assert_int_equal(g_streamed_len, 3 + (4 * DTC_COUNT));
+    assert_int_equal(g_streamed[0], 0x59);
+    assert_int_equal(g_streamed[1], 0x0A);
+    assert_int_equal(g_streamed[2], 0xFF);
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        const uint8_t *rec = &g_streamed[3 + (4 * i)];
+        assert_int_equal(((uint32_t) rec[0] << 16) | ((uint32_t) rec[1] << 8) | rec[2],
+                         code_of(i));
+        assert_int_equal(rec[3], g_status[i]);
+    }
+
+    /* 340 matches of testFailed or confirmedDTC, in DTC order */
+    const uint8_t by_mask[] = {0x19, 0x02, 0x09};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, by_mask, sizeof(by_mask));
+    assert_int_equal(g_streamed_len, 3 + (4 * 340));
+    uint32_t k = 0u;
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        if ((g_status[i] & 0x09u) != 0u) {
+            assert_int_equal(g_streamed[3 + (4 * k) + 2], (uint8_t) code_of(i));
+            k++;
+        }
+    }
+    assert_int_equal(k, 340);
+    assert_false(ctx.stream.active);
+}
+
+static void test_supported_dtcs(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_ctx(&ctx, &cfg);
+    uds_dtc_init(&g_store, g_codes, g_status, g_bits, DTC_COUNT);
+    cfg.dtc_store = &g_store;
+    assert_int_equal(uds_dtc_add(&g_store, 0x012345), UDS_OK);
+    assert_int_equal(uds_dtc_add(&g_store, 0x012345), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_dtc_add(&g_store, 0x01000000), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_dtc_add(&g_store, 0xABCDEF), UDS_OK);
+    assert_int_equal(uds_dtc_set_status(&ctx, 0xABCDEF, 0x2F), UDS_OK);
+    assert_int_equal(uds_dtc_set_status(&ctx, 0x000001, 0x01), UDS_ERR_INVALID_ARG);
+
+    const uint8_t req[] = {0x19, 0x0A};
+    send(&ctx, req, sizeof(req), 11);
+    const uint8_t expected[] = {0x59, 0x0A, 0xFF, 0x01, 0x23, 0x45, 0x00, 0xAB, 0xCD, 0xEF, 0x2F};
+    assert_memory_equal(g_tx_buf, expected, sizeof(expected));
+
+    /* Other subfunctions: the application, or NRC 0x12 without it */
+    const uint8_t snapshot[] = {0x19, 0x04, 0xAB, 0xCD, 0xEF, 0x01};
+    send(&ctx, snapshot, sizeof(snapshot), 3);
+    assert_int_equal(g_tx_buf[2], 0x12);
+    cfg.fn_dtc_read = app_read;
+    send(&ctx, snapshot, sizeof(snapshot), 3);
+    assert_int_equal(g_tx_buf[0], 0x59);
+    assert_int_equal(g_tx_buf[2], 0x04);
+}
+
+static void test_clear(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_store(&ctx, &cfg);
+    cfg.fn_dtc_clear = app_clear;
+    uint8_t status = 0u;
+
+    /* One DTC */
+    const uint8_t one[] = {0x14, 0x10, 0x00, 0x00};
+    send(&ctx, one, sizeof(one), 1);
+    assert_int_equal(uds_dtc_get_status(&ctx, 0x100000, &status), UDS_OK);
+    assert_int_equal(status, UDS_DTC_STATUS_CLEARED);
+    assert_int_equal(count_by_mask(&ctx, 0x08), 9);
+
+    /* Unknown DTC */
+    const uint8_t unknown[] = {0x14, 0x00, 0x00, 0x01};
+    send(&ctx, unknown, sizeof(unknown), 3);
+    assert_int_equal(g_tx_buf[2], 0x31);
+
+    /* The application refuses: the store is kept */
+    g_clear_result = -0x22; /* conditionsNotCorrect */
+    const uint8_t all[] = {0x14, 0xFF, 0xFF, 0xFF};
+    send(&ctx, all, sizeof(all), 3);
+    assert_int_equal(count_by_mask(&ctx, 0x01), 333);
+
+    g_clear_result = UDS_OK;
+    send(&ctx, all, sizeof(all), 1);
+    assert_int_equal(g_clears, 3);
+    assert_int_equal(count_by_mask(&ctx, 0x0F), 0);
+    assert_int_equal(count_by_mask(&ctx, UDS_DTC_STATUS_CLEARED), DTC_COUNT);
+}
+
+static void test_control_dtc_setting(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_store(&ctx, &cfg);
+    uint8_t status = 0u;
+
+    const uint8_t off[] = {0x85, 0x02};
+    send(&ctx, off, sizeof(off), 2);
+    assert_int_equal(uds_dtc_set_status(&ctx, code_of(1), 0x09), UDS_OK);
+    assert_int_equal(uds_dtc_get_status(&ctx, code_of(1), &status), UDS_OK);
+    assert_int_equal(status, 0x00);
+
+    const uint8_t on[] = {0x85, 0x01};
+    send(&ctx, on, sizeof(on), 2);
+    assert_int_equal(uds_dtc_set_status(&ctx, code_of(1), 0x09), UDS_OK);
+    assert_int_equal(uds_dtc_get_status(&ctx, code_of(1), &status), UDS_OK);
+    assert_int_equal(status, 0x09);
+    assert_int_equal(count_by_mask(&ctx, 0x08), 11);
+}
+
+/* --- Snapshot and extended data records --- */
+
+#define DTC_A 0x010001u
+#define DTC_B 0x010002u
+#define DTC_C 0x010003u
+#define FRAME_LEN 23u /* VIN (17) + speed (2) + odometer (4) */
+
+static uint8_t g_vin[17] = "WVWZZZ1JZXW000001";
+static uint8_t g_speed[2];
+static uint8_t g_odo[4] = {0x00, 0x00, 0x12, 0x34};
+static const uds_did_entry_t g_dids[] = {
+    {0xF190, 17, UDS_SESSION_ALL, 0, NULL, NULL, g_vin, 0},
+    {0x0100, 2, UDS_SESSION_ALL, 0, NULL, NULL, g_speed, 0},
+    {0x0200, 4, UDS_SESSION_ALL, 0, NULL, NULL, g_odo, 0},
+};
+static const uint16_t g_snapshot_dids[] = {0xF190, 0x0100, 0x0200};
+static uint8_t g_pool[256];
+static uint8_t g_occurrences[3];
+static uds_dtc_records_t g_records;
+
+static void setup_records(uds_ctx_t *ctx, uds_config_t *cfg, uint16_t pool_size)
+{
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 3;
+    uds_dtc_init(&g_store, g_codes, g_status, g_bits, 3);
+    uds_dtc_add(&g_store, DTC_A);
+    uds_dtc_add(&g_store, DTC_B);
+    uds_dtc_add(&g_store, DTC_C);
+    uds_dtc_records_init(&g_records, g_snapshot_dids, 3, g_pool, pool_size, g_occurrences);
+    g_store.records = &g_records;
+    cfg->dtc_store = &g_store;
+    g_clear_result = UDS_OK;
+    g_clears = 0;
+}
+
+/* testFailed of dtc goes 0 -> 1 with the given vehicle speed */
+static void report_failure(uds_ctx_t *ctx, uint32_t dtc, uint8_t speed)
+{
+    g_speed[1] = speed;
+    assert_int_equal(uds_dtc_set_status(ctx, dtc, 0x00), UDS_OK);
+    assert_int_equal(uds_dtc_set_status(ctx, dtc, 0x09), UDS_OK);
+}
+
+/* 0x19 0x04 for one record: the speed it captured */
+static uint8_t snapshot_speed(uds_ctx_t *ctx, uint32_t dtc, uint8_t recno)
+{
+    const uint8_t req[] = {0x19, 0x04, (uint8_t) (dtc >> 16), (uint8_t) (dtc >> 8), (uint8_t) dtc,
+                           recno};
+    send(ctx, req, sizeof(req), 6 + 2 + 6 + FRAME_LEN);
+    assert_int_equal(g_tx_buf[6], recno);
+    assert_int_equal(g_tx_buf[7], 3);
+    assert_memory_equal(&g_tx_buf[10], g_vin, sizeof(g_vin));
+    assert_int_equal(g_tx_buf[27], 0x01);
+    assert_int_equal(g_tx_buf[28], 0x00);
+    assert_memory_equal(&g_tx_buf[33], g_odo, sizeof(g_odo));
+    return g_tx_buf[30];
+}
+
+static void test_snapshot_records(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_records(&ctx, &cfg, sizeof(g_pool));
+
+    report_failure(&ctx, DTC_A, 0x50);
+    report_failure(&ctx, DTC_B, 0x60);
+    assert_int_equal(g_records.count, 2);
+    /* First record against zeros: 20 non-zero bytes; then only the speed changed */
+    assert_int_equal(g_records.used, (5 + 3 + 20) + (5 + 3 + 1));
+
+    assert_int_equal(snapshot_speed(&ctx, DTC_A, 0x01), 0x50);
+    assert_int_equal(snapshot_speed(&ctx, DTC_B, 0x01), 0x60);
+    const uint8_t head[] = {0x59, 0x04, 0x01, 0x00, 0x01, 0x09, 0x01, 0x03, 0xF1, 0x90};
+    const uint8_t req_a[] = {0x19, 0x04, 0x01, 0x00, 0x01, 0x01};
+    send(&ctx, req_a, sizeof(req_a), 6 + 2 + 6 + FRAME_LEN);
+    assert_memory_equal(g_tx_buf, head, sizeof(head));
+
+    /* Identification, oldest first */
+    const uint8_t ident[] = {0x19, 0x03};
+    send(&ctx, ident, sizeof(ident), 10);
+    const uint8_t ids[] = {0x59, 0x03, 0x01, 0x00, 0x01, 0x01, 0x01, 0x00, 0x02, 0x01};
+    assert_memory_equal(g_tx_buf, ids, sizeof(ids));
+
+    /* Occurrence counter (extended data record 0x01) */
+    report_failure(&ctx, DTC_A, 0x70);
+    const uint8_t ext[] = {0x19, 0x06, 0x01, 0x00, 0x01, 0xFF};
+    send(&ctx, ext, sizeof(ext), 8);
+    const uint8_t ext_resp[] = {0x59, 0x06, 0x01, 0x00, 0x01, 0x09, 0x01, 0x02};
+    assert_memory_equal(g_tx_buf, ext_resp, sizeof(ext_resp));
+
+    /* Unknown DTC, unsupported record numbers */
+    const uint8_t unknown[] = {0x19, 0x04, 0x0F, 0x00, 0x01, 0x01};
+    send(&ctx, unknown, sizeof(unknown), 3);
+    assert_int_equal(g_tx_buf[2], 0x31);
+    const uint8_t bad_rec[] = {0x19, 0x04, 0x01, 0x00, 0x01, 0x03};
+    send(&ctx, bad_rec, sizeof(bad_rec), 3);
+    assert_int_equal(g_tx_buf[2], 0x31);
+    const uint8_t short_req[] = {0x19, 0x04, 0x01, 0x00};
+    send(&ctx, short_req, sizeof(short_req), 3);
+    assert_int_equal(g_tx_buf[2], 0x13);
+}
+
+static void test_most_recent_record_replaced(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_records(&ctx, &cfg, sizeof(g_pool));
+
+    report_failure(&ctx, DTC_A, 0x10);
+    report_failure(&ctx, DTC_B, 0x20);
+    report_failure(&ctx, DTC_A, 0x30);
+    report_failure(&ctx, DTC_C, 0x40);
+    /* Record 2 of A sits between B and C: it is folded into C, then captured again */
+    report_failure(&ctx, DTC_A, 0x50);
+    assert_int_equal(g_records.count, 4);
+
+    assert_int_equal(snapshot_speed(&ctx, DTC_A, 0x01), 0x10);
+    assert_int_equal(snapshot_speed(&ctx, DTC_B, 0x01), 0x20);
+    assert_int_equal(snapshot_speed(&ctx, DTC_C, 0x01), 0x40);
+    assert_int_equal(snapshot_speed(&ctx, DTC_A, 0x02), 0x50);
+
+    /* All records of A in one response */
+    const uint8_t all[] = {0x19, 0x04, 0x01, 0x00, 0x01, 0xFF};
+    send(&ctx, all, sizeof(all), 6 + (2 * (2 + 6 + FRAME_LEN)));
+
+    /* Keep only the first occurrence */
+    g_records.max_per_dtc = 1u;
+    report_failure(&ctx, DTC_B, 0x60);
+    assert_int_equal(g_records.dropped, 1);
+    assert_int_equal(snapshot_speed(&ctx, DTC_B, 0x01), 0x20);
+}
+
+static void test_pool_eviction(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    /* Working copies, the first record (28) and two speed-only records (9) */
+    setup_records(&ctx, &cfg, (3 * FRAME_LEN) + 28 + 9 + 9);
+
+    report_failure(&ctx, DTC_A, 0x10);
+    report_failure(&ctx, DTC_B, 0x20);
+    report_failure(&ctx, DTC_C, 0x30);
+    assert_int_equal(g_records.evicted, 0);
+
+    /* The oldest record (A) goes; B now carries the full frame */
+    report_failure(&ctx, DTC_B, 0x40);
+    assert_int_equal(g_records.evicted, 1);
+    assert_int_equal(g_records.count, 3);
+    const uint8_t req_a[] = {0x19, 0x04, 0x01, 0x00, 0x01, 0xFF};
+    send(&ctx, req_a, sizeof(req_a), 6);
+    assert_int_equal(snapshot_speed(&ctx, DTC_B, 0x01), 0x20);
+    assert_int_equal(snapshot_speed(&ctx, DTC_C, 0x01), 0x30);
+    assert_int_equal(snapshot_speed(&ctx, DTC_B, 0x02), 0x40);
+
+    /* Without eviction the pool keeps the old records */
+    g_records.policy = UDS_DTC_EVICT_NONE;
+    g_odo[3]++;
+    report_failure(&ctx, DTC_A, 0x50);
+    g_odo[3]--;
+    assert_int_equal(g_records.dropped, 1);
+    assert_int_equal(g_records.count, 3);
+}
+
+static void test_clear_drops_records(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_records(&ctx, &cfg, sizeof(g_pool));
+
+    report_failure(&ctx, DTC_A, 0x10);
+    report_failure(&ctx, DTC_B, 0x20);
+    report_failure(&ctx, DTC_C, 0x30);
+
+    const uint8_t one[] = {0x14, 0x01, 0x00, 0x01};
+    send(&ctx, one, sizeof(one), 1);
+    assert_int_equal(g_records.count, 2);
+    assert_int_equal(g_occurrences[0], 0);
+    assert_int_equal(snapshot_speed(&ctx, DTC_B, 0x01), 0x20);
+    assert_int_equal(snapshot_speed(&ctx, DTC_C, 0x01), 0x30);
+
+    const uint8_t all[] = {0x14, 0xFF, 0xFF, 0xFF};
+    send(&ctx, all, sizeof(all), 1);
+    assert_int_equal(g_records.count, 0);
+    assert_int_equal(g_records.used, 0);
+    const uint8_t ident[] = {0x19, 0x03};
+    send(&ctx, ident, sizeof(ident), 2);
+
+    /* Capturing starts over from zeros */
+    report_failure(&ctx, DTC_C, 0x40);
+    assert_int_equal(snapshot_speed(&ctx, DTC_C, 0x01), 0x40);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_count_by_mask),
+        cmocka_unit_test(test_report_by_mask),
+        cmocka_unit_test(test_report_streamed),
+        cmocka_unit_test(test_supported_dtcs),
+        cmocka_unit_test(test_clear),
+        cmocka_unit_test(test_control_dtc_setting),
+        cmocka_unit_test(test_snapshot_records),
+        cmocka_unit_test(test_most_recent_record_replaced),
+        cmocka_unit_test(test_pool_eviction),
+        cmocka_unit_test(test_clear_drops_records),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
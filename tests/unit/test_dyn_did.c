@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_dyn_did.c
+ * @brief Unit tests for DynamicallyDefineDataIdentifier (0x2C) and its gather plans
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_dyn_did.h"
+
+static int g_reads;
+static uint8_t g_speed[4] = {0x10, 0x11, 0x12, 0x13};
+static uint8_t g_memory[16] = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+                               0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF};
+static uint8_t g_key[2] = {0x5E, 0xC5};
+
+static int read_temps(uds_ctx_t *ctx, uint16_t did, uint8_t *buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) did;
+    g_reads++;
+    for (uint16_t i = 0; i < max_len; i++) {
+        buf[i] = (uint8_t) (0x20u + i);
+    }
+    return (int) max_len;
+}
+
+static int mem_read(uds_ctx_t *ctx, uint32_t addr, uint32_t size, uint8_t *out_buf)
+{
+    (void) ctx;
+    if (addr + size > sizeof(g_memory)) {
+        return -0x31;
+    }
+    memcpy(out_buf, &g_memory[addr], size);
+    return 0;
+}
+
+static const uint8_t *mem_map(uds_ctx_t *ctx, uint32_t addr, uint32_t size)
+{
+    (void) ctx;
+    return (addr + size <= 8u) ? &g_memory[addr] : NULL; /* First half mapped */
+}
+
+static const uds_did_entry_t g_dids[] = {
+    {0x0100, 4, UDS_SESSION_ALL, 0, NULL, NULL, g_speed, 0},
+    {0x0200, 6, UDS_SESSION_ALL, 0, read_temps, NULL, NULL, 0},
+    {0x0300, 2, UDS_SESSION_ALL, UDS_SECURITY_LEVEL(1), NULL, NULL, g_key, 0},
+};
+
+static uds_dyn_did_t g_dyn[2];
+
+static void setup_dyn(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    g_reads = 0;
+    memset(g_dyn, 0, sizeof(g_dyn));
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 3;
+    cfg->dyn_dids = g_dyn;
+    cfg->dyn_did_count = 2;
+    cfg->fn_mem_read = mem_read;
+}
+
+static void send(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint16_t resp_len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, len);
+}
+
+static void expect_nrc(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint8_t nrc)
+{
+    send(ctx, req, len, 3);
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[2], nrc);
+}
+
+static void test_define_by_identifier(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_dyn(&ctx, &cfg);
+
+    /* speed[1..2], temps[0..1], temps[2..3] (merged), speed[0] */
+    const uint8_t define[] = {0x2C, 0x01, 0xF2, 0x00, 0x01, 0x00, 0x02, 0x02, 0x02, 0x00,
+                              0x01, 0x02, 0x02, 0x00, 0x03, 0x02, 0x01, 0x00, 0x01, 0x01};
+    send(&ctx, define, sizeof(define), 4);
+    assert_int_equal(g_tx_buf[0], 0x6C);
+    assert_int_equal(g_tx_buf[1], 0x01);
+    assert_int_equal(g_dyn[0].id, 0xF200);
+    assert_int_equal(g_dyn[0].size, 7);
+    assert_int_equal(g_dyn[0].count, 3);
+
+    const uint8_t read[] = {0x22, 0xF2, 0x00};
+    send(&ctx, read, sizeof(read), 3 + 7);
+    const uint8_t expected[] = {0x62, 0xF2, 0x00, 0x11, 0x12, 0x20, 0x21, 0x22, 0x23, 0x10};
+    assert_memory_equal(g_tx_buf, expected, sizeof(expected));
+    assert_int_equal(g_reads, 1);
+
+    /* Static sources are read live */
+    g_speed[1] = 0x99;
+    send(&ctx, read, sizeof(read), 3 + 7);
+    assert_int_equal(g_tx_buf[3], 0x99);
+    g_speed[1] = 0x11;
+
+    /* Mixed with a table DID in one request */
+    const uint8_t mixed[] = {0x22, 0x01, 0x00, 0xF2, 0x00};
+    send(&ctx, mixed, sizeof(mixed), 1 + 6 + 9);
+    assert_int_equal(g_tx_buf[7], 0xF2);
+}
+
+static void test_define_by_memory(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_dyn(&ctx, &cfg);
+    cfg.fn_mem_map = mem_map;
+
+    /* ALFID 0x11: 1-byte address, 1-byte size. [2..4) mapped, [10..13) read */
+    const uint8_t define[] = {0x2C, 0x02, 0xF3, 0x01, 0x11, 0x02, 0x02, 0x0A, 0x03};
+    send(&ctx, define, sizeof(define), 4);
+    assert_non_null(g_dyn[0].steps[0].src);
+    assert_null(g_dyn[0].steps[1].src);
+
+    const uint8_t read[] = {0x22, 0xF3, 0x01};
+    send(&ctx, read, sizeof(read), 3 + 5);
+    const uint8_t expected[] = {0xA2, 0xA3, 0xAA, 0xAB, 0xAC};
+    assert_memory_equal(&g_tx_buf[3], expected, sizeof(expected));
+
+    /* Wrong record length */
+    const uint8_t bad[] = {0x2C, 0x02, 0xF3, 0x01, 0x11, 0x02};
+    expect_nrc(&ctx, bad, sizeof(bad), 0x13);
+}
+
+static void test_rejected_request_leaves_definition(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_dyn(&ctx, &cfg);
+
+    const uint8_t first[] = {0x2C, 0x01, 0xF2, 0x00, 0x01, 0x00, 0x01, 0x02};
+    send(&ctx, first, sizeof(first), 4);
+
+    /* Second request: valid continuation, then a slice past the end of the DID */
+    const uint8_t second[] = {0x2C, 0x01, 0xF2, 0x00, 0x01, 0x00, 0x03, 0x01,
+                              0x01, 0x00, 0x04, 0x02};
+    expect_nrc(&ctx, second, sizeof(second), 0x31);
+    assert_int_equal(g_dyn[0].count, 1);
+    assert_int_equal(g_dyn[0].size, 2);
+    assert_int_equal(g_dyn[0].steps[0].len, 2);
+
+    /* Appending works */
+    const uint8_t third[] = {0x2C, 0x01, 0xF2, 0x00, 0x01, 0x00, 0x04, 0x01};
+    send(&ctx, third, sizeof(third), 4);
+    assert_int_equal(g_dyn[0].size, 3);
+
+    /* A failing first definition does not take a slot */
+    const uint8_t unknown[] = {0x2C, 0x01, 0xF2, 0x01, 0x09, 0x99, 0x01, 0x01};
+    expect_nrc(&ctx, unknown, sizeof(unknown), 0x31);
+    assert_int_equal(g_dyn[1].id, 0);
+
+    /* Outside the dynamic range */
+    const uint8_t range[] = {0x2C, 0x01, 0x01, 0x00, 0x01, 0x00, 0x01, 0x01};
+    expect_nrc(&ctx, range, sizeof(range), 0x31);
+}
+
+static void test_clear(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_dyn(&ctx, &cfg);
+
+    const uint8_t a[] = {0x2C, 0x01, 0xF2, 0x00, 0x01, 0x00, 0x01, 0x01};
+    const uint8_t b[] = {0x2C, 0x01, 0xF2, 0x01, 0x01, 0x00, 0x01, 0x01};
+    const uint8_t c[] = {0x2C, 0x01, 0xF2, 0x02, 0x01, 0x00, 0x01, 0x01};
+    send(&ctx, a, sizeof(a), 4);
+    send(&ctx, b, sizeof(b), 4);
+    expect_nrc(&ctx, c, sizeof(c), 0x31); /* Both slots in use */
+
+    const uint8_t clear_a[] = {0x2C, 0x03, 0xF2, 0x00};
+    send(&ctx, clear_a, sizeof(clear_a), 4);
+    const uint8_t read_a[] = {0x22, 0xF2, 0x00};
+    expect_nrc(&ctx, read_a, sizeof(read_a), 0x31);
+    send(&ctx, c, sizeof(c), 4);
+
+    const uint8_t clear_all[] = {0x2C, 0x03};
+    send(&ctx, clear_all, sizeof(clear_all), 2);
+    assert_int_equal(g_dyn[0].id, 0);
+    assert_int_equal(g_dyn[1].id, 0);
+}
+
+static void test_source_rules_apply(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_dyn(&ctx, &cfg);
+
+    const uint8_t define[] = {0x2C, 0x01, 0xF2, 0x00, 0x03, 0x00, 0x01, 0x02};
+    expect_nrc(&ctx, define, sizeof(define), 0x33);
+
+    ctx.security_level = 1;
+    send(&ctx, define, sizeof(define), 4);
+    const uint8_t read[] = {0x22, 0xF2, 0x00};
+    send(&ctx, read, sizeof(read), 5);
+    assert_int_equal(g_tx_buf[3], 0x5E);
+
+    /* Locked again: the dynamic DID is locked too */
+    ctx.security_level = 0;
+    expect_nrc(&ctx, read, sizeof(read), 0x33);
+}
+
+static void test_not_configured(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_dyn(&ctx, &cfg);
+    cfg.dyn_dids = NULL;
+
+    const uint8_t define[] = {0x2C, 0x01, 0xF2, 0x00, 0x01, 0x00, 0x01, 0x01};
+    expect_nrc(&ctx, define, sizeof(define), 0x22);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_define_by_identifier),
+        cmocka_unit_test(test_define_by_memory),
+        cmocka_unit_test(test_rejected_request_leaves_definition),
+        cmocka_unit_test(test_clear),
+        cmocka_unit_test(test_source_rules_apply),
+        cmocka_unit_test(test_not_configured),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
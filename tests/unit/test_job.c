@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_job.c
+ * @brief Unit tests for the asynchronous job API
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_job.h"
+
+static uds_job_t *g_submitted;
+static int g_submit_ret;
+static int g_work_calls;
+
+static int manual_submit(void *executor, uds_job_t *job)
+{
+    (void) executor;
+    g_submitted = job;
+    return g_submit_ret;
+}
+
+static int work_ok(uds_job_t *job)
+{
+    (void) job;
+    g_work_calls++;
+    return UDS_OK;
+}
+
+static int work_fail(uds_job_t *job)
+{
+    (void) job;
+    g_work_calls++;
+    return -0x72; /* GeneralProgrammingFailure */
+}
+
+static int complete_routine(struct uds_ctx *ctx, uds_job_t *job, int result)
+{
+    (void) job;
+    if (result < 0) {
+        return result;
+    }
+    ctx->config->tx_buffer[0] = 0x71;
+    ctx->config->tx_buffer[1] = 0x01;
+    ctx->config->tx_buffer[2] = 0xFF;
+    ctx->config->tx_buffer[3] = 0x00;
+    return 4;
+}
+
+static uds_job_t g_job;
+
+static int job_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    return uds_submit_job(ctx, data[0], &g_job);
+}
+
+static const uds_service_entry_t g_job_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, job_handler, NULL},
+};
+
+static const uint8_t g_routine[] = {0x31, 0x01, 0xFF, 0x00};
+
+static void setup_job(uds_ctx_t *ctx, uds_config_t *cfg, bool executor)
+{
+    g_submitted = NULL;
+    g_submit_ret = 0;
+    g_work_calls = 0;
+    memset(&g_job, 0, sizeof(g_job));
+    g_job.work = work_ok;
+    g_job.complete = complete_routine;
+
+    setup_ctx(ctx, cfg);
+    cfg->user_services = g_job_services;
+    cfg->user_service_count = 1;
+    if (executor) {
+        cfg->fn_job_submit = manual_submit;
+    }
+}
+
+static void test_inline_job_without_executor(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, false);
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 4);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+
+    assert_int_equal(g_work_calls, 1);
+    assert_int_equal(g_tx_buf[0], 0x71);
+    assert_false(ctx.p2_msg_pending);
+}
+
+static void test_executor_job_completes_pending_request(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, true);
+
+    /* Handed to the executor: NRC 0x78 while the work is outstanding */
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+
+    assert_ptr_equal(g_submitted, &g_job);
+    assert_int_equal(g_work_calls, 0);
+    assert_true(ctx.p2_msg_pending);
+    assert_int_equal(g_tx_buf[2], 0x78);
+
+    /* Worker runs the job */
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 4);
+    will_return(mock_tp_send, 0);
+    uds_job_execute(g_submitted);
+
+    assert_int_equal(g_work_calls, 1);
+    assert_int_equal(g_tx_buf[0], 0x71);
+    assert_false(ctx.p2_msg_pending);
+
+    /* A second completion of the same job is stale */
+    assert_int_equal(uds_complete_pending(&ctx, &g_job, UDS_OK), UDS_ERR_STALE_JOB);
+}
+
+static void test_failed_job_sends_nrc(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, true);
+    g_job.work = work_fail;
+    g_job.complete = NULL;
+
+    will_return_always(mock_get_time, 1000);
+    expect_any_count(mock_tp_send, data, 2);
+    expect_value_count(mock_tp_send, len, 3, 2);
+    will_return_count(mock_tp_send, 0, 2);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    uds_job_execute(g_submitted);
+
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[1], 0x31);
+    assert_int_equal(g_tx_buf[2], 0x72);
+    assert_false(ctx.p2_msg_pending);
+}
+
+static void test_job_aborted_by_rcrrp_limit_is_stale(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, true);
+    cfg.rcrrp_limit = 1;
+    ctx.p2_star_ms = 100;
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any_count(mock_tp_send, data, 3);
+    expect_value_count(mock_tp_send, len, 3, 3);
+    will_return_count(mock_tp_send, 0, 3);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+
+    will_return(mock_get_time, 1100);
+    uds_process(&ctx);
+    will_return(mock_get_time, 1200);
+    uds_process(&ctx);
+    assert_int_equal(g_tx_buf[2], 0x22);
+    assert_false(ctx.p2_msg_pending);
+
+    /* The late result is dropped without a response */
+    assert_int_equal(uds_complete_pending(&ctx, g_submitted, UDS_OK), UDS_ERR_STALE_JOB);
+}
+
+static void test_rejected_submit_sends_busy(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, true);
+    g_submit_ret = -1;
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+
+    assert_int_equal(g_tx_buf[2], 0x21);
+    assert_false(ctx.p2_msg_pending);
+    assert_int_equal(ctx.pending_job_id, 0);
+}
+
+static int complete_silent(struct uds_ctx *ctx, uds_job_t *job, int result)
+{
+    (void) ctx;
+    (void) job;
+    (void) result;
+    return 0;
+}
+
+static void test_silent_job_completes_pending_request(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, true);
+    g_job.complete = complete_silent;
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any_count(mock_tp_send, data, 2);
+    expect_value_count(mock_tp_send, len, 3, 2);
+    will_return_count(mock_tp_send, 0, 2);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    ctx.p2_star_ms = 100;
+    will_return(mock_get_time, 1100);
+    uds_process(&ctx);
+    assert_int_equal(ctx.rcrrp_count, 1);
+
+    /* No response, but the request is finished like one that sent a response */
+    cfg.rcrrp_policy = UDS_RCRRP_POLICY_ADAPTIVE;
+    will_return(mock_get_time, 1140);
+    uds_job_execute(g_submitted);
+
+    assert_false(ctx.p2_msg_pending);
+    assert_int_equal(ctx.rcrrp_count, 0);
+    assert_int_equal(ctx.latency_sid[0], 0x31);
+    assert_int_equal(ctx.latency_ms[0], 140);
+}
+
+static void noop_lock(void *handle)
+{
+    (void) handle;
+}
+
+static void test_executor_requires_serialization(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_job(&ctx, &cfg, true);
+
+    /* A worker could complete the job before the request is marked pending */
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_ERR_INVALID_ARG);
+
+    cfg.fn_mutex_lock = noop_lock;
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_ERR_INVALID_ARG);
+    cfg.fn_mutex_unlock = noop_lock;
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_OK);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_inline_job_without_executor),
+        cmocka_unit_test(test_executor_job_completes_pending_request),
+        cmocka_unit_test(test_failed_job_sends_nrc),
+        cmocka_unit_test(test_job_aborted_by_rcrrp_limit_is_stale),
+        cmocka_unit_test(test_rejected_submit_sends_busy),
+        cmocka_unit_test(test_silent_job_completes_pending_request),
+        cmocka_unit_test(test_executor_requires_serialization),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_mailbox.c
+ * @brief Unit tests for the single-owner mailbox threading model
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_job.h"
+#include "uds/uds_mailbox.h"
+
+#ifdef UDS_TEST_THREADS
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#define MB_DEPTH 4u
+#define MB_SLOT 16u
+
+static uds_mail_t g_mails[MB_DEPTH];
+static uint8_t g_mail_data[MB_DEPTH * MB_SLOT];
+static uds_mailbox_t g_mb;
+static int g_notified;
+
+static void notify_owner(void *arg)
+{
+    (*(int *) arg)++;
+}
+
+static void setup_mailbox(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    setup_ctx(ctx, cfg);
+    assert_int_equal(uds_mailbox_init(&g_mb, g_mails, g_mail_data, MB_DEPTH, MB_SLOT), UDS_OK);
+    g_notified = 0;
+    g_mb.fn_notify = notify_owner;
+    g_mb.notify_arg = &g_notified;
+    cfg->mailbox = &g_mb;
+}
+
+static void test_init_rejects_bad_arguments(void **state)
+{
+    (void) state;
+    uds_mailbox_t mb;
+    assert_int_equal(uds_mailbox_init(&mb, g_mails, g_mail_data, 3, MB_SLOT), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_mailbox_init(&mb, g_mails, g_mail_data, MB_DEPTH, 0), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_mailbox_init(&mb, NULL, g_mail_data, MB_DEPTH, MB_SLOT),
+                     UDS_ERR_INVALID_ARG);
+}
+
+static void test_input_runs_on_owner_process(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_mailbox(&ctx, &cfg);
+
+    /* Posted only: no clock read, no response yet */
+    uint8_t request[] = {0x3E, 0x00};
+    uds_input_sdu(&ctx, request, sizeof(request));
+    request[1] = 0xFF; /* The mailbox holds its own copy */
+    assert_int_equal(g_notified, 1);
+
+    /* The owner dispatches it (2 clock reads) before its own tick (1 read) */
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 2);
+    will_return(mock_tp_send, 0);
+    uds_process(&ctx);
+    assert_int_equal(g_tx_buf[0], 0x7E);
+    assert_int_equal(g_tx_buf[1], 0x00);
+
+    /* Nothing left */
+    will_return(mock_get_time, 1001);
+    uds_process(&ctx);
+}
+
+static void test_posts_keep_order_and_tester(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_mailbox(&ctx, &cfg);
+
+    uint8_t first[] = {0x10, 0x03};
+    uint8_t second[] = {0x3E, 0x00};
+    uds_input_sdu_from(&ctx, 0x0F1, first, sizeof(first));
+    uds_input_sdu(&ctx, second, sizeof(second));
+
+    will_return_count(mock_get_time, 1000, 5);
+    expect_any_count(mock_tp_send, data, 2);
+    expect_value(mock_tp_send, len, 6);
+    expect_value(mock_tp_send, len, 2);
+    will_return_count(mock_tp_send, 0, 2);
+    uds_process(&ctx);
+
+    assert_int_equal(ctx.active_session, 0x03);
+    assert_int_equal(ctx.tester_addr, 0x0F1);
+}
+
+static void test_full_mailbox_rejects_posts(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_mailbox(&ctx, &cfg);
+
+    uint8_t request[] = {0x3E, 0x80};
+    for (uint32_t i = 0u; i < MB_DEPTH; i++) {
+        assert_int_equal(uds_mailbox_post(&g_mb, UDS_MAIL_SDU, 0u, request, 2u, NULL, 0), UDS_OK);
+    }
+    assert_int_equal(uds_mailbox_post(&g_mb, UDS_MAIL_SDU, 0u, request, 2u, NULL, 0),
+                     UDS_ERR_MAILBOX_FULL);
+    assert_int_equal(g_mb.dropped, 1);
+
+    uint8_t too_long[MB_SLOT + 1u] = {0x22};
+    assert_int_equal(uds_mailbox_post(&g_mb, UDS_MAIL_SDU, 0u, too_long, sizeof(too_long), NULL, 0),
+                     UDS_ERR_BUFFER_TOO_SMALL);
+
+    /* Suppressed TesterPresent: no responses, four dispatches plus the tick */
+    will_return_count(mock_get_time, 1000, 2 * MB_DEPTH + 1);
+    uds_process(&ctx);
+    assert_int_equal(uds_mailbox_post(&g_mb, UDS_MAIL_SDU, 0u, request, 2u, NULL, 0), UDS_OK);
+}
+
+static int g_client_calls;
+
+static void client_cb(struct uds_ctx *ctx, uint8_t sid, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) sid;
+    (void) data;
+    (void) len;
+    g_client_calls++;
+}
+
+static void test_client_request_is_posted(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_mailbox(&ctx, &cfg);
+
+    uint8_t did[] = {0xF1, 0x90};
+    assert_int_equal(uds_client_request(&ctx, 0x22, did, sizeof(did), client_cb), UDS_OK);
+    assert_int_equal(ctx.pending_sid, 0);
+
+    uint8_t expected[] = {0x22, 0xF1, 0x90};
+    will_return(mock_get_time, 1000);
+    expect_memory(mock_tp_send, data, expected, sizeof(expected));
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_process(&ctx);
+    assert_int_equal(ctx.pending_sid, 0x22);
+}
+
+static int complete_job(struct uds_ctx *ctx, uds_job_t *job, int result)
+{
+    (void) job;
+    (void) result;
+    ctx->config->tx_buffer[0] = 0x71;
+    return 1;
+}
+
+static void test_job_completion_is_posted(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_mailbox(&ctx, &cfg);
+
+    uds_job_t job = {NULL, complete_job, NULL, NULL, 0, 7, 0x31};
+    ctx.p2_msg_pending = true;
+    ctx.pending_sid = 0x31;
+    ctx.pending_job_id = 7;
+
+    assert_int_equal(uds_complete_pending(&ctx, &job, UDS_OK), UDS_OK);
+    assert_true(ctx.p2_msg_pending);
+
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 1);
+    will_return(mock_tp_send, 0);
+    uds_process(&ctx);
+    assert_false(ctx.p2_msg_pending);
+}
+
+#ifdef UDS_TEST_THREADS
+
+#define PRODUCERS 4
+#define POSTS_PER_PRODUCER 2000
+
+static uds_mail_t g_big_mails[64];
+static uint8_t g_big_data[64 * MB_SLOT];
+static volatile int g_done_producers;
+static int g_received[PRODUCERS];
+static int g_order_errors;
+
+static uint32_t fixed_time(void)
+{
+    return 1000u;
+}
+
+static int count_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) len;
+    /* Echo of [0x31][0x01][producer][sequence] */
+    int producer = data[2];
+    if (data[3] != (uint8_t) g_received[producer]) {
+        g_order_errors++;
+    }
+    g_received[producer]++;
+    return 0;
+}
+
+static int seq_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    ctx->config->tx_buffer[0] = 0x71;
+    ctx->config->tx_buffer[1] = data[1];
+    ctx->config->tx_buffer[2] = data[2];
+    ctx->config->tx_buffer[3] = data[3];
+    return uds_send_response(ctx, 4);
+}
+
+static const uds_service_entry_t g_seq_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, seq_handler, NULL},
+};
+
+static void *producer_main(void *arg)
+{
+    uds_ctx_t *ctx = (uds_ctx_t *) arg;
+    static int next_id;
+    int id = __atomic_fetch_add(&next_id, 1, __ATOMIC_RELAXED);
+
+    for (int i = 0; i < POSTS_PER_PRODUCER; i++) {
+        uint8_t request[] = {0x31, 0x01, (uint8_t) id, (uint8_t) i};
+        while (uds_mailbox_post(ctx->config->mailbox, UDS_MAIL_SDU, 0u, request, sizeof(request),
+                                NULL, 0) == UDS_ERR_MAILBOX_FULL) {
+            sched_yield();
+        }
+    }
+    __atomic_fetch_add(&g_done_producers, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void test_concurrent_producers(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_mailbox_t mb;
+    pthread_t threads[PRODUCERS];
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.get_time_ms = fixed_time;
+    cfg.fn_tp_send = count_tp_send;
+    cfg.rx_buffer = g_rx_buf;
+    cfg.rx_buffer_size = sizeof(g_rx_buf);
+    cfg.tx_buffer = g_tx_buf;
+    cfg.tx_buffer_size = sizeof(g_tx_buf);
+    cfg.user_services = g_seq_services;
+    cfg.user_service_count = 1;
+    uds_mailbox_init(&mb, g_big_mails, g_big_data, 64, MB_SLOT);
+    cfg.mailbox = &mb;
+    uds_init(&ctx, &cfg);
+
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_create(&threads[i], NULL, producer_main, &ctx);
+    }
+
+    /* Owner thread: no lock anywhere */
+    while (__atomic_load_n(&g_done_producers, __ATOMIC_ACQUIRE) < PRODUCERS) {
+        uds_process(&ctx);
+    }
+    uds_process(&ctx);
+
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+        assert_int_equal(g_received[i], POSTS_PER_PRODUCER);
+    }
+    assert_int_equal(g_order_errors, 0);
+}
+
+#endif /* UDS_TEST_THREADS */
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_init_rejects_bad_arguments),
+        cmocka_unit_test(test_input_runs_on_owner_process),
+        cmocka_unit_test(test_posts_keep_order_and_tester),
+        cmocka_unit_test(test_full_mailbox_rejects_posts),
+        cmocka_unit_test(test_client_request_is_posted),
+        cmocka_unit_test(test_job_completion_is_posted),
+#ifdef UDS_TEST_THREADS
+        cmocka_unit_test(test_concurrent_producers),
+#endif
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
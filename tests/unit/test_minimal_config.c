@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_minimal_config.c
+ * @brief Unit tests for compile-time service stripping
+ *
+ * Linked against uds_minimal: only 0x22 and 0x3E are built in.
+ */
+
+#include "test_helpers.h"
+
+#if UDS_CFG_SERVICE_10 || UDS_CFG_SERVICE_27 || UDS_CFG_SERVICE_34 || !UDS_CFG_SERVICE_22 || \
+    !UDS_CFG_SERVICE_3E
+#error "test_minimal_config must be built with the uds_minimal definitions"
+#endif
+
+#if UDS_CFG_FEATURE_SECURITY || UDS_CFG_FEATURE_PERIODIC || UDS_CFG_FEATURE_FLASH || \
+    UDS_CFG_FEATURE_DTC
+#error "uds_minimal must strip the security, periodic, flash and DTC state"
+#endif
+
+#if UDS_CFG_FEATURE_MULTI_TESTER || UDS_CFG_FEATURE_QUEUE || UDS_CFG_FEATURE_BUFFER_POOL || \
+    UDS_CFG_FEATURE_TIMER_WHEEL || UDS_CFG_FEATURE_MAILBOX || UDS_CFG_FEATURE_JOB ||        \
+    UDS_CFG_FEATURE_STATS || UDS_CFG_FEATURE_TRACE || UDS_CFG_FEATURE_RCRRP_ADAPTIVE ||      \
+    UDS_CFG_FEATURE_ACCESS_MATRIX || UDS_CFG_FEATURE_DID_CACHE || UDS_CFG_FEATURE_STREAM
+#error "uds_minimal must strip the optional server state"
+#endif
+
+static uint8_t g_vin[3] = {'W', 'D', 'B'};
+
+static const uds_did_entry_t g_dids[] = {
+    {0xF190, 3, 0, 0, NULL, NULL, g_vin, 0},
+};
+
+static void setup_minimal(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 1;
+}
+
+static void expect_nrc(uds_ctx_t *ctx, const uint8_t *request, uint16_t len, uint8_t nrc)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, request, len);
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[1], request[0]);
+    assert_int_equal(g_tx_buf[2], nrc);
+}
+
+static void test_enabled_services_respond(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_minimal(&ctx, &cfg);
+
+    uint8_t rdbi[] = {0x22, 0xF1, 0x90};
+    uint8_t expected[] = {0x62, 0xF1, 0x90, 'W', 'D', 'B'};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_memory(mock_tp_send, data, expected, sizeof(expected));
+    expect_value(mock_tp_send, len, sizeof(expected));
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, rdbi, sizeof(rdbi));
+
+    uint8_t tp[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 2);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, tp, sizeof(tp));
+    assert_int_equal(g_tx_buf[0], 0x7E);
+}
+
+static void test_stripped_services_not_supported(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_minimal(&ctx, &cfg);
+
+    uint8_t session[] = {0x10, 0x03};
+    uint8_t seed[] = {0x27, 0x01};
+    uint8_t periodic[] = {0x2A, 0x01, 0x01};
+    uint8_t download[] = {0x34, 0x00, 0x11, 0x10, 0x10};
+    expect_nrc(&ctx, session, sizeof(session), 0x11);
+    expect_nrc(&ctx, seed, sizeof(seed), 0x11);
+    expect_nrc(&ctx, periodic, sizeof(periodic), 0x11);
+    expect_nrc(&ctx, download, sizeof(download), 0x11);
+}
+
+static int user_session_control(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    ctx->config->tx_buffer[0] = 0x50;
+    ctx->config->tx_buffer[1] = data[1];
+    return uds_send_response(ctx, 2);
+}
+
+static void test_user_service_replaces_stripped_one(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    static const uds_service_entry_t services[] = {
+        {0x10, 2, UDS_SESSION_ALL, 0, user_session_control, NULL},
+    };
+    setup_minimal(&ctx, &cfg);
+    cfg.user_services = services;
+    cfg.user_service_count = 1;
+
+    uint8_t session[] = {0x10, 0x01};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 2);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, session, sizeof(session));
+    assert_int_equal(g_tx_buf[0], 0x50);
+}
+
+static void test_process_without_periodic_scheduler(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_minimal(&ctx, &cfg);
+
+    will_return(mock_get_time, 1000);
+    uds_process(&ctx);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_enabled_services_respond),
+        cmocka_unit_test(test_stripped_services_not_supported),
+        cmocka_unit_test(test_user_service_replaces_stripped_one),
+        cmocka_unit_test(test_process_without_periodic_scheduler),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_multi_tester.c
+ * @brief Unit tests for per-tester session state (multiple concurrent testers)
+ */
+
+#include "test_helpers.h"
+
+#define TESTER_A 0x0E80u
+#define TESTER_B 0x0F10u
+#define TESTER_C 0x0F20u
+
+static uint16_t g_sent_addr[8];
+static uint8_t g_sent_nrc[8];
+static uint8_t g_sent_count;
+
+static int mock_multi_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    if (g_sent_count < 8u) {
+        g_sent_addr[g_sent_count] = ctx->tester_addr;
+        g_sent_nrc[g_sent_count] = (data[0] == 0x7Fu && len >= 3u) ? data[2] : 0u;
+        g_sent_count++;
+    }
+    return 0;
+}
+
+static int mock_pending_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    return UDS_PENDING;
+}
+
+static const uds_service_entry_t g_async_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, mock_pending_handler, NULL},
+};
+
+static void setup_multi(uds_ctx_t *ctx, uds_config_t *cfg, uds_tester_state_t *states,
+                        uint8_t count)
+{
+    memset(states, 0, sizeof(uds_tester_state_t) * count);
+    memset(g_sent_addr, 0, sizeof(g_sent_addr));
+    memset(g_sent_nrc, 0, sizeof(g_sent_nrc));
+    g_sent_count = 0;
+
+    setup_ctx(ctx, cfg);
+    cfg->fn_tp_send = mock_multi_tp_send;
+    cfg->tester_states = states;
+    cfg->tester_state_count = count;
+}
+
+static void test_independent_sessions(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    setup_multi(&ctx, &cfg, states, 2);
+
+    uint8_t extended[] = {0x10, 0x03};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(&ctx, TESTER_A, extended, sizeof(extended));
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1010);
+    will_return(mock_get_time, 1010);
+    uds_input_sdu_from(&ctx, TESTER_B, tester_present, sizeof(tester_present));
+
+    /* Each response went back to its own tester */
+    assert_int_equal(g_sent_count, 2);
+    assert_int_equal(g_sent_addr[0], TESTER_A);
+    assert_int_equal(g_sent_addr[1], TESTER_B);
+
+    /* Tester B did not inherit the extended session of tester A */
+    assert_int_equal(ctx.active_session, 0x01);
+    assert_int_equal(uds_select_tester(&ctx, TESTER_A), UDS_OK);
+    assert_int_equal(ctx.active_session, 0x03);
+    assert_int_equal(ctx.tester_addr, TESTER_A);
+
+    assert_int_equal(uds_select_tester(&ctx, TESTER_C), UDS_ERR_INVALID_ARG);
+}
+
+static void test_pending_tester_does_not_block_others(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    setup_multi(&ctx, &cfg, states, 2);
+    cfg.user_services = g_async_services;
+    cfg.user_service_count = 1;
+
+    /* Tester A starts a long routine: immediate NRC 0x78 */
+    uint8_t routine[] = {0x31, 0x01, 0xFF, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(&ctx, TESTER_A, routine, sizeof(routine));
+
+    /* Tester B is served normally instead of getting NRC 0x21 */
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1010);
+    will_return(mock_get_time, 1010);
+    uds_input_sdu_from(&ctx, TESTER_B, tester_present, sizeof(tester_present));
+    assert_int_equal(g_sent_addr[1], TESTER_B);
+    assert_int_equal(g_sent_nrc[1], 0x00);
+
+    /* A new request from tester A is still busy */
+    will_return(mock_get_time, 1020);
+    uds_input_sdu_from(&ctx, TESTER_A, tester_present, sizeof(tester_present));
+    assert_int_equal(g_sent_addr[2], TESTER_A);
+    assert_int_equal(g_sent_nrc[2], 0x21);
+
+    /* P2* expiry of tester A is handled while tester B is loaded */
+    uds_select_tester(&ctx, TESTER_B);
+    ctx.p2_star_ms = 100;
+    will_return(mock_get_time, 1100);
+    uds_process(&ctx);
+    assert_int_equal(g_sent_count, 4);
+    assert_int_equal(g_sent_addr[3], TESTER_A);
+    assert_int_equal(g_sent_nrc[3], 0x78);
+    assert_int_equal(ctx.tester_addr, TESTER_B);
+    assert_false(ctx.p2_msg_pending);
+
+    /* Application completes the routine for tester A */
+    assert_int_equal(uds_select_tester(&ctx, TESTER_A), UDS_OK);
+    assert_true(ctx.p2_msg_pending);
+    g_tx_buf[0] = 0x71;
+    assert_int_equal(uds_send_response(&ctx, 1), 0);
+    assert_int_equal(g_sent_addr[4], TESTER_A);
+    assert_false(ctx.p2_msg_pending);
+}
+
+static int g_lock_depth;
+
+static void count_lock(void *handle)
+{
+    (void) handle;
+    g_lock_depth++;
+}
+
+static void count_unlock(void *handle)
+{
+    (void) handle;
+    assert_true(g_lock_depth > 0);
+    g_lock_depth--;
+}
+
+static void test_complete_for_tester(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    setup_multi(&ctx, &cfg, states, 2);
+    cfg.user_services = g_async_services;
+    cfg.user_service_count = 1;
+    cfg.fn_mutex_lock = count_lock;
+    cfg.fn_mutex_unlock = count_unlock;
+    g_lock_depth = 0;
+
+    uint8_t routine[] = {0x31, 0x01, 0xFF, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(&ctx, TESTER_A, routine, sizeof(routine));
+
+    /* Tester B is loaded and its response left in the tx_buffer */
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1010);
+    will_return(mock_get_time, 1010);
+    uds_input_sdu_from(&ctx, TESTER_B, tester_present, sizeof(tester_present));
+    assert_int_equal(ctx.tester_addr, TESTER_B);
+
+    /* Not pending, or not connected */
+    const uint8_t response[] = {0x71, 0x01, 0xFF, 0x00, 0x00};
+    assert_int_equal(uds_complete_for_tester(&ctx, TESTER_B, response, sizeof(response)),
+                     UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_complete_for_tester(&ctx, TESTER_C, response, sizeof(response)),
+                     UDS_ERR_INVALID_ARG);
+
+    assert_int_equal(uds_complete_for_tester(&ctx, TESTER_A, response, sizeof(response)), 0);
+    assert_int_equal(g_sent_count, 3);
+    assert_int_equal(g_sent_addr[2], TESTER_A);
+    assert_memory_equal(g_tx_buf, response, sizeof(response));
+    assert_false(ctx.p2_msg_pending);
+    assert_int_equal(g_lock_depth, 0);
+
+    /* Negative completion */
+    will_return(mock_get_time, 1020);
+    will_return(mock_get_time, 1020);
+    will_return(mock_get_time, 1020);
+    uds_input_sdu_from(&ctx, TESTER_A, routine, sizeof(routine));
+    const uint8_t nrc[] = {0x7F, 0x31, 0x22};
+    assert_int_equal(uds_complete_for_tester(&ctx, TESTER_A, nrc, sizeof(nrc)), 0);
+    assert_int_equal(g_sent_nrc[4], 0x22);
+    assert_false(ctx.p2_msg_pending);
+}
+
+static void test_busy_when_entries_exhausted(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[1];
+    setup_multi(&ctx, &cfg, states, 1);
+
+    uint8_t extended[] = {0x10, 0x03};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(&ctx, TESTER_A, extended, sizeof(extended));
+
+    /* Tester A is in a non-default session: tester B cannot take its entry */
+    uint8_t tester_present[] = {0x3E, 0x00};
+    uds_input_sdu_from(&ctx, TESTER_B, tester_present, sizeof(tester_present));
+    assert_int_equal(g_sent_addr[1], TESTER_B);
+    assert_int_equal(g_sent_nrc[1], 0x21);
+
+    /* Tester A's state is untouched */
+    assert_int_equal(ctx.tester_addr, TESTER_A);
+    assert_int_equal(ctx.active_session, 0x03);
+    assert_int_equal(ctx.last_msg_time, 1000);
+}
+
+static void test_idle_tester_evicted(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    setup_multi(&ctx, &cfg, states, 2);
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(&ctx, TESTER_A, tester_present, sizeof(tester_present));
+    will_return(mock_get_time, 2000);
+    will_return(mock_get_time, 2000);
+    uds_input_sdu_from(&ctx, TESTER_B, tester_present, sizeof(tester_present));
+
+    /* Both entries used and idle: tester C replaces the least recently used one (A) */
+    will_return(mock_get_time, 3000);
+    will_return(mock_get_time, 3000);
+    uds_input_sdu_from(&ctx, TESTER_C, tester_present, sizeof(tester_present));
+    assert_int_equal(g_sent_addr[2], TESTER_C);
+    assert_int_equal(g_sent_nrc[2], 0x00);
+
+    assert_int_equal(uds_select_tester(&ctx, TESTER_A), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_select_tester(&ctx, TESTER_B), UDS_OK);
+}
+
+static void test_s3_timeout_per_tester(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    setup_multi(&ctx, &cfg, states, 2);
+
+    uint8_t extended[] = {0x10, 0x03};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(&ctx, TESTER_A, extended, sizeof(extended));
+    will_return(mock_get_time, 4000);
+    will_return(mock_get_time, 4000);
+    uds_input_sdu_from(&ctx, TESTER_B, extended, sizeof(extended));
+
+    /* Only tester A has been silent for longer than S3 */
+    will_return(mock_get_time, 6001);
+    uds_process(&ctx);
+
+    assert_int_equal(uds_select_tester(&ctx, TESTER_A), UDS_OK);
+    assert_int_equal(ctx.active_session, 0x01);
+    assert_int_equal(uds_select_tester(&ctx, TESTER_B), UDS_OK);
+    assert_int_equal(ctx.active_session, 0x03);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_independent_sessions),
+        cmocka_unit_test(test_pending_tester_does_not_block_others),
+        cmocka_unit_test(test_complete_for_tester),
+        cmocka_unit_test(test_busy_when_entries_exhausted),
+        cmocka_unit_test(test_idle_tester_evicted),
+        cmocka_unit_test(test_s3_timeout_per_tester),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_nvm_journal.c
+ * @brief Unit tests for the DTC status journal (replay, compaction, damaged records)
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_nvm_journal.h"
+#ifdef UDS_TEST_POSIX_NVM
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "uds/uds_posix_nvm.h"
+#endif
+
+#define DTC_COUNT 40u
+#define SECTOR 512u
+
+/* RAM flash with NOR semantics; writes fail once the byte budget is spent */
+static uint8_t g_flash[2u * SECTOR];
+static int32_t g_write_budget;
+static uds_nvm_flash_t g_hooks;
+
+static uint32_t g_codes[DTC_COUNT];
+static uint8_t g_status[DTC_COUNT];
+static uint32_t g_bits[UDS_DTC_BITS_WORDS(DTC_COUNT)];
+static uint8_t g_occurrences[DTC_COUNT];
+static uint8_t g_pool[64];
+static const uint16_t g_dids[] = {0xF190};
+static uds_dtc_records_t g_records;
+static uds_dtc_store_t g_store;
+static uds_nvm_journal_t g_journal;
+
+static int ram_read(void *dev, uint32_t addr, uint8_t *buf, uint16_t len)
+{
+    (void) dev;
+    if (addr + len > sizeof(g_flash)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    memcpy(buf, &g_flash[addr], len);
+    return UDS_OK;
+}
+
+static int ram_write(void *dev, uint32_t addr, const uint8_t *data, uint16_t len)
+{
+    (void) dev;
+    if (addr + len > sizeof(g_flash)) {
+        return UDS_ERR_INVALID_ARG;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        if (g_write_budget == 0) {
+            return UDS_ERR_INVALID_ARG; /* Power cut: the rest is not programmed */
+        }
+        if (g_write_budget > 0) {
+            g_write_budget--;
+        }
+        g_flash[addr + i] &= data[i];
+    }
+    return UDS_OK;
+}
+
+static int ram_erase(void *dev, uint32_t addr)
+{
+    (void) dev;
+    memset(&g_flash[addr], 0xFF, SECTOR);
+    return UDS_OK;
+}
+
+static uint32_t code_of(uint32_t i)
+{
+    return 0x200000u + i;
+}
+
+/* Power-up: an empty store, then whatever the journal holds */
+static int boot(void)
+{
+    uds_dtc_init(&g_store, g_codes, g_status, g_bits, DTC_COUNT);
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        assert_int_equal(uds_dtc_add(&g_store, code_of(i)), UDS_OK);
+    }
+    memset(g_occurrences, 0, sizeof(g_occurrences));
+    uds_dtc_records_init(&g_records, g_dids, 1, g_pool, sizeof(g_pool), g_occurrences);
+    g_records.trigger_mask = 0x00u; /* Occurrence counters only */
+    g_store.records = &g_records;
+    uds_nvm_journal_init(&g_journal, &g_hooks);
+    g_store.journal = &g_journal;
+    return uds_nvm_journal_restore(&g_store);
+}
+
+static void setup_journal(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    setup_ctx(ctx, cfg);
+    memset(g_flash, 0xFF, sizeof(g_flash));
+    g_write_budget = -1;
+    g_hooks.fn_read = ram_read;
+    g_hooks.fn_write = ram_write;
+    g_hooks.fn_erase = ram_erase;
+    g_hooks.dev = NULL;
+    g_hooks.sector_size = SECTOR;
+    assert_int_equal(boot(), UDS_OK);
+    cfg->dtc_store = &g_store;
+}
+
+static void set_status(uds_ctx_t *ctx, uint32_t i, uint8_t status)
+{
+    assert_int_equal(uds_dtc_set_status(ctx, code_of(i), status), UDS_OK);
+}
+
+static uint8_t status_of(uds_ctx_t *ctx, uint32_t i)
+{
+    uint8_t status = 0xAA;
+    assert_int_equal(uds_dtc_get_status(ctx, code_of(i), &status), UDS_OK);
+    return status;
+}
+
+/* 0x19 0x01: DTCs matching mask, counted from the bit planes */
+static uint16_t count_by_mask(uds_ctx_t *ctx, uint8_t mask)
+{
+    const uint8_t req[] = {0x19, 0x01, mask};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 6);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, sizeof(req));
+    return (uint16_t) ((g_tx_buf[4] << 8) | g_tx_buf[5]);
+}
+
+static uds_job_t *g_submitted;
+
+static int manual_submit(void *executor, uds_job_t *job)
+{
+    (void) executor;
+    g_submitted = job;
+    return 0;
+}
+
+static void process(uds_ctx_t *ctx)
+{
+    will_return(mock_get_time, 1000);
+    uds_process(ctx);
+}
+
+static void test_blank_flash_formats(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+
+    /* Sector 0 gets a header and a checkpoint of the registered DTCs */
+    assert_int_equal(g_journal.compactions, 1);
+    assert_int_equal(g_journal.active, 0);
+    assert_int_equal(g_journal.seq, 1);
+    assert_int_equal(g_journal.pos,
+                     UDS_NVM_JOURNAL_HEADER + UDS_NVM_JOURNAL_CHECKPOINT(DTC_COUNT));
+    assert_int_equal(g_flash[0], 0x01);
+    assert_int_equal(g_flash[SECTOR], 0xFF);
+
+    /* A sector that cannot hold a checkpoint and the reserve is refused */
+    g_hooks.sector_size = 128u;
+    assert_int_equal(boot(), UDS_ERR_BUFFER_TOO_SMALL);
+}
+
+static void test_status_survives_restart(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+    uint32_t start = g_journal.pos;
+
+    set_status(&ctx, 3, 0x09);
+    set_status(&ctx, 3, 0x08);
+    set_status(&ctx, 3, 0x09); /* Second occurrence */
+    set_status(&ctx, 7, 0x24);
+    set_status(&ctx, 7, 0x24); /* No change, no record */
+    assert_int_equal(g_journal.appended, 4);
+    assert_int_equal(g_journal.pos, start + (4 * UDS_NVM_JOURNAL_RECORD));
+
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(g_journal.replayed, 4);
+    assert_int_equal(g_journal.compactions, 0);
+    assert_int_equal(status_of(&ctx, 3), 0x09);
+    assert_int_equal(status_of(&ctx, 7), 0x24);
+    assert_int_equal(status_of(&ctx, 8), 0x00);
+    assert_int_equal(g_occurrences[3], 2);
+    assert_int_equal(g_occurrences[7], 0);
+
+    /* Bit planes are rebuilt too */
+    assert_int_equal(count_by_mask(&ctx, 0x08), 1);
+    assert_int_equal(count_by_mask(&ctx, 0x24), 1);
+
+    /* Appends continue after the replayed records */
+    set_status(&ctx, 8, 0x01);
+    assert_int_equal(g_journal.pos, start + (5 * UDS_NVM_JOURNAL_RECORD));
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(status_of(&ctx, 8), 0x01);
+}
+
+static void test_clear_is_one_record(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        set_status(&ctx, i, 0x09);
+    }
+    uint32_t before = g_journal.pos;
+
+    const uint8_t req[] = {0x14, 0xFF, 0xFF, 0xFF};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 1);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, req, sizeof(req));
+    assert_int_equal(g_journal.pos, before + 5u);
+
+    assert_int_equal(boot(), UDS_OK);
+    for (uint32_t i = 0u; i < DTC_COUNT; i++) {
+        assert_int_equal(status_of(&ctx, i), UDS_DTC_STATUS_CLEARED);
+        assert_int_equal(g_occurrences[i], 0);
+    }
+}
+
+static void test_background_compaction(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+
+    /* Toggle statuses until the free space drops below the reserve */
+    uint32_t n = 0u;
+    while (!g_journal.compact_due) {
+        set_status(&ctx, n % DTC_COUNT, (uint8_t) (0x08u | ((n / DTC_COUNT) & 1u)));
+        n++;
+    }
+    assert_true(SECTOR - g_journal.pos < g_journal.reserve);
+    assert_int_equal(g_journal.active, 0);
+
+    process(&ctx);
+    assert_false(g_journal.compact_due);
+    assert_int_equal(g_journal.active, 1);
+    assert_int_equal(g_journal.seq, 2);
+    assert_int_equal(g_journal.compactions, 2);
+    assert_int_equal(g_journal.pos,
+                     UDS_NVM_JOURNAL_HEADER + UDS_NVM_JOURNAL_CHECKPOINT(DTC_COUNT));
+
+    set_status(&ctx, 0, 0x2F);
+    uint8_t expect[DTC_COUNT];
+    memcpy(expect, g_status, sizeof(expect));
+    uint8_t occurrences[DTC_COUNT];
+    memcpy(occurrences, g_occurrences, sizeof(occurrences));
+
+    /* The newer sector wins; the old one is not erased until the next compaction */
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(g_journal.active, 1);
+    assert_int_equal(g_journal.replayed, 1);
+    assert_memory_equal(g_status, expect, sizeof(expect));
+    assert_memory_equal(g_occurrences, occurrences, sizeof(occurrences));
+}
+
+static void test_compaction_erase_on_executor(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+    cfg.fn_job_submit = manual_submit;
+    g_submitted = NULL;
+
+    uint32_t n = 0u;
+    while (!g_journal.compact_due) {
+        set_status(&ctx, n % DTC_COUNT, (uint8_t) (0x08u | ((n / DTC_COUNT) & 1u)));
+        n++;
+    }
+
+    /* uds_process() only hands the erase to the executor */
+    memset(&g_flash[SECTOR], 0x00, SECTOR);
+    process(&ctx);
+    assert_non_null(g_submitted);
+    assert_true(g_journal.erasing);
+    assert_int_equal(g_flash[SECTOR], 0x00);
+    assert_int_equal(g_journal.compactions, 1);
+    assert_int_equal(uds_nvm_journal_compact(&g_store), UDS_ERR_BUSY);
+
+    /* Changes made during the erase still land in the old sector and the checkpoint */
+    set_status(&ctx, 0, 0x2F);
+    process(&ctx);
+    assert_int_equal(g_journal.compactions, 1);
+
+    uds_job_execute(g_submitted);
+    assert_false(g_journal.erasing);
+    assert_false(g_journal.compact_due);
+    assert_int_equal(g_journal.active, 1);
+    assert_int_equal(g_journal.compactions, 2);
+    assert_int_equal(g_journal.pos,
+                     UDS_NVM_JOURNAL_HEADER + UDS_NVM_JOURNAL_CHECKPOINT(DTC_COUNT));
+
+    uint8_t expect[DTC_COUNT];
+    memcpy(expect, g_status, sizeof(expect));
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(g_journal.active, 1);
+    assert_int_equal(g_journal.replayed, 0);
+    assert_memory_equal(g_status, expect, sizeof(expect));
+    assert_int_equal(g_status[0], 0x2F);
+}
+
+static void test_torn_append(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+
+    set_status(&ctx, 1, 0x01);
+    set_status(&ctx, 2, 0x01);
+    uint32_t good = g_journal.pos;
+
+    /* Reset in the middle of the third record */
+    g_write_budget = 6;
+    set_status(&ctx, 4, 0x01);
+    assert_int_equal(g_journal.errors, 1);
+    assert_true(g_journal.compact_due);
+    assert_int_equal(g_flash[good], 0x03);
+
+    /* Recovery stops at the damaged record and moves to the other sector */
+    g_write_budget = -1;
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(g_journal.replayed, 2);
+    assert_int_equal(g_journal.active, 1);
+    assert_int_equal(status_of(&ctx, 1), 0x01);
+    assert_int_equal(status_of(&ctx, 2), 0x01);
+    assert_int_equal(status_of(&ctx, 4), 0x00);
+
+    /* A bit flipped in a record fails its CRC the same way */
+    set_status(&ctx, 5, 0x01);
+    set_status(&ctx, 6, 0x01);
+    g_flash[SECTOR + g_journal.pos - UDS_NVM_JOURNAL_RECORD + 5] ^= 0x01;
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(status_of(&ctx, 5), 0x01);
+    assert_int_equal(status_of(&ctx, 6), 0x00);
+}
+
+static void test_interrupted_compaction(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+
+    uint32_t n = 0u;
+    while (!g_journal.compact_due) {
+        set_status(&ctx, n % DTC_COUNT, (uint8_t) (0x08u | ((n / DTC_COUNT) & 1u)));
+        n++;
+    }
+    uint8_t expect[DTC_COUNT];
+    memcpy(expect, g_status, sizeof(expect));
+
+    /* Reset after the new header, in the middle of the checkpoint */
+    g_write_budget = UDS_NVM_JOURNAL_HEADER + 20;
+    process(&ctx);
+    assert_int_equal(g_journal.errors, 1);
+    assert_true(g_journal.compact_due);
+    assert_int_equal(g_journal.active, 0);
+    assert_int_equal(g_flash[SECTOR], 0x01);
+
+    /* The newer sector has no complete checkpoint: the old log is replayed */
+    g_write_budget = -1;
+    assert_int_equal(boot(), UDS_OK);
+    assert_memory_equal(g_status, expect, sizeof(expect));
+    assert_int_equal(g_journal.replayed, n);
+    assert_int_equal(g_journal.active, 1);
+    assert_int_equal(g_journal.seq, 2);
+}
+
+#ifdef UDS_TEST_POSIX_NVM
+static void test_posix_file(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_journal(&ctx, &cfg);
+    char path[] = "/tmp/uds_journal_XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    close(fd);
+
+    static uds_posix_nvm_t file;
+    assert_int_equal(uds_posix_nvm_open(&file, path, 1024u), UDS_OK);
+    g_hooks = file.flash;
+    assert_int_equal(boot(), UDS_OK);
+    set_status(&ctx, 9, 0x2F);
+    set_status(&ctx, 10, 0x01);
+    uds_posix_nvm_close(&file);
+
+    assert_int_equal(uds_posix_nvm_open(&file, path, 1024u), UDS_OK);
+    g_hooks = file.flash;
+    assert_int_equal(boot(), UDS_OK);
+    assert_int_equal(g_journal.replayed, 2);
+    assert_int_equal(status_of(&ctx, 9), 0x2F);
+    assert_int_equal(status_of(&ctx, 10), 0x01);
+    assert_int_equal(g_occurrences[9], 1);
+    uds_posix_nvm_close(&file);
+    unlink(path);
+}
+#endif
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_blank_flash_formats),
+        cmocka_unit_test(test_status_survives_restart),
+        cmocka_unit_test(test_clear_is_one_record),
+        cmocka_unit_test(test_background_compaction),
+        cmocka_unit_test(test_compaction_erase_on_executor),
+        cmocka_unit_test(test_torn_append),
+        cmocka_unit_test(test_interrupted_compaction),
+#ifdef UDS_TEST_POSIX_NVM
+        cmocka_unit_test(test_posix_file),
+#endif
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_posix_executor.c
+ * @brief Unit tests for the POSIX thread pool job executor
+ */
+
+#include <time.h>
+
+#include "test_helpers.h"
+#include "uds/uds_posix_executor.h"
+
+static pthread_mutex_t g_ctx_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int g_responses;
+static volatile uint8_t g_last_sid;
+
+static uint32_t fixed_time(void)
+{
+    return 1000u;
+}
+
+static void ctx_lock(void *handle)
+{
+    pthread_mutex_lock((pthread_mutex_t *) handle);
+}
+
+static void ctx_unlock(void *handle)
+{
+    pthread_mutex_unlock((pthread_mutex_t *) handle);
+}
+
+static int record_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) len;
+    /* Called with the context lock held */
+    if (data[0] != 0x7Fu) {
+        g_last_sid = data[0];
+        g_responses++;
+    }
+    return 0;
+}
+
+static int slow_work(uds_job_t *job)
+{
+    struct timespec delay = {0, 5 * 1000 * 1000};
+    nanosleep(&delay, NULL);
+    *(int *) job->user_data += 1;
+    return UDS_OK;
+}
+
+static int g_work_count;
+static uds_job_t g_job = {slow_work, NULL, &g_work_count, NULL, 0, 0, 0};
+
+static int job_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    return uds_submit_job(ctx, data[0], &g_job);
+}
+
+static const uds_service_entry_t g_job_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, job_handler, NULL},
+};
+
+static int wait_responses(int expected)
+{
+    for (int i = 0; i < 2000; i++) {
+        pthread_mutex_lock(&g_ctx_lock);
+        int done = g_responses;
+        pthread_mutex_unlock(&g_ctx_lock);
+        if (done >= expected) {
+            return done;
+        }
+        struct timespec delay = {0, 1000 * 1000};
+        nanosleep(&delay, NULL);
+    }
+    return g_responses;
+}
+
+static void test_pool_runs_job_off_dispatch_thread(void **state)
+{
+    (void) state;
+    uds_posix_executor_t pool;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+
+    assert_int_equal(uds_posix_executor_init(&pool, 2), UDS_OK);
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.get_time_ms = fixed_time;
+    cfg.fn_tp_send = record_tp_send;
+    cfg.rx_buffer = g_rx_buf;
+    cfg.rx_buffer_size = sizeof(g_rx_buf);
+    cfg.tx_buffer = g_tx_buf;
+    cfg.tx_buffer_size = sizeof(g_tx_buf);
+    cfg.user_services = g_job_services;
+    cfg.user_service_count = 1;
+    cfg.mutex_handle = &g_ctx_lock;
+    cfg.fn_mutex_lock = ctx_lock;
+    cfg.fn_mutex_unlock = ctx_unlock;
+    cfg.fn_job_submit = uds_posix_executor_submit;
+    cfg.job_executor = &pool;
+    uds_init(&ctx, &cfg);
+
+    uint8_t routine[] = {0x31, 0x01, 0xFF, 0x00};
+    for (int round = 1; round <= 3; round++) {
+        uds_input_sdu(&ctx, routine, sizeof(routine));
+        assert_int_equal(wait_responses(round), round);
+        assert_int_equal(g_last_sid, 0x71);
+    }
+
+    uds_posix_executor_shutdown(&pool);
+    assert_int_equal(g_work_count, 3);
+    assert_false(ctx.p2_msg_pending);
+}
+
+static void test_pool_rejects_invalid_args(void **state)
+{
+    (void) state;
+    uds_posix_executor_t pool;
+    assert_int_equal(uds_posix_executor_init(&pool, 0), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_posix_executor_init(&pool, UDS_POSIX_EXECUTOR_MAX_THREADS + 1u),
+                     UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_posix_executor_submit(NULL, &g_job), UDS_ERR_INVALID_ARG);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_pool_runs_job_off_dispatch_thread),
+        cmocka_unit_test(test_pool_rejects_invalid_args),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -88,10 +88,82 @@ static void test_core_rcrrp_limit(void **state)
     assert_false(ctx.p2_msg_pending);
 }
 
+static int g_lock_depth;
+static int g_lock_calls;
+
+static void count_lock(void *handle)
+{
+    (void) handle;
+    assert_int_equal(g_lock_depth, 0); /* Not recursive */
+    g_lock_depth++;
+    g_lock_calls++;
+}
+
+static void count_unlock(void *handle)
+{
+    (void) handle;
+    assert_int_equal(g_lock_depth, 1);
+    g_lock_depth--;
+}
+
+static void test_rcrrp_abort_releases_lock(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uint8_t rx_buf[256];
+    uint8_t tx_buf[256];
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.get_time_ms = mock_get_time;
+    cfg.fn_tp_send = mock_tp_send;
+    cfg.rx_buffer = rx_buf;
+    cfg.rx_buffer_size = sizeof(rx_buf);
+    cfg.tx_buffer = tx_buf;
+    cfg.tx_buffer_size = sizeof(tx_buf);
+    cfg.p2_ms = 50;
+    cfg.p2_star_ms = 100;
+    cfg.rcrrp_limit = 1;
+    cfg.fn_mutex_lock = count_lock;
+    cfg.fn_mutex_unlock = count_unlock;
+
+    static const uds_service_entry_t services[] = {
+        {0x99, 1, UDS_SESSION_ALL, 0, mock_pending_handler, NULL}};
+    cfg.user_services = services;
+    cfg.user_service_count = 1;
+
+    g_lock_depth = 0;
+    g_lock_calls = 0;
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_OK);
+
+    uint8_t req[] = {0x99};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any_count(mock_tp_send, data, 3);
+    expect_value_count(mock_tp_send, len, 3, 3);
+    will_return_count(mock_tp_send, 0, 3);
+    uds_input_sdu(&ctx, req, 1);
+
+    will_return(mock_get_time, 1110); /* Repeated 0x78 */
+    uds_process(&ctx);
+    will_return(mock_get_time, 1220); /* Limit reached: 0x22 aborts the request */
+    uds_process(&ctx);
+    assert_int_equal(g_tx_buf[2], 0x22);
+    assert_false(ctx.p2_msg_pending);
+
+    /* Every uds_process() after the abort takes and releases the lock again */
+    will_return(mock_get_time, 1230);
+    uds_process(&ctx);
+    assert_int_equal(g_lock_depth, 0);
+    assert_int_equal(g_lock_calls, 4);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_core_rcrrp_limit),
+        cmocka_unit_test(test_rcrrp_abort_releases_lock),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
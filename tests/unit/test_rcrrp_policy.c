@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_rcrrp_policy.c
+ * @brief Unit tests for deferred and adaptive NRC 0x78 transmission
+ */
+
+#include "test_helpers.h"
+
+static uint8_t g_sent_nrc[8];
+static uint8_t g_sent_count;
+
+static int mock_rcrrp_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    if (g_sent_count < 8u) {
+        g_sent_nrc[g_sent_count] = (data[0] == 0x7Fu && len >= 3u) ? data[2] : 0u;
+        g_sent_count++;
+    }
+    return 0;
+}
+
+static int mock_pending_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    return UDS_PENDING;
+}
+
+static const uds_service_entry_t g_async_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, mock_pending_handler, NULL},
+};
+
+static const uint8_t g_routine[] = {0x31, 0x01, 0xFF, 0x00};
+
+static void setup_rcrrp(uds_ctx_t *ctx, uds_config_t *cfg, uint8_t policy)
+{
+    memset(g_sent_nrc, 0, sizeof(g_sent_nrc));
+    g_sent_count = 0;
+
+    setup_ctx(ctx, cfg);
+    cfg->fn_tp_send = mock_rcrrp_tp_send;
+    cfg->user_services = g_async_services;
+    cfg->user_service_count = 1;
+    cfg->rcrrp_policy = policy;
+    cfg->rcrrp_margin_ms = 10;
+}
+
+static void complete_routine(uds_ctx_t *ctx)
+{
+    g_tx_buf[0] = 0x71;
+    uds_send_response(ctx, 1);
+}
+
+static void test_deferred_sends_0x78_before_p2(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_rcrrp(&ctx, &cfg, UDS_RCRRP_POLICY_DEFERRED);
+
+    /* No immediate NRC 0x78 and no extra time read */
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    assert_int_equal(g_sent_count, 0);
+    assert_true(ctx.p2_msg_pending);
+    assert_false(ctx.p2_star_active);
+
+    will_return(mock_get_time, 1039);
+    uds_process(&ctx);
+    assert_int_equal(g_sent_count, 0);
+
+    /* P2 (50 ms) minus margin (10 ms) reached */
+    will_return(mock_get_time, 1040);
+    uds_process(&ctx);
+    assert_int_equal(g_sent_count, 1);
+    assert_int_equal(g_sent_nrc[0], 0x78);
+    assert_true(ctx.p2_star_active);
+    assert_int_equal(ctx.p2_timer_start, 1040);
+}
+
+static void test_deferred_fast_completion_sends_no_0x78(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_rcrrp(&ctx, &cfg, UDS_RCRRP_POLICY_DEFERRED);
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+
+    will_return(mock_get_time, 1002);
+    uds_process(&ctx);
+    complete_routine(&ctx);
+
+    /* Only the final positive response went on the bus */
+    assert_int_equal(g_sent_count, 1);
+    assert_int_equal(g_sent_nrc[0], 0x00);
+    assert_false(ctx.p2_msg_pending);
+}
+
+static void test_adaptive_learns_slow_sid(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_rcrrp(&ctx, &cfg, UDS_RCRRP_POLICY_ADAPTIVE);
+
+    /* First request: unknown SID, deferred 0x78, completes after 500 ms */
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    will_return(mock_get_time, 1040);
+    uds_process(&ctx);
+    assert_int_equal(g_sent_nrc[0], 0x78);
+
+    will_return(mock_get_time, 1500);
+    complete_routine(&ctx);
+    assert_int_equal(ctx.latency_sid[0], 0x31);
+    assert_int_equal(ctx.latency_ms[0], 500);
+
+    /* Second request: known to be slow, NRC 0x78 goes out immediately */
+    will_return(mock_get_time, 2000);
+    will_return(mock_get_time, 2000);
+    will_return(mock_get_time, 2000);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    assert_int_equal(g_sent_count, 3);
+    assert_int_equal(g_sent_nrc[2], 0x78);
+    assert_true(ctx.p2_star_active);
+}
+
+static void test_adaptive_keeps_fast_sid_deferred(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_rcrrp(&ctx, &cfg, UDS_RCRRP_POLICY_ADAPTIVE);
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    will_return(mock_get_time, 1008);
+    complete_routine(&ctx);
+    assert_int_equal(ctx.latency_ms[0], 8);
+
+    /* Moving average: (8 + (16 - 8) / 4) = 10 ms, still below the deferred window */
+    will_return(mock_get_time, 2000);
+    will_return(mock_get_time, 2000);
+    uds_input_sdu(&ctx, g_routine, sizeof(g_routine));
+    assert_false(ctx.p2_star_active);
+    will_return(mock_get_time, 2016);
+    complete_routine(&ctx);
+    assert_int_equal(ctx.latency_ms[0], 10);
+
+    assert_int_equal(g_sent_count, 2);
+    assert_int_equal(g_sent_nrc[0], 0x00);
+    assert_int_equal(g_sent_nrc[1], 0x00);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_deferred_sends_0x78_before_p2),
+        cmocka_unit_test(test_deferred_fast_completion_sends_no_0x78),
+        cmocka_unit_test(test_adaptive_learns_slow_sid),
+        cmocka_unit_test(test_adaptive_keeps_fast_sid_deferred),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_request_queue.c
+ * @brief Unit tests for the bounded request queue (busy handling policies)
+ */
+
+#include "test_helpers.h"
+
+#define QUEUE_DEPTH 2u
+#define QUEUE_SLOT 8u
+
+static uint8_t g_queue_buf[UDS_QUEUE_BUFFER_SIZE(QUEUE_DEPTH, QUEUE_SLOT)];
+
+static uint8_t g_sent_sid[8];
+static uint8_t g_sent_nrc[8];
+static uint8_t g_sent_count;
+
+static int mock_queue_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    if (g_sent_count < 8u) {
+        bool is_nrc = (data[0] == 0x7Fu) && (len >= 3u);
+        g_sent_sid[g_sent_count] = is_nrc ? data[1] : data[0];
+        g_sent_nrc[g_sent_count] = is_nrc ? data[2] : 0u;
+        g_sent_count++;
+    }
+    return 0;
+}
+
+static int mock_pending_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    return UDS_PENDING;
+}
+
+static const uds_service_entry_t g_async_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, mock_pending_handler, NULL},
+};
+
+static void setup_queue(uds_ctx_t *ctx, uds_config_t *cfg, uint8_t policy)
+{
+    memset(g_queue_buf, 0, sizeof(g_queue_buf));
+    memset(g_sent_sid, 0, sizeof(g_sent_sid));
+    memset(g_sent_nrc, 0, sizeof(g_sent_nrc));
+    g_sent_count = 0;
+
+    setup_ctx(ctx, cfg);
+    cfg->fn_tp_send = mock_queue_tp_send;
+    cfg->user_services = g_async_services;
+    cfg->user_service_count = 1;
+    cfg->queue_buffer = g_queue_buf;
+    cfg->queue_slot_size = QUEUE_SLOT;
+    cfg->queue_depth = QUEUE_DEPTH;
+    cfg->queue_policy = policy;
+}
+
+static void start_pending_routine(uds_ctx_t *ctx)
+{
+    uint8_t routine[] = {0x31, 0x01, 0xFF, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(ctx, routine, sizeof(routine));
+    assert_true(ctx->p2_msg_pending);
+}
+
+static void test_reject_policy_sends_busy(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_REJECT);
+    start_pending_routine(&ctx);
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1010);
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+
+    assert_int_equal(ctx.queue_count, 0);
+    assert_int_equal(g_sent_count, 2);
+    assert_int_equal(g_sent_sid[1], 0x3E);
+    assert_int_equal(g_sent_nrc[1], 0x21);
+}
+
+static void test_queued_request_drained_after_completion(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_QUEUE);
+    start_pending_routine(&ctx);
+
+    /* Queued silently instead of NRC 0x21 */
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1010);
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+    assert_int_equal(ctx.queue_count, 1);
+    assert_int_equal(g_sent_count, 1);
+
+    /* Still pending: nothing is dispatched */
+    will_return(mock_get_time, 1020);
+    uds_process(&ctx);
+    assert_int_equal(ctx.queue_count, 1);
+
+    /* Application completes the routine */
+    g_tx_buf[0] = 0x71;
+    uds_send_response(&ctx, 1);
+    assert_int_equal(g_sent_sid[1], 0x71);
+
+    /* Next tick dispatches the queued TesterPresent */
+    will_return(mock_get_time, 1030);
+    will_return(mock_get_time, 1030);
+    will_return(mock_get_time, 1030);
+    uds_process(&ctx);
+    assert_int_equal(ctx.queue_count, 0);
+    assert_int_equal(g_sent_count, 3);
+    assert_int_equal(g_sent_sid[2], 0x7E);
+    assert_int_equal(ctx.last_msg_time, 1030);
+}
+
+static void test_queued_requests_keep_arrival_order(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_QUEUE);
+    start_pending_routine(&ctx);
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1010);
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+
+    g_tx_buf[0] = 0x71;
+    uds_send_response(&ctx, 1);
+
+    /* A new request arriving before the next tick is served after the queued one */
+    uint8_t default_session[] = {0x10, 0x01};
+    will_return_count(mock_get_time, 1020, 4);
+    uds_input_sdu(&ctx, default_session, sizeof(default_session));
+
+    assert_int_equal(g_sent_count, 4);
+    assert_int_equal(g_sent_sid[2], 0x7E);
+    assert_int_equal(g_sent_sid[3], 0x50);
+}
+
+static void test_full_queue_rejects(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_QUEUE);
+    start_pending_routine(&ctx);
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return_count(mock_get_time, 1010, 3);
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+
+    assert_int_equal(ctx.queue_count, QUEUE_DEPTH);
+    assert_int_equal(g_sent_count, 2);
+    assert_int_equal(g_sent_nrc[1], 0x21);
+
+    /* Requests longer than a queue slot are rejected as well */
+    uint8_t routine_long[] = {0x31, 0x01, 0xFF, 0x00, 1, 2, 3, 4, 5};
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_QUEUE);
+    start_pending_routine(&ctx);
+    will_return(mock_get_time, 1010);
+    uds_input_sdu(&ctx, routine_long, sizeof(routine_long));
+    assert_int_equal(ctx.queue_count, 0);
+    assert_int_equal(g_sent_nrc[1], 0x21);
+}
+
+static void test_replace_same_sid(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_REPLACE_SAME_SID);
+    start_pending_routine(&ctx);
+
+    uint8_t extended[] = {0x10, 0x03};
+    uint8_t default_session[] = {0x10, 0x01};
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return_count(mock_get_time, 1010, 3);
+    uds_input_sdu(&ctx, extended, sizeof(extended));
+    uds_input_sdu(&ctx, default_session, sizeof(default_session));
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+
+    /* The second 0x10 replaced the first; 0x3E got its own entry */
+    assert_int_equal(ctx.queue_count, 2);
+    assert_int_equal(g_sent_count, 1);
+    assert_int_equal(g_queue_buf[UDS_QUEUE_SLOT_HEADER + 1u], 0x01);
+}
+
+static void test_busy_tester_does_not_block_others(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    setup_queue(&ctx, &cfg, UDS_QUEUE_POLICY_QUEUE);
+    memset(states, 0, sizeof(states));
+    cfg.tester_states = states;
+    cfg.tester_state_count = 2;
+    will_return_always(mock_get_time, 1000);
+
+    /* Both testers run a routine and queue a TesterPresent behind it: A first */
+    uint8_t routine[] = {0x31, 0x01, 0xFF, 0x00};
+    uint8_t tester_present[] = {0x3E, 0x00};
+    uds_input_sdu_from(&ctx, 0x0E80u, routine, sizeof(routine));
+    uds_input_sdu_from(&ctx, 0x0F10u, routine, sizeof(routine));
+    uds_input_sdu_from(&ctx, 0x0E80u, tester_present, sizeof(tester_present));
+    uds_input_sdu_from(&ctx, 0x0F10u, tester_present, sizeof(tester_present));
+    assert_int_equal(ctx.queue_count, 2);
+    assert_int_equal(g_sent_count, 2);
+
+    /* B's routine completes: its request is served although A's is older */
+    uint8_t done[] = {0x71, 0x01, 0xFF, 0x00};
+    assert_int_equal(uds_complete_for_tester(&ctx, 0x0F10u, done, sizeof(done)), UDS_OK);
+    uds_process(&ctx);
+    assert_int_equal(g_sent_count, 4);
+    assert_int_equal(g_sent_sid[3], 0x7E);
+    assert_int_equal(ctx.queue_count, 1);
+
+    /* A's request waited for A, then goes out */
+    assert_int_equal(uds_complete_for_tester(&ctx, 0x0E80u, done, sizeof(done)), UDS_OK);
+    uds_process(&ctx);
+    assert_int_equal(g_sent_count, 6);
+    assert_int_equal(g_sent_sid[5], 0x7E);
+    assert_int_equal(ctx.queue_count, 0);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_reject_policy_sends_busy),
+        cmocka_unit_test(test_queued_request_drained_after_completion),
+        cmocka_unit_test(test_queued_requests_keep_arrival_order),
+        cmocka_unit_test(test_full_queue_rejects),
+        cmocka_unit_test(test_replace_same_sid),
+        cmocka_unit_test(test_busy_tester_does_not_block_others),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
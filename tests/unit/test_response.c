@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_response.c
+ * @brief Unit tests for the zero-copy response writer
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_response.h"
+
+static uds_iovec_t g_iov[UDS_RESPONSE_MAX_SEGMENTS];
+static uint8_t g_iov_count;
+static uint16_t g_iov_len;
+static int g_sendv_calls;
+
+static int record_sendv(uds_ctx_t *ctx, const uds_iovec_t *iov, uint8_t count, uint16_t len)
+{
+    (void) ctx;
+    memcpy(g_iov, iov, (size_t) count * sizeof(iov[0]));
+    g_iov_count = count;
+    g_iov_len = len;
+    g_sendv_calls++;
+    return 0;
+}
+
+static uint8_t g_vin[17] = "WDB1234567890ABCD";
+static uint8_t g_flash[2048];
+
+static const uds_did_entry_t g_dids[] = {
+    {0xF190, 17, 0, 0, NULL, NULL, g_vin, 0},
+};
+
+static const uint8_t *map_flash(struct uds_ctx *ctx, uint32_t addr, uint32_t size)
+{
+    (void) ctx;
+    if ((addr + size) > sizeof(g_flash)) {
+        return NULL;
+    }
+    return &g_flash[addr];
+}
+
+static uint8_t g_streamed[4096];
+static uint32_t g_streamed_len;
+static int g_pull_result;
+static int g_mem_reads;
+
+/* Transport pulling a streamed SDU in classic CAN consecutive frame sizes */
+static int pull_stream(uds_ctx_t *ctx, uint32_t len)
+{
+    g_streamed_len = 0u;
+    g_pull_result = 0;
+    while (g_streamed_len < len) {
+        int n = uds_stream_pull(ctx, &g_streamed[g_streamed_len], 7u);
+        if (n <= 0) {
+            g_pull_result = n;
+            break;
+        }
+        g_streamed_len += (uint32_t) n;
+    }
+    return 0;
+}
+
+static int read_flash(struct uds_ctx *ctx, uint32_t addr, uint32_t size, uint8_t *out)
+{
+    (void) ctx;
+    g_mem_reads++;
+    if ((addr + size) > sizeof(g_flash)) {
+        return -0x31;
+    }
+    memcpy(out, &g_flash[addr], size);
+    return 0;
+}
+
+static int fill_counter(uds_ctx_t *ctx, void *arg, uint32_t pos, uint8_t *buf, uint16_t len)
+{
+    (void) ctx;
+    (void) arg;
+    for (uint16_t k = 0u; k < len; k++) {
+        buf[k] = (uint8_t) (pos + k);
+    }
+    return UDS_OK;
+}
+
+static void setup_writer(uds_ctx_t *ctx, uds_config_t *cfg, bool sendv)
+{
+    g_iov_count = 0u;
+    g_iov_len = 0u;
+    g_sendv_calls = 0;
+    g_streamed_len = 0u;
+    g_mem_reads = 0;
+
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 1;
+    if (sendv) {
+        cfg->fn_tp_sendv = record_sendv;
+    }
+}
+
+static void test_ref_is_copied_without_sendv(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, false);
+
+    uint8_t expected[] = {0x62, 0xF1, 0x90, 'W', 'D', 'B'};
+    uds_response_t resp;
+    assert_int_equal(uds_response_begin(&resp, &ctx, 0x22), UDS_OK);
+    assert_int_equal(uds_response_append(&resp, &expected[1], 2), UDS_OK);
+    assert_int_equal(uds_response_ref(&resp, g_vin, 3), UDS_OK);
+    assert_int_equal(resp.count, 1);
+
+    expect_memory(mock_tp_send, data, expected, sizeof(expected));
+    expect_value(mock_tp_send, len, sizeof(expected));
+    will_return(mock_tp_send, 0);
+    assert_int_equal(uds_response_commit(&resp), 0);
+}
+
+static void test_static_did_sent_by_reference(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, true);
+
+    uint8_t request[] = {0x22, 0xF1, 0x90, 0xF1, 0x90};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+
+    assert_int_equal(g_sendv_calls, 1);
+    assert_int_equal(g_iov_len, 1 + 2 * (2 + 17));
+    assert_int_equal(g_iov_count, 4);
+
+    /* Header bytes in the tx_buffer, DID data straight from storage */
+    assert_ptr_equal(g_iov[0].base, g_tx_buf);
+    assert_int_equal(g_iov[0].len, 3);
+    assert_int_equal(g_tx_buf[0], 0x62);
+    assert_ptr_equal(g_iov[1].base, g_vin);
+    assert_int_equal(g_iov[1].len, 17);
+    assert_ptr_equal(g_iov[2].base, &g_tx_buf[3]);
+    assert_int_equal(g_iov[2].len, 2);
+    assert_ptr_equal(g_iov[3].base, g_vin);
+}
+
+static void test_overflow_sends_response_too_long(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, false);
+    cfg.tx_buffer_size = 8;
+
+    uds_response_t resp;
+    uds_response_begin(&resp, &ctx, 0x22);
+    assert_non_null(uds_response_reserve(&resp, 4));
+    assert_null(uds_response_reserve(&resp, 4));
+    assert_int_equal(uds_response_ref(&resp, g_vin, 17), UDS_ERR_BUFFER_TOO_SMALL);
+
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_response_commit(&resp);
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[1], 0x22);
+    assert_int_equal(g_tx_buf[2], 0x14);
+}
+
+static void test_suppressed_response_not_sent(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, true);
+    ctx.suppress_pos_resp = true;
+
+    uds_response_t resp;
+    uds_response_begin(&resp, &ctx, 0x31);
+    uds_response_ref(&resp, g_vin, 4);
+    assert_int_equal(uds_response_commit(&resp), UDS_OK);
+    assert_int_equal(g_sendv_calls, 0);
+    assert_false(ctx.suppress_pos_resp);
+}
+
+static void test_mapped_memory_read_by_reference(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, true);
+    cfg.fn_mem_map = map_flash;
+    cfg.tx_buffer_size = 16; /* Far smaller than the read */
+
+    /* ALFID 0x22: 2-byte address 0x0100, 2-byte size 0x0400 */
+    uint8_t request[] = {0x23, 0x22, 0x01, 0x00, 0x04, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+
+    assert_int_equal(g_sendv_calls, 1);
+    assert_int_equal(g_iov_count, 2);
+    assert_int_equal(g_iov_len, 1 + 0x400);
+    assert_int_equal(g_tx_buf[0], 0x63);
+    assert_ptr_equal(g_iov[1].base, &g_flash[0x100]);
+    assert_int_equal(g_iov[1].len, 0x400);
+}
+
+static void test_stream_fits_in_place(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, false);
+    cfg.fn_tp_send_stream = pull_stream;
+
+    uint8_t expected[] = {0x63, 0x10, 0x11, 0x12, 0x13};
+    uds_response_t resp;
+    uds_response_begin(&resp, &ctx, 0x23);
+    assert_int_equal(uds_response_stream(&resp, 0x10, 4, fill_counter, NULL), UDS_OK);
+
+    /* Small enough: produced into the tx_buffer and sent as usual */
+    expect_memory(mock_tp_send, data, expected, sizeof(expected));
+    expect_value(mock_tp_send, len, sizeof(expected));
+    will_return(mock_tp_send, 0);
+    assert_int_equal(uds_response_commit(&resp), 0);
+    assert_int_equal(g_streamed_len, 0);
+    assert_false(ctx.stream.active);
+}
+
+static void test_memory_read_streamed(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, false);
+    cfg.fn_mem_read = read_flash;
+    cfg.fn_tp_send_stream = pull_stream;
+    cfg.tx_buffer_size = 16; /* Far smaller than the read */
+    for (uint32_t k = 0u; k < sizeof(g_flash); k++) {
+        g_flash[k] = (uint8_t) (k * 7u);
+    }
+
+    /* ALFID 0x22: 2-byte address 0x0100, 2-byte size 0x0400 */
+    uint8_t request[] = {0x23, 0x22, 0x01, 0x00, 0x04, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+
+    assert_int_equal(g_pull_result, 0);
+    assert_int_equal(g_streamed_len, 1 + 0x400);
+    assert_int_equal(g_streamed[0], 0x63);
+    assert_memory_equal(&g_streamed[1], &g_flash[0x100], 0x400);
+    assert_int_equal(g_mem_reads, (0x401 + 6) / 7); /* One read per frame */
+    assert_false(ctx.stream.active);
+}
+
+static void test_streamed_read_failure_ends_stream(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, false);
+    cfg.fn_mem_read = read_flash;
+    cfg.fn_tp_send_stream = pull_stream;
+    cfg.tx_buffer_size = 16;
+
+    /* 0x40 bytes from 0x07F0 run past the end of g_flash */
+    uint8_t request[] = {0x23, 0x22, 0x07, 0xF0, 0x00, 0x40};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+
+    assert_int_equal(g_pull_result, UDS_ERR_INVALID_ARG);
+    assert_true(g_streamed_len < 0x41);
+    assert_false(ctx.stream.active);
+    assert_int_equal(uds_stream_pull(&ctx, g_streamed, 7), UDS_ERR_NOT_INIT);
+}
+
+static void test_memory_read_too_long_without_stream(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_writer(&ctx, &cfg, false);
+    cfg.fn_mem_read = read_flash;
+    cfg.tx_buffer_size = 16;
+
+    uint8_t request[] = {0x23, 0x22, 0x01, 0x00, 0x04, 0x00};
+    uint8_t expected[] = {0x7F, 0x23, 0x14};
+    expect_memory(mock_tp_send, data, expected, sizeof(expected));
+    expect_value(mock_tp_send, len, sizeof(expected));
+    will_return(mock_tp_send, 0);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+    assert_int_equal(g_mem_reads, 0);
+}
+
+static void test_large_did_streamed_from_storage(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    static const uds_did_entry_t big[] = {
+        {0xF1A0, sizeof(g_flash), 0, 0, NULL, NULL, g_flash, 0},
+    };
+    setup_writer(&ctx, &cfg, true);
+    cfg.did_table.entries = big;
+    cfg.fn_tp_send_stream = pull_stream;
+
+    uint8_t request[] = {0x22, 0xF1, 0xA0};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+
+    assert_int_equal(g_sendv_calls, 0);
+    assert_int_equal(g_streamed_len, 3 + sizeof(g_flash));
+    assert_int_equal(g_streamed[0], 0x62);
+    assert_int_equal(g_streamed[1], 0xF1);
+    assert_int_equal(g_streamed[2], 0xA0);
+    assert_memory_equal(&g_streamed[3], g_flash, sizeof(g_flash));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_ref_is_copied_without_sendv),
+        cmocka_unit_test(test_static_did_sent_by_reference),
+        cmocka_unit_test(test_overflow_sends_response_too_long),
+        cmocka_unit_test(test_suppressed_response_not_sent),
+        cmocka_unit_test(test_mapped_memory_read_by_reference),
+        cmocka_unit_test(test_stream_fits_in_place),
+        cmocka_unit_test(test_memory_read_streamed),
+        cmocka_unit_test(test_streamed_read_failure_ends_stream),
+        cmocka_unit_test(test_memory_read_too_long_without_stream),
+        cmocka_unit_test(test_large_did_streamed_from_storage),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_roe.c
+ * @brief Unit tests for ResponseOnEvent (0x86) and its change detection
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_roe.h"
+
+static int g_reads;
+static uint8_t g_speed[2] = {0x00, 0x10};
+static uint8_t g_temp[2];
+
+static int read_temp(uds_ctx_t *ctx, uint16_t did, uint8_t *buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) did;
+    g_reads++;
+    memcpy(buf, g_temp, max_len);
+    return (int) max_len;
+}
+
+static int dtc_read(uds_ctx_t *ctx, uint8_t subfn, uint8_t *out_buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) subfn;
+    (void) max_len;
+    const uint8_t record[] = {0x08, 0x12, 0x34, 0x56, 0x09};
+    memcpy(out_buf, record, sizeof(record));
+    return (int) sizeof(record);
+}
+
+static const uds_did_entry_t g_dids[] = {
+    {0x0100, 2, UDS_SESSION_ALL, 0, NULL, NULL, g_speed, 0},
+    {0x0200, 2, UDS_SESSION_ALL, 0, read_temp, NULL, NULL, 0},
+};
+
+static uds_roe_event_t g_events[3];
+static uds_roe_t g_roe;
+
+static void setup_roe(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    g_reads = 0;
+    g_speed[1] = 0x10;
+    memset(g_temp, 0, sizeof(g_temp));
+    uds_roe_init(&g_roe, g_events, 3);
+    setup_ctx(ctx, cfg);
+    cfg->did_table.entries = g_dids;
+    cfg->did_table.count = 2;
+    cfg->fn_dtc_read = dtc_read;
+    cfg->roe = &g_roe;
+}
+
+static void send(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint16_t resp_len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, len);
+}
+
+static void expect_nrc(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint8_t nrc)
+{
+    send(ctx, req, len, 3);
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[2], nrc);
+}
+
+/* uds_process() at now, expecting one response of resp_len (0 = none) */
+static void tick(uds_ctx_t *ctx, uint32_t now, uint16_t resp_len)
+{
+    will_return(mock_get_time, now);
+    if (resp_len > 0u) {
+        expect_any(mock_tp_send, data);
+        expect_value(mock_tp_send, len, resp_len);
+        will_return(mock_tp_send, 0);
+    }
+    uds_process(ctx);
+}
+
+static const uint8_t g_start[] = {0x86, 0x05, 0x02};
+
+/* startResponseOnEvent: reads the time once more to open the windows */
+static void start(uds_ctx_t *ctx)
+{
+    will_return(mock_get_time, 1000);
+    send(ctx, g_start, sizeof(g_start), 4);
+}
+
+static void test_change_of_did(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_roe(&ctx, &cfg);
+
+    const uint8_t setup[] = {0x86, 0x03, 0x02, 0x01, 0x00, 0x22, 0x01, 0x00};
+    send(&ctx, setup, sizeof(setup), 9);
+    const uint8_t expected[] = {0xC6, 0x03, 0x00, 0x02, 0x01, 0x00, 0x22, 0x01, 0x00};
+    assert_memory_equal(g_tx_buf, expected, sizeof(expected));
+
+    start(&ctx);
+    assert_int_equal(g_tx_buf[2], 1);
+    tick(&ctx, 1010, 0); /* Value at start recorded */
+
+    /* Not reported and not polled: not seen */
+    g_speed[1] = 0x20;
+    tick(&ctx, 1020, 0);
+
+    uds_roe_notify_did(&ctx, 0x0100);
+    tick(&ctx, 1030, 5);
+    const uint8_t pushed[] = {0x62, 0x01, 0x00, 0x00, 0x20};
+    assert_memory_equal(g_tx_buf, pushed, sizeof(pushed));
+
+    /* Same value again: nothing sent */
+    uds_roe_notify_did(&ctx, 0x0100);
+    tick(&ctx, 1040, 0);
+
+    /* A write through 0x2E marks the DID dirty */
+    const uint8_t write[] = {0x2E, 0x01, 0x00, 0x00, 0x30};
+    send(&ctx, write, sizeof(write), 3);
+    tick(&ctx, 1050, 5);
+    assert_int_equal(g_tx_buf[4], 0x30);
+    assert_int_equal(g_roe.responses, 2);
+    assert_int_equal(g_events[0].identified, 2);
+}
+
+static void test_polled_did(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_roe(&ctx, &cfg);
+    g_roe.poll_ms = 50;
+
+    const uint8_t setup[] = {0x86, 0x03, 0x02, 0x02, 0x00, 0x22, 0x02, 0x00};
+    send(&ctx, setup, sizeof(setup), 9);
+    start(&ctx);
+    tick(&ctx, 1000, 0);
+    assert_int_equal(g_reads, 1);
+
+    g_temp[1] = 7;
+    tick(&ctx, 1020, 0); /* Not due yet */
+    assert_int_equal(g_reads, 1);
+    tick(&ctx, 1050, 5);
+    assert_int_equal(g_tx_buf[4], 7);
+    assert_int_equal(g_reads, 3); /* Hash check, then the 0x22 response */
+}
+
+static void test_comparison_with_hysteresis(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_roe(&ctx, &cfg);
+    g_roe.poll_ms = 10;
+
+    /* temp > 100, hysteresis 10 %, unsigned 16-bit value at bit 0 */
+    const uint8_t setup[] = {0x86, 0x07, 0x02, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00,
+                             0x64, 0x0A, 0x40, 0x00, 0x22, 0x02, 0x00};
+    send(&ctx, setup, sizeof(setup), 17);
+    start(&ctx);
+
+    const struct
+    {
+        uint16_t temp;
+        bool pushed;
+    } steps[] = {{90, false},  {105, true},  {120, false}, {95, false},
+                 {105, false}, {85, false}, {110, true}};
+    uint32_t now = 1000;
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        g_temp[0] = (uint8_t) (steps[i].temp >> 8);
+        g_temp[1] = (uint8_t) steps[i].temp;
+        tick(&ctx, now, steps[i].pushed ? 5 : 0);
+        now += 10;
+    }
+    assert_int_equal(g_roe.responses, 2);
+
+    /* Localization past the end of the DID */
+    const uint8_t bad[] = {0x86, 0x07, 0x02, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00,
+                           0x64, 0x0A, 0x40, 0x01, 0x22, 0x02, 0x00};
+    expect_nrc(&ctx, bad, sizeof(bad), 0x31);
+}
+
+static void test_dtc_status_change(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_roe(&ctx, &cfg);
+
+    const uint8_t setup[] = {0x86, 0x01, 0x02, 0x08, 0x19, 0x02, 0x08};
+    send(&ctx, setup, sizeof(setup), 8);
+    start(&ctx);
+    tick(&ctx, 1000, 0);
+
+    uds_roe_notify_dtc(&ctx, 0x123456, 0x00, 0x01); /* testFailed only: not in the mask */
+    tick(&ctx, 1010, 0);
+    uds_roe_notify_dtc(&ctx, 0x123456, 0x01, 0x09); /* confirmedDTC set */
+    tick(&ctx, 1020, 7);
+    assert_int_equal(g_tx_buf[0], 0x59);
+    assert_int_equal(g_tx_buf[1], 0x02);
+}
+
+static void test_window_report_stop_clear(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_roe(&ctx, &cfg);
+    g_roe.window_ms[0] = 100;
+
+    const uint8_t setup[] = {0x86, 0x03, 0x03, 0x01, 0x00, 0x22, 0x01, 0x00};
+    send(&ctx, setup, sizeof(setup), 9);
+
+    const uint8_t report[] = {0x86, 0x04};
+    send(&ctx, report, sizeof(report), 3);
+    assert_int_equal(g_tx_buf[2], 0); /* Set up, not started */
+
+    start(&ctx);
+    send(&ctx, report, sizeof(report), 3 + 7);
+    const uint8_t listed[] = {0xC6, 0x04, 0x01, 0x03, 0x03, 0x01, 0x00, 0x22, 0x01, 0x00};
+    assert_memory_equal(g_tx_buf, listed, sizeof(listed));
+
+    /* One change inside the window, then the window closes */
+    tick(&ctx, 1000, 0);
+    uds_roe_notify_did(&ctx, 0x0100);
+    g_speed[1] = 0x11;
+    tick(&ctx, 1050, 5);
+    tick(&ctx, 1100, 9);
+    const uint8_t closed[] = {0xC6, 0x03, 0x01, 0x03, 0x01, 0x00, 0x22, 0x01, 0x00};
+    assert_memory_equal(g_tx_buf, closed, sizeof(closed));
+    send(&ctx, report, sizeof(report), 3);
+    assert_int_equal(g_tx_buf[2], 0);
+
+    /* Stop keeps the set-up events, clear removes them */
+    start(&ctx);
+    const uint8_t stop[] = {0x86, 0x00, 0x02};
+    send(&ctx, stop, sizeof(stop), 4);
+    assert_false(g_events[0].active);
+    assert_int_equal(g_events[0].type, 0x03);
+    const uint8_t clear[] = {0x86, 0x06, 0x02};
+    send(&ctx, clear, sizeof(clear), 4);
+    assert_int_equal(g_events[0].type, 0);
+    expect_nrc(&ctx, g_start, sizeof(g_start), 0x24);
+}
+
+#define TESTER_A 0x0E80u
+#define TESTER_B 0x0F10u
+
+static uint16_t g_sent_addr;
+static uint8_t g_sent[8];
+
+static int tester_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    g_sent_addr = ctx->tester_addr;
+    memcpy(g_sent, data, (len < sizeof(g_sent)) ? len : sizeof(g_sent));
+    return 0;
+}
+
+static void send_from(uds_ctx_t *ctx, uint16_t addr, const uint8_t *req, uint16_t len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu_from(ctx, addr, req, len);
+}
+
+static void test_event_uses_its_tester(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_tester_state_t states[2];
+    static const uds_did_entry_t extended_dids[] = {
+        {0x0100, 2, UDS_SESSION_EXTENDED, 0, NULL, NULL, g_speed, 0},
+    };
+    setup_roe(&ctx, &cfg);
+    memset(states, 0, sizeof(states));
+    cfg.tester_states = states;
+    cfg.tester_state_count = 2;
+    cfg.did_table.entries = extended_dids;
+    cfg.did_table.count = 1;
+    cfg.fn_tp_send = tester_tp_send;
+
+    /* Tester A sets the event up in the extended session, where the DID is readable */
+    const uint8_t extended[] = {0x10, 0x03};
+    send_from(&ctx, TESTER_A, extended, sizeof(extended));
+    const uint8_t setup[] = {0x86, 0x03, 0x02, 0x01, 0x00, 0x22, 0x01, 0x00};
+    send_from(&ctx, TESTER_A, setup, sizeof(setup));
+    will_return(mock_get_time, 1000);
+    send_from(&ctx, TESTER_A, g_start, sizeof(g_start));
+    tick(&ctx, 1010, 0);
+
+    /* Tester B, in the default session, is loaded when the event occurs */
+    const uint8_t tester_present[] = {0x3E, 0x00};
+    send_from(&ctx, TESTER_B, tester_present, sizeof(tester_present));
+    assert_int_equal(ctx.active_session, 0x01);
+
+    g_speed[1] = 0x20;
+    uds_roe_notify_did(&ctx, 0x0100);
+    g_sent_addr = 0u;
+    tick(&ctx, 1020, 0);
+
+    /* Read with tester A's session and sent to tester A */
+    const uint8_t pushed[] = {0x62, 0x01, 0x00, 0x00, 0x20};
+    assert_memory_equal(g_sent, pushed, sizeof(pushed));
+    assert_int_equal(g_sent_addr, TESTER_A);
+    assert_int_equal(g_roe.responses, 1);
+
+    /* Tester B is loaded again */
+    assert_int_equal(ctx.tester_addr, TESTER_B);
+    assert_int_equal(ctx.active_session, 0x01);
+}
+
+static void test_rejected_requests(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_roe(&ctx, &cfg);
+
+    const uint8_t timer[] = {0x86, 0x02, 0x02, 0x01, 0x22, 0x01, 0x00};
+    expect_nrc(&ctx, timer, sizeof(timer), 0x12);
+    const uint8_t unknown_did[] = {0x86, 0x03, 0x02, 0x09, 0x99, 0x22, 0x09, 0x99};
+    expect_nrc(&ctx, unknown_did, sizeof(unknown_did), 0x31);
+    const uint8_t bad_service[] = {0x86, 0x03, 0x02, 0x01, 0x00, 0x2E, 0x01, 0x00};
+    expect_nrc(&ctx, bad_service, sizeof(bad_service), 0x31);
+    const uint8_t bad_window[] = {0x86, 0x03, 0x09, 0x01, 0x00, 0x22, 0x01, 0x00};
+    expect_nrc(&ctx, bad_window, sizeof(bad_window), 0x31);
+    const uint8_t no_service[] = {0x86, 0x03, 0x02, 0x01, 0x00};
+    expect_nrc(&ctx, no_service, sizeof(no_service), 0x13);
+
+    cfg.roe = NULL;
+    expect_nrc(&ctx, g_start, sizeof(g_start), 0x22);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_change_of_did),
+        cmocka_unit_test(test_polled_did),
+        cmocka_unit_test(test_comparison_with_hysteresis),
+        cmocka_unit_test(test_dtc_status_change),
+        cmocka_unit_test(test_window_report_stop_clear),
+        cmocka_unit_test(test_event_uses_its_tester),
+        cmocka_unit_test(test_rejected_requests),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_server_group.c
+ * @brief Unit tests for the multi-ECU server group
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_mailbox.h"
+#include "uds/uds_server_group.h"
+
+#ifdef UDS_TEST_THREADS
+#include <sched.h>
+#include "uds/uds_posix_group.h"
+#endif
+
+#define ECUS 4
+#define MB_DEPTH 8u
+#define MB_SLOT 16u
+
+static uds_ctx_t g_ctx[ECUS];
+static uds_config_t g_cfg[ECUS];
+static uint8_t g_rx[ECUS][64];
+static uint8_t g_tx[ECUS][64];
+static uds_mail_t g_mails[ECUS][MB_DEPTH];
+static uint8_t g_mail_data[ECUS][MB_DEPTH * MB_SLOT];
+static uds_mailbox_t g_mb[ECUS];
+
+static uds_server_member_t g_members[ECUS];
+static uds_server_shard_t g_shards[2];
+static uds_server_group_t g_group;
+
+static uint32_t g_now;
+static int g_sent[ECUS];
+static uint8_t g_last[ECUS];
+
+static uint32_t group_time(void)
+{
+    return __atomic_load_n(&g_now, __ATOMIC_RELAXED);
+}
+
+static int group_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    int ecu = (int) (ctx - g_ctx);
+    g_last[ecu] = data[0];
+    __atomic_fetch_add(&g_sent[ecu], 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static void setup_ecus(bool mailbox)
+{
+    g_now = 1000u;
+    memset(g_sent, 0, sizeof(g_sent));
+    memset(g_last, 0, sizeof(g_last));
+
+    for (int i = 0; i < ECUS; i++) {
+        memset(&g_cfg[i], 0, sizeof(g_cfg[i]));
+        g_cfg[i].get_time_ms = group_time;
+        g_cfg[i].fn_tp_send = group_tp_send;
+        g_cfg[i].rx_buffer = g_rx[i];
+        g_cfg[i].rx_buffer_size = sizeof(g_rx[i]);
+        g_cfg[i].tx_buffer = g_tx[i];
+        g_cfg[i].tx_buffer_size = sizeof(g_tx[i]);
+        if (mailbox) {
+            uds_mailbox_init(&g_mb[i], g_mails[i], g_mail_data[i], MB_DEPTH, MB_SLOT);
+            g_cfg[i].mailbox = &g_mb[i];
+        }
+        uds_init(&g_ctx[i], &g_cfg[i]);
+    }
+}
+
+static void test_add_keeps_members_sorted(void **state)
+{
+    (void) state;
+    setup_ecus(false);
+    assert_int_equal(uds_server_group_init(&g_group, g_members, 3, g_shards, 1, 1000), UDS_OK);
+
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[0], 0x7E2, 0), UDS_OK);
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[1], 0x7E0, 0), UDS_OK);
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[2], 0x7E1, 0), UDS_OK);
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[3], 0x7E3, 0),
+                     UDS_ERR_BUFFER_TOO_SMALL);
+
+    assert_int_equal(g_members[0].addr, 0x7E0);
+    assert_int_equal(g_members[1].addr, 0x7E1);
+    assert_int_equal(g_members[2].addr, 0x7E2);
+    assert_ptr_equal(uds_server_group_find(&g_group, 0x7E2), &g_ctx[0]);
+    assert_null(uds_server_group_find(&g_group, 0x7E5));
+}
+
+static void test_add_rejects_bad_members(void **state)
+{
+    (void) state;
+    setup_ecus(false);
+    assert_int_equal(uds_server_group_init(&g_group, g_members, ECUS, g_shards, 0, 1000),
+                     UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_server_group_init(&g_group, g_members, ECUS, g_shards, 2, 1000), UDS_OK);
+
+    /* Several shards need single-owner contexts */
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[0], 0x7E0, 0), UDS_ERR_INVALID_ARG);
+    g_cfg[0].mailbox = &g_mb[0];
+    uds_mailbox_init(&g_mb[0], g_mails[0], g_mail_data[0], MB_DEPTH, MB_SLOT);
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[0], 0x7E0, 2), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[0], 0x7E0, 1), UDS_OK);
+    assert_int_equal(uds_server_group_add(&g_group, &g_ctx[0], 0x7E0, 0), UDS_ERR_INVALID_ARG);
+}
+
+static void test_input_routes_by_address(void **state)
+{
+    (void) state;
+    setup_ecus(false);
+    uds_server_group_init(&g_group, g_members, ECUS, g_shards, 1, 1000);
+    for (int i = 0; i < ECUS; i++) {
+        uds_server_group_add(&g_group, &g_ctx[i], (uint16_t) (0x7E0 + i), 0);
+    }
+
+    uint8_t request[] = {0x3E, 0x00};
+    assert_int_equal(uds_server_group_input(&g_group, 0x7E2, 0x0F1, request, sizeof(request)),
+                     UDS_OK);
+    assert_int_equal(g_sent[2], 1);
+    assert_int_equal(g_last[2], 0x7E);
+    assert_int_equal(g_sent[0] + g_sent[1] + g_sent[3], 0);
+    assert_int_equal(g_ctx[2].tester_addr, 0x0F1);
+
+    assert_int_equal(uds_server_group_input(&g_group, 0x700, 0x0F1, request, sizeof(request)),
+                     UDS_ERR_INVALID_ARG);
+    assert_int_equal(g_group.unknown, 1);
+
+    uds_server_group_input_functional(&g_group, 0x0F1, request, sizeof(request));
+    assert_int_equal(g_sent[0] + g_sent[1] + g_sent[2] + g_sent[3], 5);
+}
+
+static void test_process_only_touches_due_members(void **state)
+{
+    (void) state;
+    setup_ecus(false);
+    uds_server_group_init(&g_group, g_members, ECUS, g_shards, 1, 1000);
+    for (int i = 0; i < ECUS; i++) {
+        uds_server_group_add(&g_group, &g_ctx[i], (uint16_t) (0x7E0 + i), 0);
+    }
+
+    /* All in the default session: nothing to do */
+    g_now = 2000u;
+    assert_int_equal(uds_server_group_process(&g_group, 2000), 0);
+
+    /* One ECU in the extended session: only its S3 expiry is processed */
+    uint8_t extended[] = {0x10, 0x03};
+    uds_server_group_input(&g_group, 0x7E1, 0x0F1, extended, sizeof(extended));
+    assert_int_equal(g_ctx[1].active_session, 0x03);
+
+    g_now = 2000u + 5000u + 1u;
+    assert_int_equal(uds_server_group_process(&g_group, g_now), 1);
+    assert_int_equal(g_ctx[1].active_session, 0x01);
+}
+
+static void test_posted_members_processed_once(void **state)
+{
+    (void) state;
+    setup_ecus(true);
+    uds_server_group_init(&g_group, g_members, ECUS, g_shards, 2, 1000);
+    for (int i = 0; i < ECUS; i++) {
+        uds_server_group_add(&g_group, &g_ctx[i], (uint16_t) (0x7E0 + i), (uint8_t) (i % 2));
+    }
+
+    uint8_t request[] = {0x3E, 0x00};
+    uds_server_group_input(&g_group, 0x7E1, 0x0F1, request, sizeof(request));
+    uds_server_group_input(&g_group, 0x7E1, 0x0F1, request, sizeof(request));
+    assert_int_equal(g_sent[1], 0);
+
+    /* Shard 0 has nothing to do; shard 1 runs ECU 1 once for both mails */
+    assert_int_equal(uds_server_group_process_shard(&g_group, 0, 1000), 0);
+    assert_int_equal(uds_server_group_process_shard(&g_group, 1, 1000), 1);
+    assert_int_equal(g_sent[1], 2);
+    assert_int_equal(uds_server_group_process_shard(&g_group, 1, 1000), 0);
+}
+
+#ifdef UDS_TEST_THREADS
+
+#define POSTS_PER_ECU 500
+
+static void test_shard_threads(void **state)
+{
+    (void) state;
+    static const int cpus[] = {0, -1};
+    uds_posix_group_t runner;
+
+    setup_ecus(true);
+    uds_server_group_init(&g_group, g_members, ECUS, g_shards, 2, 1000);
+    for (int i = 0; i < ECUS; i++) {
+        uds_server_group_add(&g_group, &g_ctx[i], (uint16_t) (0x7E0 + i), (uint8_t) (i % 2));
+    }
+    assert_int_equal(uds_posix_group_start(&runner, &g_group, group_time, cpus), UDS_OK);
+
+    /* This thread is the RX thread */
+    uint8_t request[] = {0x3E, 0x00};
+    for (int n = 0; n < POSTS_PER_ECU; n++) {
+        for (int i = 0; i < ECUS; i++) {
+            while (__atomic_load_n(&g_sent[i], __ATOMIC_RELAXED) < (n - (int) MB_DEPTH + 1)) {
+                sched_yield(); /* Do not overrun the mailbox */
+            }
+            uds_server_group_input(&g_group, (uint16_t) (0x7E0 + i), 0x0F1, request,
+                                   sizeof(request));
+        }
+    }
+    for (int i = 0; i < ECUS; i++) {
+        while (__atomic_load_n(&g_sent[i], __ATOMIC_RELAXED) < POSTS_PER_ECU) {
+            sched_yield();
+        }
+    }
+    uds_posix_group_stop(&runner);
+
+    for (int i = 0; i < ECUS; i++) {
+        assert_int_equal(g_sent[i], POSTS_PER_ECU);
+        assert_int_equal(g_mb[i].dropped, 0);
+    }
+}
+
+#endif /* UDS_TEST_THREADS */
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_add_keeps_members_sorted),
+        cmocka_unit_test(test_add_rejects_bad_members),
+        cmocka_unit_test(test_input_routes_by_address),
+        cmocka_unit_test(test_process_only_touches_due_members),
+        cmocka_unit_test(test_posted_members_processed_once),
+#ifdef UDS_TEST_THREADS
+        cmocka_unit_test(test_shard_threads),
+#endif
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
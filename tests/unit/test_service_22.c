@@ -13,7 +13,7 @@
 static uint8_t g_vin[] = "UDSLIB_SIM_001";
 
 static const uds_did_entry_t g_test_dids[] = {
-    {0xF190, 14, UDS_SESSION_ALL, 0, NULL, NULL, g_vin},
+    {0xF190, 14, UDS_SESSION_ALL, 0, NULL, NULL, g_vin, 0},
 };
 
 static const uds_did_table_t g_test_table = {.entries = g_test_dids, .count = 1};
@@ -53,7 +53,7 @@ static void setup_test(void **state)
     cfg.tx_buffer_size = sizeof(tx_buf);
 
     /* Missing table */
-    static const uds_did_entry_t dids[] = {{0, 0, UDS_SESSION_ALL, 0, NULL, NULL, NULL}};
+    static const uds_did_entry_t dids[] = {{0, 0, UDS_SESSION_ALL, 0, NULL, NULL, NULL, 0}};
     cfg.did_table.entries = dids;
     cfg.did_table.count = 0;
 
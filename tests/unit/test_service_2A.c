@@ -11,8 +11,12 @@
 #include <string.h>
 
 #include "uds/uds_core.h"
+#include "uds/uds_periodic.h"
 #include "test_helpers.h"
 
+static uint16_t g_payload_len;
+static uint16_t g_last_max_len;
+
 static int mock_periodic_read(struct uds_ctx *ctx, uint8_t periodic_id, uint8_t *out_buf,
                               uint16_t max_len)
 {
@@ -49,9 +53,10 @@ static void test_periodic_read_setup(void **state)
     will_return(mock_tp_send, 0);
 
     uds_input_sdu(&ctx, req, 3);
-    assert_int_equal(ctx.periodic_count, 1);
-    assert_int_equal(ctx.periodic_ids[0], 0xE1);
-    assert_int_equal(ctx.periodic_rates[0], 0x01);
+    uds_periodic_entry_t entry;
+    assert_int_equal(uds_periodic_get(&ctx, 0xE1, &entry), UDS_OK);
+    assert_int_equal(entry.rate, 0x01);
+    assert_int_equal(entry.deadline, 1000);
 }
 
 static void test_periodic_scheduler_trigger(void **state)
@@ -60,10 +65,10 @@ static void test_periodic_scheduler_trigger(void **state)
     BEGIN_UDS_TEST(ctx, cfg);
     cfg.fn_periodic_read = mock_periodic_read;
 
-    /* Manually setup state */
-    ctx.periodic_ids[0] = 0xE1;
-    ctx.periodic_rates[0] = 0x01; /* Fast: 100ms */
-    ctx.periodic_timers[0] = 1000;
+    /* Manually setup state: Fast (100ms), due at T=1000 */
+    ctx.periodic_slots[0].id = 0xE1;
+    ctx.periodic_slots[0].rate = 0x01;
+    ctx.periodic_slots[0].deadline = 1000;
     ctx.periodic_count = 1;
 
     /* Trigger scheduler at T=1000 */
@@ -75,7 +80,8 @@ static void test_periodic_scheduler_trigger(void **state)
     uds_process(&ctx);
 
     /* Check timer reset */
-    assert_int_equal(ctx.periodic_timers[0], 1100);
+    assert_int_equal(ctx.periodic_slots[0].deadline, 1100);
+    assert_int_equal(ctx.periodic_slots[0].sent, 1);
 }
 
 static void test_periodic_read_stop(void **state)
@@ -83,7 +89,8 @@ static void test_periodic_read_stop(void **state)
     (void) state;
     BEGIN_UDS_TEST(ctx, cfg);
 
-    ctx.periodic_ids[0] = 0xE1;
+    ctx.periodic_slots[0].id = 0xE1;
+    ctx.periodic_slots[0].rate = 0x01;
     ctx.periodic_count = 1;
 
     /* 2A 04 E1 (Stop ID 0xE1) */
@@ -99,7 +106,233 @@ static void test_periodic_read_stop(void **state)
 
     uds_input_sdu(&ctx, req, 3);
     assert_int_equal(ctx.periodic_count, 0);
-    assert_int_equal(ctx.periodic_ids[0], 0x00);
+}
+
+static int counter_read(struct uds_ctx *ctx, uint8_t periodic_id, uint8_t *out_buf,
+                        uint16_t max_len)
+{
+    (void) ctx;
+    g_last_max_len = max_len;
+    memset(out_buf, periodic_id, g_payload_len);
+    return (int) g_payload_len;
+}
+
+/* Requests scheduling a new ID read the time once more */
+static void request(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint16_t resp_len,
+                    bool new_id)
+{
+    will_return_count(mock_get_time, 1000, new_id ? 3 : 2);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, len);
+}
+
+static void tick(uds_ctx_t *ctx, uint32_t now, int sends, uint16_t len)
+{
+    will_return(mock_get_time, now);
+    if (sends > 0) {
+        expect_any_count(mock_tp_send, data, sends);
+        expect_value_count(mock_tp_send, len, len, sends);
+        will_return_count(mock_tp_send, 0, sends);
+    }
+    uds_process(ctx);
+}
+
+static void test_scheduler_capacity_and_rates(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+    static uds_periodic_entry_t entries[32];
+    static uds_periodic_t sched;
+    uds_periodic_init(&sched, entries, 32);
+    sched.interval_ms[0] = 10;
+    sched.interval_ms[1] = 20;
+    sched.interval_ms[2] = 40;
+    cfg.periodic = &sched;
+    cfg.fn_periodic_read = counter_read;
+    g_payload_len = 2;
+
+    /* IDs 0..31: i % 3 == 0 fast, 1 medium, 2 slow */
+    for (uint8_t mode = 1; mode <= 3; mode++) {
+        uint8_t req[2 + 11] = {0x2A, mode};
+        uint16_t n = 2;
+        for (uint8_t id = (uint8_t) (mode - 1u); id < 32u; id = (uint8_t) (id + 3u)) {
+            req[n++] = id;
+        }
+        request(&ctx, req, n, 1, true);
+    }
+    assert_int_equal(sched.count, 32);
+
+    const uint8_t full[] = {0x2A, 0x01, 0x40};
+    request(&ctx, full, sizeof(full), 3, false); /* Rejected before anything starts */
+    assert_int_equal(g_tx_buf[2], 0x14);
+
+    tick(&ctx, 1000, 32, 3); /* All due at once */
+    tick(&ctx, 1005, 0, 0);
+    tick(&ctx, 1010, 11, 3); /* Fast */
+    tick(&ctx, 1020, 11 + 11, 3);
+    tick(&ctx, 1040, 11 + 11 + 10, 3);
+
+    /* Stopping IDs anywhere in the heap keeps the order */
+    const uint8_t stop[] = {0x2A, 0x04, 0x00, 0x10, 0x1F};
+    request(&ctx, stop, sizeof(stop), 1, false);
+    assert_int_equal(sched.count, 29);
+    tick(&ctx, 1050, 10, 3);
+    tick(&ctx, 1060, 10 + 9, 3);
+
+    uds_periodic_entry_t entry;
+    assert_int_equal(uds_periodic_get(&ctx, 0x10, &entry), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_periodic_get(&ctx, 0x03, &entry), UDS_OK);
+    assert_int_equal(entry.sent, 6);
+    assert_int_equal(entry.overruns, 1); /* No tick at 1030 */
+    assert_int_equal(entry.deadline, 1070);
+}
+
+static void test_start_is_all_or_nothing(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+    static uds_periodic_entry_t entries[4];
+    static uds_periodic_t sched;
+    uds_periodic_init(&sched, entries, 4);
+    cfg.periodic = &sched;
+    cfg.fn_periodic_read = counter_read;
+
+    const uint8_t first[] = {0x2A, 0x01, 0x01, 0x02, 0x03};
+    request(&ctx, first, sizeof(first), 1, true);
+    assert_int_equal(sched.count, 3);
+
+    /* Two new IDs, one free entry: none of them starts, the rate is unchanged */
+    const uint8_t over[] = {0x2A, 0x03, 0x01, 0x04, 0x05};
+    request(&ctx, over, sizeof(over), 3, false);
+    assert_int_equal(g_tx_buf[2], 0x14);
+    assert_int_equal(sched.count, 3);
+    uds_periodic_entry_t entry;
+    assert_int_equal(uds_periodic_get(&ctx, 0x04, &entry), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_periodic_get(&ctx, 0x01, &entry), UDS_OK);
+    assert_int_equal(entry.rate, 0x01);
+
+    /* An ID listed twice needs one entry */
+    const uint8_t twice[] = {0x2A, 0x02, 0x04, 0x01, 0x04};
+    request(&ctx, twice, sizeof(twice), 1, true);
+    assert_int_equal(sched.count, 4);
+    assert_int_equal(uds_periodic_get(&ctx, 0x04, &entry), UDS_OK);
+    assert_int_equal(entry.rate, 0x02);
+}
+
+static void test_late_ticks_do_not_drift(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+    cfg.fn_periodic_read = counter_read;
+    g_payload_len = 2;
+
+    const uint8_t req[] = {0x2A, 0x01, 0xE1};
+    request(&ctx, req, sizeof(req), 1, true);
+
+    uds_periodic_entry_t entry;
+    tick(&ctx, 1000, 1, 3);
+    tick(&ctx, 1130, 1, 3); /* 30 ms late */
+    assert_int_equal(uds_periodic_get(&ctx, 0xE1, &entry), UDS_OK);
+    assert_int_equal(entry.deadline, 1200);
+    assert_int_equal(entry.last_jitter_ms, 30);
+
+    tick(&ctx, 1200, 1, 3);
+    tick(&ctx, 1555, 1, 3); /* Sent for 1500; 1300 and 1400 missed */
+    assert_int_equal(uds_periodic_get(&ctx, 0xE1, &entry), UDS_OK);
+    assert_int_equal(entry.deadline, 1600);
+    assert_int_equal(entry.sent, 4);
+    assert_int_equal(entry.overruns, 2);
+    assert_int_equal(entry.last_jitter_ms, 55);
+    assert_int_equal(entry.max_jitter_ms, 55);
+}
+
+static void test_payload_size(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+    cfg.fn_periodic_read = counter_read;
+
+    /* Built-in scheduler: classic CAN sized payloads */
+    const uint8_t req[] = {0x2A, 0x03, 0xE1};
+    request(&ctx, req, sizeof(req), 1, true);
+    g_payload_len = 8;
+    tick(&ctx, 1000, 1, 9);
+    assert_int_equal(g_last_max_len, 8);
+
+    /* Configured scheduler: CAN FD frames, 63 data bytes after the ID */
+    static uint8_t frames[2][64];
+    static uds_periodic_entry_t entries[4];
+    static uds_periodic_t sched;
+    uds_periodic_init(&sched, entries, 4);
+    sched.frames = &frames[0][0];
+    sched.frame_size = 64;
+    sched.frame_count = 2;
+    cfg.periodic = &sched;
+    request(&ctx, req, sizeof(req), 1, true);
+    g_payload_len = 63;
+    tick(&ctx, 1000, 1, 64);
+    assert_int_equal(g_last_max_len, 63);
+    assert_int_equal(g_tx_buf[0], 0xE1);
+    assert_int_equal(g_tx_buf[63], 0xE1);
+
+    /* A callback overrunning the limit is not sent */
+    sched.max_len = 16;
+    tick(&ctx, 2000, 0, 0);
+    assert_int_equal(g_last_max_len, 16);
+}
+
+static const uint8_t *g_raw_frame;
+static uint16_t g_raw_len;
+static int g_raw_sends;
+
+static int mock_periodic_send(struct uds_ctx *ctx, const uint8_t *frame, uint16_t len)
+{
+    (void) ctx;
+    g_raw_frame = frame;
+    g_raw_len = len;
+    g_raw_sends++;
+    return 0;
+}
+
+static void test_raw_path_leaves_response_buffer(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+    cfg.fn_periodic_read = counter_read;
+    cfg.fn_periodic_send = mock_periodic_send;
+    g_payload_len = 7;
+    g_raw_sends = 0;
+
+    const uint8_t req[] = {0x2A, 0x01, 0xE1, 0xE2};
+    request(&ctx, req, sizeof(req), 1, true);
+
+    /* A response being built or segmented in the tx buffer */
+    memset(g_tx_buf, 0x5A, 16);
+
+    tick(&ctx, 1000, 0, 0); /* Nothing through fn_tp_send */
+    assert_int_equal(g_raw_sends, 2);
+    assert_int_equal(g_raw_len, 8);
+    assert_ptr_equal(g_raw_frame, ctx.periodic_frame);
+    for (int i = 0; i < 16; i++) {
+        assert_int_equal(g_tx_buf[i], 0x5A);
+    }
+
+    /* Several frames are used in turn */
+    static uint8_t frames[2][8];
+    static uds_periodic_entry_t entries[4];
+    static uds_periodic_t sched;
+    uds_periodic_init(&sched, entries, 4);
+    sched.frames = &frames[0][0];
+    sched.frame_size = 8;
+    sched.frame_count = 2;
+    cfg.periodic = &sched;
+    request(&ctx, req, sizeof(req), 1, true);
+    tick(&ctx, 1000, 0, 0);
+    assert_int_equal(g_raw_sends, 4);
+    assert_ptr_equal(g_raw_frame, frames[1]);
+    assert_int_equal(frames[0][0] ^ frames[1][0], 0xE1 ^ 0xE2);
 }
 
 int main(void)
@@ -108,6 +341,11 @@ int main(void)
         cmocka_unit_test(test_periodic_read_setup),
         cmocka_unit_test(test_periodic_scheduler_trigger),
         cmocka_unit_test(test_periodic_read_stop),
+        cmocka_unit_test(test_scheduler_capacity_and_rates),
+        cmocka_unit_test(test_start_is_all_or_nothing),
+        cmocka_unit_test(test_late_ticks_do_not_drift),
+        cmocka_unit_test(test_payload_size),
+        cmocka_unit_test(test_raw_path_leaves_response_buffer),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -30,8 +30,8 @@ static int mock_did_write_fn(uds_ctx_t *ctx, uint16_t did, const uint8_t *data,
 }
 
 static const uds_did_entry_t g_test_dids[] = {
-    {0xF00D, 4, UDS_SESSION_ALL, 0, NULL, NULL, g_storage_did},     /* Storage DID */
-    {0x1234, 2, UDS_SESSION_ALL, 0, NULL, mock_did_write_fn, NULL}, /* Callback DID */
+    {0xF00D, 4, UDS_SESSION_ALL, 0, NULL, NULL, g_storage_did, 0},     /* Storage DID */
+    {0x1234, 2, UDS_SESSION_ALL, 0, NULL, mock_did_write_fn, NULL, 0}, /* Callback DID */
 };
 
 static const uds_did_table_t g_test_table = {.entries = g_test_dids, .count = 2};
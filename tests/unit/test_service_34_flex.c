@@ -28,10 +28,15 @@ static void test_request_download_flex_44(void **state)
     expect_value(mock_download, size, 0xAABBCCDD);
     will_return(mock_download, UDS_OK);
     expect_any(mock_tp_send, data);
-    expect_value(mock_tp_send, len, 6);
+    expect_value(mock_tp_send, len, 4);
     will_return(mock_tp_send, 0);
 
     uds_input_sdu(&ctx, request, sizeof(request));
+
+    /* maxNumberOfBlockLength = rx_buffer_size (1024) in 2 bytes */
+    assert_int_equal(g_tx_buf[1], 0x20);
+    assert_int_equal(g_tx_buf[2], 0x04);
+    assert_int_equal(g_tx_buf[3], 0x00);
 }
 
 static void test_request_download_flex_21(void **state)
@@ -49,10 +54,105 @@ static void test_request_download_flex_21(void **state)
     expect_value(mock_download, size, 0xCC);
     will_return(mock_download, UDS_OK);
     expect_any(mock_tp_send, data);
-    expect_value(mock_tp_send, len, 6);
+    expect_value(mock_tp_send, len, 4);
     will_return(mock_tp_send, 0);
 
     uds_input_sdu(&ctx, request, sizeof(request));
+
+    /* maxNumberOfBlockLength = rx_buffer_size (1024) in 2 bytes */
+    assert_int_equal(g_tx_buf[1], 0x20);
+    assert_int_equal(g_tx_buf[2], 0x04);
+    assert_int_equal(g_tx_buf[3], 0x00);
+}
+
+static uint32_t g_max_sdu;
+
+static uint32_t mock_max_sdu(struct uds_ctx *ctx, bool response)
+{
+    (void) ctx;
+    assert_false(response); /* Downloaded blocks are received */
+    return g_max_sdu;
+}
+
+/* Positive response of a download, returns its length */
+static uint16_t download(uds_ctx_t *ctx, uint16_t resp_len)
+{
+    uint8_t request[] = {0x34, 0x00, 0x11, 0x10, 0x20};
+
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_value(mock_download, addr, 0x10);
+    expect_value(mock_download, size, 0x20);
+    will_return(mock_download, UDS_OK);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, request, sizeof(request));
+    assert_int_equal(g_tx_buf[0], 0x74);
+    return resp_len;
+}
+
+static void test_block_length_limits(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+    cfg.fn_request_download = mock_download;
+
+    /* Transport below the rx_buffer: 300 = 0x012C */
+    g_max_sdu = 300u;
+    cfg.fn_tp_max_sdu = mock_max_sdu;
+    download(&ctx, 4);
+    assert_int_equal(g_tx_buf[1], 0x20);
+    assert_int_equal(g_tx_buf[2], 0x01);
+    assert_int_equal(g_tx_buf[3], 0x2C);
+
+    /* Application cap, fits in 1 byte */
+    cfg.max_block_length = 200u;
+    download(&ctx, 3);
+    assert_int_equal(g_tx_buf[1], 0x10);
+    assert_int_equal(g_tx_buf[2], 200);
+
+    /* A cap above the limits does not raise them */
+    cfg.max_block_length = 0x10000u;
+    g_max_sdu = UINT32_MAX;
+    download(&ctx, 4);
+    assert_int_equal(g_tx_buf[1], 0x20);
+    assert_int_equal(g_tx_buf[2], 0x04);
+    assert_int_equal(g_tx_buf[3], 0x00);
+}
+
+static void test_client_honours_block_length(void **state)
+{
+    (void) state;
+    BEGIN_UDS_TEST(ctx, cfg);
+
+    uint8_t req_34[] = {0x00, 0x11, 0x10, 0x20};
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 5);
+    will_return(mock_tp_send, 0);
+    assert_int_equal(uds_client_request(&ctx, 0x34, req_34, sizeof(req_34), NULL), UDS_OK);
+    assert_int_equal(uds_client_block_length(&ctx), 0u);
+
+    /* Server grants 10 bytes: SID, sequence counter and 8 data bytes */
+    uint8_t resp[] = {0x74, 0x10, 0x0A};
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, resp, sizeof(resp));
+    assert_int_equal(uds_client_block_length(&ctx), 10u);
+
+    uint8_t block[10] = {0x01};
+    assert_int_equal(uds_client_request(&ctx, 0x36, block, 10, NULL), UDS_ERR_BUFFER_TOO_SMALL);
+
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 10);
+    will_return(mock_tp_send, 0);
+    assert_int_equal(uds_client_request(&ctx, 0x36, block, 9, NULL), UDS_OK);
+
+    /* A new download drops the grant */
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 5);
+    will_return(mock_tp_send, 0);
+    assert_int_equal(uds_client_request(&ctx, 0x34, req_34, sizeof(req_34), NULL), UDS_OK);
+    assert_int_equal(uds_client_block_length(&ctx), 0u);
 }
 
 int main(void)
@@ -60,6 +160,8 @@ int main(void)
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_request_download_flex_44),
         cmocka_unit_test(test_request_download_flex_21),
+        cmocka_unit_test(test_block_length_limits),
+        cmocka_unit_test(test_client_honours_block_length),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -38,11 +38,14 @@ static void test_request_upload_success(void **state)
     will_return(mock_get_time, 1000);
 
     expect_any(mock_tp_send, data);
-    expect_value(mock_tp_send, len, 6); /* 75 20 ... */
+    expect_value(mock_tp_send, len, 4); /* 75 20 04 00: tx_buffer_size */
     will_return(mock_tp_send, 0);
 
     uds_input_sdu(&ctx, req, 7);
     assert_int_equal(g_tx_buf[0], 0x75);
+    assert_int_equal(g_tx_buf[1], 0x20);
+    assert_int_equal(g_tx_buf[2], 0x04);
+    assert_int_equal(g_tx_buf[3], 0x00);
     assert_int_equal(g_upload_addr, 0x1122);
     assert_int_equal(g_upload_size, 0x3344);
     assert_int_equal(ctx.flash_sequence, 0);
@@ -42,10 +42,10 @@ static int mock_did_write_fn(uds_ctx_t *ctx, uint16_t did, const uint8_t *data,
 }
 
 static const uds_did_entry_t g_test_dids[] = {
-    {0xF190, 8, UDS_SESSION_ALL, 0, NULL, NULL, &g_val_8},          /* Direct Storage */
-    {0x0100, 1, UDS_SESSION_ALL, 0, mock_did_read_fn, NULL, NULL},  /* Read Callback */
-    {0x0200, 3, UDS_SESSION_ALL, 0, NULL, mock_did_write_fn, NULL}, /* Write Callback */
-    {0x5EC1, 4, UDS_SESSION_ALL, 0x04, NULL, NULL, &g_val_8},       /* Security Level 2 Required */
+    {0xF190, 8, UDS_SESSION_ALL, 0, NULL, NULL, &g_val_8, 0},          /* Direct Storage */
+    {0x0100, 1, UDS_SESSION_ALL, 0, mock_did_read_fn, NULL, NULL, 0},  /* Read Callback */
+    {0x0200, 3, UDS_SESSION_ALL, 0, NULL, mock_did_write_fn, NULL, 0}, /* Write Callback */
+    {0x5EC1, 4, UDS_SESSION_ALL, 0x04, NULL, NULL, &g_val_8, 0},       /* Needs Security Level 2 */
 };
 
 static const uds_did_table_t g_test_table = {.entries = g_test_dids, .count = 4};
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_stats.c
+ * @brief Unit tests for per-SID counters and latency histograms
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_stats.h"
+
+static uint32_t g_now_us;
+static uint32_t g_work_us;
+static uint16_t g_sent_len;
+
+static uint32_t fake_time_us(void)
+{
+    return g_now_us;
+}
+
+static int stats_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    g_sent_len = len;
+    return 0;
+}
+
+static int sync_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) len;
+    g_now_us += g_work_us;
+    ctx->config->tx_buffer[0] = (uint8_t) (data[0] + 0x40u);
+    return uds_send_response(ctx, 1);
+}
+
+static int pending_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    g_now_us += 100u;
+    return UDS_PENDING;
+}
+
+static const uds_service_entry_t g_stats_services[] = {
+    {0x31, 2, UDS_SESSION_ALL, 0, sync_handler, NULL},
+    {0xBA, 1, UDS_SESSION_ALL, 0, pending_handler, NULL},
+};
+
+static const uds_did_entry_t g_stats_dids[] = {
+    {UDS_DID_STACK_STATISTICS, UDS_STATS_DID_SIZE, 0, 0, uds_stats_read_did, NULL, NULL, 0},
+};
+
+static uds_stats_t g_stats;
+
+static void setup_stats(uds_ctx_t *ctx, uds_config_t *cfg)
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_now_us = 1000000u;
+    g_work_us = 0u;
+
+    setup_ctx(ctx, cfg);
+    cfg->fn_tp_send = stats_tp_send;
+    cfg->user_services = g_stats_services;
+    cfg->user_service_count = 2;
+    cfg->did_table.entries = g_stats_dids;
+    cfg->did_table.count = 1;
+    cfg->stats = &g_stats;
+    cfg->get_time_us = fake_time_us;
+}
+
+static void send_request(uds_ctx_t *ctx, const uint8_t *req, uint16_t len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(ctx, req, len);
+}
+
+static void test_counts_responses_and_nrcs(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_stats(&ctx, &cfg);
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    uint8_t bad_session[] = {0x10, 0x7F};
+    send_request(&ctx, tester_present, sizeof(tester_present));
+    send_request(&ctx, tester_present, sizeof(tester_present));
+    send_request(&ctx, bad_session, sizeof(bad_session));
+
+    const uds_sid_stats_t *tp = uds_stats_get(&ctx, 0x3E);
+    assert_non_null(tp);
+    assert_int_equal(tp->requests, 2);
+    assert_int_equal(tp->positive, 2);
+    assert_int_equal(tp->negative, 0);
+
+    const uds_sid_stats_t *sess = uds_stats_get(&ctx, 0x10);
+    assert_non_null(sess);
+    assert_int_equal(sess->requests, 1);
+    assert_int_equal(sess->negative, 1);
+    assert_int_equal(sess->nrc[uds_stats_nrc_bucket(0x12)], 1);
+    assert_int_equal(uds_stats_nrc_bucket(0x93), UDS_STATS_NRC_OTHER);
+
+    assert_null(uds_stats_get(&ctx, 0x22));
+}
+
+static void test_latency_histogram_and_near_miss(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_stats(&ctx, &cfg);
+
+    uint8_t routine[] = {0x31, 0x01};
+    g_work_us = 3000u; /* bucket 11: [2048, 4096) */
+    send_request(&ctx, routine, sizeof(routine));
+    g_work_us = 45000u; /* Above 80 % of P2 (50 ms) */
+    send_request(&ctx, routine, sizeof(routine));
+
+    const uds_sid_stats_t *entry = uds_stats_get(&ctx, 0x31);
+    assert_int_equal(entry->latency_hist[11], 1);
+    assert_int_equal(entry->latency_hist[15], 1);
+    assert_int_equal(entry->max_latency_us, 45000);
+    assert_int_equal(entry->max_handler_us, 45000);
+    assert_int_equal(entry->p2_near_miss, 1);
+}
+
+static void test_pending_latency_until_completion(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_stats(&ctx, &cfg);
+
+    uint8_t request[] = {0xBA};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, request, sizeof(request));
+
+    const uds_sid_stats_t *entry = uds_stats_get(&ctx, 0xBA);
+    assert_int_equal(entry->rcrrp, 1);
+    assert_int_equal(entry->max_handler_us, 100);
+    assert_int_equal(entry->max_latency_us, 0);
+
+    g_now_us += 200000u;
+    g_tx_buf[0] = 0xFA;
+    uds_send_response(&ctx, 1);
+
+    assert_int_equal(entry->positive, 1);
+    assert_int_equal(entry->max_latency_us, 200100);
+    assert_int_equal(entry->latency_hist[17], 1);
+}
+
+static void test_statistics_did_export(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_stats(&ctx, &cfg);
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    send_request(&ctx, tester_present, sizeof(tester_present));
+
+    uint8_t read[] = {0x22, 0xFD, 0xF0};
+    send_request(&ctx, read, sizeof(read));
+
+    assert_int_equal(g_sent_len, 3 + UDS_STATS_DID_SIZE);
+    const uint8_t *rec = &g_tx_buf[3];
+    assert_int_equal(rec[0], 0x3E);
+    assert_int_equal(rec[4], 1); /* requests */
+    assert_int_equal(rec[8], 1); /* positive */
+
+    rec = &g_tx_buf[3 + UDS_STATS_DID_RECORD_SIZE];
+    assert_int_equal(rec[0], 0x22);
+    assert_int_equal(rec[4], 1);
+    assert_int_equal(rec[8], 0); /* Response still being built */
+
+    uds_stats_reset(&ctx);
+    assert_null(uds_stats_get(&ctx, 0x3E));
+}
+
+static void test_disabled_statistics(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_stats(&ctx, &cfg);
+    cfg.stats = NULL;
+
+    uint8_t buf[UDS_STATS_DID_SIZE];
+    assert_null(uds_stats_get(&ctx, 0x3E));
+    assert_int_equal(uds_stats_read_did(&ctx, UDS_DID_STACK_STATISTICS, buf, sizeof(buf)), -0x22);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_counts_responses_and_nrcs),
+        cmocka_unit_test(test_latency_histogram_and_near_miss),
+        cmocka_unit_test(test_pending_latency_until_completion),
+        cmocka_unit_test(test_statistics_did_export),
+        cmocka_unit_test(test_disabled_statistics),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_timer_wheel.c
+ * @brief Unit tests for the shared hierarchical timer wheel
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_timer_wheel.h"
+
+static int mock_pending_handler(struct uds_ctx *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    return UDS_PENDING;
+}
+
+static const uds_service_entry_t g_async_services[] = {
+    {0x31, 4, UDS_SESSION_ALL, 0, mock_pending_handler, NULL},
+};
+
+static void test_idle_contexts_not_processed(void **state)
+{
+    (void) state;
+    uds_timer_wheel_t wheel;
+    uds_ctx_t ctx[3];
+    uds_config_t cfg[3];
+
+    uds_timer_wheel_init(&wheel, 1000);
+    for (int i = 0; i < 3; i++) {
+        setup_ctx(&ctx[i], &cfg[i]);
+        assert_int_equal(uds_timer_wheel_attach(&wheel, &ctx[i]), UDS_OK);
+    }
+
+    /* No deadlines registered: no uds_process() and therefore no get_time_ms() calls */
+    assert_int_equal(uds_timer_wheel_process(&wheel, 2000), 0);
+    assert_int_equal(uds_timer_wheel_process(&wheel, 100000), 0);
+    assert_int_equal(wheel.armed, 0);
+}
+
+static void test_p2_deadline_fires_only_owner(void **state)
+{
+    (void) state;
+    uds_timer_wheel_t wheel;
+    uds_ctx_t idle_ctx, busy_ctx;
+    uds_config_t idle_cfg, busy_cfg;
+
+    uds_timer_wheel_init(&wheel, 1000);
+    setup_ctx(&idle_ctx, &idle_cfg);
+    setup_ctx(&busy_ctx, &busy_cfg);
+    busy_cfg.user_services = g_async_services;
+    busy_cfg.user_service_count = 1;
+    busy_ctx.p2_star_ms = 100;
+    uds_timer_wheel_attach(&wheel, &idle_ctx);
+    uds_timer_wheel_attach(&wheel, &busy_ctx);
+
+    /* Async request: immediate NRC 0x78, P2* deadline at 1100 */
+    uint8_t req[] = {0x31, 0x01, 0xFF, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&busy_ctx, req, sizeof(req));
+
+    assert_true(busy_ctx.timer_node.armed);
+    assert_int_equal(busy_ctx.timer_node.expires, 1100);
+    assert_false(idle_ctx.timer_node.armed);
+
+    assert_int_equal(uds_timer_wheel_process(&wheel, 1099), 0);
+
+    /* Deadline reached: only the busy context is processed and repeats NRC 0x78 */
+    will_return(mock_get_time, 1100);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 3);
+    will_return(mock_tp_send, 0);
+    assert_int_equal(uds_timer_wheel_process(&wheel, 1100), 1);
+    assert_int_equal(g_tx_buf[2], 0x78);
+
+    /* Re-armed for the next P2* period */
+    assert_true(busy_ctx.timer_node.armed);
+    assert_int_equal(busy_ctx.timer_node.expires, 1200);
+}
+
+static void test_s3_deadline_cascades_levels(void **state)
+{
+    (void) state;
+    uds_timer_wheel_t wheel;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+
+    uds_timer_wheel_init(&wheel, 1000);
+    setup_ctx(&ctx, &cfg);
+    uds_timer_wheel_attach(&wheel, &ctx);
+
+    uint8_t req[] = {0x10, 0x03};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, 6);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(&ctx, req, sizeof(req));
+
+    /* S3 deadline lives in a higher wheel level and must cascade down */
+    assert_int_equal(ctx.timer_node.expires, 1000 + 5000 + 1);
+    assert_int_equal(uds_timer_wheel_process(&wheel, 6000), 0);
+
+    will_return(mock_get_time, 6001);
+    assert_int_equal(uds_timer_wheel_process(&wheel, 6001), 1);
+    assert_int_equal(ctx.active_session, 0x01);
+    assert_false(ctx.timer_node.armed);
+
+    uds_timer_wheel_detach(&ctx);
+    assert_null(ctx.timer_wheel);
+}
+
+static void test_long_gap_fires_each_deadline(void **state)
+{
+    (void) state;
+    uds_timer_wheel_t wheel;
+    uds_ctx_t ctx[2];
+    uds_config_t cfg[2];
+    const uint8_t req[] = {0x10, 0x03};
+
+    uds_timer_wheel_init(&wheel, 1000);
+    for (int i = 0; i < 2; i++) {
+        setup_ctx(&ctx[i], &cfg[i]);
+        uds_timer_wheel_attach(&wheel, &ctx[i]);
+        will_return(mock_get_time, 1000 + 777 * i);
+        will_return(mock_get_time, 1000 + 777 * i);
+        expect_any(mock_tp_send, data);
+        expect_value(mock_tp_send, len, 6);
+        will_return(mock_tp_send, 0);
+        uds_input_sdu(&ctx[i], req, sizeof(req));
+    }
+    assert_int_equal(ctx[0].timer_node.expires, 6001);
+    assert_int_equal(ctx[1].timer_node.expires, 6778);
+
+    /* One call across both deadlines and several cascade boundaries */
+    will_return(mock_get_time, 7000);
+    will_return(mock_get_time, 7000);
+    assert_int_equal(uds_timer_wheel_process(&wheel, 7000), 2);
+    assert_int_equal(wheel.current, 7000);
+    assert_int_equal(ctx[0].active_session, 0x01);
+    assert_int_equal(ctx[1].active_session, 0x01);
+    assert_int_equal(wheel.armed, 0);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_idle_contexts_not_processed),
+        cmocka_unit_test(test_p2_deadline_fires_only_owner),
+        cmocka_unit_test(test_s3_deadline_cascades_levels),
+        cmocka_unit_test(test_long_gap_fires_each_deadline),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
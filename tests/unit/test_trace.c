@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_trace.c
+ * @brief Unit tests for the binary event trace ring
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_trace.h"
+
+static uint32_t g_now_us;
+
+static uint32_t fake_time_us(void)
+{
+    return g_now_us++;
+}
+
+static int quiet_tp_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    return 0;
+}
+
+static void test_init_rejects_bad_capacity(void **state)
+{
+    (void) state;
+    uds_trace_ring_t ring;
+    uds_trace_record_t records[6];
+
+    assert_int_equal(uds_trace_init(&ring, records, 6), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_trace_init(&ring, records, 0), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_trace_init(&ring, NULL, 4), UDS_ERR_INVALID_ARG);
+    assert_int_equal(uds_trace_init(&ring, records, 4), UDS_OK);
+}
+
+static void test_full_ring_drops_and_wraps(void **state)
+{
+    (void) state;
+    uds_trace_ring_t ring;
+    uds_trace_record_t records[4];
+    uds_trace_record_t out[8];
+    uds_trace_init(&ring, records, 4);
+
+    for (uint16_t i = 0u; i < 6u; i++) {
+        uds_trace_write(&ring, i, 0x80u, 0x22u, i);
+    }
+    assert_int_equal(ring.dropped, 2);
+
+    assert_int_equal(uds_trace_read(&ring, out, 3), 3);
+    assert_int_equal(out[0].arg, 0);
+    assert_int_equal(out[2].arg, 2);
+
+    /* Freed slots are reused across the end of the storage */
+    uds_trace_write(&ring, 10u, 0x81u, 0x00u, 10u);
+    assert_int_equal(uds_trace_read(&ring, out, 8), 2);
+    assert_int_equal(out[0].arg, 3);
+    assert_int_equal(out[1].event, 0x81);
+    assert_int_equal(out[1].timestamp, 10);
+    assert_int_equal(uds_trace_read(&ring, out, 8), 0);
+}
+
+static void test_core_records_request_and_responses(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_trace_ring_t ring;
+    uds_trace_record_t records[8];
+    uds_trace_record_t out[8];
+
+    setup_ctx(&ctx, &cfg);
+    cfg.fn_tp_send = quiet_tp_send;
+    cfg.get_time_us = fake_time_us;
+    uds_trace_init(&ring, records, 8);
+    cfg.trace = &ring;
+    g_now_us = 500u;
+
+    uint8_t tester_present[] = {0x3E, 0x00};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, tester_present, sizeof(tester_present));
+
+    uint8_t unknown[] = {0xA5};
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, unknown, sizeof(unknown));
+
+    assert_int_equal(uds_trace_read(&ring, out, 8), 4);
+
+    assert_int_equal(out[0].event, UDS_TRACE_EV_REQUEST);
+    assert_int_equal(out[0].sid, 0x3E);
+    assert_int_equal(out[0].arg, 2);
+    assert_int_equal(out[0].timestamp, 500);
+
+    assert_int_equal(out[1].event, UDS_TRACE_EV_RESPONSE);
+    assert_int_equal(out[1].sid, 0x3E);
+    assert_int_equal(out[1].arg, 2);
+    assert_true(out[1].timestamp > out[0].timestamp);
+
+    assert_int_equal(out[2].event, UDS_TRACE_EV_REQUEST);
+    assert_int_equal(out[3].event, UDS_TRACE_EV_NRC);
+    assert_int_equal(out[3].sid, 0xA5);
+    assert_int_equal(out[3].arg, 0x11);
+}
+
+static void test_busy_request_is_traced(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    uds_trace_ring_t ring;
+    uds_trace_record_t records[8];
+    uds_trace_record_t out[8];
+
+    setup_ctx(&ctx, &cfg);
+    cfg.fn_tp_send = quiet_tp_send;
+    cfg.get_time_us = fake_time_us;
+    uds_trace_init(&ring, records, 8);
+    cfg.trace = &ring;
+    ctx.p2_msg_pending = true;
+    ctx.pending_sid = 0x31;
+
+    uint8_t read[] = {0x22, 0xF1, 0x90};
+    will_return(mock_get_time, 1000);
+    uds_input_sdu(&ctx, read, sizeof(read));
+
+    assert_int_equal(uds_trace_read(&ring, out, 8), 3);
+    assert_int_equal(out[1].event, UDS_TRACE_EV_BUSY);
+    assert_int_equal(out[1].arg, 0);
+    assert_int_equal(out[2].event, UDS_TRACE_EV_NRC);
+    assert_int_equal(out[2].arg, 0x21);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_init_rejects_bad_capacity),
+        cmocka_unit_test(test_full_ring_drops_and_wraps),
+        cmocka_unit_test(test_core_records_request_and_responses),
+        cmocka_unit_test(test_busy_request_is_traced),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file test_transfer_pipe.c
+ * @brief Unit tests for pipelined TransferData (SID 0x36)
+ */
+
+#include "test_helpers.h"
+#include "uds/uds_transfer_pipe.h"
+
+#define SLOT_SIZE 8u
+
+static uint8_t g_slots[2 * SLOT_SIZE];
+static uds_transfer_pipe_t g_pipe;
+static uds_job_t *g_submitted;
+static uint8_t g_flash[64];
+static uint16_t g_flash_len;
+static int g_write_result;
+static int g_exits;
+
+static int manual_submit(void *executor, uds_job_t *job)
+{
+    (void) executor;
+    g_submitted = job;
+    return 0;
+}
+
+static int flash_write(struct uds_ctx *ctx, uint8_t sequence, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) sequence;
+    if (g_write_result < 0) {
+        return g_write_result;
+    }
+    memcpy(&g_flash[g_flash_len], data, len);
+    g_flash_len = (uint16_t) (g_flash_len + len);
+    return UDS_OK;
+}
+
+static int transfer_exit(struct uds_ctx *ctx)
+{
+    (void) ctx;
+    g_exits++;
+    return UDS_OK;
+}
+
+static int request_download(struct uds_ctx *ctx, uint32_t addr, uint32_t size)
+{
+    (void) ctx;
+    (void) addr;
+    (void) size;
+    return UDS_OK;
+}
+
+static void setup_pipe(uds_ctx_t *ctx, uds_config_t *cfg, bool executor)
+{
+    g_submitted = NULL;
+    g_flash_len = 0u;
+    g_write_result = UDS_OK;
+    g_exits = 0;
+
+    setup_ctx(ctx, cfg);
+    uds_transfer_pipe_init(&g_pipe, g_slots, SLOT_SIZE, 2);
+    cfg->transfer_pipe = &g_pipe;
+    cfg->fn_transfer_data = flash_write;
+    cfg->fn_transfer_exit = transfer_exit;
+    cfg->fn_request_download = request_download;
+    if (executor) {
+        cfg->fn_job_submit = manual_submit;
+    }
+}
+
+/* Request answered at once with resp_len bytes */
+static void send(uds_ctx_t *ctx, const uint8_t *req, uint16_t len, uint16_t resp_len)
+{
+    will_return(mock_get_time, 1000);
+    will_return(mock_get_time, 1000);
+    expect_any(mock_tp_send, data);
+    expect_value(mock_tp_send, len, resp_len);
+    will_return(mock_tp_send, 0);
+    uds_input_sdu(ctx, req, len);
+}
+
+/* Request that goes pending with NRC 0x78 */
+static void send_pending(uds_ctx_t *ctx, const uint8_t *req, uint16_t len)
+{
+    will_return(mock_get_time, 1000);
+    send(ctx, req, len, 3);
+    assert_int_equal(g_tx_buf[2], 0x78);
+    assert_true(ctx->p2_msg_pending);
+}
+
+/* Executor finishes the running write */
+static void run_write(uds_job_t *job, uint16_t resp_len)
+{
+    if (resp_len > 0u) {
+        expect_any(mock_tp_send, data);
+        expect_value(mock_tp_send, len, resp_len);
+        will_return(mock_tp_send, 0);
+    }
+    uds_job_execute(job);
+}
+
+static const uint8_t g_block1[] = {0x36, 0x01, 0x10, 0x11, 0x12, 0x13};
+static const uint8_t g_block2[] = {0x36, 0x02, 0x20, 0x21, 0x22, 0x23};
+static const uint8_t g_block3[] = {0x36, 0x03, 0x30, 0x31};
+static const uint8_t g_exit[] = {0x37};
+
+static void test_blocks_acknowledged_while_writing(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pipe(&ctx, &cfg, true);
+
+    /* Staged and acknowledged before the flash is written */
+    send(&ctx, g_block1, sizeof(g_block1), 2);
+    assert_int_equal(g_tx_buf[0], 0x76);
+    assert_int_equal(g_tx_buf[1], 0x01);
+    assert_ptr_equal(g_submitted, &g_pipe.write);
+    assert_int_equal(g_flash_len, 0);
+
+    /* Both slots in use: block 2 waits until block 1 is written */
+    send_pending(&ctx, g_block2, sizeof(g_block2));
+    assert_int_equal(g_pipe.stalls, 1u);
+
+    run_write(g_submitted, 2);
+    assert_int_equal(g_tx_buf[0], 0x76);
+    assert_int_equal(g_tx_buf[1], 0x02);
+    assert_false(ctx.p2_msg_pending);
+    assert_int_equal(g_flash_len, 4);
+
+    /* Block 3 is received while block 2 is written */
+    send_pending(&ctx, g_block3, sizeof(g_block3));
+    run_write(g_submitted, 2);
+    assert_int_equal(g_tx_buf[1], 0x03);
+    run_write(g_submitted, 0);
+
+    const uint8_t image[] = {0x10, 0x11, 0x12, 0x13, 0x20, 0x21, 0x22, 0x23, 0x30, 0x31};
+    assert_int_equal(g_flash_len, sizeof(image));
+    assert_memory_equal(g_flash, image, sizeof(image));
+    assert_int_equal(g_pipe.written, 3u);
+    assert_int_equal(g_pipe.count, 0);
+
+    send(&ctx, g_exit, sizeof(g_exit), 1);
+    assert_int_equal(g_tx_buf[0], 0x77);
+    assert_int_equal(g_exits, 1);
+}
+
+static void test_exit_waits_for_last_write(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pipe(&ctx, &cfg, true);
+
+    send(&ctx, g_block1, sizeof(g_block1), 2);
+    send_pending(&ctx, g_exit, sizeof(g_exit));
+    assert_int_equal(g_exits, 0);
+
+    run_write(g_submitted, 1);
+    assert_int_equal(g_tx_buf[0], 0x77);
+    assert_int_equal(g_exits, 1);
+    assert_int_equal(g_flash_len, 4);
+}
+
+static void test_failed_write_ends_transfer(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pipe(&ctx, &cfg, true);
+
+    send(&ctx, g_block1, sizeof(g_block1), 2);
+    send_pending(&ctx, g_block2, sizeof(g_block2));
+
+    /* Block 1 fails: the waiting block 2 gets the write's NRC */
+    g_write_result = -0x72;
+    uds_job_t *job = g_submitted;
+    g_submitted = NULL;
+    run_write(job, 3);
+    assert_int_equal(g_tx_buf[0], 0x7F);
+    assert_int_equal(g_tx_buf[1], 0x36);
+    assert_int_equal(g_tx_buf[2], 0x72);
+    assert_null(g_submitted); /* Block 2 is dropped */
+    assert_int_equal(g_pipe.count, 0);
+
+    /* Sticky until the next RequestDownload */
+    send(&ctx, g_block3, sizeof(g_block3), 3);
+    assert_int_equal(g_tx_buf[2], 0x72);
+    send(&ctx, g_exit, sizeof(g_exit), 3);
+    assert_int_equal(g_tx_buf[1], 0x37);
+    assert_int_equal(g_tx_buf[2], 0x72);
+    assert_int_equal(g_exits, 0);
+
+    const uint8_t download[] = {0x34, 0x00, 0x11, 0x00, 0x10};
+    send(&ctx, download, sizeof(download), 3);
+    assert_int_equal(g_tx_buf[0], 0x74);
+    assert_int_equal(g_tx_buf[2], SLOT_SIZE + 2u); /* Blocks fit a slot */
+    assert_int_equal(g_pipe.error, 0);
+
+    g_write_result = UDS_OK;
+    send(&ctx, g_block1, sizeof(g_block1), 2);
+    assert_int_equal(g_tx_buf[0], 0x76);
+}
+
+static void test_inline_without_executor(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    setup_pipe(&ctx, &cfg, false);
+
+    /* Written before the response, as without the pipe */
+    send(&ctx, g_block1, sizeof(g_block1), 2);
+    assert_int_equal(g_flash_len, 4);
+    send(&ctx, g_block2, sizeof(g_block2), 2);
+    assert_int_equal(g_flash_len, 8);
+    assert_int_equal(g_pipe.stalls, 0u);
+
+    g_write_result = -0x72;
+    send(&ctx, g_block3, sizeof(g_block3), 3);
+    assert_int_equal(g_tx_buf[2], 0x72);
+
+    /* Blocks larger than a slot */
+    const uint8_t big[] = {0x36, 0x01, 0, 1, 2, 3, 4, 5, 6, 7, 8};
+    g_pipe.error = 0u;
+    ctx.flash_sequence = 0u;
+    send(&ctx, big, sizeof(big), 3);
+    assert_int_equal(g_tx_buf[2], 0x13);
+
+    /* Rejected configurations */
+    g_pipe.slot_count = 0u;
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_ERR_INVALID_ARG);
+    g_pipe.slot_count = UDS_TRANSFER_PIPE_MAX_SLOTS + 1u;
+    assert_int_equal(uds_init(&ctx, &cfg), UDS_ERR_INVALID_ARG);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_blocks_acknowledged_while_writing),
+        cmocka_unit_test(test_exit_waits_for_last_write),
+        cmocka_unit_test(test_failed_write_ends_transfer),
+        cmocka_unit_test(test_inline_without_executor),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -10,9 +10,11 @@
 #include <cmocka.h>
 #include <string.h>
 
+#include "uds/uds_buffer_pool.h"
 #include "uds/uds_core.h"
 #include "uds/uds_isotp.h"
 #include "uds/uds_config.h"
+#include "uds/uds_response.h"
 
 /* Mock CAN Send */
 int mock_can_send(uint32_t id, const uint8_t *data, uint8_t len)
@@ -79,6 +81,35 @@ static void test_send_ff(void **state)
     /* Note: State is now ISOTP_TX_WAIT_FC */
 }
 
+/* 2b. Scatter-gather send: segments gathered into one SF / FF */
+static void test_sendv_gathers_segments(void **state)
+{
+    (void) state;
+    uint8_t head[] = {0x62, 0xF1};
+    uint8_t tail[] = {0x90, 0x01};
+    uds_iovec_t iov[] = {{head, 2}, {tail, 2}};
+    uint8_t expected_sf[] = {0x04, 0x62, 0xF1, 0x90, 0x01, 0x00, 0x00, 0x00};
+
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_memory(mock_can_send, data, expected_sf, 8);
+    will_return(mock_can_send, 0);
+    assert_int_equal(uds_isotp_sendv(NULL, iov, 2, 4), 0);
+
+    uint8_t big[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    uds_iovec_t iov_mf[] = {{head, 2}, {big, 8}};
+    uint8_t expected_ff[] = {0x10, 0x0A, 0x62, 0xF1, 0x01, 0x02, 0x03, 0x04};
+
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_memory(mock_can_send, data, expected_ff, 8);
+    will_return(mock_can_send, 0);
+    assert_int_equal(uds_isotp_sendv(NULL, iov_mf, 2, 10), 0);
+
+    /* Segment lengths must add up to the SDU length */
+    assert_int_equal(uds_isotp_sendv(NULL, iov, 2, 5), -1);
+}
+
 /* 3. Receive Flow Control (FC) and Send Consecutive Frames (CF) */
 static void test_recv_fc_send_cf(void **state)
 {
@@ -125,6 +156,94 @@ static void test_recv_fc_send_cf(void **state)
     uds_tp_isotp_process(0);
 }
 
+/* Body byte k of a streamed SDU is k + 1 */
+static int stream_counter(struct uds_ctx *ctx, void *arg, uint32_t pos, uint8_t *buf,
+                          uint16_t len)
+{
+    (void) ctx;
+    (void) arg;
+    for (uint16_t k = 0u; k < len; k++) {
+        buf[k] = (uint8_t) (pos + k);
+    }
+    return 0;
+}
+
+static int g_lock_depth;
+static int g_lock_calls;
+
+static void count_lock(void *handle)
+{
+    (void) handle;
+    g_lock_depth++;
+    g_lock_calls++;
+}
+
+static void count_unlock(void *handle)
+{
+    (void) handle;
+    g_lock_depth--;
+}
+
+/* 3b. Streamed SDU above 4095 bytes: escape FF, CFs pulled from the producer */
+static void test_send_stream_escape_ff(void **state)
+{
+    (void) state;
+    uds_ctx_t ctx;
+    uds_config_t cfg;
+    memset(&ctx, 0, sizeof(ctx));
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.fn_mutex_lock = count_lock;
+    cfg.fn_mutex_unlock = count_unlock;
+    ctx.config = &cfg;
+    g_lock_depth = 0;
+    g_lock_calls = 0;
+    ctx.stream.fn = stream_counter;
+    ctx.stream.start = 1u;
+    ctx.stream.len = 5000u;
+    ctx.stream.head[0] = 0x63;
+    ctx.stream.head_len = 1u;
+    ctx.stream.active = true;
+
+    /* 10 00 + 32-bit length 5000, then the head and body bytes 1 */
+    uint8_t expected_ff[] = {0x10, 0x00, 0x00, 0x00, 0x13, 0x88, 0x63, 0x01};
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_memory(mock_can_send, data, expected_ff, 8);
+    will_return(mock_can_send, 0);
+    assert_int_equal(uds_isotp_send_stream(&ctx, 5000u), 0);
+
+    uint8_t fc_frame[] = {0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    uds_isotp_rx_callback(&ctx, 0x7E8, fc_frame, 8);
+
+    /* A failed CAN send retries the same bytes */
+    uint8_t expected_cf[] = {0x21, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_memory(mock_can_send, data, expected_cf, 8);
+    will_return(mock_can_send, -1);
+    uds_tp_isotp_process(0);
+
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_memory(mock_can_send, data, expected_cf, 8);
+    will_return(mock_can_send, 0);
+    uds_tp_isotp_process(1);
+
+    uint8_t expected_cf2[] = {0x22, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_memory(mock_can_send, data, expected_cf2, 8);
+    will_return(mock_can_send, 0);
+    uds_tp_isotp_process(2);
+
+    assert_int_equal(ctx.stream.pos, 2u + 14u);
+    assert_true(ctx.stream.active);
+
+    /* The FF was pulled by the caller; each CF pull takes the context lock once */
+    assert_int_equal(g_lock_calls, 2);
+    assert_int_equal(g_lock_depth, 0);
+}
+
 /* 4. Receive Single Frame (SF) */
 static void test_recv_sf(void **state)
 {
@@ -180,14 +299,147 @@ static void test_recv_multiframe(void **state)
     uds_isotp_rx_callback(&dummy_ctx, 0x7E8, cf_frame, 8);
 }
 
+/* 6. Receive Escape First Frame on CAN-FD (SDU > 4095 bytes) */
+static void test_recv_escape_ff(void **state)
+{
+    (void) state;
+    static uint8_t rx_buffer[4200];
+    static uint8_t expected[4100];
+    struct uds_ctx dummy_ctx;
+    uds_config_t config = {0};
+    config.rx_buffer = rx_buffer;
+    config.rx_buffer_size = sizeof(rx_buffer);
+    dummy_ctx.config = &config;
+    for (uint32_t i = 0; i < sizeof(expected); i++) {
+        expected[i] = (uint8_t) i;
+    }
+
+    /* Limits: 12-bit FF_DL on Classic CAN, escape FF on CAN-FD */
+    assert_int_equal(uds_isotp_max_sdu(&dummy_ctx, false), 4095);
+    assert_int_equal(uds_isotp_max_sdu(&dummy_ctx, true), 1024);
+    uds_tp_isotp_set_fd(true);
+    assert_int_equal(uds_isotp_max_sdu(&dummy_ctx, false), UINT32_MAX);
+
+    /* Escape FF announcing 4095 bytes or less is ignored: no FC */
+    uint8_t frame[64] = {0x10, 0x00, 0x00, 0x00, 0x0F, 0xFF};
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 64);
+
+    /* Escape FF too short for its length or payload is ignored */
+    frame[4] = 0x10;
+    frame[5] = 0x04;
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 4);
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 6);
+
+    /* FF: 10 00 00 00 10 04 + 58 bytes */
+    frame[4] = 0x10;
+    frame[5] = 0x04;
+    memcpy(&frame[6], expected, 58);
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_any(mock_can_send, data);
+    will_return(mock_can_send, 0);
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 64);
+
+    /* CFs of 63 bytes */
+    uint32_t pos = 58u;
+    uint8_t sn = 1u;
+    while (pos < sizeof(expected)) {
+        uint32_t chunk = sizeof(expected) - pos;
+        if (chunk > 63u) {
+            chunk = 63u;
+        }
+        frame[0] = (uint8_t) (0x20u | sn);
+        memcpy(&frame[1], &expected[pos], chunk);
+        pos += chunk;
+        sn = (uint8_t) ((sn + 1u) & 0x0Fu);
+        if (pos == sizeof(expected)) {
+            expect_memory(__wrap_uds_input_sdu, data, expected, sizeof(expected));
+            expect_value(__wrap_uds_input_sdu, len, sizeof(expected));
+        }
+        uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 64);
+    }
+}
+
+/* 7. Pool mode: malformed First Frames must not overrun the borrowed block */
+static void test_recv_ff_pool_bounds(void **state)
+{
+    (void) state;
+    static uint8_t storage[2 * 16];
+    static uint32_t used[UDS_BUFFER_POOL_WORDS(2)];
+    uds_buffer_pool_t pool;
+    uds_buffer_pool_init(&pool);
+    uds_buffer_pool_add_class(&pool, storage, used, 16, 2);
+
+    struct uds_ctx dummy_ctx;
+    uds_config_t config = {0};
+    config.buffer_pool = &pool;
+    config.rx_buffer_size = 16;
+    dummy_ctx.config = &config;
+    uds_tp_isotp_set_fd(true);
+
+    /* CAN-FD FF announcing 12 bytes but carrying 62: ignored, nothing borrowed */
+    uint8_t frame[64];
+    memset(frame, 0xAB, sizeof(frame));
+    frame[0] = 0x10;
+    frame[1] = 12;
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 64);
+    assert_int_equal(pool.in_use, 0);
+    assert_int_equal(storage[16], 0x00);
+
+    /* Too short to carry any payload */
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 2);
+    assert_int_equal(pool.in_use, 0);
+
+    /* Valid FF of 16 bytes (6 in the FF), then an oversized CF */
+    uint8_t ff[8] = {0x10, 16, 1, 2, 3, 4, 5, 6};
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_any(mock_can_send, data);
+    will_return(mock_can_send, 0);
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, ff, 8);
+    assert_int_equal(pool.in_use, 1);
+
+    uint8_t expected[16] = {1, 2, 3, 4, 5, 6};
+    memset(&expected[6], 0xAB, 10);
+    memset(frame, 0xAB, sizeof(frame));
+    frame[0] = 0x21;
+    expect_memory(__wrap_uds_input_sdu, data, expected, 16);
+    expect_value(__wrap_uds_input_sdu, len, 16);
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 64); /* Only 10 bytes are copied */
+    assert_int_equal(pool.in_use, 0);
+    assert_int_equal(storage[16], 0x00);
+
+    /* N_Cr: a tester that stops after the FF loses its block */
+    expect_value(mock_can_send, id, 0x7E0);
+    expect_value(mock_can_send, len, 8);
+    expect_any(mock_can_send, data);
+    will_return(mock_can_send, 0);
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, ff, 8);
+    assert_int_equal(pool.in_use, 1);
+    uds_tp_isotp_process(5000);
+    uds_tp_isotp_process(5000 + ISOTP_TIMEOUT_N_CR_MS);
+    assert_int_equal(pool.in_use, 1);
+    uds_tp_isotp_process(5000 + ISOTP_TIMEOUT_N_CR_MS + 1u);
+    assert_int_equal(pool.in_use, 0);
+
+    /* A late CF is dropped */
+    frame[0] = 0x21;
+    uds_isotp_rx_callback(&dummy_ctx, 0x7E8, frame, 8);
+    assert_int_equal(pool.in_use, 0);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup_teardown(test_send_sf, setup, teardown),
         cmocka_unit_test_setup_teardown(test_send_ff, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sendv_gathers_segments, setup, teardown),
         cmocka_unit_test_setup_teardown(test_recv_fc_send_cf, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_send_stream_escape_ff, setup, teardown),
         cmocka_unit_test_setup_teardown(test_recv_sf, setup, teardown),
         cmocka_unit_test_setup_teardown(test_recv_multiframe, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_recv_escape_ff, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_recv_ff_pool_bounds, setup, teardown),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 Andrii Shylenko
+# SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+
+"""Decode a binary UDS event trace (uds_trace_record_t dump) into text.
+
+The dump is the raw record array as read with uds_trace_read(): 8 bytes per
+record (uint32 timestamp, uint8 event, uint8 sid, uint16 arg) in target byte
+order.
+
+Usage: decode_trace.py trace.bin [--big-endian]
+"""
+
+import argparse
+import struct
+import sys
+
+RECORD_SIZE = 8
+
+NRC_NAMES = {
+    0x10: "generalReject",
+    0x11: "serviceNotSupported",
+    0x12: "subFunctionNotSupported",
+    0x13: "incorrectMessageLength",
+    0x14: "responseTooLong",
+    0x21: "busyRepeatRequest",
+    0x22: "conditionsNotCorrect",
+    0x24: "requestSequenceError",
+    0x31: "requestOutOfRange",
+    0x33: "securityAccessDenied",
+    0x35: "invalidKey",
+    0x36: "exceededNumberOfAttempts",
+    0x37: "requiredTimeDelayNotExpired",
+    0x70: "uploadDownloadNotAccepted",
+    0x72: "generalProgrammingFailure",
+    0x78: "responsePending",
+    0x7F: "serviceNotSupportedInActiveSession",
+}
+
+
+def fmt_nrc(arg):
+    return f"NRC 0x{arg:02X} ({NRC_NAMES.get(arg, 'unknown')})"
+
+
+EVENTS = {
+    0x01: ("REQUEST", lambda a: f"len={a}"),
+    0x02: ("RESPONSE", lambda a: f"len={a}"),
+    0x03: ("NRC", fmt_nrc),
+    0x04: ("PENDING", lambda a: ""),
+    0x05: ("BUSY", lambda a: "queued" if a else "rejected"),
+    0x06: ("S3_TIMEOUT", lambda a: f"from session 0x{a:02X}"),
+    0x07: ("RCRRP_LIMIT", lambda a: ""),
+    0x08: ("JOB_SUBMIT", lambda a: f"job={a}"),
+    0x09: ("JOB_DONE", lambda a: f"job={a}"),
+    0x0A: ("JOB_STALE", lambda a: f"job={a}"),
+}
+
+
+def decode(data, big_endian=False):
+    """Yield (timestamp_us, text) for every complete record in data."""
+    fmt = (">" if big_endian else "<") + "IBBH"
+    for off in range(0, len(data) - RECORD_SIZE + 1, RECORD_SIZE):
+        ts, event, sid, arg = struct.unpack_from(fmt, data, off)
+        name, describe = EVENTS.get(event, (f"USER_0x{event:02X}", lambda a: f"arg=0x{a:04X}"))
+        sid_str = f"SID 0x{sid:02X}" if sid else "       "
+        yield ts, f"{name:<12} {sid_str} {describe(arg)}".rstrip()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", help="binary trace dump")
+    parser.add_argument("--big-endian", action="store_true", help="dump taken on a big-endian target")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+    if len(data) % RECORD_SIZE:
+        print(f"warning: {len(data) % RECORD_SIZE} trailing bytes ignored", file=sys.stderr)
+
+    prev = None
+    for ts, text in decode(data, args.big_endian):
+        delta = "" if prev is None else f"(+{(ts - prev) & 0xFFFFFFFF} us)"
+        print(f"{ts / 1000.0:12.3f} ms {delta:>16}  {text}")
+        prev = ts
+
+
+if __name__ == "__main__":
+    main()
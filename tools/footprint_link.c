@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file footprint_link.c
+ * @brief Smallest ReadDataByIdentifier + TesterPresent Application
+ *
+ * Linked against uds_minimal with unused sections garbage-collected. Its
+ * text + data is what such an ECU spends on the stack, which the
+ * size_minimal_link test holds under UDS_MINIMAL_LINK_BUDGET: a feature that
+ * is compiled out must not leave code behind in this link.
+ */
+
+#include "uds/uds_core.h"
+
+static uint8_t g_rx[64];
+static uint8_t g_tx[64];
+static uint8_t g_vin[17];
+
+static const uds_did_entry_t g_dids[] = {
+    {0xF190, sizeof(g_vin), 0, 0, NULL, NULL, g_vin, 0},
+};
+
+static uint32_t link_time_ms(void)
+{
+    return 0u;
+}
+
+static int link_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    return 0;
+}
+
+int main(void)
+{
+    static uds_ctx_t ctx;
+    static uds_config_t cfg;
+    static const uint8_t request[] = {0x22, 0xF1, 0x90};
+
+    cfg.get_time_ms = link_time_ms;
+    cfg.fn_tp_send = link_send;
+    cfg.rx_buffer = g_rx;
+    cfg.rx_buffer_size = sizeof(g_rx);
+    cfg.tx_buffer = g_tx;
+    cfg.tx_buffer_size = sizeof(g_tx);
+    cfg.did_table.entries = g_dids;
+    cfg.did_table.count = 1u;
+
+    if (uds_init(&ctx, &cfg) != UDS_OK) {
+        return 1;
+    }
+    uds_input_sdu(&ctx, request, sizeof(request));
+    uds_process(&ctx);
+    return 0;
+}
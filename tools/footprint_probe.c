@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file footprint_probe.c
+ * @brief Per-Instance RAM Probe for the size_report Target
+ *
+ * Compiled with the same UDS_CFG_* definitions as the library variant it
+ * describes. Its .bss is the RAM an application spends on one server context
+ * and one tester state slot; everything else the stack uses is
+ * application-owned (buffers, tables) or lives on the stack.
+ */
+
+#include "uds/uds_core.h"
+
+uds_ctx_t uds_probe_ctx;
+uds_tester_state_t uds_probe_tester;
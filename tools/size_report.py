@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 Andrii Shylenko
+# SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+
+"""Print the flash and RAM footprint of UDS library variants.
+
+Each variant is given as NAME=ARCHIVE:PROBE, where ARCHIVE is the static
+library and PROBE the footprint_probe.c object built with the same UDS_CFG_*
+definitions. Flash is text + data of the archive, static RAM is data + bss of
+the archive, and context RAM is the bss of the probe (one uds_ctx_t plus one
+uds_tester_state_t).
+
+A linked application is given with --link NAME=EXECUTABLE; its flash is the
+text + data of the executable. With --budget, the exit status is 1 if any
+linked application is larger than BYTES of flash.
+
+Usage: size_report.py [--size-tool size] [--link NAME=EXECUTABLE] [--budget BYTES]
+                      [NAME=ARCHIVE:PROBE...]
+"""
+
+import argparse
+import subprocess
+import sys
+
+
+def berkeley_totals(size_tool, path):
+    """Sum text, data and bss over every object in path."""
+    out = subprocess.run([size_tool, path], check=True, capture_output=True, text=True).stdout
+    text = data = bss = 0
+    for line in out.splitlines()[1:]:
+        fields = line.split()
+        if len(fields) < 3 or not fields[0].isdigit():
+            continue
+        text += int(fields[0])
+        data += int(fields[1])
+        bss += int(fields[2])
+    return text, data, bss
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--size-tool", default="size", help="Berkeley-format size binary")
+    parser.add_argument("--link", action="append", default=[], metavar="NAME=EXECUTABLE",
+                        help="linked application to report")
+    parser.add_argument("--budget", type=int, metavar="BYTES",
+                        help="largest flash allowed for the linked applications")
+    parser.add_argument("variants", nargs="*", metavar="NAME=ARCHIVE:PROBE")
+    args = parser.parse_args()
+    if not args.variants and not args.link:
+        parser.error("nothing to report")
+
+    rows = []
+    for spec in args.variants:
+        name, _, paths = spec.partition("=")
+        archive, _, probe = paths.partition(":")
+        if not name or not archive or not probe:
+            parser.error("bad variant '%s'" % spec)
+        text, data, bss = berkeley_totals(args.size_tool, archive)
+        _, _, ctx_bss = berkeley_totals(args.size_tool, probe)
+        rows.append((name, text + data, data + bss, ctx_bss))
+
+    if rows:
+        print("%-16s %10s %12s %12s" % ("variant", "flash", "static RAM", "context RAM"))
+        for name, flash, ram, ctx in rows:
+            print("%-16s %10d %12d %12d" % (name, flash, ram, ctx))
+
+    status = 0
+    for spec in args.link:
+        name, _, path = spec.partition("=")
+        if not name or not path:
+            parser.error("bad link '%s'" % spec)
+        text, data, bss = berkeley_totals(args.size_tool, path)
+        line = "%-16s %10d %12d" % (name, text + data, data + bss)
+        if args.budget is not None:
+            line += "   budget %d" % args.budget
+            if text + data > args.budget:
+                line += "   EXCEEDED"
+                status = 1
+        print(line)
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,847 @@
+/*
+ * Copyright (c) 2026 Andrii Shylenko
+ * SPDX-License-Identifier: PolyForm-Noncommercial-1.0.0
+ */
+
+/**
+ * @file wcet_harness.c
+ * @brief Worst-Case Execution Time Harness for Request Dispatch
+ *
+ * Host-side sweep through uds_input_sdu(): every SID with every value of the
+ * first request byte (subfunction, DID high byte, format identifier), at the
+ * boundary lengths of the SID and at the maximum request size, in each
+ * session / security / transfer state of the scenario table. A maximum-size
+ * multi-DID request and one request per configured DID are added on top.
+ *
+ * Each request is timed from the call into the stack until it returns, which
+ * covers dispatch, the handler and the response send. It is repeated from a
+ * fresh server and the fastest repetition is kept, so that host noise
+ * (preemption, page faults) does not mask the cost of the input itself.
+ * Samples are grouped by path: (SID, subfunction of positive responses,
+ * result), where the result is the positive response, the NRC, or no
+ * response. Max, p99 and mean cycles over the inputs of a path are reported.
+ *
+ * The time hook is the CPU cycle counter where one is available (TSC on x86,
+ * virtual counter on AArch64) and CLOCK_MONOTONIC nanoseconds otherwise.
+ * Define UDS_WCET_CYCLES to the name of a `uint64_t fn(void)` to plug in a
+ * target counter instead (e.g. DWT->CYCCNT when run on hardware).
+ *
+ * Usage:
+ *   uds_wcet [--iterations N] [--clock tsc|ns] [--save FILE]
+ *            [--baseline FILE] [--tolerance PERCENT] [--slack CYCLES]
+ *
+ * --save writes the worst case of every path. --baseline compares the run
+ * against such a file and exits with 1 if any path got slower than the
+ * baseline plus the tolerance (or plus the slack, whichever is larger: short
+ * paths jitter by more than a percentage on a host).
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "uds/uds_core.h"
+#include "uds/uds_dyn_did.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/** Largest request the harness sends (classic ISO-TP limit) */
+#define WCET_RX_SIZE 4095u
+/** Response buffer; large enough for the maximum multi-DID response */
+#define WCET_TX_SIZE 8192u
+/** Upper bound on distinct paths */
+#define WCET_MAX_PATHS 2048u
+/** Sub value of paths without a subfunction */
+#define WCET_NO_SUB 0xFFFFu
+/** Result value of positive responses */
+#define WCET_POSITIVE 0x100u
+/** Result value of suppressed / missing responses */
+#define WCET_NONE 0x200u
+
+/* --- Time Hook --- */
+
+static uint64_t clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec;
+}
+
+#if defined(UDS_WCET_CYCLES)
+uint64_t UDS_WCET_CYCLES(void);
+static uint64_t clock_cycles(void)
+{
+    return UDS_WCET_CYCLES();
+}
+#define WCET_HAVE_CYCLES 1
+#elif defined(__x86_64__) || defined(__i386__)
+static uint64_t clock_cycles(void)
+{
+    /* Fenced so the read is not reordered around the measured call */
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+#define WCET_HAVE_CYCLES 1
+#elif defined(__aarch64__)
+static uint64_t clock_cycles(void)
+{
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(t)::"memory");
+    return t;
+}
+#define WCET_HAVE_CYCLES 1
+#else
+#define WCET_HAVE_CYCLES 0
+#endif
+
+static uint64_t (*g_clock)(void) = clock_ns;
+static uint64_t g_clock_overhead;
+
+/* Smallest back-to-back reading: subtracted from every sample */
+static uint64_t measure_overhead(void)
+{
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t t0 = g_clock();
+        uint64_t t1 = g_clock();
+        if ((t1 - t0) < best) {
+            best = t1 - t0;
+        }
+    }
+    return best;
+}
+
+/* --- Application Under Test --- */
+
+static uint8_t g_rx[WCET_RX_SIZE];
+static uint8_t g_tx[WCET_TX_SIZE];
+static uint8_t g_resp[4];
+static uint16_t g_resp_len;
+
+static uint8_t g_vin[17] = "WVWZZZ1JZXW000001";
+static uint8_t g_word[2] = {0x12, 0x34};
+static uint8_t g_byte[1] = {0x5A};
+static uint8_t g_seed[4] = {0x11, 0x22, 0x33, 0x44};
+
+static uint32_t app_time(void)
+{
+    return 1000u;
+}
+
+static int app_send(uds_ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    g_resp_len = len;
+    memcpy(g_resp, data, (len < sizeof(g_resp)) ? len : sizeof(g_resp));
+    return 0;
+}
+
+static int app_did_read(uds_ctx_t *ctx, uint16_t did, uint8_t *buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) did;
+    memset(buf, 0xA5, max_len);
+    return (int) max_len;
+}
+
+static int app_did_write(uds_ctx_t *ctx, uint16_t did, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) did;
+    (void) data;
+    (void) len;
+    return UDS_OK;
+}
+
+static const uds_did_entry_t g_dids[] = {
+    {0xF190, 17, UDS_SESSION_ALL, 0, NULL, NULL, g_vin, 0},
+    {0xF18C, 4, UDS_SESSION_ALL, 0, app_did_read, NULL, NULL, 0},
+    {0x0100, 2, UDS_SESSION_ALL, 0, NULL, app_did_write, g_word, 0},
+    {0x0200, 2, UDS_SESSION_EXTENDED | UDS_SESSION_PROGRAMMING, 0, app_did_read, app_did_write,
+     NULL, 0},
+    {0x0300, 2, UDS_SESSION_ALL, UDS_SECURITY_LEVEL(1), NULL, app_did_write, g_word, 0},
+    {0x0400, 2, UDS_SESSION_ALL, 0, NULL, NULL, NULL, 0},
+    {0xFD00, 1, UDS_SESSION_ALL, 0, NULL, NULL, g_byte, 0},
+};
+#define WCET_DID_COUNT (sizeof(g_dids) / sizeof(g_dids[0]))
+
+static uds_dyn_did_t g_dyn_dids[4];
+
+static void app_reset(uds_ctx_t *ctx, uint8_t type)
+{
+    (void) ctx;
+    (void) type;
+}
+
+static int app_comm_control(uds_ctx_t *ctx, uint8_t ctrl_type, uint8_t comm_type)
+{
+    (void) ctx;
+    (void) comm_type;
+    return (ctrl_type <= 3u) ? UDS_OK : -0x31;
+}
+
+static int app_seed(uds_ctx_t *ctx, uint8_t level, uint8_t *seed_buf, uint16_t max_len)
+{
+    (void) ctx;
+    if ((level > 2u) || (max_len < sizeof(g_seed))) {
+        return -0x31;
+    }
+    memcpy(seed_buf, g_seed, sizeof(g_seed));
+    return (int) sizeof(g_seed);
+}
+
+static int app_key(uds_ctx_t *ctx, uint8_t level, const uint8_t *seed, const uint8_t *key,
+                   uint16_t key_len)
+{
+    (void) ctx;
+    (void) seed; /* The stack does not keep the seed: compare with the one handed out */
+    if ((level > 2u) || (key_len != sizeof(g_seed))) {
+        return -0x35;
+    }
+    for (uint16_t i = 0u; i < key_len; i++) {
+        if ((uint8_t) (key[i] ^ g_seed[i]) != 0xFFu) {
+            return -0x35;
+        }
+    }
+    return UDS_OK;
+}
+
+static int app_dtc_read(uds_ctx_t *ctx, uint8_t subfn, uint8_t *out_buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) subfn;
+    uint16_t n = (max_len < 8u) ? max_len : 8u;
+    memset(out_buf, 0x01, n);
+    return (int) n;
+}
+
+static int app_dtc_clear(uds_ctx_t *ctx, uint32_t group)
+{
+    (void) ctx;
+    return (group == 0xFFFFFFu) ? UDS_OK : -0x31;
+}
+
+static int app_auth(uds_ctx_t *ctx, uint8_t subfn, const uint8_t *data, uint16_t len,
+                    uint8_t *out_buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) data;
+    (void) len;
+    if ((subfn > 0x08u) || (max_len < 2u)) {
+        return -0x12;
+    }
+    out_buf[0] = 0x00;
+    out_buf[1] = 0x00;
+    return 2;
+}
+
+static int app_routine(uds_ctx_t *ctx, uint8_t type, uint16_t id, const uint8_t *data,
+                       uint16_t len, uint8_t *out_buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) type;
+    (void) data;
+    (void) len;
+    if ((id != 0xFF00u) || (max_len < 1u)) {
+        return -0x31;
+    }
+    out_buf[0] = 0x00;
+    return 1;
+}
+
+static int app_download(uds_ctx_t *ctx, uint32_t addr, uint32_t size)
+{
+    (void) ctx;
+    (void) addr;
+    return (size <= 0x10000u) ? UDS_OK : -0x70;
+}
+
+static int app_transfer(uds_ctx_t *ctx, uint8_t sequence, const uint8_t *data, uint16_t len)
+{
+    (void) ctx;
+    (void) sequence;
+    (void) data;
+    (void) len;
+    return UDS_OK;
+}
+
+static int app_transfer_exit(uds_ctx_t *ctx)
+{
+    (void) ctx;
+    return UDS_OK;
+}
+
+static int app_mem_read(uds_ctx_t *ctx, uint32_t addr, uint32_t size, uint8_t *out_buf)
+{
+    (void) ctx;
+    (void) addr;
+    memset(out_buf, 0x3C, size);
+    return UDS_OK;
+}
+
+static int app_mem_write(uds_ctx_t *ctx, uint32_t addr, uint32_t size, const uint8_t *data)
+{
+    (void) ctx;
+    (void) addr;
+    (void) size;
+    (void) data;
+    return UDS_OK;
+}
+
+static int app_io_control(uds_ctx_t *ctx, uint16_t id, uint8_t type, const uint8_t *data,
+                          uint16_t len, uint8_t *out_buf, uint16_t max_len)
+{
+    (void) ctx;
+    (void) type;
+    (void) data;
+    (void) len;
+    if ((id != 0x0100u) || (max_len < 2u)) {
+        return -0x31;
+    }
+    memcpy(out_buf, g_word, 2u);
+    return 2;
+}
+
+static int app_periodic_read(uds_ctx_t *ctx, uint8_t periodic_id, uint8_t *out_buf,
+                             uint16_t max_len)
+{
+    (void) ctx;
+    (void) periodic_id;
+    if (max_len < 2u) {
+        return -0x14;
+    }
+    memcpy(out_buf, g_word, 2u);
+    return 2;
+}
+
+static uds_config_t g_cfg;
+static uds_ctx_t g_ctx;
+
+static void config_init(void)
+{
+    memset(&g_cfg, 0, sizeof(g_cfg));
+    g_cfg.get_time_ms = app_time;
+    g_cfg.fn_tp_send = app_send;
+    g_cfg.p2_ms = 50;
+    g_cfg.p2_star_ms = 5000;
+    g_cfg.rx_buffer = g_rx;
+    g_cfg.rx_buffer_size = WCET_RX_SIZE;
+    g_cfg.tx_buffer = g_tx;
+    g_cfg.tx_buffer_size = WCET_TX_SIZE;
+    g_cfg.fn_reset = app_reset;
+    g_cfg.fn_comm_control = app_comm_control;
+    g_cfg.fn_security_seed = app_seed;
+    g_cfg.fn_security_key = app_key;
+    g_cfg.did_table.entries = g_dids;
+    g_cfg.did_table.count = (uint16_t) WCET_DID_COUNT;
+    g_cfg.dyn_dids = g_dyn_dids;
+    g_cfg.dyn_did_count = (uint8_t) (sizeof(g_dyn_dids) / sizeof(g_dyn_dids[0]));
+    g_cfg.fn_dtc_read = app_dtc_read;
+    g_cfg.fn_dtc_clear = app_dtc_clear;
+    g_cfg.fn_auth = app_auth;
+    g_cfg.fn_routine_control = app_routine;
+    g_cfg.fn_request_download = app_download;
+    g_cfg.fn_transfer_data = app_transfer;
+    g_cfg.fn_transfer_exit = app_transfer_exit;
+    g_cfg.fn_mem_read = app_mem_read;
+    g_cfg.fn_mem_write = app_mem_write;
+    g_cfg.fn_io_control = app_io_control;
+    g_cfg.fn_request_upload = app_download;
+    g_cfg.fn_periodic_read = app_periodic_read;
+}
+
+/* --- Scenarios --- */
+
+static void send_untimed(const uint8_t *req, uint16_t len)
+{
+    uds_input_sdu(&g_ctx, req, len);
+}
+
+static void prep_download(void)
+{
+    static const uint8_t req[] = {0x34, 0x00, 0x44, 0, 0, 0, 0, 0, 0, 0x10, 0x00};
+    send_untimed(req, sizeof(req));
+}
+
+static void prep_upload(void)
+{
+    static const uint8_t req[] = {0x35, 0x00, 0x44, 0, 0, 0, 0, 0, 0, 0x10, 0x00};
+    send_untimed(req, sizeof(req));
+}
+
+static void prep_seed(void)
+{
+    static const uint8_t req[] = {0x27, 0x01};
+    send_untimed(req, sizeof(req));
+}
+
+static void prep_lockout(void)
+{
+    static const uint8_t bad[] = {0x27, 0x02, 0, 0, 0, 0};
+    for (int i = 0; i < 3; i++) {
+        prep_seed();
+        send_untimed(bad, sizeof(bad));
+    }
+}
+
+static void prep_dynamic(void)
+{
+    /* 0xF200 from slices of a static and a read-callback DID */
+    static const uint8_t req[] = {0x2C, 0x01, 0xF2, 0x00, 0xF1, 0x90, 0x01, 0x08,
+                                  0xF1, 0x8C, 0x01, 0x02, 0xF1, 0x90, 0x0A, 0x08,
+                                  0xF1, 0x8C, 0x03, 0x02, 0xFD, 0x00, 0x01, 0x01};
+    send_untimed(req, sizeof(req));
+}
+
+/**
+ * @brief Server state a request is measured in
+ */
+typedef struct
+{
+    const char *name;   /**< Printed name */
+    uint8_t session;    /**< Active session */
+    uint8_t level;      /**< Unlocked security level */
+    void (*prep)(void); /**< Untimed requests that set up the state (NULL = none) */
+} wcet_scenario_t;
+
+static const wcet_scenario_t g_scenarios[] = {
+    {"default/locked", 0x01, 0, NULL},
+    {"extended/locked", 0x03, 0, NULL},
+    {"extended/seed", 0x03, 0, prep_seed},
+    {"extended/lockout", 0x03, 0, prep_lockout},
+    {"extended/level1", 0x03, 1, NULL},
+    {"extended/dynamic-did", 0x03, 1, prep_dynamic},
+    {"programming/level1", 0x02, 1, NULL},
+    {"programming/download", 0x02, 1, prep_download},
+    {"programming/upload", 0x02, 1, prep_upload},
+};
+#define WCET_SCENARIO_COUNT (sizeof(g_scenarios) / sizeof(g_scenarios[0]))
+
+/* --- Request Templates --- */
+
+/**
+ * @brief Well-formed request of a SID; byte 1 is swept over 0x00..0xFF
+ */
+typedef struct
+{
+    uint8_t len;
+    uint8_t bytes[20];
+    bool subfunction; /**< Byte 1 is a subfunction (positive paths keyed by it) */
+} wcet_template_t;
+
+static const wcet_template_t g_templates[] = {
+    {2, {0x10, 0x03}, true},
+    {2, {0x11, 0x01}, true},
+    {4, {0x14, 0xFF, 0xFF, 0xFF}, false},
+    {3, {0x19, 0x02, 0xFF}, true},
+    {3, {0x22, 0xF1, 0x90}, false},
+    {10, {0x23, 0x44, 0, 0, 0x10, 0, 0, 0, 0, 0x10}, false},
+    {6, {0x27, 0x02, 0xEE, 0xDD, 0xCC, 0xBB}, true},
+    {3, {0x28, 0x00, 0x01}, true},
+    {4, {0x29, 0x01, 0x00, 0x00}, true},
+    {3, {0x2A, 0x01, 0x01}, false},
+    {8, {0x2C, 0x01, 0xF2, 0x00, 0xF1, 0x90, 0x01, 0x04}, true},
+    {5, {0x2E, 0x01, 0x00, 0xAA, 0xBB}, false},
+    {5, {0x2F, 0x01, 0x00, 0x03, 0x00}, false},
+    {4, {0x31, 0x01, 0xFF, 0x00}, true},
+    {11, {0x34, 0x00, 0x44, 0, 0, 0, 0, 0, 0, 0x10, 0x00}, false},
+    {11, {0x35, 0x00, 0x44, 0, 0, 0, 0, 0, 0, 0x10, 0x00}, false},
+    {18, {0x36, 0x01, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}, false},
+    {1, {0x37}, false},
+    {12, {0x3D, 0x24, 0, 0, 0x10, 0, 0, 0, 0, 0x02, 0x55, 0xAA}, false},
+    {2, {0x3E, 0x00}, true},
+    {2, {0x85, 0x01}, true},
+};
+#define WCET_TEMPLATE_COUNT (sizeof(g_templates) / sizeof(g_templates[0]))
+
+static const wcet_template_t *find_template(uint8_t sid)
+{
+    for (size_t i = 0; i < WCET_TEMPLATE_COUNT; i++) {
+        if (g_templates[i].bytes[0] == sid) {
+            return &g_templates[i];
+        }
+    }
+    return NULL;
+}
+
+/* --- Path Statistics --- */
+
+typedef struct
+{
+    uint8_t sid;
+    uint16_t sub;    /**< Subfunction of positive responses, WCET_NO_SUB otherwise */
+    uint16_t result; /**< NRC, WCET_POSITIVE or WCET_NONE */
+    uint64_t *samples;
+    size_t count;
+    size_t capacity;
+    uint64_t max;
+    uint64_t p99;
+    double mean;
+} wcet_path_t;
+
+static wcet_path_t g_paths[WCET_MAX_PATHS];
+static size_t g_path_count;
+
+static wcet_path_t *path_get(uint8_t sid, uint16_t sub, uint16_t result)
+{
+    for (size_t i = 0; i < g_path_count; i++) {
+        wcet_path_t *p = &g_paths[i];
+        if ((p->sid == sid) && (p->sub == sub) && (p->result == result)) {
+            return p;
+        }
+    }
+    if (g_path_count >= WCET_MAX_PATHS) {
+        fprintf(stderr, "wcet: more than %u paths\n", WCET_MAX_PATHS);
+        exit(2);
+    }
+    wcet_path_t *p = &g_paths[g_path_count++];
+    p->sid = sid;
+    p->sub = sub;
+    p->result = result;
+    return p;
+}
+
+static void path_add(wcet_path_t *p, uint64_t cycles)
+{
+    if (p->count == p->capacity) {
+        p->capacity = (p->capacity == 0u) ? 256u : (p->capacity * 2u);
+        p->samples = realloc(p->samples, p->capacity * sizeof(uint64_t));
+        if (p->samples == NULL) {
+            fprintf(stderr, "wcet: out of memory\n");
+            exit(2);
+        }
+    }
+    p->samples[p->count++] = cycles;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_path(const void *a, const void *b)
+{
+    const wcet_path_t *x = a;
+    const wcet_path_t *y = b;
+    if (x->sid != y->sid) {
+        return (int) x->sid - (int) y->sid;
+    }
+    if (x->sub != y->sub) {
+        return (int) x->sub - (int) y->sub;
+    }
+    return (int) x->result - (int) y->result;
+}
+
+static void path_finish(wcet_path_t *p)
+{
+    double sum = 0.0;
+    qsort(p->samples, p->count, sizeof(uint64_t), cmp_u64);
+    for (size_t i = 0; i < p->count; i++) {
+        sum += (double) p->samples[i];
+    }
+    p->max = p->samples[p->count - 1u];
+    p->p99 = p->samples[((p->count * 99u) + 99u) / 100u - 1u];
+    p->mean = sum / (double) p->count;
+}
+
+/* --- Measurement --- */
+
+static const wcet_template_t *g_current;
+
+/* Time one request from a fresh server in the scenario state */
+static uint64_t time_one(const wcet_scenario_t *sc, const uint8_t *req, uint16_t len)
+{
+    memset(g_dyn_dids, 0, sizeof(g_dyn_dids));
+    uds_init(&g_ctx, &g_cfg);
+    g_ctx.active_session = sc->session;
+    g_ctx.security_level = sc->level;
+    if (sc->prep != NULL) {
+        sc->prep();
+    }
+    g_resp_len = 0u;
+
+    uint64_t t0 = g_clock();
+    uds_input_sdu(&g_ctx, req, len);
+    uint64_t t1 = g_clock();
+    return ((t1 - t0) > g_clock_overhead) ? (t1 - t0 - g_clock_overhead) : 0u;
+}
+
+static void run_request(const uint8_t *req, uint16_t len, unsigned iterations)
+{
+    for (size_t s = 0; s < WCET_SCENARIO_COUNT; s++) {
+        /* The same input takes the same path: the fastest repetition is its cost without
+         * preemption, cache misses or page faults of the host */
+        uint64_t cycles = UINT64_MAX;
+        for (unsigned n = 0; n < iterations; n++) {
+            uint64_t t = time_one(&g_scenarios[s], req, len);
+            cycles = (t < cycles) ? t : cycles;
+        }
+
+        uint16_t result = WCET_POSITIVE;
+        uint16_t sub = WCET_NO_SUB;
+        if (g_resp_len == 0u) {
+            result = WCET_NONE;
+        }
+        else if ((g_resp[0] == 0x7Fu) && (g_resp_len >= 3u)) {
+            result = g_resp[2];
+        }
+        else if ((g_current != NULL) && g_current->subfunction && (len >= 2u)) {
+            sub = (uint16_t) (req[1] & 0x7Fu);
+        }
+        path_add(path_get(req[0], sub, result), cycles);
+    }
+}
+
+static void run_sweep(unsigned iterations)
+{
+    static uint8_t req[WCET_RX_SIZE];
+
+    for (unsigned sid = 0u; sid <= 0xFFu; sid++) {
+        g_current = find_template((uint8_t) sid);
+        memset(req, 0, sizeof(req));
+        req[0] = (uint8_t) sid;
+
+        if (g_current == NULL) {
+            /* Not a core service: one request per length class is enough */
+            run_request(req, 1u, iterations);
+            run_request(req, 2u, iterations);
+            continue;
+        }
+
+        uint16_t tl = g_current->len;
+        uint16_t lengths[] = {1u, 2u, (uint16_t) (tl - 1u), tl, (uint16_t) (tl + 1u),
+                              WCET_RX_SIZE};
+        memcpy(req, g_current->bytes, tl);
+        for (unsigned b1 = 0u; b1 <= 0xFFu; b1++) {
+            req[1] = (uint8_t) b1;
+            for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+                bool dup = false;
+                for (size_t k = 0; k < l; k++) {
+                    dup = dup || (lengths[k] == lengths[l]);
+                }
+                if ((lengths[l] >= 1u) && !dup) {
+                    run_request(req, lengths[l], iterations);
+                }
+            }
+        }
+    }
+
+    /* Subfunctions the template sweep cannot reach with valid parameters */
+    static const uint8_t define_by_memory[] = {0x2C, 0x02, 0xF2, 0x01, 0x14, 0, 0, 0x10, 0, 0x04};
+    g_current = find_template(0x2C);
+    run_request(define_by_memory, sizeof(define_by_memory), iterations);
+
+    /* Every configured DID through 0x22 and 0x2E */
+    g_current = NULL;
+    for (size_t i = 0; i < WCET_DID_COUNT; i++) {
+        uint8_t rd[3] = {0x22, (uint8_t) (g_dids[i].id >> 8u), (uint8_t) g_dids[i].id};
+        run_request(rd, sizeof(rd), iterations);
+
+        memset(req, 0x5A, 3u + g_dids[i].size);
+        req[0] = 0x2E;
+        req[1] = rd[1];
+        req[2] = rd[2];
+        run_request(req, (uint16_t) (3u + g_dids[i].size), iterations);
+    }
+
+    /* Maximum-size multi-DID requests: last table entry (longest lookup), then a read callback */
+    static const uint16_t multi[] = {0xFD00, 0xF18C};
+    for (size_t m = 0; m < sizeof(multi) / sizeof(multi[0]); m++) {
+        req[0] = 0x22;
+        uint16_t len = 1u;
+        while (len + 2u <= WCET_RX_SIZE) {
+            req[len++] = (uint8_t) (multi[m] >> 8u);
+            req[len++] = (uint8_t) multi[m];
+        }
+        run_request(req, len, iterations);
+    }
+}
+
+/* --- Report and Regression Gate --- */
+
+static void format_key(const wcet_path_t *p, char *sub, char *result)
+{
+    if (p->sub == WCET_NO_SUB) {
+        strcpy(sub, "--");
+    }
+    else {
+        sprintf(sub, "%02X", (unsigned) p->sub);
+    }
+    if (p->result == WCET_POSITIVE) {
+        strcpy(result, "pos");
+    }
+    else if (p->result == WCET_NONE) {
+        strcpy(result, "none");
+    }
+    else {
+        sprintf(result, "%02X", (unsigned) p->result);
+    }
+}
+
+static void report(void)
+{
+    char sub[8];
+    char result[8];
+    uint64_t worst = 0u;
+
+    printf("%-4s %-4s %-6s %10s %12s %12s %12s\n", "SID", "SUB", "RESULT", "SAMPLES", "MEAN",
+           "P99", "MAX");
+    for (size_t i = 0; i < g_path_count; i++) {
+        const wcet_path_t *p = &g_paths[i];
+        format_key(p, sub, result);
+        printf("%02X   %-4s %-6s %10zu %12.1f %12llu %12llu\n", (unsigned) p->sid, sub, result,
+               p->count, p->mean, (unsigned long long) p->p99, (unsigned long long) p->max);
+        worst = (p->max > worst) ? p->max : worst;
+    }
+    printf("%zu paths, worst case %llu\n", g_path_count, (unsigned long long) worst);
+}
+
+static int save(const char *file)
+{
+    FILE *f = fopen(file, "w");
+    char sub[8];
+    char result[8];
+
+    if (f == NULL) {
+        perror(file);
+        return 2;
+    }
+    fprintf(f, "# sid sub result max\n");
+    for (size_t i = 0; i < g_path_count; i++) {
+        format_key(&g_paths[i], sub, result);
+        fprintf(f, "%02X %s %s %llu\n", (unsigned) g_paths[i].sid, sub, result,
+                (unsigned long long) g_paths[i].max);
+    }
+    fclose(f);
+    return 0;
+}
+
+static int check_baseline(const char *file, unsigned tolerance, unsigned long long slack)
+{
+    FILE *f = fopen(file, "r");
+    char line[128];
+    int regressions = 0;
+
+    if (f == NULL) {
+        perror(file);
+        return 2;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        unsigned sid;
+        char sub_s[8];
+        char result_s[8];
+        unsigned long long base;
+        if ((line[0] == '#') ||
+            (sscanf(line, "%x %7s %7s %llu", &sid, sub_s, result_s, &base) != 4)) {
+            continue;
+        }
+
+        const wcet_path_t *p = NULL;
+        char sub[8];
+        char result[8];
+        for (size_t i = 0; (i < g_path_count) && (p == NULL); i++) {
+            format_key(&g_paths[i], sub, result);
+            if ((g_paths[i].sid == sid) && (strcmp(sub, sub_s) == 0) &&
+                (strcmp(result, result_s) == 0)) {
+                p = &g_paths[i];
+            }
+        }
+        if (p == NULL) {
+            printf("wcet: path %02X %s %s no longer reached\n", sid, sub_s, result_s);
+            continue;
+        }
+        unsigned long long margin = (base * tolerance) / 100u;
+        unsigned long long limit = base + ((margin > slack) ? margin : slack);
+        if (p->max > limit) {
+            printf("wcet: REGRESSION %02X %s %s: %llu > %llu (baseline %llu)\n", sid, sub_s,
+                   result_s, (unsigned long long) p->max, limit, base);
+            regressions++;
+        }
+    }
+    fclose(f);
+
+    printf("wcet: %d path(s) over the baseline\n", regressions);
+    return (regressions > 0) ? 1 : 0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: uds_wcet [--iterations N] [--clock tsc|ns] [--save FILE]\n"
+                    "                [--baseline FILE] [--tolerance PERCENT] [--slack CYCLES]\n");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned iterations = 10u;
+    unsigned tolerance = 20u;
+    unsigned long long slack = 256u;
+    const char *save_file = NULL;
+    const char *baseline = NULL;
+
+#if WCET_HAVE_CYCLES
+    g_clock = clock_cycles;
+#endif
+    for (int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if ((strcmp(argv[i], "--iterations") == 0) && has_value) {
+            iterations = (unsigned) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "--clock") == 0) && has_value) {
+            const char *name = argv[++i];
+            if (strcmp(name, "ns") == 0) {
+                g_clock = clock_ns;
+            }
+            else if ((strcmp(name, "tsc") != 0) || !WCET_HAVE_CYCLES) {
+                fprintf(stderr, "wcet: clock '%s' not available\n", name);
+                return 2;
+            }
+        }
+        else if ((strcmp(argv[i], "--save") == 0) && has_value) {
+            save_file = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--baseline") == 0) && has_value) {
+            baseline = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--tolerance") == 0) && has_value) {
+            tolerance = (unsigned) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "--slack") == 0) && has_value) {
+            slack = strtoull(argv[++i], NULL, 0);
+        }
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (iterations == 0u) {
+        iterations = 1u;
+    }
+
+    config_init();
+    g_clock_overhead = measure_overhead();
+    run_sweep(iterations);
+
+    qsort(g_paths, g_path_count, sizeof(wcet_path_t), cmp_path);
+    for (size_t i = 0; i < g_path_count; i++) {
+        path_finish(&g_paths[i]);
+    }
+    report();
+
+    int rc = 0;
+    if (save_file != NULL) {
+        rc = save(save_file);
+    }
+    if ((rc == 0) && (baseline != NULL)) {
+        rc = check_baseline(baseline, tolerance, slack);
+    }
+    return rc;
+}
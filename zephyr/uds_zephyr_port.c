@@ -27,3 +27,39 @@ void uds_log_zephyr(uint8_t level, const char *msg)
 {
     printk("[%u] UDS: %s\n", level, msg);
 }
+
+#ifdef CONFIG_UDSLIB_JOB_WORKER
+#include "uds/uds_job.h"
+
+K_MSGQ_DEFINE(uds_job_msgq, sizeof(uds_job_t *), CONFIG_UDSLIB_JOB_QUEUE_DEPTH, 4);
+
+/**
+ * @brief Zephyr job executor (uds_config_t::fn_job_submit compatible).
+ *
+ * @param executor Unused (single worker thread).
+ * @param job      Job to run on the worker thread.
+ * @return 0 on success, negative errno if the queue is full.
+ */
+int uds_job_submit_zephyr(void *executor, uds_job_t *job)
+{
+    ARG_UNUSED(executor);
+    return k_msgq_put(&uds_job_msgq, &job, K_NO_WAIT);
+}
+
+static void uds_job_worker_zephyr(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    uds_job_t *job;
+    for (;;) {
+        if (k_msgq_get(&uds_job_msgq, &job, K_FOREVER) == 0) {
+            uds_job_execute(job);
+        }
+    }
+}
+
+K_THREAD_DEFINE(uds_job_worker, CONFIG_UDSLIB_JOB_WORKER_STACK_SIZE, uds_job_worker_zephyr, NULL,
+                NULL, NULL, CONFIG_UDSLIB_JOB_WORKER_PRIORITY, 0, 0);
+#endif /* CONFIG_UDSLIB_JOB_WORKER */